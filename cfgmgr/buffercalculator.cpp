@@ -0,0 +1,574 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include "logger.h"
+#include "buffercalculator.h"
+
+using namespace std;
+using namespace swss;
+
+#define STATE_ASIC_TABLE_NAME                   "ASIC_TABLE"
+#define CFG_LOSSLESS_TRAFFIC_PATTERN_TABLE_NAME "LOSSLESS_TRAFFIC_PATTERN"
+
+#define INGRESS_LOSSLESS_POOL_NAME  "ingress_lossless_pool"
+#define EGRESS_LOSSLESS_POOL_NAME   "egress_lossless_pool"
+
+namespace
+{
+    // Lua numbers are converted to strings this way
+    string formatNumber(double value)
+    {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%.14g", value);
+        return buf;
+    }
+
+    // Counterpart of tonumber() in Lua, which returns nil for empty or malformed strings
+    bool parseNumber(const string &str, double &value)
+    {
+        if (str.empty())
+            return false;
+
+        char *end = nullptr;
+        value = strtod(str.c_str(), &end);
+        return *end == '\0';
+    }
+
+    bool getNumberField(const vector<FieldValueTuple> &fvs, const string &field, double &value)
+    {
+        for (auto &fv : fvs)
+        {
+            if (fvField(fv) == field)
+                return parseNumber(fvValue(fv), value);
+        }
+
+        return false;
+    }
+
+    // Number of PGs or queues in an item, like 2 for "Ethernet0:3-4"
+    long countObjectIds(const string &key)
+    {
+        auto pos = key.find_last_of(':');
+        if (pos == string::npos)
+            return 1;
+
+        auto ids = key.substr(pos + 1);
+        auto dash = ids.find('-');
+        if (dash == string::npos)
+            return 1;
+
+        return atol(ids.substr(dash + 1).c_str()) - atol(ids.substr(0, dash).c_str()) + 1;
+    }
+}
+
+void BufferPoolAccounting::addReference(map<string, long> &references, const string &profile, long count)
+{
+    auto &reference = references[profile];
+    reference += count;
+    if (reference == 0)
+        references.erase(profile);
+}
+
+void BufferPoolAccounting::setPool(const string &name, const vector<FieldValueTuple> &fvs)
+{
+    pool_t pool;
+
+    for (auto &fv : fvs)
+    {
+        if (fvField(fv) == "type")
+            pool.type = fvValue(fv);
+        else if (fvField(fv) == "size")
+            pool.size = fvValue(fv);
+        else if (fvField(fv) == "xoff")
+            pool.xoff = fvValue(fv);
+    }
+
+    m_pools[name] = pool;
+}
+
+void BufferPoolAccounting::removePool(const string &name)
+{
+    m_pools.erase(name);
+}
+
+void BufferPoolAccounting::setProfile(const string &name, const vector<FieldValueTuple> &fvs)
+{
+    profile_t profile;
+
+    for (auto &fv : fvs)
+    {
+        if (fvField(fv) == "pool")
+            profile.pool = fvValue(fv);
+        else if (fvField(fv) == "size")
+            profile.size = fvValue(fv);
+        else if (fvField(fv) == "xon")
+            profile.xon = fvValue(fv);
+        else if (fvField(fv) == "xoff")
+            profile.xoff = fvValue(fv);
+    }
+
+    m_profiles[name] = profile;
+}
+
+void BufferPoolAccounting::removeProfile(const string &name)
+{
+    m_profiles.erase(name);
+}
+
+void BufferPoolAccounting::setPort(const string &port, long lane_count, bool admin_up)
+{
+    m_ports[port] = {lane_count, admin_up};
+}
+
+void BufferPoolAccounting::removePort(const string &port)
+{
+    m_ports.erase(port);
+}
+
+void BufferPoolAccounting::setObject(bool ingress, const string &key, const string &profile)
+{
+    removeObject(ingress, key);
+
+    object_t object = {key.substr(0, key.find(':')), profile, countObjectIds(key)};
+
+    addReference(m_objectReferences, profile, object.count);
+    if (ingress)
+    {
+        addReference(m_portPgReferences[object.port], profile, object.count);
+    }
+
+    m_objects[ingress ? 0 : 1][key] = object;
+}
+
+void BufferPoolAccounting::removeObject(bool ingress, const string &key)
+{
+    auto &objects = m_objects[ingress ? 0 : 1];
+    auto objectRef = objects.find(key);
+    if (objectRef == objects.end())
+        return;
+
+    auto &object = objectRef->second;
+
+    addReference(m_objectReferences, object.profile, -object.count);
+    if (ingress)
+    {
+        auto &portReferences = m_portPgReferences[object.port];
+        addReference(portReferences, object.profile, -object.count);
+        if (portReferences.empty())
+            m_portPgReferences.erase(object.port);
+    }
+
+    objects.erase(objectRef);
+}
+
+void BufferPoolAccounting::setProfileList(bool ingress, const string &port, const string &profileList)
+{
+    removeProfileList(ingress, port);
+
+    auto &profiles = m_profileLists[ingress ? 0 : 1][port];
+    size_t start = 0;
+    while (start <= profileList.size())
+    {
+        auto end = profileList.find(',', start);
+        if (end == string::npos)
+            end = profileList.size();
+        if (end > start)
+        {
+            profiles.push_back(profileList.substr(start, end - start));
+            addReference(m_listReferences, profiles.back(), 1);
+        }
+        start = end + 1;
+    }
+}
+
+void BufferPoolAccounting::removeProfileList(bool ingress, const string &port)
+{
+    auto &profileLists = m_profileLists[ingress ? 0 : 1];
+    auto listRef = profileLists.find(port);
+    if (listRef == profileLists.end())
+        return;
+
+    for (auto &profile : listRef->second)
+    {
+        addReference(m_listReferences, profile, -1);
+    }
+
+    profileLists.erase(listRef);
+}
+
+unique_ptr<BufferCalculator> BufferCalculator::create(const string &platform, const BufferPoolAccounting &accounting,
+                                                      DBConnector *cfgDb, DBConnector *stateDb)
+{
+    if (platform == "vs")
+    {
+        return unique_ptr<BufferCalculator>(new VsBufferCalculator(accounting, cfgDb, stateDb));
+    }
+
+    return nullptr;
+}
+
+VsBufferCalculator::VsBufferCalculator(const BufferPoolAccounting &accounting, DBConnector *cfgDb, DBConnector *stateDb) :
+    m_accounting(accounting),
+    m_stateAsicTable(stateDb, STATE_ASIC_TABLE_NAME),
+    m_cfgLosslessTrafficPatternTable(cfgDb, CFG_LOSSLESS_TRAFFIC_PATTERN_TABLE_NAME)
+{
+}
+
+bool VsBufferCalculator::fetchSingleEntry(Table &table, string &key, vector<FieldValueTuple> &fvs)
+{
+    if (key.empty())
+    {
+        vector<string> keys;
+        table.getKeys(keys);
+        if (keys.empty())
+            return false;
+        key = keys[0];
+    }
+
+    if (!table.get(key, fvs))
+    {
+        key.clear();
+        return false;
+    }
+
+    return true;
+}
+
+double VsBufferCalculator::getSharedHeadroomPoolSize() const
+{
+    double shp_size = 0;
+    auto &pools = m_accounting.getPools();
+    auto poolRef = pools.find(INGRESS_LOSSLESS_POOL_NAME);
+
+    if (poolRef == pools.end() || !parseNumber(poolRef->second.xoff, shp_size))
+        return 0;
+
+    return shp_size;
+}
+
+bool VsBufferCalculator::calculateHeadroom(const string &speed, const string &cable_length, const string &mtu,
+                                           const string &gearbox_delay, long lane_count, const string &over_subscribe_ratio,
+                                           vector<string> &result)
+{
+    // Pause quanta per operating speed in Mb/s, as defined in IEEE 802.3 31B.3.7
+    static const map<double, double> pause_quanta_per_speed = {
+        {400000, 905}, {200000, 453}, {100000, 394}, {50000, 147}, {40000, 118},
+        {25000, 80}, {10000, 67}, {1000, 2}, {100, 1}
+    };
+    const double speed_of_light = 198000000;
+    const double minimal_packet_size = 64;
+
+    double port_speed, cable, port_mtu, gearbox = 0;
+    if (!parseNumber(speed, port_speed) || cable_length.empty()
+        || !parseNumber(cable_length.substr(0, cable_length.size() - 1), cable)
+        || !parseNumber(mtu, port_mtu))
+    {
+        SWSS_LOG_INFO("Invalid headroom parameters speed %s cable length %s mtu %s", speed.c_str(), cable_length.c_str(), mtu.c_str());
+        return false;
+    }
+    parseNumber(gearbox_delay, gearbox);
+
+    vector<FieldValueTuple> asicInfo, trafficPattern;
+    if (!fetchSingleEntry(m_stateAsicTable, m_asicKey, asicInfo)
+        || !fetchSingleEntry(m_cfgLosslessTrafficPatternTable, m_losslessTrafficPatternKey, trafficPattern))
+    {
+        SWSS_LOG_INFO("ASIC table or lossless traffic pattern is not available for calculating headroom");
+        return false;
+    }
+
+    double cell_size, pipeline_latency, mac_phy_delay, peer_response_time;
+    double lossless_mtu, small_packet_percentage;
+    auto pause_quanta = pause_quanta_per_speed.find(port_speed);
+    if (!getNumberField(asicInfo, "cell_size", cell_size)
+        || !getNumberField(asicInfo, "pipeline_latency", pipeline_latency)
+        || !getNumberField(asicInfo, "mac_phy_delay", mac_phy_delay)
+        || !getNumberField(trafficPattern, "mtu", lossless_mtu)
+        || !getNumberField(trafficPattern, "small_packet_percentage", small_packet_percentage))
+    {
+        SWSS_LOG_INFO("Missing parameters in ASIC table or lossless traffic pattern for calculating headroom");
+        return false;
+    }
+
+    if (pause_quanta != pause_quanta_per_speed.end())
+    {
+        peer_response_time = pause_quanta->second * 512 / 8;
+    }
+    else if (getNumberField(asicInfo, "peer_response_time", peer_response_time))
+    {
+        peer_response_time *= 1024;
+    }
+    else
+    {
+        SWSS_LOG_INFO("Neither pause quanta nor peer response time is available for speed %s", speed.c_str());
+        return false;
+    }
+
+    pipeline_latency *= 1024;
+    mac_phy_delay *= 1024;
+
+    double ratio = 0;
+    parseNumber(over_subscribe_ratio, ratio);
+    bool shp_enabled = (getSharedHeadroomPoolSize() != 0 || ratio != 0);
+
+    // Adjustment for 8-lane port
+    double speed_overhead = 0;
+    if (lane_count == 8)
+    {
+        pipeline_latency = pipeline_latency * 2 - 1024;
+        speed_overhead = port_mtu;
+    }
+
+    double worst_case_factor;
+    if (cell_size > 2 * minimal_packet_size)
+        worst_case_factor = cell_size / minimal_packet_size;
+    else
+        worst_case_factor = (2 * cell_size) / (1 + cell_size);
+
+    double cell_occupancy = (100 - small_packet_percentage + small_packet_percentage * worst_case_factor) / 100;
+    double bytes_on_gearbox = (gearbox == 0) ? 0 : port_speed * gearbox / (8 * 1024);
+    double bytes_on_cable = 2 * cable * port_speed * 1000000000 / speed_of_light / (8 * 1024);
+    double propagation_delay = port_mtu + bytes_on_cable + 2 * bytes_on_gearbox + mac_phy_delay + peer_response_time;
+
+    // Calculate the xoff and xon and then round up at 1024 bytes
+    double xoff = ceil((lossless_mtu + propagation_delay * cell_occupancy) / 1024) * 1024;
+    double xon = ceil(pipeline_latency / 1024) * 1024;
+    double size = shp_enabled ? xon : xoff + xon + speed_overhead;
+    size = ceil(size / 1024) * 1024;
+
+    result.push_back("xon:" + formatNumber(xon));
+    result.push_back("xoff:" + formatNumber(xoff));
+    result.push_back("size:" + formatNumber(size));
+
+    return true;
+}
+
+bool VsBufferCalculator::calculatePoolSizes(const string &mmu_size_str, const string &over_subscribe_ratio,
+                                            vector<string> &result)
+{
+    const double private_headroom = 10 * 1024;
+    const double mgmt_pool_size = 256 * 1024;
+    const double egress_mirror_headroom = 10 * 1024;
+
+    auto &pools = m_accounting.getPools();
+    auto &profiles = m_accounting.getProfiles();
+    auto &ports = m_accounting.getPorts();
+
+    vector<FieldValueTuple> asicInfo;
+    double cell_size, pipeline_latency;
+    if (!fetchSingleEntry(m_stateAsicTable, m_asicKey, asicInfo)
+        || !getNumberField(asicInfo, "cell_size", cell_size)
+        || !getNumberField(asicInfo, "pipeline_latency", pipeline_latency))
+    {
+        SWSS_LOG_INFO("ASIC table is not available for calculating buffer pool size");
+        return false;
+    }
+
+    double mmu_size;
+    if (!parseNumber(mmu_size_str, mmu_size))
+    {
+        auto egressPool = pools.find(EGRESS_LOSSLESS_POOL_NAME);
+        if (egressPool == pools.end() || !parseNumber(egressPool->second.size, mmu_size))
+        {
+            SWSS_LOG_INFO("Neither mmu size nor size of %s is available for calculating buffer pool size", EGRESS_LOSSLESS_POOL_NAME);
+            return false;
+        }
+    }
+
+    double ratio = 0;
+    parseNumber(over_subscribe_ratio, ratio);
+    double shp_size = getSharedHeadroomPoolSize();
+    bool shp_enabled = (ratio != 0 || shp_size != 0);
+
+    double lossypg_reserved = pipeline_latency * 1024;
+    double lossypg_reserved_8lanes = (2 * pipeline_latency - 1) * 1024;
+
+    // Align mmu_size at cell size boundary, otherwise the sdk will complain and the syncd will fail
+    double ceiling_mmu_size = floor(mmu_size / cell_size) * cell_size;
+
+    // Ingress profiles are lossless if they have xoff, lossy otherwise.
+    // For lossy profiles, there is buffer implicitly reserved when they are applied on PGs
+    map<string, bool> ingressProfileIsLossless;
+    for (auto &profileRef : profiles)
+    {
+        auto poolRef = pools.find(profileRef.second.pool);
+        if (poolRef != pools.end() && poolRef->second.type == "ingress")
+            ingressProfileIsLossless[profileRef.first] = !profileRef.second.xoff.empty();
+    }
+
+    map<string, long> references;
+    for (auto &reference : m_accounting.getObjectReferences())
+    {
+        if (profiles.find(reference.first) == profiles.end())
+        {
+            SWSS_LOG_INFO("Profile %s referenced by buffer items is not available", reference.first.c_str());
+            return false;
+        }
+        references[reference.first] += reference.second;
+    }
+
+    for (auto &reference : m_accounting.getListReferences())
+    {
+        // An ingress lossy profile in a profile list doesn't occupy buffer
+        auto lossless = ingressProfileIsLossless.find(reference.first);
+        if (lossless != ingressProfileIsLossless.end() && !lossless->second)
+            continue;
+
+        if (profiles.find(reference.first) == profiles.end())
+        {
+            SWSS_LOG_INFO("Profile %s referenced by profile lists is not available", reference.first.c_str());
+            return false;
+        }
+        references[reference.first] += reference.second;
+    }
+
+    long port_count_8lanes = 0, admin_up_port = 0, admin_up_8lanes_port = 0;
+    for (auto &portRef : ports)
+    {
+        bool is8lanes = (portRef.second.lane_count == 8);
+        if (is8lanes)
+            port_count_8lanes++;
+        if (portRef.second.admin_up)
+        {
+            admin_up_port++;
+            if (is8lanes)
+                admin_up_8lanes_port++;
+        }
+    }
+
+    // Number of lossy PGs on ports with 8 lanes and number of ports with lossless PGs
+    long lossypg_8lanes = 0, lossless_port_count = 0;
+    for (auto &portRef : m_accounting.getPortPgReferences())
+    {
+        auto port = ports.find(portRef.first);
+        bool is8lanes = (port != ports.end() && port->second.lane_count == 8);
+        bool hasLossless = false;
+
+        for (auto &reference : portRef.second)
+        {
+            auto lossless = ingressProfileIsLossless.find(reference.first);
+            if (lossless == ingressProfileIsLossless.end())
+                continue;
+            if (lossless->second)
+                hasLossless = true;
+            else if (is8lanes)
+                lossypg_8lanes += reference.second;
+        }
+
+        if (hasLossless)
+            lossless_port_count++;
+    }
+
+    // Accumulate sizes of all of the profiles
+    double accumulative_occupied_buffer = 0;
+    double accumulative_xoff = 0;
+    for (auto &reference : references)
+    {
+        auto &profile = profiles.at(reference.first);
+        double size;
+        if (!parseNumber(profile.size, size))
+            continue;
+
+        auto lossless = ingressProfileIsLossless.find(reference.first);
+        if (lossless != ingressProfileIsLossless.end() && !lossless->second)
+            size += lossypg_reserved;
+
+        if (size != 0)
+        {
+            double xon, xoff;
+            if (shp_enabled && shp_size == 0 && parseNumber(profile.xon, xon) && parseNumber(profile.xoff, xoff) && xon + xoff > size)
+            {
+                accumulative_xoff += (xon + xoff - size) * static_cast<double>(reference.second);
+            }
+            accumulative_occupied_buffer += size * static_cast<double>(reference.second);
+        }
+    }
+
+    // Extra lossy xon buffer for ports with 8 lanes
+    accumulative_occupied_buffer += (lossypg_reserved_8lanes - lossypg_reserved) * static_cast<double>(lossypg_8lanes);
+
+    // Accumulate sizes for private headrooms
+    double accumulative_private_headroom = 0;
+    if (shp_enabled)
+    {
+        accumulative_private_headroom = static_cast<double>(lossless_port_count) * private_headroom;
+        accumulative_occupied_buffer += accumulative_private_headroom;
+        accumulative_xoff -= accumulative_private_headroom;
+        if (accumulative_xoff < 0)
+            accumulative_xoff = 0;
+    }
+
+    // Accumulate sizes for management PGs, egress mirror and management pool
+    double accumulative_management_pg = static_cast<double>(admin_up_port - admin_up_8lanes_port) * lossypg_reserved
+                                        + static_cast<double>(admin_up_8lanes_port) * lossypg_reserved_8lanes;
+    double accumulative_egress_mirror_overhead = static_cast<double>(admin_up_port) * egress_mirror_headroom;
+    accumulative_occupied_buffer += accumulative_management_pg + accumulative_egress_mirror_overhead + mgmt_pool_size;
+
+    // Fetch all the pools that need update
+    vector<string> pools_need_update;
+    long ingress_pool_count = 0;
+    double ingress_lossless_pool_size = 0;
+    bool has_ingress_lossless_pool_size = false;
+    for (auto &poolRef : pools)
+    {
+        if (poolRef.second.type != "ingress" && poolRef.second.type != "egress")
+            continue;
+
+        if (poolRef.second.size.empty())
+        {
+            pools_need_update.push_back(poolRef.first);
+            if (poolRef.second.type == "ingress")
+                ingress_pool_count++;
+        }
+        else if (poolRef.first == INGRESS_LOSSLESS_POOL_NAME && shp_enabled && shp_size == 0)
+        {
+            has_ingress_lossless_pool_size = parseNumber(poolRef.second.size, ingress_lossless_pool_size);
+        }
+    }
+
+    if (shp_enabled && shp_size == 0)
+        shp_size = ceil(accumulative_xoff / ratio);
+
+    accumulative_occupied_buffer += shp_size;
+
+    double pool_size;
+    if (ingress_pool_count == 1)
+        pool_size = mmu_size - accumulative_occupied_buffer;
+    else
+        pool_size = (mmu_size - accumulative_occupied_buffer) / 2;
+
+    if (pool_size > ceiling_mmu_size)
+        pool_size = ceiling_mmu_size;
+
+    bool shp_deployed = false;
+    for (auto &pool : pools_need_update)
+    {
+        if (shp_size != 0 && pool == INGRESS_LOSSLESS_POOL_NAME)
+        {
+            result.push_back(pool + ":" + formatNumber(ceil(pool_size)) + ":" + formatNumber(ceil(shp_size)));
+            shp_deployed = true;
+        }
+        else
+        {
+            result.push_back(pool + ":" + formatNumber(ceil(pool_size)));
+        }
+    }
+
+    if (!shp_deployed && shp_size != 0 && has_ingress_lossless_pool_size)
+    {
+        result.push_back(string(INGRESS_LOSSLESS_POOL_NAME) + ":" + formatNumber(ceil(ingress_lossless_pool_size)) + ":" + formatNumber(ceil(shp_size)));
+    }
+
+    result.push_back("debug:mmu_size:" + formatNumber(mmu_size));
+    result.push_back("debug:accumulative size:" + formatNumber(accumulative_occupied_buffer));
+    result.push_back("debug:extra_8lanes:" + formatNumber(lossypg_reserved_8lanes - lossypg_reserved) + ":" + to_string(lossypg_8lanes) + ":" + to_string(port_count_8lanes));
+    if (shp_enabled)
+    {
+        result.push_back("debug:accumulative_private_headroom:" + formatNumber(accumulative_private_headroom));
+        result.push_back("debug:accumulative xoff:" + formatNumber(accumulative_xoff));
+    }
+    result.push_back("debug:accumulative_mgmt_pg:" + formatNumber(accumulative_management_pg));
+    result.push_back("debug:egress_mirror:" + formatNumber(accumulative_egress_mirror_overhead));
+    result.push_back("debug:shp_size:" + formatNumber(shp_size));
+
+    return true;
+}
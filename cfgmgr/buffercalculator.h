@@ -0,0 +1,145 @@
+#ifndef __BUFFERCALCULATOR__
+#define __BUFFERCALCULATOR__
+
+#include "dbconnector.h"
+#include "table.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace swss {
+
+/*
+ * BufferPoolAccounting
+ *
+ * Mirror of the buffer objects buffermgrd has programmed to APPL_DB and of the
+ * ports and pools it has received from CONFIG_DB, which are the inputs of the
+ * shared buffer pool calculation.
+ * It is updated by BufferMgrDynamic whenever it writes a buffer profile, PG,
+ * queue or profile list to APPL_DB, so the reference count of each profile is
+ * maintained incrementally instead of being recounted by scanning APPL_DB on
+ * every pool calculation.
+ */
+class BufferPoolAccounting
+{
+public:
+    typedef struct {
+        std::string pool;
+        std::string size;
+        std::string xon;
+        std::string xoff;
+    } profile_t;
+
+    typedef struct {
+        std::string type;
+        std::string size;
+        std::string xoff;
+    } pool_t;
+
+    typedef struct {
+        long lane_count;
+        bool admin_up;
+    } port_t;
+
+    void setPool(const std::string &name, const std::vector<FieldValueTuple> &fvs);
+    void removePool(const std::string &name);
+    void setProfile(const std::string &name, const std::vector<FieldValueTuple> &fvs);
+    void removeProfile(const std::string &name);
+    void setPort(const std::string &port, long lane_count, bool admin_up);
+    void removePort(const std::string &port);
+
+    // Objects are BUFFER_PG (ingress) and BUFFER_QUEUE (egress) items in APPL_DB format, like Ethernet0:3-4
+    void setObject(bool ingress, const std::string &key, const std::string &profile);
+    void removeObject(bool ingress, const std::string &key);
+    void setProfileList(bool ingress, const std::string &port, const std::string &profileList);
+    void removeProfileList(bool ingress, const std::string &port);
+
+    const std::map<std::string, pool_t> &getPools() const { return m_pools; }
+    const std::map<std::string, profile_t> &getProfiles() const { return m_profiles; }
+    const std::map<std::string, port_t> &getPorts() const { return m_ports; }
+    // Number of PGs and queues referencing each profile
+    const std::map<std::string, long> &getObjectReferences() const { return m_objectReferences; }
+    // Number of profile lists referencing each profile
+    const std::map<std::string, long> &getListReferences() const { return m_listReferences; }
+    // Number of PGs referencing each profile, per port
+    const std::map<std::string, std::map<std::string, long>> &getPortPgReferences() const { return m_portPgReferences; }
+
+private:
+    typedef struct {
+        std::string port;
+        std::string profile;
+        long count;
+    } object_t;
+
+    void addReference(std::map<std::string, long> &references, const std::string &profile, long count);
+
+    std::map<std::string, pool_t> m_pools;
+    std::map<std::string, profile_t> m_profiles;
+    std::map<std::string, port_t> m_ports;
+    std::map<std::string, object_t> m_objects[2];
+    std::map<std::string, std::vector<std::string>> m_profileLists[2];
+
+    std::map<std::string, long> m_objectReferences;
+    std::map<std::string, long> m_listReferences;
+    std::map<std::string, std::map<std::string, long>> m_portPgReferences;
+};
+
+/*
+ * BufferCalculator
+ *
+ * In-process implementation of the vendor specific buffer_headroom_<vendor>.lua
+ * and buffer_pool_<vendor>.lua plugins.
+ * The results are in the same format as that returned by the plugins, so they
+ * are consumed by the same logic. A calculator that fails returns false and
+ * the caller falls back to the plugin.
+ */
+class BufferCalculator
+{
+public:
+    virtual ~BufferCalculator() = default;
+
+    // Returns "xon:<xon>", "xoff:<xoff>", "size:<size>" and optionally "xon_offset:<xon_offset>"
+    virtual bool calculateHeadroom(const std::string &speed, const std::string &cable_length, const std::string &mtu,
+                                   const std::string &gearbox_delay, long lane_count, const std::string &over_subscribe_ratio,
+                                   std::vector<std::string> &result) = 0;
+    // Returns "<pool>:<size>" or "<pool>:<size>:<shared headroom pool size>" for each pool to update and "debug:<info>"
+    virtual bool calculatePoolSizes(const std::string &mmu_size, const std::string &over_subscribe_ratio,
+                                    std::vector<std::string> &result) = 0;
+
+    // Returns nullptr if there is no calculator for the platform, in which case the plugins are used
+    static std::unique_ptr<BufferCalculator> create(const std::string &platform, const BufferPoolAccounting &accounting,
+                                                    DBConnector *cfgDb, DBConnector *stateDb);
+};
+
+/*
+ * Calculator for the virtual switch, port of buffer_headroom_vs.lua and buffer_pool_vs.lua
+ */
+class VsBufferCalculator : public BufferCalculator
+{
+public:
+    VsBufferCalculator(const BufferPoolAccounting &accounting, DBConnector *cfgDb, DBConnector *stateDb);
+
+    bool calculateHeadroom(const std::string &speed, const std::string &cable_length, const std::string &mtu,
+                           const std::string &gearbox_delay, long lane_count, const std::string &over_subscribe_ratio,
+                           std::vector<std::string> &result) override;
+    bool calculatePoolSizes(const std::string &mmu_size, const std::string &over_subscribe_ratio,
+                            std::vector<std::string> &result) override;
+
+private:
+    bool fetchSingleEntry(Table &table, std::string &key, std::vector<FieldValueTuple> &fvs);
+    double getSharedHeadroomPoolSize() const;
+
+    const BufferPoolAccounting &m_accounting;
+
+    Table m_stateAsicTable;
+    Table m_cfgLosslessTrafficPatternTable;
+    // Each table has only one key, which is looked up once
+    std::string m_asicKey;
+    std::string m_losslessTrafficPatternKey;
+};
+
+}
+
+#endif /* __BUFFERCALCULATOR__ */
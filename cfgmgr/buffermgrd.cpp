@@ -43,13 +43,15 @@ mutex gDbMutex;
 
 void usage()
 {
-    cout << "Usage: buffermgrd <-l pg_lookup.ini|-a asic_table.json [-p peripheral_table.json] [-z zero_profiles.json]>" << endl;
+    cout << "Usage: buffermgrd <-l pg_lookup.ini|-a asic_table.json [-p peripheral_table.json] [-z zero_profiles.json] [-d msec]>" << endl;
     cout << "       -l pg_lookup.ini: PG profile look up table file (mandatory for static mode)" << endl;
     cout << "           format: csv" << endl;
     cout << "           values: 'speed, cable, size, xon,  xoff, dynamic_threshold, xon_offset'" << endl;
     cout << "       -a asic_table.json: ASIC-specific parameters definition (mandatory for dynamic mode)" << endl;
     cout << "       -p peripheral_table.json: Peripheral (eg. gearbox) parameters definition (optional for dynamic mode)" << endl;
     cout << "       -z zero_profiles.json: Zero profiles definition for reclaiming unused buffers (optional for dynamic mode)" << endl;
+    cout << "       -d msec: Debounce interval of shared buffer pool recalculation (optional for dynamic mode)" << endl;
+    cout << "           default: 0, recalculate once all pending updates of a table have been handled" << endl;
 }
 
 void dump_db_item(KeyOpFieldsValuesTuple &db_item)
@@ -116,12 +118,13 @@ int main(int argc, char **argv)
     string asic_table_file = "";
     string peripherial_table_file = "";
     string zero_profile_file = "";
+    unsigned int pool_check_debounce_msec = 0;
     Logger::linkToDbNative("buffermgrd");
     SWSS_LOG_ENTER();
 
     SWSS_LOG_NOTICE("--- Starting buffermgrd ---");
 
-    while ((opt = getopt(argc, argv, "l:a:p:z:h")) != -1 )
+    while ((opt = getopt(argc, argv, "l:a:p:z:d:h")) != -1 )
     {
         switch (opt)
         {
@@ -140,6 +143,20 @@ int main(int argc, char **argv)
         case 'z':
             zero_profile_file = optarg;
             break;
+        case 'd':
+            {
+                auto debounce = atoi(optarg);
+                if (debounce >= 0)
+                {
+                    pool_check_debounce_msec = static_cast<unsigned int>(debounce);
+                    SWSS_LOG_NOTICE("Setting buffer pool recalculation debounce interval as %u ms", pool_check_debounce_msec);
+                }
+                else
+                {
+                    SWSS_LOG_ERROR("Invalid input for buffer pool recalculation debounce interval: %d. Ignoring.", debounce);
+                }
+            }
+            break;
         default: /* '?' */
             usage();
             return EXIT_FAILURE;
@@ -202,7 +219,7 @@ int main(int argc, char **argv)
                 TableConnector(&stateDb, STATE_BUFFER_MAXIMUM_VALUE_TABLE),
                 TableConnector(&stateDb, STATE_PORT_TABLE_NAME)
             };
-            cfgOrchList.emplace_back(new BufferMgrDynamic(&cfgDb, &stateDb, &applDb, buffer_table_connectors, peripherial_table_ptr, zero_profiles_ptr));
+            cfgOrchList.emplace_back(new BufferMgrDynamic(&cfgDb, &stateDb, &applDb, buffer_table_connectors, peripherial_table_ptr, zero_profiles_ptr, pool_check_debounce_msec));
         }
         else if (!pg_lookup_file.empty())
         {
@@ -26,7 +26,7 @@
 using namespace std;
 using namespace swss;
 
-BufferMgrDynamic::BufferMgrDynamic(DBConnector *cfgDb, DBConnector *stateDb, DBConnector *applDb, const vector<TableConnector> &tables, shared_ptr<vector<KeyOpFieldsValuesTuple>> gearboxInfo, shared_ptr<vector<KeyOpFieldsValuesTuple>> zeroProfilesInfo) :
+BufferMgrDynamic::BufferMgrDynamic(DBConnector *cfgDb, DBConnector *stateDb, DBConnector *applDb, const vector<TableConnector> &tables, shared_ptr<vector<KeyOpFieldsValuesTuple>> gearboxInfo, shared_ptr<vector<KeyOpFieldsValuesTuple>> zeroProfilesInfo, unsigned int poolCheckDebounceMsec) :
         Orch(tables),
         m_platform(),
         m_bufferDirections{BUFFER_INGRESS, BUFFER_EGRESS},
@@ -98,6 +98,12 @@ BufferMgrDynamic::BufferMgrDynamic(DBConnector *cfgDb, DBConnector *stateDb, DBC
         }
     }
 
+    m_bufferCalculator = BufferCalculator::create(platform, m_bufferAccounting, cfgDb, stateDb);
+    if (m_bufferCalculator)
+    {
+        SWSS_LOG_NOTICE("Buffer headroom and pool sizes are calculated in process for platform %s", platform.c_str());
+    }
+
     try
     {
         string headroomLuaScript = swss::loadLuaScript(headroomPluginName);
@@ -111,7 +117,11 @@ BufferMgrDynamic::BufferMgrDynamic(DBConnector *cfgDb, DBConnector *stateDb, DBC
     }
     catch (...)
     {
-        if (platform != "mock_test")
+        if (m_bufferCalculator)
+        {
+            SWSS_LOG_WARN("Lua scripts for buffer calculation were not loaded successfully, no fallback for the in-process calculator");
+        }
+        else if (platform != "mock_test")
         {
             SWSS_LOG_ERROR("Lua scripts for buffer calculation were not loaded successfully, buffermgrd won't start");
             return;
@@ -125,6 +135,14 @@ BufferMgrDynamic::BufferMgrDynamic(DBConnector *cfgDb, DBConnector *stateDb, DBC
     Orch::addExecutor(executor);
     m_buffermgrPeriodtimer->start();
 
+    if (poolCheckDebounceMsec)
+    {
+        auto debounce = timespec { .tv_sec = poolCheckDebounceMsec / 1000, .tv_nsec = (poolCheckDebounceMsec % 1000) * 1000000 };
+        m_bufferPoolCheckTimer = new SelectableTimer(debounce);
+        Orch::addExecutor(new ExecutableTimer(m_bufferPoolCheckTimer, this, "BUFFER_POOL_CHECK_TIMER"));
+        SWSS_LOG_NOTICE("Shared buffer pool recalculation is debounced by %u ms", poolCheckDebounceMsec);
+    }
+
     // Try fetch mmu size from STATE_DB
     // - warm-reboot, the mmuSize should be in the STATE_DB,
     //   which is done by not removing it from STATE_DB before warm reboot
@@ -354,6 +372,7 @@ void BufferMgrDynamic::loadZeroPoolAndProfiles()
             }
             m_applBufferProfileTable.set(key, fvs);
             m_stateBufferProfileTable.set(key, fvs);
+            m_bufferAccounting.setProfile(key, fvs);
             SWSS_LOG_NOTICE("Loaded zero buffer profile %s", key.c_str());
         }
         else
@@ -414,6 +433,7 @@ void BufferMgrDynamic::unloadZeroPoolAndProfiles()
         }
         m_applBufferProfileTable.del(zeroProfileName);
         m_stateBufferProfileTable.del(zeroProfileName);
+        m_bufferAccounting.removeProfile(zeroProfileName);
         SWSS_LOG_NOTICE("Unloaded zero buffer profile %s", zeroProfileName.c_str());
     }
 
@@ -597,7 +617,8 @@ bool BufferMgrDynamic::needRefreshPortDueToEffectiveSpeed(port_info_t &portInfo,
 // Meta flows which are called by main flows
 void BufferMgrDynamic::calculateHeadroomSize(buffer_profile_t &headroom)
 {
-    // Call vendor-specific lua plugin to calculate the xon, xoff, xon_offset, size and threshold
+    // Call the in-process calculator or, if it is not available or fails, the vendor-specific lua plugin
+    // to calculate the xon, xoff, xon_offset, size and threshold
     vector<string> keys = {};
     vector<string> argv = {};
 
@@ -610,7 +631,14 @@ void BufferMgrDynamic::calculateHeadroomSize(buffer_profile_t &headroom)
 
     try
     {
-        auto ret = swss::runRedisScript(*m_applDb, m_headroomSha, keys, argv);
+        vector<string> ret;
+
+        if (!m_bufferCalculator
+            || !m_bufferCalculator->calculateHeadroom(headroom.speed, headroom.cable_length, headroom.port_mtu,
+                                                      m_identifyGearboxDelay, headroom.lane_count, m_overSubscribeRatio, ret))
+        {
+            ret = swss::runRedisScript(*m_applDb, m_headroomSha, keys, argv);
+        }
 
         if (ret.empty())
         {
@@ -647,7 +675,7 @@ void BufferMgrDynamic::calculateHeadroomSize(buffer_profile_t &headroom)
 // This function is designed to fetch the sizes of shared buffer pool and shared headroom pool
 // and programe them to APPL_DB if they differ from the current value.
 // The function is called periodically:
-// 1. Fetch the sizes by calling lug plugin
+// 1. Fetch the sizes from the in-process calculator, or by calling lug plugin if it is not available or fails
 //    - For each of the pools, it checks the size of shared buffer pool.
 //    - For ingress_lossless_pool, it checks the size of the shared headroom pool (field xoff of the pool) as well.
 // 2. Compare the fetched value and the previous value
@@ -687,7 +715,12 @@ void BufferMgrDynamic::recalculateSharedBufferPool()
             }
         }
 
-        auto ret = runRedisScript(*m_applDb, m_bufferpoolSha, keys, argv);
+        vector<string> ret;
+
+        if (!m_bufferCalculator || !m_bufferCalculator->calculatePoolSizes(m_mmuSize, m_overSubscribeRatio, ret))
+        {
+            ret = runRedisScript(*m_applDb, m_bufferpoolSha, keys, argv);
+        }
 
         // The format of the result:
         // a list of lines containing key, value pairs with colon as separator
@@ -855,6 +888,37 @@ void BufferMgrDynamic::checkSharedBufferPoolSize(bool force_update_during_initia
         recalculateSharedBufferPool();
 }
 
+// The pool sizes depend on all the buffer items, so handlers updating them only request the pool sizes to be checked.
+// Requests are coalesced into one check when the consumer has been drained, or when the debounce timer fires.
+// Buffer profiles and objects are pending until the pools are ready, so pool sizes are checked immediately before that.
+void BufferMgrDynamic::scheduleSharedBufferPoolCheck()
+{
+    if (!m_bufferPoolReady)
+    {
+        checkSharedBufferPoolSize();
+        return;
+    }
+
+    if (m_bufferPoolCheckPending)
+        return;
+
+    m_bufferPoolCheckPending = true;
+    if (m_bufferPoolCheckTimer)
+        m_bufferPoolCheckTimer->start();
+}
+
+void BufferMgrDynamic::flushSharedBufferPoolCheck()
+{
+    if (!m_bufferPoolCheckPending)
+        return;
+
+    m_bufferPoolCheckPending = false;
+    if (m_bufferPoolCheckTimer)
+        m_bufferPoolCheckTimer->stop();
+
+    checkSharedBufferPoolSize();
+}
+
 // For buffer pool, only size can be updated on-the-fly
 void BufferMgrDynamic::updateBufferPoolToDb(const string &name, const buffer_pool_t &pool)
 {
@@ -901,6 +965,7 @@ void BufferMgrDynamic::updateBufferProfileToDb(const string &name, const buffer_
 
     m_applBufferProfileTable.set(name, fvVector);
     m_stateBufferProfileTable.set(name, fvVector);
+    m_bufferAccounting.setProfile(name, fvVector);
 }
 
 // Database operation
@@ -923,10 +988,12 @@ void BufferMgrDynamic::updateBufferObjectToDb(const string &key, const string &p
         fvVector.emplace_back(buffer_profile_field_name, profile);
 
         table.set(key, fvVector);
+        m_bufferAccounting.setObject(dir == BUFFER_INGRESS, key, profile);
     }
     else
     {
         table.del(key);
+        m_bufferAccounting.removeObject(dir == BUFFER_INGRESS, key);
     }
 }
 
@@ -947,6 +1014,7 @@ void BufferMgrDynamic::updateBufferObjectListToDb(const string &key, const strin
     fvVector.emplace_back(buffer_profile_list_field_name, profileList);
 
     table.set(key, fvVector);
+    m_bufferAccounting.setProfileList(dir == BUFFER_INGRESS, key, profileList);
 }
 
 // We have to check the headroom ahead of applying them
@@ -1039,6 +1107,8 @@ void BufferMgrDynamic::releaseProfile(const string &profile_name)
 
     m_stateBufferProfileTable.del(profile_name);
 
+    m_bufferAccounting.removeProfile(profile_name);
+
     m_bufferProfileLookup.erase(profile_name);
 
     SWSS_LOG_NOTICE("BUFFER_PROFILE %s has been released successfully", profile_name.c_str());
@@ -1197,6 +1267,7 @@ void BufferMgrDynamic::removeSupportedButNotConfiguredItemsOnPort(port_info_t &p
             for (auto &it: portInfo.supported_but_not_configured_buffer_objects[dir])
             {
                 m_applBufferObjectTables[dir].del(portPrefix + it);
+                m_bufferAccounting.removeObject(dir == BUFFER_INGRESS, portPrefix + it);
             }
             portInfo.supported_but_not_configured_buffer_objects[dir].clear();
         }
@@ -1232,6 +1303,7 @@ void BufferMgrDynamic::applyNormalBufferObjectsOnPort(const string &port)
         {
             fvVector.emplace_back(buffer_profile_list_field_name, profileList);
             m_applBufferProfileListTables[dir].set(port, fvVector);
+            m_bufferAccounting.setProfileList(dir == BUFFER_INGRESS, port, profileList);
             fvVector.clear();
         }
     }
@@ -1397,6 +1469,7 @@ template<class T> task_process_status BufferMgrDynamic::reclaimReservedBufferFor
         const string &zeroIngressProfileNameList = constructZeroProfileListFromNormalProfileList(profileList, port);
         fvVector.emplace_back(buffer_profile_list_field_name, zeroIngressProfileNameList);
         m_applBufferProfileListTables[dir].set(port, fvVector);
+        m_bufferAccounting.setProfileList(dir == BUFFER_INGRESS, port, zeroIngressProfileNameList);
     }
 
     return task_process_status::task_success;
@@ -1531,7 +1604,7 @@ task_process_status BufferMgrDynamic::refreshPgsForPort(const string &port, cons
 
     if (isHeadroomUpdated)
     {
-        checkSharedBufferPoolSize();
+        scheduleSharedBufferPoolCheck();
     }
     else
     {
@@ -1649,7 +1722,7 @@ void BufferMgrDynamic::refreshSharedHeadroomPool(bool enable_state_updated_by_ra
 
     if (m_portInitDone)
     {
-        checkSharedBufferPoolSize();
+        scheduleSharedBufferPoolCheck();
     }
 }
 
@@ -1719,7 +1792,7 @@ task_process_status BufferMgrDynamic::doRemovePgTask(const string &pg_key, const
     SWSS_LOG_NOTICE("Remove BUFFER_PG %s (profile %s, %s)", pg_key.c_str(), bufferPg.running_profile_name.c_str(), bufferPg.configured_profile_name.c_str());
 
     // Recalculate pool size
-    checkSharedBufferPoolSize();
+    scheduleSharedBufferPoolCheck();
 
     if (portInfo.state != PORT_ADMIN_DOWN)
     {
@@ -1772,7 +1845,7 @@ task_process_status BufferMgrDynamic::doUpdateBufferProfileForDynamicTh(buffer_p
         }
     }
 
-    checkSharedBufferPoolSize();
+    scheduleSharedBufferPoolCheck();
 
     return task_process_status::task_success;
 }
@@ -1808,7 +1881,7 @@ task_process_status BufferMgrDynamic::doUpdateBufferProfileForSize(buffer_profil
     }
 
     if (update_pool_size)
-        checkSharedBufferPoolSize();
+        scheduleSharedBufferPoolCheck();
 
     return task_process_status::task_success;
 }
@@ -2193,6 +2266,8 @@ task_process_status BufferMgrDynamic::handlePortTable(KeyOpFieldsValuesTuple &tu
             }
         }
 
+        m_bufferAccounting.setPort(port, portInfo.lane_count, admin_up);
+
         if (need_check_speed && needRefreshPortDueToEffectiveSpeed(portInfo, port))
         {
             effective_speed_updated = true;
@@ -2302,7 +2377,7 @@ task_process_status BufferMgrDynamic::handlePortTable(KeyOpFieldsValuesTuple &tu
                 {
                     reclaimReservedBufferForPort(port, m_portPgLookup, BUFFER_PG);
                     reclaimReservedBufferForPort(port, m_portQueueLookup, BUFFER_QUEUE);
-                    checkSharedBufferPoolSize();
+                    scheduleSharedBufferPoolCheck();
                 }
                 else
                 {
@@ -2348,6 +2423,7 @@ task_process_status BufferMgrDynamic::handlePortTable(KeyOpFieldsValuesTuple &tu
         m_portProfileListLookups[BUFFER_INGRESS].erase(port);
         m_portProfileListLookups[BUFFER_EGRESS].erase(port);
         m_portInfoLookup.erase(port);
+        m_bufferAccounting.removePort(port);
         SWSS_LOG_NOTICE("Port %s is removed", port.c_str());
     }
 
@@ -2400,6 +2476,8 @@ task_process_status BufferMgrDynamic::handleBufferPoolTable(KeyOpFieldsValuesTup
             SWSS_LOG_INFO("Inserting BUFFER_POOL table field %s value %s", field.c_str(), value.c_str());
         }
 
+        m_bufferAccounting.setPool(pool, kfvFieldsValues(tuple));
+
         bool dontUpdatePoolToDb = bufferPool.dynamic_size;
         if (pool == INGRESS_LOSSLESS_PG_POOL_NAME)
         {
@@ -2447,6 +2525,7 @@ task_process_status BufferMgrDynamic::handleBufferPoolTable(KeyOpFieldsValuesTup
         m_applBufferPoolTable.del(pool);
         m_stateBufferPoolTable.del(pool);
         m_bufferPoolLookup.erase(pool);
+        m_bufferAccounting.removePool(pool);
         if (pool == INGRESS_LOSSLESS_PG_POOL_NAME)
         {
             m_configuredSharedHeadroomPoolSize.clear();
@@ -2674,6 +2753,7 @@ task_process_status BufferMgrDynamic::handleBufferProfileTable(KeyOpFieldsValues
             {
                 m_applBufferProfileTable.del(profileName);
                 m_stateBufferProfileTable.del(profileName);
+                m_bufferAccounting.removeProfile(profileName);
             }
 
             m_bufferProfileLookup.erase(profileName);
@@ -2743,6 +2823,7 @@ void BufferMgrDynamic::handleSetSingleBufferObjectOnAdminDownPort(buffer_directi
                     SWSS_LOG_INFO("Buffer %s %s overlapped with existing zero item %s, remove the latter first",
                                   objectName.c_str(), key.c_str(), keyToRemove.c_str());
                     table.del(keyToRemove);
+                    m_bufferAccounting.removeObject(direction == BUFFER_INGRESS, keyToRemove);
                     overlappedUnconfiguredIdsMap = (idsBitmap ^ idsToAddBitmap);
                     overlappedUnconfiguredIdsStr = ids;
                     break;
@@ -2795,6 +2876,7 @@ void BufferMgrDynamic::handleSetSingleBufferObjectOnAdminDownPort(buffer_directi
             // In case the port is admin down during initialization, the PG will be removed from the port,
             // which effectively notifies bufferOrch to add the item to the m_ready_list
             table.del(key);
+            m_bufferAccounting.removeObject(direction == BUFFER_INGRESS, key);
         }
     }
     else
@@ -3053,6 +3135,7 @@ task_process_status BufferMgrDynamic::handleSingleBufferPgEntry(const string &ke
         {
             SWSS_LOG_NOTICE("Removing BUFFER_PG table entry %s from APPL_DB directly", key.c_str());
             m_applBufferObjectTables[BUFFER_PG].del(key);
+            m_bufferAccounting.removeObject(true, key);
         }
 
         m_portPgLookup[port].erase(key);
@@ -3171,6 +3254,7 @@ task_process_status BufferMgrDynamic::handleSingleBufferQueueEntry(const string
         else
         {
             m_applBufferObjectTables[BUFFER_QUEUE].del(key);
+            m_bufferAccounting.removeObject(false, key);
         }
     }
 
@@ -3229,6 +3313,7 @@ task_process_status BufferMgrDynamic::handleSingleBufferPortProfileListEntry(con
                 const string &zeroProfileNameList = constructZeroProfileListFromNormalProfileList(profileList, port);
                 fvVector.emplace_back(buffer_profile_list_field_name, zeroProfileNameList);
                 m_applBufferProfileListTables[dir].set(port, fvVector);
+                m_bufferAccounting.setProfileList(dir == BUFFER_INGRESS, port, zeroProfileNameList);
             }
         }
     }
@@ -3238,6 +3323,7 @@ task_process_status BufferMgrDynamic::handleSingleBufferPortProfileListEntry(con
         SWSS_LOG_INFO("Removing entry %s:%s from APPL_DB", tableName.c_str(), key.c_str());
         profileListLookup.erase(port);
         appTable.del(key);
+        m_bufferAccounting.removeProfileList(dir == BUFFER_INGRESS, key);
     }
 
     return task_process_status::task_success;
@@ -3401,6 +3487,11 @@ void BufferMgrDynamic::doTask(Consumer &consumer)
                 break;
         }
     }
+
+    if (!m_bufferPoolCheckTimer)
+    {
+        flushSharedBufferPoolCheck();
+    }
 }
 
 /*
@@ -3584,6 +3675,17 @@ void BufferMgrDynamic::cleanUpItemsForReclaimingBuffer(const string &port)
 
 void BufferMgrDynamic::doTask(SelectableTimer &timer)
 {
+    if (&timer == m_bufferPoolCheckTimer)
+    {
+        flushSharedBufferPoolCheck();
+        return;
+    }
+
+    // The periodic check covers any pending one
+    m_bufferPoolCheckPending = false;
+    if (m_bufferPoolCheckTimer)
+        m_bufferPoolCheckTimer->stop();
+
     checkSharedBufferPoolSize(true);
     if (!m_bufferCompletelyInitialized)
     {
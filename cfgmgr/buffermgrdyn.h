@@ -4,8 +4,10 @@
 #include "dbconnector.h"
 #include "producerstatetable.h"
 #include "orch.h"
+#include "buffercalculator.h"
 
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 
@@ -147,7 +149,7 @@ typedef std::map<std::string, std::string> gearbox_delay_t;
 class BufferMgrDynamic : public Orch
 {
 public:
-    BufferMgrDynamic(DBConnector *cfgDb, DBConnector *stateDb, DBConnector *applDb, const std::vector<TableConnector> &tables, std::shared_ptr<std::vector<KeyOpFieldsValuesTuple>> gearboxInfo, std::shared_ptr<std::vector<KeyOpFieldsValuesTuple>> zeroProfilesInfo);
+    BufferMgrDynamic(DBConnector *cfgDb, DBConnector *stateDb, DBConnector *applDb, const std::vector<TableConnector> &tables, std::shared_ptr<std::vector<KeyOpFieldsValuesTuple>> gearboxInfo, std::shared_ptr<std::vector<KeyOpFieldsValuesTuple>> zeroProfilesInfo, unsigned int poolCheckDebounceMsec = 0);
     using Orch::doTask;
 
 private:
@@ -181,6 +183,11 @@ private:
     DBConnector *m_applDb = nullptr;
     SelectableTimer *m_buffermgrPeriodtimer = nullptr;
 
+    // Shared buffer pool recalculation requested by handlers, performed once the consumer is drained
+    // or, if a debounce interval is configured, when m_bufferPoolCheckTimer fires
+    bool m_bufferPoolCheckPending = false;
+    SelectableTimer *m_bufferPoolCheckTimer = nullptr;
+
     // Fields for zero pool and profiles
     std::vector<KeyOpFieldsValuesTuple> m_zeroPoolAndProfileInfo;
     std::set<std::string> m_zeroPoolNameSet;
@@ -255,6 +262,12 @@ private:
     std::string m_bufferpoolSha;
     std::string m_checkHeadroomSha;
 
+    // In-process calculator taking the place of the headroom and buffer pool plugins on platforms it supports
+    // m_bufferAccounting is the mirror of the buffer items in APPL_DB it calculates from,
+    // updated on every APPL_DB write regardless of whether the calculator is available
+    BufferPoolAccounting m_bufferAccounting;
+    std::unique_ptr<BufferCalculator> m_bufferCalculator;
+
     // Parameters for headroom generation
     std::string m_mmuSize;
     unsigned long m_mmuSizeNumber;
@@ -291,6 +304,8 @@ private:
     void calculateHeadroomSize(buffer_profile_t &headroom);
     void checkSharedBufferPoolSize(bool force_update_during_initialization);
     void recalculateSharedBufferPool();
+    void scheduleSharedBufferPoolCheck();
+    void flushSharedBufferPoolCheck();
     task_process_status allocateProfile(const std::string &speed, const std::string &cable, const std::string &mtu, const std::string &threshold, const std::string &gearbox_model, long lane_count, std::string &profile_name);
     void releaseProfile(const std::string &profile_name);
     bool isHeadroomResourceValid(const std::string &port, const buffer_profile_t &profile, const std::string &new_pg);
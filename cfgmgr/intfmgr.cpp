@@ -25,7 +25,7 @@ using namespace swss;
 #define VRF_PREFIX          "Vrf"
 #define VRF_MGMT            "mgmt"
 
-#define LOOPBACK_DEFAULT_MTU_STR "65536"
+#define LOOPBACK_DEFAULT_MTU    65536
 #define DEFAULT_MTU_STR 9100
 
 IntfMgr::IntfMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, const vector<string> &tableNames) :
@@ -79,21 +79,10 @@ IntfMgr::IntfMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, c
 void IntfMgr::setIntfIp(const string &alias, const string &opCmd,
                         const IpPrefix &ipPrefix)
 {
-    stringstream    cmd;
-    string          res;
-    string          ipPrefixStr = ipPrefix.to_string();
-    string          broadcastIpStr = ipPrefix.getBroadcastIp().to_string();
-    int             prefixLen = ipPrefix.getMaskLength();
+    uint32_t metric = 0;
 
-    if (ipPrefix.isV4())
+    if (!ipPrefix.isV4() && mySwitchType == "voq")
     {
-        (prefixLen < 31) ?
-        (cmd << IP_CMD << " address " << shellquote(opCmd) << " " << shellquote(ipPrefixStr) << " broadcast " << shellquote(broadcastIpStr) <<" dev " << shellquote(alias)) :
-        (cmd << IP_CMD << " address " << shellquote(opCmd) << " " << shellquote(ipPrefixStr) << " dev " << shellquote(alias));
-    }
-    else
-    {
-        string metric = "";
         // Kernel adds connected route with default metric of 256. But the metric is not
         // communicated to frr unless the ip address is added with explicit metric
         // In voq system, We need the static route to the remote neighbor and connected
@@ -101,69 +90,69 @@ void IntfMgr::setIntfIp(const string &alias, const string &opCmd,
         // via eBGP and iBGP over the internal inband port be part of same ecmp group.
         // For v4 both the metrics (connected and static) are default 0 so we do not need
         // to set the metric explicitly.
-        if(mySwitchType == "voq")
+        metric = 256;
+    }
+
+    auto queueIp = [&]() {
+        if (opCmd == "add")
         {
-           metric = " metric 256";
+            m_nl.addAddress(alias, ipPrefix, metric);
         }
+        else
+        {
+            m_nl.delAddress(alias, ipPrefix);
+        }
+    };
 
-        (prefixLen < 127) ?
-        (cmd << IP_CMD << " -6 address " << shellquote(opCmd) << " " << shellquote(ipPrefixStr) << " broadcast " << shellquote(broadcastIpStr) <<
-         " dev " << shellquote(alias) << metric) :
-        (cmd << IP_CMD << " -6 address " << shellquote(opCmd) << " " << shellquote(ipPrefixStr) << " dev " << shellquote(alias) << metric);
+    queueIp();
+    if (m_nl.commit())
+    {
+        return;
     }
 
-    int ret = swss::exec(cmd.str(), res);
-    if (ret)
+    if (!ipPrefix.isV4() && opCmd == "add")
     {
-        if (!ipPrefix.isV4() && opCmd == "add")
+        SWSS_LOG_NOTICE("Failed to assign IPv6 on interface %s, %s, trying to enable IPv6 and retry",
+                        alias.c_str(), m_nl.getLastError().c_str());
+        if (!enableIpv6Flag(alias))
         {
-            SWSS_LOG_NOTICE("Failed to assign IPv6 on interface %s with return code %d, trying to enable IPv6 and retry", alias.c_str(), ret);
-            if (!enableIpv6Flag(alias))
-            {
-                SWSS_LOG_ERROR("Failed to enable IPv6 on interface %s", alias.c_str());
-                return;
-            }
-            ret = swss::exec(cmd.str(), res);
+            SWSS_LOG_ERROR("Failed to enable IPv6 on interface %s", alias.c_str());
+            return;
         }
-
-        if (ret)
+        queueIp();
+        if (m_nl.commit())
         {
-            SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmd.str().c_str(), ret);
+            return;
         }
     }
+
+    SWSS_LOG_ERROR("Netlink request %s", m_nl.getLastError().c_str());
 }
 
 void IntfMgr::setIntfMac(const string &alias, const string &mac_str)
 {
-    stringstream cmd;
-    string res;
-
-    cmd << IP_CMD << " link set " << alias << " address " << mac_str;
+    try
+    {
+        m_nl.setMac(alias, MacAddress(mac_str));
+    }
+    catch (const std::invalid_argument &)
+    {
+        SWSS_LOG_ERROR("Invalid mac address %s for %s", mac_str.c_str(), alias.c_str());
+        return;
+    }
 
-    int ret = swss::exec(cmd.str(), res);
-    if (ret)
+    if (!m_nl.commit())
     {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmd.str().c_str(), ret);
+        SWSS_LOG_ERROR("Netlink request %s", m_nl.getLastError().c_str());
     }
 }
 
 void IntfMgr::setIntfVrf(const string &alias, const string &vrfName)
 {
-    stringstream cmd;
-    string res;
-
-    if (!vrfName.empty())
+    m_nl.setMaster(alias, vrfName);
+    if (!m_nl.commit())
     {
-        cmd << IP_CMD << " link set " << shellquote(alias) << " master " << shellquote(vrfName);
-    }
-    else
-    {
-        cmd << IP_CMD << " link set " << shellquote(alias) << " nomaster";
-    }
-    int ret = swss::exec(cmd.str(), res);
-    if (ret)
-    {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmd.str().c_str(), ret);
+        SWSS_LOG_ERROR("Netlink request %s", m_nl.getLastError().c_str());
     }
 }
 
@@ -196,28 +185,20 @@ bool IntfMgr::setIntfMpls(const string &alias, const string& mpls)
 
 void IntfMgr::addLoopbackIntf(const string &alias)
 {
-    stringstream cmd;
-    string res;
-
-    cmd << IP_CMD << " link add " << alias << " mtu " << LOOPBACK_DEFAULT_MTU_STR << " type dummy && ";
-    cmd << IP_CMD << " link set " << alias << " up";
-    int ret = swss::exec(cmd.str(), res);
-    if (ret)
+    m_nl.addDummy(alias, LOOPBACK_DEFAULT_MTU);
+    m_nl.setAdminState(alias, true);
+    if (!m_nl.commit())
     {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmd.str().c_str(), ret);
+        SWSS_LOG_ERROR("Netlink request %s", m_nl.getLastError().c_str());
     }
 }
 
 void IntfMgr::delLoopbackIntf(const string &alias)
 {
-    stringstream cmd;
-    string res;
-
-    cmd << IP_CMD << " link del " << alias;
-    int ret = swss::exec(cmd.str(), res);
-    if (ret)
+    m_nl.delLink(alias);
+    if (!m_nl.commit())
     {
-        SWSS_LOG_ERROR("Command '%s' failed with rc %d", cmd.str().c_str(), ret);
+        SWSS_LOG_ERROR("Netlink request %s", m_nl.getLastError().c_str());
     }
 }
 
@@ -332,11 +313,11 @@ bool IntfMgr::isIntfChangeVrf(const string &alias, const string &vrfName)
 
 void IntfMgr::addHostSubIntf(const string&intf, const string &subIntf, const string &vlan)
 {
-    stringstream cmd;
-    string res;
-
-    cmd << IP_CMD " link add link " << shellquote(intf) << " name " << shellquote(subIntf) << " type vlan id " << shellquote(vlan);
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    m_nl.addVlan(subIntf, intf, static_cast<uint16_t>(stoul(vlan)));
+    if (!m_nl.commit())
+    {
+        throw runtime_error(m_nl.getLastError());
+    }
 }
 
 
@@ -432,9 +413,6 @@ void IntfMgr::updateSubIntfMtu(const string &alias, const string &mtu)
 
 std::string IntfMgr::setHostSubIntfMtu(const string &alias, const string &mtu, const string &parent_mtu)
 {
-    stringstream cmd;
-    string res;
-
     string subifMtu = mtu;
     subIntf subIf(alias);
 
@@ -446,8 +424,11 @@ std::string IntfMgr::setHostSubIntfMtu(const string &alias, const string &mtu, c
         subifMtu = parent_mtu;
     }
     SWSS_LOG_INFO("subintf %s active mtu: %s", alias.c_str(), subifMtu.c_str());
-    cmd << IP_CMD " link set " << shellquote(alias) << " mtu " << shellquote(subifMtu);
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    m_nl.setMtu(alias, static_cast<uint32_t>(stoul(subifMtu)));
+    if (!m_nl.commit())
+    {
+        throw runtime_error(m_nl.getLastError());
+    }
 
     return subifMtu;
 }
@@ -479,14 +460,14 @@ void IntfMgr::updateSubIntfAdminStatus(const string &alias, const string &admin)
 
 std::string IntfMgr::setHostSubIntfAdminStatus(const string &alias, const string &admin_status, const string &parent_admin_status)
 {
-    stringstream cmd;
-    string res;
-
     if (parent_admin_status == "up" || admin_status == "down")
     {
         SWSS_LOG_INFO("subintf %s admin_status: %s", alias.c_str(), admin_status.c_str());
-        cmd << IP_CMD " link set " << shellquote(alias) << " " << shellquote(admin_status);
-        EXEC_WITH_ERROR_THROW(cmd.str(), res);
+        m_nl.setAdminState(alias, admin_status == "up");
+        if (!m_nl.commit())
+        {
+            throw runtime_error(m_nl.getLastError());
+        }
         return admin_status;
     }
     else
@@ -497,11 +478,11 @@ std::string IntfMgr::setHostSubIntfAdminStatus(const string &alias, const string
 
 void IntfMgr::removeHostSubIntf(const string &subIntf)
 {
-    stringstream cmd;
-    string res;
-
-    cmd << IP_CMD " link del " << shellquote(subIntf);
-    EXEC_WITH_ERROR_THROW(cmd.str(), res);
+    m_nl.delLink(subIntf);
+    if (!m_nl.commit())
+    {
+        throw runtime_error(m_nl.getLastError());
+    }
 }
 
 void IntfMgr::setSubIntfStateOk(const string &alias)
@@ -691,16 +672,15 @@ void IntfMgr::delIpv6LinkLocalNeigh(const string &alias)
                 IpAddress ipAddress(keys[1]);
                 if (ipAddress.getAddrScope() == IpAddress::AddrScope::LINK_SCOPE)
                 {
-                    stringstream cmd;
-                    string res;
-
-                    cmd << IP_CMD << " neigh del dev " << keys[0] << " " << keys[1] ;
-                    swss::exec(cmd.str(), res);
-                    SWSS_LOG_INFO("Deleted ipv6 link local neighbor - %s", keys[1].c_str());
+                    m_nl.delNeighbor(keys[0], ipAddress);
+                    SWSS_LOG_INFO("Deleting ipv6 link local neighbor - %s", keys[1].c_str());
                 }
             }
         }
     }
+
+    /* Neighbors already gone from the kernel are not an error */
+    m_nl.commit(false);
 }
 
 bool IntfMgr::doIntfGeneralTask(const vector<string>& keys,
@@ -1,4 +1,7 @@
 #include <string.h>
+#include <errno.h>
+#include <fstream>
+#include <algorithm>
 #include "logger.h"
 #include "producerstatetable.h"
 #include "macaddress.h"
@@ -15,7 +18,7 @@ using namespace swss;
 #define DOT1Q_BRIDGE_NAME   "Bridge"
 #define VLAN_PREFIX         "Vlan"
 #define LAG_PREFIX          "PortChannel"
-#define DEFAULT_VLAN_ID     "1"
+#define DEFAULT_VLAN_ID     1
 #define DEFAULT_MTU_STR     "9100"
 #define VLAN_HLEN            4
 
@@ -29,8 +32,9 @@ VlanMgr::VlanMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, c
         m_stateLagTable(stateDb, STATE_LAG_TABLE_NAME),
         m_stateVlanTable(stateDb, STATE_VLAN_TABLE_NAME),
         m_stateVlanMemberTable(stateDb, STATE_VLAN_MEMBER_TABLE_NAME),
+        m_appPipeline(appDb),
         m_appVlanTableProducer(appDb, APP_VLAN_TABLE_NAME),
-        m_appVlanMemberTableProducer(appDb, APP_VLAN_MEMBER_TABLE_NAME),
+        m_appVlanMemberTableProducer(&m_appPipeline, APP_VLAN_MEMBER_TABLE_NAME, true),
         replayDone(false)
 {
     SWSS_LOG_ENTER();
@@ -87,7 +91,7 @@ VlanMgr::VlanMgr(DBConnector *cfgDb, DBConnector *appDb, DBConnector *stateDb, c
       + IP_CMD + " link add " + DOT1Q_BRIDGE_NAME + " up type bridge && "
       + IP_CMD + " link set " + DOT1Q_BRIDGE_NAME + " mtu " + DEFAULT_MTU_STR + " && "
       + IP_CMD + " link set " + DOT1Q_BRIDGE_NAME + " address " + gMacAddress.to_string() + " && "
-      + BRIDGE_CMD + " vlan del vid " + DEFAULT_VLAN_ID + " dev " + DOT1Q_BRIDGE_NAME + " self; "
+      + BRIDGE_CMD + " vlan del vid " + std::to_string(DEFAULT_VLAN_ID) + " dev " + DOT1Q_BRIDGE_NAME + " self; "
       + IP_CMD + " link del dev dummy 2>/dev/null; "
       + IP_CMD + " link add dummy type dummy && "
       + IP_CMD + " link set dummy master " + DOT1Q_BRIDGE_NAME + "\"";
@@ -119,25 +123,24 @@ bool VlanMgr::addHostVlan(int vlan_id)
 {
     SWSS_LOG_ENTER();
 
-    // The command should be generated as:
-    // /bin/bash -c "/sbin/bridge vlan add vid {{vlan_id}} dev Bridge self &&
-    //               /sbin/ip link add link Bridge up name Vlan{{vlan_id}} address {{gMacAddress}} type vlan id {{vlan_id}}"
-    const std::string cmds = std::string("")
-      + BASH_CMD + " -c \""
-      + BRIDGE_CMD + " vlan add vid " + std::to_string(vlan_id) + " dev " + DOT1Q_BRIDGE_NAME + " self && "
-      + IP_CMD + " link add link " + DOT1Q_BRIDGE_NAME
-               + " up"
-               + " name " + VLAN_PREFIX + std::to_string(vlan_id)
-               + " address " + gMacAddress.to_string()
-               + " type vlan id " + std::to_string(vlan_id) + "\"";
-
-    std::string res;
-    EXEC_WITH_ERROR_THROW(cmds, res);
+    // Equivalent to:
+    // /sbin/bridge vlan add vid {{vlan_id}} dev Bridge self
+    // /sbin/ip link add link Bridge up name Vlan{{vlan_id}} address {{gMacAddress}} type vlan id {{vlan_id}}
+    m_nl.addBridgeVlan(DOT1Q_BRIDGE_NAME, static_cast<uint16_t>(vlan_id), false, true);
+    m_nl.addVlan(VLAN_PREFIX + std::to_string(vlan_id), DOT1Q_BRIDGE_NAME,
+                 static_cast<uint16_t>(vlan_id), gMacAddress, true);
+    if (!m_nl.commit())
+    {
+        throw runtime_error(m_nl.getLastError());
+    }
 
-    res.clear();
-    const std::string echo_cmd = std::string("")
-      + ECHO_CMD + " 0 > /proc/sys/net/ipv4/conf/" + VLAN_PREFIX + std::to_string(vlan_id) + "/arp_evict_nocarrier";
-    swss::exec(echo_cmd, res);
+    // The setting is absent on kernels without arp_evict_nocarrier, which is not an error
+    const string arpEvictPath = "/proc/sys/net/ipv4/conf/" VLAN_PREFIX + std::to_string(vlan_id) + "/arp_evict_nocarrier";
+    ofstream arpEvict(arpEvictPath);
+    if (!arpEvict.is_open() || !(arpEvict << "0" << flush))
+    {
+        SWSS_LOG_NOTICE("Failed to write %s, %s", arpEvictPath.c_str(), strerror(errno));
+    }
 
     return true;
 }
@@ -146,16 +149,15 @@ bool VlanMgr::removeHostVlan(int vlan_id)
 {
     SWSS_LOG_ENTER();
 
-    // The command should be generated as:
-    // /bin/bash -c "/sbin/ip link del Vlan{{vlan_id}} &&
-    //               /sbin/bridge vlan del vid {{vlan_id}} dev Bridge self"
-    const std::string cmds = std::string("")
-      + BASH_CMD + " -c \""
-      + IP_CMD + " link del " + VLAN_PREFIX + std::to_string(vlan_id) + " && "
-      + BRIDGE_CMD + " vlan del vid " + std::to_string(vlan_id) + " dev " + DOT1Q_BRIDGE_NAME + " self\"";
-
-    std::string res;
-    EXEC_WITH_ERROR_THROW(cmds, res);
+    // Equivalent to:
+    // /sbin/ip link del Vlan{{vlan_id}}
+    // /sbin/bridge vlan del vid {{vlan_id}} dev Bridge self
+    m_nl.delLink(VLAN_PREFIX + std::to_string(vlan_id));
+    m_nl.delBridgeVlan(DOT1Q_BRIDGE_NAME, static_cast<uint16_t>(vlan_id), true);
+    if (!m_nl.commit())
+    {
+        throw runtime_error(m_nl.getLastError());
+    }
 
     return true;
 }
@@ -164,13 +166,13 @@ bool VlanMgr::setHostVlanAdminState(int vlan_id, const string &admin_status)
 {
     SWSS_LOG_ENTER();
 
-    // The command should be generated as:
+    // Equivalent to:
     // /sbin/ip link set Vlan{{vlan_id}} {{admin_status}}
-    ostringstream cmds;
-    cmds << IP_CMD " link set " VLAN_PREFIX + std::to_string(vlan_id) + " " << shellquote(admin_status);
-
-    std::string res;
-    EXEC_WITH_ERROR_THROW(cmds.str(), res);
+    m_nl.setAdminState(VLAN_PREFIX + std::to_string(vlan_id), admin_status == "up");
+    if (!m_nl.commit())
+    {
+        throw runtime_error(m_nl.getLastError());
+    }
 
     return true;
 }
@@ -179,34 +181,28 @@ bool VlanMgr::setHostVlanMtu(int vlan_id, uint32_t mtu)
 {
     SWSS_LOG_ENTER();
 
-    // The command should be generated as:
+    // Equivalent to:
     // /sbin/ip link set Vlan{{vlan_id}} mtu {{mtu}}
-    const std::string cmds = std::string("")
-      + IP_CMD + " link set " + VLAN_PREFIX + std::to_string(vlan_id) + " mtu " + std::to_string(mtu);
-
-    std::string res;
-    int ret = swss::exec(cmds, res);
-    if (ret == 0)
-    {
-        return true;
-    }
+    m_nl.setMtu(VLAN_PREFIX + std::to_string(vlan_id), mtu);
 
     /* VLAN mtu should not be larger than member mtu */
-    return false;
+    return m_nl.commit();
 }
 
 bool VlanMgr::setHostVlanMac(int vlan_id, const string &mac)
 {
     SWSS_LOG_ENTER();
 
-    // The command should be generated as:
+    // Equivalent to:
     // /sbin/ip link set Vlan{{vlan_id}} address {{mac}}
-    ostringstream cmds;
-    cmds << IP_CMD " link set " VLAN_PREFIX + std::to_string(vlan_id) + " address " << shellquote(mac) << " && "
-            IP_CMD " link set " DOT1Q_BRIDGE_NAME " address " << shellquote(mac);
-
-    std::string res;
-    EXEC_WITH_ERROR_THROW(cmds.str(), res);
+    // /sbin/ip link set Bridge address {{mac}}
+    MacAddress macAddress(mac);
+    m_nl.setMac(VLAN_PREFIX + std::to_string(vlan_id), macAddress);
+    m_nl.setMac(DOT1Q_BRIDGE_NAME, macAddress);
+    if (!m_nl.commit())
+    {
+        throw runtime_error(m_nl.getLastError());
+    }
 
     return true;
 }
@@ -215,62 +211,192 @@ bool VlanMgr::addHostVlanMember(int vlan_id, const string &port_alias, const str
 {
     SWSS_LOG_ENTER();
 
-    std::string tagging_cmd;
-    if (tagging_mode == "untagged" || tagging_mode == "priority_tagged")
+    bool pvidUntagged = (tagging_mode == "untagged" || tagging_mode == "priority_tagged");
+
+    // Equivalent to:
+    // /sbin/ip link set {{port_alias}} master Bridge
+    // /sbin/bridge vlan del vid 1 dev {{ port_alias }}
+    // /sbin/bridge vlan add vid {{vlan_id}} dev {{port_alias}} {{tagging_mode}}
+    m_nl.setMaster(port_alias, DOT1Q_BRIDGE_NAME);
+    m_nl.delBridgeVlan(port_alias, DEFAULT_VLAN_ID);
+    m_nl.addBridgeVlan(port_alias, static_cast<uint16_t>(vlan_id), pvidUntagged);
+    if (!m_nl.commit())
     {
-        tagging_cmd = "pvid untagged";
+        throw runtime_error(m_nl.getLastError());
     }
 
-    // The command should be generated as:
-    // /bin/bash -c "/sbin/ip link set {{port_alias}} master Bridge &&
-    //               /sbin/bridge vlan del vid 1 dev {{ port_alias }} &&
-    //               /sbin/bridge vlan add vid {{vlan_id}} dev {{port_alias}} {{tagging_mode}}"
-    ostringstream cmds, inner;
-    inner << IP_CMD " link set " << shellquote(port_alias) << " master " DOT1Q_BRIDGE_NAME " && "
-      BRIDGE_CMD " vlan del vid " DEFAULT_VLAN_ID " dev " << shellquote(port_alias) << " && "
-      BRIDGE_CMD " vlan add vid " + std::to_string(vlan_id) + " dev " << shellquote(port_alias) << " " + tagging_cmd;
-    cmds << BASH_CMD " -c " << shellquote(inner.str());
+    return true;
+}
 
-    std::string res;
-    EXEC_WITH_ERROR_THROW(cmds.str(), res);
+bool VlanMgr::removeHostVlanMember(int vlan_id, const string &port_alias)
+{
+    SWSS_LOG_ENTER();
+
+    // Equivalent to:
+    // /sbin/bridge vlan del vid {{vlan_id}} dev {{port_alias}}
+    // /sbin/ip link set {{port_alias}} nomaster, when no VLAN is left on the port
+    m_nl.delBridgeVlan(port_alias, static_cast<uint16_t>(vlan_id));
+    if (!m_nl.commit())
+    {
+        throw runtime_error(m_nl.getLastError());
+    }
+
+    // When port is not member of any VLAN, it shall be detached from Dot1Q bridge!
+    set<uint16_t> vlans;
+    if (!m_nl.getBridgeVlans(port_alias, vlans))
+    {
+        throw runtime_error("Failed to get bridge vlans of " + port_alias);
+    }
+    if (vlans.empty())
+    {
+        m_nl.setMaster(port_alias, "");
+        if (!m_nl.commit())
+        {
+            throw runtime_error(m_nl.getLastError());
+        }
+    }
 
     return true;
 }
 
-bool VlanMgr::removeHostVlanMember(int vlan_id, const string &port_alias)
+bool VlanMgr::setHostVlanMembers(map<string, VlanMemberBatch> &ports)
 {
     SWSS_LOG_ENTER();
 
-    // The command should be generated as:
-    // /bin/bash -c '/sbin/bridge vlan del vid {{vlan_id}} dev {{port_alias}} &&
-    //               ( vlanShow=$(/sbin/bridge vlan show dev {{port_alias}});
-    //               ret=$?;
-    //               if [ $ret -eq 0 ]; then
-    //               if (! echo "$vlanShow" | grep -q {{port_alias}})
-    //                 || (echo "$vlanShow" | grep -q None$)
-    //                 || (echo "$vlanShow" | grep -q {{port_alias}}$); then
-    //               /sbin/ip link set {{port_alias}} nomaster;
-    //               fi;
-    //               else exit $ret; fi )'
+    /* Requests of a port in the batch, as [first, last) positions in queue order */
+    typedef pair<size_t, size_t> Span;
+    struct PortRequests
+    {
+        Span removed;                       // bridge vlan del of the removed VLANs
+        Span joined;                        // link set master Bridge, bridge vlan del vid 1
+        Span tagged;                        // bridge vlan add of the tagged VLANs
+        map<uint16_t, size_t> untagged;     // bridge vlan add of each untagged VLAN
+    };
+    map<string, PortRequests> requests;
+
+    auto failed = [this](const Span &span) {
+        const auto &results = m_nl.getResults();
+        return any_of(results.begin() + span.first, results.begin() + span.second,
+                      [](int result) { return result != 0; });
+    };
+
+    // Removals go first so that a member deleted and re-added in the same drain ends up added
+    for (const auto &port : ports)
+    {
+        auto &req = requests[port.first];
+        req.removed.first = m_nl.size();
+        if (!port.second.removed.empty())
+        {
+            m_nl.delBridgeVlans(port.first, port.second.removed);
+        }
+        req.removed.second = m_nl.size();
+    }
+
+    for (const auto &port : ports)
+    {
+        const auto &members = port.second;
+        auto &req = requests[port.first];
+        if (members.tagged.empty() && members.untagged.empty())
+        {
+            continue;
+        }
+
+        req.joined.first = m_nl.size();
+        m_nl.setMaster(port.first, DOT1Q_BRIDGE_NAME);
+        m_nl.delBridgeVlan(port.first, DEFAULT_VLAN_ID);
+        req.joined.second = req.tagged.first = m_nl.size();
+        if (!members.tagged.empty())
+        {
+            m_nl.addBridgeVlans(port.first, members.tagged);
+        }
+        req.tagged.second = m_nl.size();
+        for (auto vid : members.untagged)
+        {
+            req.untagged[vid] = m_nl.size();
+            m_nl.addBridgeVlan(port.first, vid, true);
+        }
+    }
+
+    // Ports are independent of each other, a failure only fails the members it belongs to
+    bool ok = m_nl.commit(false);
+    for (auto &port : ports)
+    {
+        auto &members = port.second;
+        const auto &req = requests[port.first];
+        if (failed(req.removed))
+        {
+            members.removeFailed = members.removed;
+        }
+        if (failed(req.joined))
+        {
+            members.addFailed.insert(members.tagged.begin(), members.tagged.end());
+            members.addFailed.insert(members.untagged.begin(), members.untagged.end());
+            continue;
+        }
+        if (failed(req.tagged))
+        {
+            members.addFailed.insert(members.tagged.begin(), members.tagged.end());
+        }
+        for (const auto &untagged : req.untagged)
+        {
+            if (m_nl.getResults()[untagged.second] != 0)
+            {
+                members.addFailed.insert(untagged.first);
+            }
+        }
+    }
 
     // When port is not member of any VLAN, it shall be detached from Dot1Q bridge!
-    ostringstream cmds, inner;
-    inner << BRIDGE_CMD " vlan del vid " + std::to_string(vlan_id) + " dev " << shellquote(port_alias) << " && ( "
-      "vlanShow=$(" BRIDGE_CMD " vlan show dev " << shellquote(port_alias) << "); "
-      "ret=$?; "
-      "if [ $ret -eq 0 ]; then "
-      "if (! echo \"$vlanShow\" | " GREP_CMD " -q " << shellquote(port_alias) << ") "
-      " || (echo \"$vlanShow\" | " GREP_CMD " -q None$) "
-      " || (echo \"$vlanShow\" | " GREP_CMD " -q " << shellquote(port_alias) << "$); then "
-      IP_CMD " link set " << shellquote(port_alias) << " nomaster; "
-      "fi; "
-      "else exit $ret; fi )";
-    cmds << BASH_CMD " -c " << shellquote(inner.str());
+    map<string, size_t> detached;
+    for (auto &port : ports)
+    {
+        auto &members = port.second;
+        if (members.removed.empty() || !members.removeFailed.empty() ||
+            !members.tagged.empty() || !members.untagged.empty())
+        {
+            continue;
+        }
 
-    std::string res;
-    EXEC_WITH_ERROR_THROW(cmds.str(), res);
+        set<uint16_t> vlans;
+        if (!m_nl.getBridgeVlans(port.first, vlans))
+        {
+            members.removeFailed = members.removed;
+            ok = false;
+            continue;
+        }
+        if (vlans.empty())
+        {
+            detached[port.first] = m_nl.size();
+            m_nl.setMaster(port.first, "");
+        }
+    }
 
-    return true;
+    if (!detached.empty() && !m_nl.commit(false))
+    {
+        ok = false;
+        for (const auto &port : detached)
+        {
+            if (m_nl.getResults()[port.second] != 0)
+            {
+                ports[port.first].removeFailed = ports[port.first].removed;
+            }
+        }
+    }
+
+    // A failed removal of a VLAN that is added back successfully needs no replay
+    for (auto &port : ports)
+    {
+        auto &members = port.second;
+        for (auto it = members.removeFailed.begin(); it != members.removeFailed.end();)
+        {
+            bool readded = (members.tagged.count(*it) ||
+                            find(members.untagged.begin(), members.untagged.end(), *it) != members.untagged.end()) &&
+                           !members.addFailed.count(*it);
+            it = readded ? members.removeFailed.erase(it) : next(it);
+        }
+    }
+
+    return ok;
 }
 
 bool VlanMgr::isVlanMacOk()
@@ -557,6 +683,19 @@ void VlanMgr::processUntaggedVlanMembers(string vlan, const string &members)
 
 void VlanMgr::doVlanMemberTask(Consumer &consumer)
 {
+    struct VlanMember
+    {
+        int vlan_id;
+        string port_alias;
+        string tagging_mode;
+        KeyOpFieldsValuesTuple tuple;
+    };
+
+    /* Members ready in this drain are programmed together, per port */
+    map<string, VlanMemberBatch> ports;
+    vector<VlanMember> added, removed;
+    set<string> removedKeys;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -595,7 +734,8 @@ void VlanMgr::doVlanMemberTask(Consumer &consumer)
        // TODO:  store port/lag/VLAN data in local data structure and perform more validations.
         if (op == SET_COMMAND)
         {
-             if (isVlanMemberStateOk(kfvKey(t)))
+             /* A member removed earlier in this drain is not programmed yet, so its state is stale */
+             if (removedKeys.find(kfvKey(t)) == removedKeys.end() && isVlanMemberStateOk(kfvKey(t)))
              {
                 SWSS_LOG_DEBUG("%s already set", kfvKey(t).c_str());
                 m_vlanMemberReplay.erase(kfvKey(t));
@@ -629,31 +769,23 @@ void VlanMgr::doVlanMemberTask(Consumer &consumer)
                 continue;
             }
 
-            if (addHostVlanMember(vlan_id, port_alias, tagging_mode))
+            if (tagging_mode == "tagged")
             {
-                key = VLAN_PREFIX + to_string(vlan_id);
-                key += DEFAULT_KEY_SEPARATOR;
-                key += port_alias;
-                m_appVlanMemberTableProducer.set(key, kfvFieldsValues(t));
-
-                vector<FieldValueTuple> fvVector;
-                FieldValueTuple s("state", "ok");
-                fvVector.push_back(s);
-                m_stateVlanMemberTable.set(kfvKey(t), fvVector);
-
-                m_vlanMemberReplay.erase(kfvKey(t));
+                ports[port_alias].tagged.insert(static_cast<uint16_t>(vlan_id));
             }
+            else
+            {
+                ports[port_alias].untagged.push_back(static_cast<uint16_t>(vlan_id));
+            }
+            added.push_back({vlan_id, port_alias, tagging_mode, t});
         }
         else if (op == DEL_COMMAND)
         {
             if (isVlanMemberStateOk(kfvKey(t)))
             {
-                removeHostVlanMember(vlan_id, port_alias);
-                key = VLAN_PREFIX + to_string(vlan_id);
-                key += DEFAULT_KEY_SEPARATOR;
-                key += port_alias;
-                m_appVlanMemberTableProducer.del(key);
-                m_stateVlanMemberTable.del(kfvKey(t));
+                ports[port_alias].removed.insert(static_cast<uint16_t>(vlan_id));
+                removed.push_back({vlan_id, port_alias, "", t});
+                removedKeys.insert(kfvKey(t));
             }
             else
             {
@@ -668,6 +800,78 @@ void VlanMgr::doVlanMemberTask(Consumer &consumer)
         /* Other than the case of member port/lag is not ready, no retry will be performed */
         it = consumer.m_toSync.erase(it);
     }
+
+    auto removeFromDb = [this](const VlanMember &member) {
+        string key = VLAN_PREFIX + to_string(member.vlan_id);
+        key += DEFAULT_KEY_SEPARATOR;
+        key += member.port_alias;
+        m_appVlanMemberTableProducer.del(key);
+        m_stateVlanMemberTable.del(kfvKey(member.tuple));
+    };
+
+    auto addToDb = [this](const VlanMember &member) {
+        string key = VLAN_PREFIX + to_string(member.vlan_id);
+        key += DEFAULT_KEY_SEPARATOR;
+        key += member.port_alias;
+        m_appVlanMemberTableProducer.set(key, kfvFieldsValues(member.tuple));
+
+        vector<FieldValueTuple> fvVector;
+        FieldValueTuple s("state", "ok");
+        fvVector.push_back(s);
+        m_stateVlanMemberTable.set(kfvKey(member.tuple), fvVector);
+
+        m_vlanMemberReplay.erase(kfvKey(member.tuple));
+    };
+
+    bool batched = ports.empty() || setHostVlanMembers(ports);
+    if (!batched)
+    {
+        SWSS_LOG_WARN("Batched VLAN member update failed, %s, retrying the failed members",
+                      m_nl.getLastError().c_str());
+    }
+
+    /* Only the members programmed in the kernel are published */
+    for (const auto &member : removed)
+    {
+        if (!ports[member.port_alias].removeFailed.count(static_cast<uint16_t>(member.vlan_id)))
+        {
+            removeFromDb(member);
+        }
+    }
+    for (const auto &member : added)
+    {
+        if (!ports[member.port_alias].addFailed.count(static_cast<uint16_t>(member.vlan_id)))
+        {
+            addToDb(member);
+        }
+    }
+
+    /* Replay the failed members one by one, so that the failing one is reported as before */
+    if (!batched)
+    {
+        m_appVlanMemberTableProducer.flush();
+
+        for (const auto &member : removed)
+        {
+            if (ports[member.port_alias].removeFailed.count(static_cast<uint16_t>(member.vlan_id)))
+            {
+                removeHostVlanMember(member.vlan_id, member.port_alias);
+                removeFromDb(member);
+            }
+        }
+        for (const auto &member : added)
+        {
+            if (ports[member.port_alias].addFailed.count(static_cast<uint16_t>(member.vlan_id)))
+            {
+                addHostVlanMember(member.vlan_id, member.port_alias, member.tagging_mode);
+                addToDb(member);
+            }
+        }
+    }
+
+    /* Publish the whole drain to APPL_DB in one pipelined write */
+    m_appVlanMemberTableProducer.flush();
+
     if (!replayDone && m_vlanMemberReplay.empty() &&
         WarmStart::isWarmStart())
     {
@@ -3,14 +3,28 @@
 
 #include "dbconnector.h"
 #include "producerstatetable.h"
+#include "redispipeline.h"
 #include "orch.h"
+#include "netlinkbatch.h"
 
 #include <set>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace swss {
 
+/* VLAN membership changes of one port collected from a VLAN_MEMBER drain */
+struct VlanMemberBatch
+{
+    std::set<uint16_t> tagged;
+    std::vector<uint16_t> untagged;
+    std::set<uint16_t> removed;
+    /* Set by setHostVlanMembers() to the VLANs whose update was not programmed */
+    std::set<uint16_t> addFailed;
+    std::set<uint16_t> removeFailed;
+};
+
 class VlanMgr : public Orch
 {
 public:
@@ -18,6 +32,7 @@ public:
     using Orch::doTask;
 
 private:
+    RedisPipeline m_appPipeline;
     ProducerStateTable m_appVlanTableProducer, m_appVlanMemberTableProducer;
     Table m_cfgVlanTable, m_cfgVlanMemberTable;
     Table m_statePortTable, m_stateLagTable;
@@ -26,6 +41,7 @@ private:
     std::set<std::string> m_vlanReplay;
     std::set<std::string> m_vlanMemberReplay;
     bool replayDone;
+    NetlinkBatch m_nl;
     
     void doTask(Consumer &consumer);
     void doVlanTask(Consumer &consumer);
@@ -39,6 +55,7 @@ private:
     bool setHostVlanMac(int vlan_id, const std::string &mac);
     bool addHostVlanMember(int vlan_id, const std::string &port_alias, const std::string& tagging_mode);
     bool removeHostVlanMember(int vlan_id, const std::string &port_alias);
+    bool setHostVlanMembers(std::map<std::string, VlanMemberBatch> &ports);
     bool isMemberStateOk(const std::string &alias);
     bool isVlanStateOk(const std::string &alias);
     bool isVlanMacOk();
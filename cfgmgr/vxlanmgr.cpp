@@ -51,122 +51,79 @@ static std::string getVxlanIfName(const swss::VxlanMgr::VxlanInfo & info)
 
 #define RET_SUCCESS 0
 
-static int cmdCreateVxlan(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static void cmdCreateVxlan(NetlinkBatch &nl, const swss::VxlanMgr::VxlanInfo & info, uint32_t vni)
 {
     // ip link add {{VXLAN}} type vxlan id {{VNI}} [local {{SOURCE IP}}] dstport 4789
-    ostringstream cmd;
-    cmd << IP_CMD " link add "
-        << shellquote(info.m_vxlan)
-        << " type vxlan id "
-        << shellquote(info.m_vni)
-        << " ";
-    if (!info.m_sourceIp.empty())
-    {
-        cmd << " local " << shellquote(info.m_sourceIp);
-    }
-    cmd << " dstport 4789";
-    return swss::exec(cmd.str(), res);
+    nl.addVxlan(info.m_vxlan, vni, info.m_sourceIp);
 }
 
-static int cmdUpVxlan(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static void cmdUpVxlan(NetlinkBatch &nl, const swss::VxlanMgr::VxlanInfo & info)
 {
     // ip link set dev {{VXLAN}} up
-    ostringstream cmd;
-    cmd << IP_CMD " link set dev "
-        << shellquote(info.m_vxlan)
-        << " up";
-    return swss::exec(cmd.str(), res);
+    nl.setAdminState(info.m_vxlan, true);
 }
 
-static int cmdCreateVxlanIf(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static void cmdCreateVxlanIf(NetlinkBatch &nl, const swss::VxlanMgr::VxlanInfo & info)
 {
     // ip link add {{VXLAN_IF}} type bridge
-    ostringstream cmd;
-    cmd << IP_CMD " link add "
-        << shellquote(info.m_vxlanIf)
-        << " type bridge";
-    return swss::exec(cmd.str(), res);
+    nl.addBridge(info.m_vxlanIf);
 }
 
-static int cmdAddVxlanIntoVxlanIf(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static void cmdAddVxlanIntoVxlanIf(NetlinkBatch &nl, const swss::VxlanMgr::VxlanInfo & info)
 {
     // brctl addif {{VXLAN_IF}} {{VXLAN}}
-    ostringstream cmd;
-    cmd << BRCTL_CMD " addif "
-        << shellquote(info.m_vxlanIf)
-        << " "
-        << shellquote(info.m_vxlan);
+    nl.setMaster(info.m_vxlan, info.m_vxlanIf);
     if (!info.m_macAddress.empty())
     {
         // Change the MAC address of Vxlan bridge interface to ensure it's same with switch's.
         // Otherwise it will not response traceroute packets.
         // ip link set dev {{VXLAN_IF}} address {{MAC_ADDRESS}}
-        cmd << " && " IP_CMD " link set dev "
-            << shellquote(info.m_vxlanIf)
-            << " address "
-            << shellquote(info.m_macAddress);
+        uint8_t mac[6];
+        if (MacAddress::parseMacString(info.m_macAddress, mac))
+        {
+            nl.setMac(info.m_vxlanIf, MacAddress(mac));
+        }
+        else
+        {
+            SWSS_LOG_WARN("Invalid mac address %s for %s", info.m_macAddress.c_str(), info.m_vxlanIf.c_str());
+        }
     }
-    return swss::exec(cmd.str(), res);
 }
 
-static int cmdAttachVxlanIfToVnet(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static void cmdAttachVxlanIfToVnet(NetlinkBatch &nl, const swss::VxlanMgr::VxlanInfo & info)
 {
     // ip link set dev {{VXLAN_IF}} master {{VNET}}
-    ostringstream cmd;
-    cmd << IP_CMD " link set dev "
-        << shellquote(info.m_vxlanIf)
-        << " master "
-        << shellquote(info.m_vnet);
-    return swss::exec(cmd.str(), res);
+    nl.setMaster(info.m_vxlanIf, info.m_vnet);
 }
 
-static int cmdUpVxlanIf(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static void cmdUpVxlanIf(NetlinkBatch &nl, const swss::VxlanMgr::VxlanInfo & info)
 {
     // ip link set dev {{VXLAN_IF}} up
-    ostringstream cmd;
-    cmd << IP_CMD " link set dev "
-        << shellquote(info.m_vxlanIf)
-        << " up";
-    return swss::exec(cmd.str(), res);
+    nl.setAdminState(info.m_vxlanIf, true);
 }
 
-static int cmdDeleteVxlan(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static void cmdDeleteVxlan(NetlinkBatch &nl, const swss::VxlanMgr::VxlanInfo & info)
 {
     // ip link del dev {{VXLAN}}
-    ostringstream cmd;
-    cmd << IP_CMD " link del dev "
-        << shellquote(info.m_vxlan);
-    return swss::exec(cmd.str(), res);
+    nl.delLink(info.m_vxlan);
 }
 
-static int cmdDeleteVxlanFromVxlanIf(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static void cmdDeleteVxlanFromVxlanIf(NetlinkBatch &nl, const swss::VxlanMgr::VxlanInfo & info)
 {
     // brctl delif {{VXLAN_IF}} {{VXLAN}}
-    ostringstream cmd;
-    cmd << BRCTL_CMD " delif "
-        << shellquote(info.m_vxlanIf)
-        << " " 
-        << shellquote(info.m_vxlan);
-    return swss::exec(cmd.str(), res);
+    nl.setMaster(info.m_vxlan, "");
 }
 
-static int cmdDeleteVxlanIf(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static void cmdDeleteVxlanIf(NetlinkBatch &nl, const swss::VxlanMgr::VxlanInfo & info)
 {
     // ip link del {{VXLAN_IF}}
-    ostringstream cmd;
-    cmd << IP_CMD " link del "
-        << shellquote(info.m_vxlanIf);
-    return swss::exec(cmd.str(), res);
+    nl.delLink(info.m_vxlanIf);
 }
 
-static int cmdDetachVxlanIfFromVnet(const swss::VxlanMgr::VxlanInfo & info, std::string & res)
+static void cmdDetachVxlanIfFromVnet(NetlinkBatch &nl, const swss::VxlanMgr::VxlanInfo & info)
 {
     // ip link set dev {{VXLAN_IF}} nomaster
-    ostringstream cmd;
-    cmd << IP_CMD " link set dev "
-        << shellquote(info.m_vxlanIf)
-        << " nomaster";
-    return swss::exec(cmd.str(), res);
+    nl.setMaster(info.m_vxlanIf, "");
 }
 
 // Vxlanmgr
@@ -797,83 +754,51 @@ std::pair<bool, std::string> VxlanMgr::getVxlanRouterMacAddress()
 bool VxlanMgr::createVxlan(const VxlanInfo & info)
 {
     SWSS_LOG_ENTER();
-    
-    std::string res;
-    int ret = 0;
 
-    // Create Vxlan
-    ret = cmdCreateVxlan(info, res);
-    if (ret != RET_SUCCESS)
-    {
-        SWSS_LOG_WARN(
-            "Failed to create vxlan %s (vni: %s, source ip %s)",
-            info.m_vxlan.c_str(),
-            info.m_vni.c_str(),
-            info.m_sourceIp.c_str());
-        return false;
-    }
-
-    // Up Vxlan
-    ret = cmdUpVxlan(info, res);
-    if (ret != RET_SUCCESS)
+    uint32_t vni;
+    try
     {
-        cmdDeleteVxlan(info, res);
-        SWSS_LOG_WARN(
-            "Fail to up vxlan %s",
-            info.m_vxlan.c_str());
-        return false;
+        vni = static_cast<uint32_t>(stoul(info.m_vni));
     }
-
-    // Create Vxlan Interface
-    ret = cmdCreateVxlanIf(info, res);
-    if (ret != RET_SUCCESS)
+    catch (const std::exception &)
     {
-        cmdDeleteVxlan(info, res);
-        SWSS_LOG_WARN(
-            "Fail to create vxlan interface %s",
-            info.m_vxlanIf.c_str());
+        SWSS_LOG_WARN("Invalid vni %s of vxlan %s", info.m_vni.c_str(), info.m_vxlan.c_str());
         return false;
     }
 
-    // Add vxlan into vxlan interface
-    ret = cmdAddVxlanIntoVxlanIf(info, res);
-    if ( ret != RET_SUCCESS )
+    // Create Vxlan
+    cmdCreateVxlan(m_nl, info, vni);
+    if (!m_nl.commit())
     {
-        cmdDeleteVxlanIf(info, res);
-        cmdDeleteVxlan(info, res);
         SWSS_LOG_WARN(
-            "Fail to add %s into %s",
+            "Failed to create vxlan %s (vni: %s, source ip %s), %s",
             info.m_vxlan.c_str(),
-            info.m_vxlanIf.c_str());
+            info.m_vni.c_str(),
+            info.m_sourceIp.c_str(),
+            m_nl.getLastError().c_str());
         return false;
     }
 
-    // Attach vxlan interface to vnet
-    ret = cmdAttachVxlanIfToVnet(info, res);
-    if ( ret != RET_SUCCESS )
+    // Up Vxlan, create Vxlan Interface, add vxlan into it, attach it to vnet and up it
+    cmdUpVxlan(m_nl, info);
+    cmdCreateVxlanIf(m_nl, info);
+    cmdAddVxlanIntoVxlanIf(m_nl, info);
+    cmdAttachVxlanIfToVnet(m_nl, info);
+    cmdUpVxlanIf(m_nl, info);
+    if (!m_nl.commit())
     {
-        cmdDeleteVxlanFromVxlanIf(info, res);
-        cmdDeleteVxlanIf(info, res);
-        cmdDeleteVxlan(info, res);
         SWSS_LOG_WARN(
-            "Fail to set %s master %s",
+            "Fail to set up %s with bridge %s in %s, %s",
+            info.m_vxlan.c_str(),
             info.m_vxlanIf.c_str(),
-            info.m_vnet.c_str());
-        return false;
-       
-    }
-
-    // Up Vxlan Interface
-    ret = cmdUpVxlanIf(info, res);
-    if ( ret != RET_SUCCESS )
-    {
-        cmdDetachVxlanIfFromVnet(info, res);
-        cmdDeleteVxlanFromVxlanIf(info, res);
-        cmdDeleteVxlanIf(info, res);
-        cmdDeleteVxlan(info, res);
-        SWSS_LOG_WARN(
-            "Fail to up bridge %s",
-            info.m_vxlanIf.c_str());
+            info.m_vnet.c_str(),
+            m_nl.getLastError().c_str());
+
+        cmdDetachVxlanIfFromVnet(m_nl, info);
+        cmdDeleteVxlanFromVxlanIf(m_nl, info);
+        cmdDeleteVxlanIf(m_nl, info);
+        cmdDeleteVxlan(m_nl, info);
+        m_nl.commit(false);
         return false;
     }
 
@@ -888,12 +813,11 @@ bool VxlanMgr::deleteVxlan(const VxlanInfo & info)
 {
     SWSS_LOG_ENTER();
 
-    std::string res;
-
-    cmdDetachVxlanIfFromVnet(info, res);
-    cmdDeleteVxlanFromVxlanIf(info, res);
-    cmdDeleteVxlanIf(info, res);
-    cmdDeleteVxlan(info, res);
+    cmdDetachVxlanIfFromVnet(m_nl, info);
+    cmdDeleteVxlanFromVxlanIf(m_nl, info);
+    cmdDeleteVxlanIf(m_nl, info);
+    cmdDeleteVxlan(m_nl, info);
+    m_nl.commit(false);
 
     m_stateVxlanTable.del(info.m_vxlan);
 
@@ -944,9 +868,6 @@ int VxlanMgr::createVxlanNetdevice(std::string vxlanTunnelName, std::string vni_
                                    std::string src_ip, std::string dst_ip,
                                    std::string vlan_id)
 {
-    std::string res, cmds;
-    std::string link_add_cmd, link_set_master_cmd, link_up_cmd;
-    std::string bridge_add_cmd, bridge_untagged_add_cmd, bridge_del_vid_cmd;
     std::string vxlan_dev_name;
 
     vxlan_dev_name = std::string("") + std::string(vxlanTunnelName) + "-" +
@@ -988,57 +909,49 @@ int VxlanMgr::createVxlanNetdevice(std::string vxlanTunnelName, std::string vni_
     // bridge vlan add vid <vlan_id> untagged pvid dev <vxlan_dev_name>
     // ip link set <vxlan_dev_name> up
 
-    link_add_cmd = std::string("") + IP_CMD + " link add " + vxlan_dev_name + 
-                   " address " + gMacAddress.to_string() + " type vxlan id " + 
-                   std::string(vni_id) + " local " + src_ip + 
-                   ((dst_ip  == "")? "":(" remote " + dst_ip)) + 
-                   " nolearning " + " dstport 4789 ";
-    
-    link_set_master_cmd = std::string("") + IP_CMD + " link set " + 
-                          vxlan_dev_name + " master Bridge ";
-
-    link_up_cmd = std::string("") + IP_CMD + " link set " + vxlan_dev_name + " up ";
-
-    bridge_add_cmd = std::string("") + BRIDGE_CMD + " vlan add vid " + 
-                     std::string(vlan_id) + " dev " + vxlan_dev_name;
-
-    bridge_untagged_add_cmd = std::string("") + BRIDGE_CMD + " vlan add vid " + 
-                              std::string(vlan_id) + " untagged pvid dev " + vxlan_dev_name;
-
-    bridge_del_vid_cmd = std::string("") + BRIDGE_CMD + " vlan del vid 1 dev " + 
-                         vxlan_dev_name;
-    
-    
-    cmds = std::string("") + BASH_CMD + " -c \"" + 
-           link_add_cmd + " && " + 
-           link_set_master_cmd + " && " + 
-           bridge_add_cmd + " && " + 
-           bridge_untagged_add_cmd + " && "; 
-        
-    if ( vlan_id != "1")
+    uint32_t vni;
+    uint16_t vid;
+    try
     {
-        cmds += bridge_del_vid_cmd + " && ";
+        vni = static_cast<uint32_t>(stoul(vni_id));
+        vid = static_cast<uint16_t>(stoul(vlan_id));
+    }
+    catch (const std::exception &)
+    {
+        SWSS_LOG_ERROR("Invalid vni %s or vlan %s for %s", vni_id.c_str(), vlan_id.c_str(), vxlan_dev_name.c_str());
+        return -1;
     }
 
-    cmds += link_up_cmd + "\"";
+    m_nl.addVxlan(vxlan_dev_name, vni, src_ip, dst_ip, gMacAddress, false);
+    m_nl.setMaster(vxlan_dev_name, "Bridge");
+    m_nl.addBridgeVlan(vxlan_dev_name, vid);
+    m_nl.addBridgeVlan(vxlan_dev_name, vid, true);
+    if (vid != 1)
+    {
+        m_nl.delBridgeVlan(vxlan_dev_name, 1);
+    }
+    m_nl.setAdminState(vxlan_dev_name, true);
 
-    return swss::exec(cmds,res);
+    if (!m_nl.commit())
+    {
+        SWSS_LOG_ERROR("Netlink request %s", m_nl.getLastError().c_str());
+        return -1;
+    }
+    return RET_SUCCESS;
 }
 
 int VxlanMgr::downVxlanNetdevice(std::string vxlan_dev_name)
 {
     int ret = 0;
-    std::string res;
-    const std::string cmd = std::string("") + IP_CMD + " link set dev " + vxlan_dev_name + " down";
-    exec(cmd, res);
+    m_nl.setAdminState(vxlan_dev_name, false);
+    m_nl.commit();
     return ret;
 }
 
 int VxlanMgr::deleteVxlanNetdevice(std::string vxlan_dev_name)
 {    
-    std::string res;
-    const std::string cmd = std::string("") + IP_CMD  + " link del dev " + vxlan_dev_name;
-    return swss::exec(cmd, res);
+    m_nl.delLink(vxlan_dev_name);
+    return m_nl.commit() ? RET_SUCCESS : -1;
 }
 
 std::vector<std::string> VxlanMgr::parseNetDev(const string& stdout){
@@ -1194,20 +1107,20 @@ void VxlanMgr::clearAllVxlanDevices()
         std::string netdev_type = it->second;
         SWSS_LOG_INFO("Deleting Stale NetDevice %s, type: %s\n", netdev_name.c_str(), netdev_type.c_str());
         VxlanInfo info;
-        std::string res;
         if (netdev_type.compare(VXLAN))
         {
             info.m_vxlan = netdev_name;
-            downVxlanNetdevice(netdev_name);
-            cmdDeleteVxlan(info, res);
+            m_nl.setAdminState(netdev_name, false);
+            cmdDeleteVxlan(m_nl, info);
         }
         else if(netdev_type.compare(VXLAN_IF))
         {
             info.m_vxlanIf = netdev_name;
-            cmdDeleteVxlanIf(info, res);
+            cmdDeleteVxlanIf(m_nl, info);
         }
         it = m_vxlanNetDevices.erase(it);
     }
+    m_nl.commit(false);
 }
 
 void VxlanMgr::waitTillReadyToReconcile()
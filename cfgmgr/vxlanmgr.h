@@ -4,6 +4,7 @@
 #include "dbconnector.h"
 #include "producerstatetable.h"
 #include "orch.h"
+#include "netlinkbatch.h"
 
 #include <map>
 #include <vector>
@@ -117,6 +118,7 @@ private:
     bool m_in_reconcile;
     std::vector<std::string> m_appVxlanTunnelMapKeysRecon;
     std::map<std::string, std::string> m_vxlanNetDevices;
+    NetlinkBatch m_nl;
 };
 
 }
@@ -0,0 +1,929 @@
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <net/if.h>
+#include <net/ethernet.h>
+#include <arpa/inet.h>
+#include <linux/if_bridge.h>
+#include <linux/if_link.h>
+#include <linux/neighbour.h>
+#include <linux/rtnetlink.h>
+#include <netlink/netlink.h>
+#include <netlink/msg.h>
+#include <netlink/attr.h>
+
+#include "logger.h"
+#include "netlinkbatch.h"
+
+using namespace swss;
+
+/* Requests written into one datagram, bounded so that the acks fit the receive buffer */
+#define NETLINK_BATCH_WINDOW 64
+/* VLAN ranges carried by one bridge VLAN request, keeps it within a default sized nl_msg */
+#define NETLINK_BRIDGE_VLAN_RANGES 128
+/* Time the kernel is given to answer, the remaining requests of a window fail once it expires */
+#define NETLINK_BATCH_TIMEOUT_MS 1000
+
+/* Status of each request of a window, -1 until its ack arrives */
+struct AckState
+{
+    uint32_t firstSeq;
+    size_t acked;
+    std::vector<int> results;
+};
+
+static void setAck(AckState *state, uint32_t seq, int error)
+{
+    size_t idx = seq - state->firstSeq;
+
+    /* Late acks of an earlier window fall out of range */
+    if (idx < state->results.size() && state->results[idx] < 0)
+    {
+        state->results[idx] = error;
+        state->acked++;
+    }
+}
+
+static int onAck(struct nl_msg *msg, void *arg)
+{
+    setAck(static_cast<AckState *>(arg), nlmsg_hdr(msg)->nlmsg_seq, 0);
+    return NL_OK;
+}
+
+static int onError(struct sockaddr_nl *nla, struct nlmsgerr *err, void *arg)
+{
+    setAck(static_cast<AckState *>(arg), err->msg.nlmsg_seq, -err->error);
+    return NL_SKIP;
+}
+
+/* Returns > 0 when the socket has data to read, 0 on timeout */
+static int waitReadable(struct nl_sock *sock)
+{
+    struct pollfd pfd = { nl_socket_get_fd(sock), POLLIN, 0 };
+    int ret;
+
+    while ((ret = poll(&pfd, 1, NETLINK_BATCH_TIMEOUT_MS)) < 0 && errno == EINTR)
+    {
+    }
+    return ret;
+}
+
+static int noSeqCheck(struct nl_msg *msg, void *arg)
+{
+    return NL_OK;
+}
+
+struct BridgeVlanDump
+{
+    int ifindex;
+    std::set<uint16_t> *vlans;
+};
+
+static int onBridgeVlan(struct nl_msg *msg, void *arg)
+{
+    auto *dump = static_cast<BridgeVlanDump *>(arg);
+    struct nlmsghdr *hdr = nlmsg_hdr(msg);
+    struct ifinfomsg *ifi = static_cast<struct ifinfomsg *>(nlmsg_data(hdr));
+
+    if (ifi->ifi_index != dump->ifindex)
+    {
+        return NL_OK;
+    }
+
+    struct nlattr *spec = nlmsg_find_attr(hdr, sizeof(*ifi), IFLA_AF_SPEC);
+    if (!spec)
+    {
+        return NL_OK;
+    }
+
+    struct nlattr *attr;
+    int rem;
+    nla_for_each_nested(attr, spec, rem)
+    {
+        if (nla_type(attr) != IFLA_BRIDGE_VLAN_INFO)
+        {
+            continue;
+        }
+        auto *vinfo = static_cast<struct bridge_vlan_info *>(nla_data(attr));
+        dump->vlans->insert(vinfo->vid);
+    }
+    return NL_OK;
+}
+
+static int putHeader(struct nl_msg *msg, int type, int flags, const void *body, size_t len)
+{
+    if (!nlmsg_put(msg, NL_AUTO_PORT, NL_AUTO_SEQ, type, 0, flags))
+    {
+        return -ENOMEM;
+    }
+    if (nlmsg_append(msg, const_cast<void *>(body), len, NLMSG_ALIGNTO) < 0)
+    {
+        return -ENOMEM;
+    }
+    return 0;
+}
+
+static int putLink(struct nl_msg *msg, int type, int flags, const std::string &name,
+                   int ifindex = 0, unsigned ifflags = 0, unsigned change = 0)
+{
+    struct ifinfomsg ifi;
+    memset(&ifi, 0, sizeof(ifi));
+    ifi.ifi_family = AF_UNSPEC;
+    ifi.ifi_index = ifindex;
+    ifi.ifi_flags = ifflags;
+    ifi.ifi_change = change;
+
+    int err = putHeader(msg, type, flags, &ifi, sizeof(ifi));
+    if (err < 0)
+    {
+        return err;
+    }
+    if (!name.empty() && nla_put_string(msg, IFLA_IFNAME, name.c_str()) < 0)
+    {
+        return -ENOMEM;
+    }
+    return 0;
+}
+
+static int putAddress(struct nl_msg *msg, int attr, const IpAddress &ip)
+{
+    ip_addr_t addr = ip.getIp();
+    if (ip.isV4())
+    {
+        return nla_put(msg, attr, sizeof(addr.ip_addr.ipv4_addr), &addr.ip_addr.ipv4_addr) < 0 ? -ENOMEM : 0;
+    }
+    return nla_put(msg, attr, sizeof(addr.ip_addr.ipv6_addr), addr.ip_addr.ipv6_addr) < 0 ? -ENOMEM : 0;
+}
+
+static std::string updown(bool up)
+{
+    return up ? "up" : "down";
+}
+
+NetlinkBatch::NetlinkBatch()
+{
+    int err = 0;
+
+    m_sock = nl_socket_alloc();
+    if (!m_sock)
+    {
+        SWSS_LOG_ERROR("Netlink socket alloc failed");
+    }
+    else if ((err = nl_connect(m_sock, NETLINK_ROUTE)) < 0)
+    {
+        SWSS_LOG_ERROR("Netlink socket connect failed, error '%s'", nl_geterror(err));
+        nl_socket_free(m_sock);
+        m_sock = nullptr;
+    }
+    else
+    {
+        nl_socket_disable_seq_check(m_sock);
+
+        /* Bounds the reads libnl issues by itself, such as the rest of a multipart dump */
+        struct timeval tv = { NETLINK_BATCH_TIMEOUT_MS / 1000, (NETLINK_BATCH_TIMEOUT_MS % 1000) * 1000 };
+        if (setsockopt(nl_socket_get_fd(m_sock), SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) < 0)
+        {
+            SWSS_LOG_WARN("Netlink socket receive timeout not set, error '%s'", strerror(errno));
+        }
+    }
+}
+
+NetlinkBatch::~NetlinkBatch()
+{
+    if (m_sock)
+    {
+        nl_socket_free(m_sock);
+    }
+}
+
+void NetlinkBatch::queue(const std::string &desc, Builder build)
+{
+    m_requests.push_back({desc, build});
+}
+
+int NetlinkBatch::resolve(const std::string &name)
+{
+    return static_cast<int>(if_nametoindex(name.c_str()));
+}
+
+void NetlinkBatch::addBridge(const std::string &name)
+{
+    queue("link add " + name + " type bridge",
+          [name](struct nl_msg *msg, NetlinkBatch &batch) {
+        int err = putLink(msg, RTM_NEWLINK, NLM_F_CREATE | NLM_F_EXCL, name);
+        if (err < 0)
+        {
+            return err;
+        }
+        struct nlattr *info = nla_nest_start(msg, IFLA_LINKINFO);
+        if (!info || nla_put_string(msg, IFLA_INFO_KIND, "bridge") < 0)
+        {
+            return -ENOMEM;
+        }
+        nla_nest_end(msg, info);
+        return 0;
+    });
+}
+
+void NetlinkBatch::addDummy(const std::string &name, uint32_t mtu)
+{
+    queue("link add " + name + (mtu ? " mtu " + std::to_string(mtu) : "") + " type dummy",
+          [name, mtu](struct nl_msg *msg, NetlinkBatch &batch) {
+        int err = putLink(msg, RTM_NEWLINK, NLM_F_CREATE | NLM_F_EXCL, name);
+        if (err < 0)
+        {
+            return err;
+        }
+        if (mtu && nla_put_u32(msg, IFLA_MTU, mtu) < 0)
+        {
+            return -ENOMEM;
+        }
+        struct nlattr *info = nla_nest_start(msg, IFLA_LINKINFO);
+        if (!info || nla_put_string(msg, IFLA_INFO_KIND, "dummy") < 0)
+        {
+            return -ENOMEM;
+        }
+        nla_nest_end(msg, info);
+        return 0;
+    });
+}
+
+void NetlinkBatch::addVlan(const std::string &name, const std::string &parent, uint16_t vlanId,
+                           const MacAddress &mac, bool up)
+{
+    queue("link add link " + parent + (up ? " up" : "") + " name " + name +
+          (mac ? " address " + mac.to_string() : "") + " type vlan id " + std::to_string(vlanId),
+          [name, parent, vlanId, mac, up](struct nl_msg *msg, NetlinkBatch &batch) {
+        int link = batch.resolve(parent);
+        if (!link)
+        {
+            return -ENODEV;
+        }
+        int err = putLink(msg, RTM_NEWLINK, NLM_F_CREATE | NLM_F_EXCL, name, 0,
+                          up ? IFF_UP : 0, up ? IFF_UP : 0);
+        if (err < 0)
+        {
+            return err;
+        }
+        if (nla_put_u32(msg, IFLA_LINK, link) < 0)
+        {
+            return -ENOMEM;
+        }
+        if (mac && nla_put(msg, IFLA_ADDRESS, ETHER_ADDR_LEN, mac.getMac()) < 0)
+        {
+            return -ENOMEM;
+        }
+        struct nlattr *info = nla_nest_start(msg, IFLA_LINKINFO);
+        if (!info || nla_put_string(msg, IFLA_INFO_KIND, "vlan") < 0)
+        {
+            return -ENOMEM;
+        }
+        struct nlattr *data = nla_nest_start(msg, IFLA_INFO_DATA);
+        if (!data || nla_put_u16(msg, IFLA_VLAN_ID, vlanId) < 0)
+        {
+            return -ENOMEM;
+        }
+        nla_nest_end(msg, data);
+        nla_nest_end(msg, info);
+        return 0;
+    });
+}
+
+void NetlinkBatch::addVxlan(const std::string &name, uint32_t vni, const std::string &srcIp,
+                            const std::string &dstIp, const MacAddress &mac,
+                            bool learning, uint16_t dstPort)
+{
+    queue("link add " + name + (mac ? " address " + mac.to_string() : "") +
+          " type vxlan id " + std::to_string(vni) +
+          (srcIp.empty() ? "" : " local " + srcIp) +
+          (dstIp.empty() ? "" : " remote " + dstIp) +
+          (learning ? "" : " nolearning") + " dstport " + std::to_string(dstPort),
+          [name, vni, srcIp, dstIp, mac, learning, dstPort](struct nl_msg *msg, NetlinkBatch &batch) {
+        int err = putLink(msg, RTM_NEWLINK, NLM_F_CREATE | NLM_F_EXCL, name);
+        if (err < 0)
+        {
+            return err;
+        }
+        if (mac && nla_put(msg, IFLA_ADDRESS, ETHER_ADDR_LEN, mac.getMac()) < 0)
+        {
+            return -ENOMEM;
+        }
+        struct nlattr *info = nla_nest_start(msg, IFLA_LINKINFO);
+        if (!info || nla_put_string(msg, IFLA_INFO_KIND, "vxlan") < 0)
+        {
+            return -ENOMEM;
+        }
+        struct nlattr *data = nla_nest_start(msg, IFLA_INFO_DATA);
+        if (!data || nla_put_u32(msg, IFLA_VXLAN_ID, vni) < 0)
+        {
+            return -ENOMEM;
+        }
+        try
+        {
+            if (!srcIp.empty())
+            {
+                IpAddress src(srcIp);
+                err = putAddress(msg, src.isV4() ? IFLA_VXLAN_LOCAL : IFLA_VXLAN_LOCAL6, src);
+            }
+            if (err == 0 && !dstIp.empty())
+            {
+                IpAddress dst(dstIp);
+                err = putAddress(msg, dst.isV4() ? IFLA_VXLAN_GROUP : IFLA_VXLAN_GROUP6, dst);
+            }
+        }
+        catch (const std::invalid_argument &)
+        {
+            return -EINVAL;
+        }
+        if (err < 0)
+        {
+            return err;
+        }
+        if (!learning && nla_put_u8(msg, IFLA_VXLAN_LEARNING, 0) < 0)
+        {
+            return -ENOMEM;
+        }
+        if (nla_put_u16(msg, IFLA_VXLAN_PORT, htons(dstPort)) < 0)
+        {
+            return -ENOMEM;
+        }
+        nla_nest_end(msg, data);
+        nla_nest_end(msg, info);
+        return 0;
+    });
+}
+
+void NetlinkBatch::delLink(const std::string &name)
+{
+    queue("link del " + name,
+          [name](struct nl_msg *msg, NetlinkBatch &batch) {
+        return putLink(msg, RTM_DELLINK, 0, name);
+    });
+}
+
+void NetlinkBatch::setAdminState(const std::string &name, bool up)
+{
+    queue("link set " + name + " " + updown(up),
+          [name, up](struct nl_msg *msg, NetlinkBatch &batch) {
+        return putLink(msg, RTM_NEWLINK, 0, name, 0, up ? IFF_UP : 0, IFF_UP);
+    });
+}
+
+void NetlinkBatch::setMtu(const std::string &name, uint32_t mtu)
+{
+    queue("link set " + name + " mtu " + std::to_string(mtu),
+          [name, mtu](struct nl_msg *msg, NetlinkBatch &batch) {
+        int err = putLink(msg, RTM_NEWLINK, 0, name);
+        if (err < 0)
+        {
+            return err;
+        }
+        return nla_put_u32(msg, IFLA_MTU, mtu) < 0 ? -ENOMEM : 0;
+    });
+}
+
+void NetlinkBatch::setMac(const std::string &name, const MacAddress &mac)
+{
+    queue("link set " + name + " address " + mac.to_string(),
+          [name, mac](struct nl_msg *msg, NetlinkBatch &batch) {
+        int err = putLink(msg, RTM_NEWLINK, 0, name);
+        if (err < 0)
+        {
+            return err;
+        }
+        return nla_put(msg, IFLA_ADDRESS, ETHER_ADDR_LEN, mac.getMac()) < 0 ? -ENOMEM : 0;
+    });
+}
+
+void NetlinkBatch::setMaster(const std::string &name, const std::string &master)
+{
+    queue("link set " + name + (master.empty() ? " nomaster" : " master " + master),
+          [name, master](struct nl_msg *msg, NetlinkBatch &batch) {
+        int index = 0;
+        if (!master.empty() && !(index = batch.resolve(master)))
+        {
+            return -ENODEV;
+        }
+        int err = putLink(msg, RTM_NEWLINK, 0, name);
+        if (err < 0)
+        {
+            return err;
+        }
+        return nla_put_u32(msg, IFLA_MASTER, index) < 0 ? -ENOMEM : 0;
+    });
+}
+
+void NetlinkBatch::addAddress(const std::string &dev, const IpPrefix &prefix, uint32_t metric)
+{
+    queue("address add " + prefix.to_string() + " dev " + dev +
+          (metric ? " metric " + std::to_string(metric) : ""),
+          [dev, prefix, metric](struct nl_msg *msg, NetlinkBatch &batch) {
+        int index = batch.resolve(dev);
+        if (!index)
+        {
+            return -ENODEV;
+        }
+
+        IpAddress ip = prefix.getIp();
+        struct ifaddrmsg ifa;
+        memset(&ifa, 0, sizeof(ifa));
+        ifa.ifa_family = ip.isV4() ? AF_INET : AF_INET6;
+        ifa.ifa_prefixlen = static_cast<unsigned char>(prefix.getMaskLength());
+        ifa.ifa_index = index;
+        /* Same default scope as iproute2: host for 127/8, global otherwise */
+        if (ip.isV4() && (ntohl(ip.getV4Addr()) >> 24) == 127)
+        {
+            ifa.ifa_scope = RT_SCOPE_HOST;
+        }
+
+        int err = putHeader(msg, RTM_NEWADDR, NLM_F_CREATE | NLM_F_EXCL, &ifa, sizeof(ifa));
+        if (err < 0 || (err = putAddress(msg, IFA_LOCAL, ip)) < 0 || (err = putAddress(msg, IFA_ADDRESS, ip)) < 0)
+        {
+            return err;
+        }
+        if (ip.isV4() && prefix.getMaskLength() < 31 &&
+            (err = putAddress(msg, IFA_BROADCAST, prefix.getBroadcastIp())) < 0)
+        {
+            return err;
+        }
+        if (metric && nla_put_u32(msg, IFA_RT_PRIORITY, metric) < 0)
+        {
+            return -ENOMEM;
+        }
+        return 0;
+    });
+}
+
+void NetlinkBatch::delAddress(const std::string &dev, const IpPrefix &prefix)
+{
+    queue("address del " + prefix.to_string() + " dev " + dev,
+          [dev, prefix](struct nl_msg *msg, NetlinkBatch &batch) {
+        int index = batch.resolve(dev);
+        if (!index)
+        {
+            return -ENODEV;
+        }
+
+        IpAddress ip = prefix.getIp();
+        struct ifaddrmsg ifa;
+        memset(&ifa, 0, sizeof(ifa));
+        ifa.ifa_family = ip.isV4() ? AF_INET : AF_INET6;
+        ifa.ifa_prefixlen = static_cast<unsigned char>(prefix.getMaskLength());
+        ifa.ifa_index = index;
+
+        int err = putHeader(msg, RTM_DELADDR, 0, &ifa, sizeof(ifa));
+        if (err < 0)
+        {
+            return err;
+        }
+        return putAddress(msg, IFA_LOCAL, ip);
+    });
+}
+
+static int putBridgeVlan(struct nl_msg *msg, int type, int index,
+                         uint16_t vid, uint16_t flags, bool self)
+{
+    struct ifinfomsg ifi;
+    memset(&ifi, 0, sizeof(ifi));
+    ifi.ifi_family = AF_BRIDGE;
+    ifi.ifi_index = index;
+
+    int err = putHeader(msg, type, 0, &ifi, sizeof(ifi));
+    if (err < 0)
+    {
+        return err;
+    }
+
+    struct nlattr *spec = nla_nest_start(msg, IFLA_AF_SPEC);
+    if (!spec)
+    {
+        return -ENOMEM;
+    }
+    if (self && nla_put_u16(msg, IFLA_BRIDGE_FLAGS, BRIDGE_FLAGS_SELF) < 0)
+    {
+        return -ENOMEM;
+    }
+
+    struct bridge_vlan_info vinfo;
+    memset(&vinfo, 0, sizeof(vinfo));
+    vinfo.flags = flags;
+    vinfo.vid = vid;
+    if (nla_put(msg, IFLA_BRIDGE_VLAN_INFO, sizeof(vinfo), &vinfo) < 0)
+    {
+        return -ENOMEM;
+    }
+    nla_nest_end(msg, spec);
+    return 0;
+}
+
+void NetlinkBatch::addBridgeVlan(const std::string &dev, uint16_t vid, bool pvidUntagged, bool self)
+{
+    queue("bridge vlan add vid " + std::to_string(vid) + " dev " + dev +
+          (pvidUntagged ? " pvid untagged" : "") + (self ? " self" : ""),
+          [dev, vid, pvidUntagged, self](struct nl_msg *msg, NetlinkBatch &batch) {
+        int index = batch.resolve(dev);
+        if (!index)
+        {
+            return -ENODEV;
+        }
+        uint16_t flags = pvidUntagged ? static_cast<uint16_t>(BRIDGE_VLAN_INFO_PVID | BRIDGE_VLAN_INFO_UNTAGGED) : 0;
+        return putBridgeVlan(msg, RTM_SETLINK, index, vid, flags, self);
+    });
+}
+
+void NetlinkBatch::delBridgeVlan(const std::string &dev, uint16_t vid, bool self)
+{
+    queue("bridge vlan del vid " + std::to_string(vid) + " dev " + dev + (self ? " self" : ""),
+          [dev, vid, self](struct nl_msg *msg, NetlinkBatch &batch) {
+        int index = batch.resolve(dev);
+        if (!index)
+        {
+            return -ENODEV;
+        }
+        return putBridgeVlan(msg, RTM_DELLINK, index, vid, 0, self);
+    });
+}
+
+static std::string vlanRanges(const std::vector<std::pair<uint16_t, uint16_t>> &ranges)
+{
+    std::string str;
+    for (const auto &range : ranges)
+    {
+        if (!str.empty())
+        {
+            str += ",";
+        }
+        str += std::to_string(range.first);
+        if (range.second != range.first)
+        {
+            str += "-" + std::to_string(range.second);
+        }
+    }
+    return str;
+}
+
+void NetlinkBatch::queueBridgeVlans(int type, const std::string &dev, const std::set<uint16_t> &vids)
+{
+    std::vector<std::pair<uint16_t, uint16_t>> ranges;
+
+    for (auto vid : vids)
+    {
+        if (!ranges.empty() && ranges.back().second + 1 == vid)
+        {
+            ranges.back().second = vid;
+        }
+        else
+        {
+            ranges.emplace_back(vid, vid);
+        }
+    }
+
+    for (size_t i = 0; i < ranges.size(); i += NETLINK_BRIDGE_VLAN_RANGES)
+    {
+        std::vector<std::pair<uint16_t, uint16_t>> chunk(ranges.begin() + i,
+                ranges.begin() + std::min(ranges.size(), i + NETLINK_BRIDGE_VLAN_RANGES));
+
+        queue(std::string("bridge vlan ") + (type == RTM_SETLINK ? "add" : "del") +
+              " vid " + vlanRanges(chunk) + " dev " + dev,
+              [type, dev, chunk](struct nl_msg *msg, NetlinkBatch &batch) {
+            int index = batch.resolve(dev);
+            if (!index)
+            {
+                return -ENODEV;
+            }
+
+            struct ifinfomsg ifi;
+            memset(&ifi, 0, sizeof(ifi));
+            ifi.ifi_family = AF_BRIDGE;
+            ifi.ifi_index = index;
+
+            int err = putHeader(msg, type, 0, &ifi, sizeof(ifi));
+            if (err < 0)
+            {
+                return err;
+            }
+
+            struct nlattr *spec = nla_nest_start(msg, IFLA_AF_SPEC);
+            if (!spec)
+            {
+                return -ENOMEM;
+            }
+            for (const auto &range : chunk)
+            {
+                struct bridge_vlan_info vinfo;
+                memset(&vinfo, 0, sizeof(vinfo));
+                vinfo.vid = range.first;
+                if (range.second != range.first)
+                {
+                    vinfo.flags = BRIDGE_VLAN_INFO_RANGE_BEGIN;
+                }
+                if (nla_put(msg, IFLA_BRIDGE_VLAN_INFO, sizeof(vinfo), &vinfo) < 0)
+                {
+                    return -ENOMEM;
+                }
+                if (range.second != range.first)
+                {
+                    vinfo.vid = range.second;
+                    vinfo.flags = BRIDGE_VLAN_INFO_RANGE_END;
+                    if (nla_put(msg, IFLA_BRIDGE_VLAN_INFO, sizeof(vinfo), &vinfo) < 0)
+                    {
+                        return -ENOMEM;
+                    }
+                }
+            }
+            nla_nest_end(msg, spec);
+            return 0;
+        });
+    }
+}
+
+void NetlinkBatch::addBridgeVlans(const std::string &dev, const std::set<uint16_t> &vids)
+{
+    queueBridgeVlans(RTM_SETLINK, dev, vids);
+}
+
+void NetlinkBatch::delBridgeVlans(const std::string &dev, const std::set<uint16_t> &vids)
+{
+    queueBridgeVlans(RTM_DELLINK, dev, vids);
+}
+
+static int putNeighbor(struct nl_msg *msg, int type, int flags, int index, const IpAddress &ip)
+{
+    struct ndmsg ndm;
+    memset(&ndm, 0, sizeof(ndm));
+    ndm.ndm_family = ip.isV4() ? AF_INET : AF_INET6;
+    ndm.ndm_ifindex = index;
+    ndm.ndm_state = NUD_PERMANENT;
+
+    int err = putHeader(msg, type, flags, &ndm, sizeof(ndm));
+    if (err < 0)
+    {
+        return err;
+    }
+    return putAddress(msg, NDA_DST, ip);
+}
+
+void NetlinkBatch::setNeighbor(const std::string &dev, const IpAddress &ip, const MacAddress &mac)
+{
+    queue("neigh replace " + ip.to_string() + " lladdr " + mac.to_string() + " dev " + dev,
+          [dev, ip, mac](struct nl_msg *msg, NetlinkBatch &batch) {
+        int index = batch.resolve(dev);
+        if (!index)
+        {
+            return -ENODEV;
+        }
+        int err = putNeighbor(msg, RTM_NEWNEIGH, NLM_F_CREATE | NLM_F_REPLACE, index, ip);
+        if (err < 0)
+        {
+            return err;
+        }
+        return nla_put(msg, NDA_LLADDR, ETHER_ADDR_LEN, mac.getMac()) < 0 ? -ENOMEM : 0;
+    });
+}
+
+void NetlinkBatch::delNeighbor(const std::string &dev, const IpAddress &ip)
+{
+    queue("neigh del " + ip.to_string() + " dev " + dev,
+          [dev, ip](struct nl_msg *msg, NetlinkBatch &batch) {
+        int index = batch.resolve(dev);
+        if (!index)
+        {
+            return -ENODEV;
+        }
+        return putNeighbor(msg, RTM_DELNEIGH, 0, index, ip);
+    });
+}
+
+void NetlinkBatch::setError(size_t req, int err)
+{
+    const std::string &desc = m_requests[req].desc;
+
+    SWSS_LOG_INFO("Netlink request '%s' failed, error '%s'", desc.c_str(), strerror(err));
+
+    m_results[req] = err;
+    if (m_lastError.empty())
+    {
+        m_lastError = "'" + desc + "' failed: " + strerror(err);
+    }
+}
+
+bool NetlinkBatch::flush(std::vector<struct nl_msg *> &msgs, std::vector<size_t> &reqs)
+{
+    if (msgs.empty())
+    {
+        return true;
+    }
+
+    std::vector<uint8_t> buf;
+
+    for (auto *msg : msgs)
+    {
+        struct nlmsghdr *hdr = nlmsg_hdr(msg);
+        const uint8_t *data = reinterpret_cast<const uint8_t *>(hdr);
+        buf.insert(buf.end(), data, data + NLMSG_ALIGN(hdr->nlmsg_len));
+    }
+
+    AckState state = { nlmsg_hdr(msgs.front())->nlmsg_seq, 0, std::vector<int>(reqs.size(), -1) };
+    bool ok = true;
+
+    int err = nl_sendto(m_sock, buf.data(), buf.size());
+    if (err < 0)
+    {
+        SWSS_LOG_ERROR("Netlink send message failed, error '%s'", nl_geterror(err));
+        state.results.assign(reqs.size(), ECOMM);
+    }
+    else
+    {
+        struct nl_cb *cb = nl_cb_alloc(NL_CB_DEFAULT);
+        nl_cb_set(cb, NL_CB_SEQ_CHECK, NL_CB_CUSTOM, noSeqCheck, nullptr);
+        nl_cb_set(cb, NL_CB_ACK, NL_CB_CUSTOM, onAck, &state);
+        nl_cb_err(cb, NL_CB_CUSTOM, onError, &state);
+
+        while (state.acked < reqs.size())
+        {
+            int ready = waitReadable(m_sock);
+            if (ready <= 0 || (err = nl_recvmsgs(m_sock, cb)) < 0)
+            {
+                SWSS_LOG_ERROR("Netlink receive ack failed, error '%s'",
+                               ready == 0 ? "timed out" : ready < 0 ? strerror(errno) : nl_geterror(err));
+                break;
+            }
+        }
+        nl_cb_put(cb);
+    }
+
+    for (size_t i = 0; i < reqs.size(); i++)
+    {
+        /* Requests without an ack are reported as failed */
+        int result = state.results[i] < 0 ? ETIMEDOUT : state.results[i];
+        if (result != 0)
+        {
+            setError(reqs[i], result);
+            ok = false;
+        }
+        else
+        {
+            m_results[reqs[i]] = 0;
+        }
+    }
+
+    for (auto *msg : msgs)
+    {
+        nlmsg_free(msg);
+    }
+    msgs.clear();
+    reqs.clear();
+
+    return ok;
+}
+
+bool NetlinkBatch::commit(bool stopOnError)
+{
+    std::vector<struct nl_msg *> msgs;
+    std::vector<size_t> reqs;
+    bool ok = true;
+
+    m_lastError.clear();
+    m_results.assign(m_requests.size(), ECANCELED);
+
+    if (!m_sock)
+    {
+        for (size_t i = 0; i < m_requests.size(); i++)
+        {
+            setError(i, ENOTCONN);
+        }
+        ok = m_requests.empty();
+        m_requests.clear();
+        return ok;
+    }
+
+    for (size_t i = 0; i < m_requests.size() && (ok || !stopOnError); i++)
+    {
+        const auto &req = m_requests[i];
+
+        struct nl_msg *msg = nlmsg_alloc();
+        int err = msg ? req.build(msg, *this) : -ENOMEM;
+        if (err == -ENODEV && !msgs.empty())
+        {
+            /* The device may be created by a request that has not been sent yet */
+            nlmsg_free(msg);
+            ok = flush(msgs, reqs) && ok;
+            if (!ok && stopOnError)
+            {
+                break;
+            }
+            msg = nlmsg_alloc();
+            err = msg ? req.build(msg, *this) : -ENOMEM;
+        }
+
+        if (err < 0)
+        {
+            nlmsg_free(msg);
+            /* The requests queued before this one are still applied */
+            ok = flush(msgs, reqs) && ok;
+            if (ok || !stopOnError)
+            {
+                setError(i, -err);
+            }
+            ok = false;
+            continue;
+        }
+
+        struct nlmsghdr *hdr = nlmsg_hdr(msg);
+        hdr->nlmsg_flags |= NLM_F_REQUEST | NLM_F_ACK;
+        hdr->nlmsg_seq = ++m_seq;
+
+        msgs.push_back(msg);
+        reqs.push_back(i);
+
+        if (msgs.size() >= NETLINK_BATCH_WINDOW)
+        {
+            ok = flush(msgs, reqs) && ok;
+        }
+    }
+
+    ok = flush(msgs, reqs) && ok;
+
+    m_requests.clear();
+    return ok;
+}
+
+const std::string &NetlinkBatch::getLastError() const
+{
+    return m_lastError;
+}
+
+const std::vector<int> &NetlinkBatch::getResults() const
+{
+    return m_results;
+}
+
+size_t NetlinkBatch::size() const
+{
+    return m_requests.size();
+}
+
+bool NetlinkBatch::getBridgeVlans(const std::string &dev, std::set<uint16_t> &vlans)
+{
+    vlans.clear();
+
+    if (!m_sock)
+    {
+        return false;
+    }
+
+    int index = resolve(dev);
+    if (!index)
+    {
+        SWSS_LOG_ERROR("Netlink cannot find device %s", dev.c_str());
+        return false;
+    }
+
+    struct nl_msg *msg = nlmsg_alloc();
+    if (!msg)
+    {
+        return false;
+    }
+
+    struct ifinfomsg ifi;
+    memset(&ifi, 0, sizeof(ifi));
+    ifi.ifi_family = AF_BRIDGE;
+
+    int err = putHeader(msg, RTM_GETLINK, NLM_F_REQUEST | NLM_F_DUMP, &ifi, sizeof(ifi));
+    if (err < 0 || nla_put_u32(msg, IFLA_EXT_MASK, RTEXT_FILTER_BRVLAN) < 0)
+    {
+        nlmsg_free(msg);
+        return false;
+    }
+
+    err = nl_send_auto(m_sock, msg);
+    nlmsg_free(msg);
+    if (err < 0)
+    {
+        SWSS_LOG_ERROR("Netlink send message failed, error '%s'", nl_geterror(err));
+        return false;
+    }
+
+    if (waitReadable(m_sock) <= 0)
+    {
+        SWSS_LOG_ERROR("Netlink bridge vlan dump of %s timed out", dev.c_str());
+        return false;
+    }
+
+    BridgeVlanDump dump = { index, &vlans };
+    struct nl_cb *cb = nl_cb_alloc(NL_CB_DEFAULT);
+    nl_cb_set(cb, NL_CB_SEQ_CHECK, NL_CB_CUSTOM, noSeqCheck, nullptr);
+    nl_cb_set(cb, NL_CB_VALID, NL_CB_CUSTOM, onBridgeVlan, &dump);
+    err = nl_recvmsgs(m_sock, cb);
+    nl_cb_put(cb);
+
+    if (err < 0)
+    {
+        SWSS_LOG_ERROR("Netlink bridge vlan dump failed, error '%s'", nl_geterror(err));
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "ipaddress.h"
+#include "ipprefix.h"
+#include "macaddress.h"
+
+struct nl_sock;
+struct nl_msg;
+
+namespace swss {
+    /*
+     * Queue of rtnetlink requests that are sent to the kernel in batches.
+     *
+     * Each queued request carries NLM_F_ACK and is written back to back with
+     * its neighbours into a single datagram, so a commit costs one sendmsg()
+     * per window instead of one fork/exec of iproute2 per operation.
+     *
+     * commit() stops at the first failed request, like a chain of iproute2
+     * commands joined with &&: the requests queued after it are not sent.
+     * The kernel processes every message of a datagram independently, so
+     * the requests already written in the same window as the failed one are
+     * still applied. getResults() tells which requests were applied.
+     *
+     * Devices are referenced by name. Names are resolved to ifindex right
+     * before a request is sent, so a request may refer to a device created
+     * by an earlier request of the same batch.
+     */
+    class NetlinkBatch
+    {
+    public:
+        NetlinkBatch();
+        ~NetlinkBatch();
+
+        NetlinkBatch(const NetlinkBatch&) = delete;
+        NetlinkBatch& operator=(const NetlinkBatch&) = delete;
+
+        /* Links */
+        void addBridge(const std::string &name);
+        void addDummy(const std::string &name, uint32_t mtu = 0);
+        void addVlan(const std::string &name, const std::string &parent, uint16_t vlanId,
+                     const MacAddress &mac = MacAddress(), bool up = false);
+        void addVxlan(const std::string &name, uint32_t vni, const std::string &srcIp,
+                      const std::string &dstIp = "", const MacAddress &mac = MacAddress(),
+                      bool learning = true, uint16_t dstPort = 4789);
+        void delLink(const std::string &name);
+        void setAdminState(const std::string &name, bool up);
+        void setMtu(const std::string &name, uint32_t mtu);
+        void setMac(const std::string &name, const MacAddress &mac);
+        /* Empty master detaches the device from its current master */
+        void setMaster(const std::string &name, const std::string &master);
+
+        /* Addresses */
+        void addAddress(const std::string &dev, const IpPrefix &prefix, uint32_t metric = 0);
+        void delAddress(const std::string &dev, const IpPrefix &prefix);
+
+        /* Bridge VLANs, self applies the VLAN to the bridge device itself */
+        void addBridgeVlan(const std::string &dev, uint16_t vid, bool pvidUntagged = false, bool self = false);
+        void delBridgeVlan(const std::string &dev, uint16_t vid, bool self = false);
+        /* Tagged VLANs, contiguous VIDs are sent as ranges */
+        void addBridgeVlans(const std::string &dev, const std::set<uint16_t> &vids);
+        void delBridgeVlans(const std::string &dev, const std::set<uint16_t> &vids);
+
+        /* Neighbors */
+        void setNeighbor(const std::string &dev, const IpAddress &ip, const MacAddress &mac);
+        void delNeighbor(const std::string &dev, const IpAddress &ip);
+
+        /*
+         * Send all queued requests and wait for their acks. Returns false if
+         * any request failed, getLastError() then describes the first failure.
+         * With stopOnError false every request is sent regardless of the
+         * failures, for cleanups whose steps are independent of each other.
+         */
+        bool commit(bool stopOnError = true);
+        const std::string &getLastError() const;
+        /*
+         * Result of each request of the last commit(), in queue order: 0 if it
+         * was applied, otherwise the errno it failed with. Requests that were
+         * not sent because an earlier one failed are ECANCELED.
+         */
+        const std::vector<int> &getResults() const;
+        size_t size() const;
+
+        /* VLANs the bridge port dev is a member of */
+        bool getBridgeVlans(const std::string &dev, std::set<uint16_t> &vlans);
+
+    private:
+        typedef std::function<int (struct nl_msg *msg, NetlinkBatch &batch)> Builder;
+
+        struct Request
+        {
+            std::string desc;
+            Builder build;
+        };
+
+        struct nl_sock *m_sock = nullptr;
+        uint32_t m_seq = 0;
+        std::vector<Request> m_requests;
+        std::vector<int> m_results;
+        std::string m_lastError;
+
+        void queue(const std::string &desc, Builder build);
+        void queueBridgeVlans(int type, const std::string &dev, const std::set<uint16_t> &vids);
+        int resolve(const std::string &name);
+        bool flush(std::vector<struct nl_msg *> &msgs, std::vector<size_t> &reqs);
+        void setError(size_t req, int err);
+    };
+}
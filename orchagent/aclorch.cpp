@@ -2,6 +2,7 @@
 #include <limits.h>
 #include <unordered_map>
 #include <algorithm>
+#include <typeinfo>
 #include "aclorch.h"
 #include "logger.h"
 #include "schema.h"
@@ -28,6 +29,7 @@ extern sai_switch_api_t* sai_switch_api;
 extern sai_object_id_t   gSwitchId;
 extern PortsOrch*        gPortsOrch;
 extern CrmOrch *gCrmOrch;
+extern size_t gMaxBulkSize;
 
 #define MIN_VLAN_ID 1    // 0 is a reserved VLAN ID
 #define MAX_VLAN_ID 4095 // 4096 is a reserved VLAN ID
@@ -1020,11 +1022,23 @@ bool AclRule::createRule()
     SWSS_LOG_ENTER();
 
     vector<sai_attribute_t> rule_attrs;
-    sai_object_id_t range_objects[2];
-    sai_object_list_t range_object_list = {0, range_objects};
+    sai_status_t status;
+
+    if (!getRuleAttributes(rule_attrs))
+    {
+        return false;
+    }
+
+    status = sai_acl_api->create_acl_entry(&m_ruleOid, gSwitchId, (uint32_t)rule_attrs.size(), rule_attrs.data());
+
+    return processCreateRuleStatus(status);
+}
+
+bool AclRule::getRuleAttributes(vector<sai_attribute_t> &rule_attrs)
+{
+    SWSS_LOG_ENTER();
 
     sai_attribute_t attr;
-    sai_status_t status;
 
     // store table oid this rule belongs to
     attr.id = SAI_ACL_ENTRY_ATTR_TABLE_ID;
@@ -1048,6 +1062,7 @@ bool AclRule::createRule()
         rule_attrs.push_back(attr);
     }
 
+    m_rangeOids.clear();
     if (!m_rangeConfig.empty())
     {
         for (const auto& rangeConfig: m_rangeConfig)
@@ -1058,17 +1073,19 @@ bool AclRule::createRule()
             if (!range)
             {
                 // release already created range if any
-                AclRange::remove(range_objects, range_object_list.count);
+                AclRange::remove(m_rangeOids.data(), (int)m_rangeOids.size());
+                m_rangeOids.clear();
                 return false;
             }
 
             m_ranges.push_back(range);
-            range_objects[range_object_list.count++] = range->getOid();
+            m_rangeOids.push_back(range->getOid());
         }
 
         attr.id = SAI_ACL_ENTRY_ATTR_FIELD_ACL_RANGE_TYPE;
         attr.value.aclfield.enable = true;
-        attr.value.aclfield.data.objlist = range_object_list;
+        attr.value.aclfield.data.objlist.count = (uint32_t)m_rangeOids.size();
+        attr.value.aclfield.data.objlist.list = m_rangeOids.data();
         rule_attrs.push_back(attr);
     }
 
@@ -1086,21 +1103,89 @@ bool AclRule::createRule()
         rule_attrs.push_back(attr);
     }
 
-    status = sai_acl_api->create_acl_entry(&m_ruleOid, gSwitchId, (uint32_t)rule_attrs.size(), rule_attrs.data());
+    return true;
+}
+
+bool AclRule::processCreateRuleStatus(sai_status_t status)
+{
+    SWSS_LOG_ENTER();
+
     if (status != SAI_STATUS_SUCCESS)
     {
         SWSS_LOG_ERROR("Failed to create ACL rule %s, rv:%d",
                 m_id.c_str(), status);
-        AclRange::remove(range_objects, range_object_list.count);
+        AclRange::remove(m_rangeOids.data(), (int)m_rangeOids.size());
+        m_rangeOids.clear();
         decreaseNextHopRefCount();
+        return false;
     }
 
-    if (status == SAI_STATUS_SUCCESS)
+    m_rangeOids.clear();
+    gCrmOrch->incCrmAclTableUsedCounter(CrmResourceType::CRM_ACL_ENTRY, m_pTable->getOid());
+
+    return true;
+}
+
+bool AclRule::bulkCreateCounter(ObjectBulker<sai_acl_api_t> &bulker)
+{
+    SWSS_LOG_ENTER();
+
+    if (!m_createCounter || m_counterOid != SAI_NULL_OBJECT_ID)
+    {
+        return true;
+    }
+
+    vector<sai_attribute_t> counter_attrs;
+    getCounterAttributes(counter_attrs);
+
+    bulker.create_entry(&m_counterOid, (uint32_t)counter_attrs.size(), counter_attrs.data());
+    m_bulkCounter = true;
+
+    return true;
+}
+
+bool AclRule::bulkCreateRule(ObjectBulker<sai_acl_api_t> &bulker)
+{
+    SWSS_LOG_ENTER();
+
+    if (m_bulkCounter)
+    {
+        m_bulkCounter = false;
+
+        if (m_counterOid == SAI_NULL_OBJECT_ID)
+        {
+            SWSS_LOG_ERROR("Failed to create counter for the rule %s in table %s", m_id.c_str(), m_pTable->getId().c_str());
+            return false;
+        }
+
+        gCrmOrch->incCrmAclTableUsedCounter(CrmResourceType::CRM_ACL_COUNTER, m_pTable->getOid());
+
+        SWSS_LOG_INFO("Created counter for the rule %s in table %s", m_id.c_str(), m_pTable->getId().c_str());
+    }
+
+    vector<sai_attribute_t> rule_attrs;
+    if (!getRuleAttributes(rule_attrs))
+    {
+        removeCounter();
+        return false;
+    }
+
+    bulker.create_entry(&m_ruleOid, (uint32_t)rule_attrs.size(), rule_attrs.data());
+
+    return true;
+}
+
+bool AclRule::bulkCreateDone()
+{
+    SWSS_LOG_ENTER();
+
+    if (!processCreateRuleStatus(m_ruleOid != SAI_NULL_OBJECT_ID ? SAI_STATUS_SUCCESS : SAI_STATUS_FAILURE))
     {
-        gCrmOrch->incCrmAclTableUsedCounter(CrmResourceType::CRM_ACL_ENTRY, m_pTable->getOid());
+        removeCounter();
+        return false;
     }
 
-    return (status == SAI_STATUS_SUCCESS);
+    return true;
 }
 
 void AclRule::decreaseNextHopRefCount()
@@ -1226,8 +1311,46 @@ bool AclRule::update(const AclRule& updatedRule)
     return true;
 }
 
+bool AclRule::updateInPlace(AclRule& newRule)
+{
+    SWSS_LOG_ENTER();
+
+    // A rule that changes its type, or whose type can't be updated, is recreated instead
+    if (typeid(*this) != typeid(newRule) || !isInPlaceUpdateSupported())
+    {
+        return false;
+    }
+
+    // Range objects are shared between rules and are not updated in place, the rule is recreated instead
+    if (!m_rangeConfig.empty() || !newRule.m_rangeConfig.empty())
+    {
+        return false;
+    }
+
+    if (!update(newRule))
+    {
+        return false;
+    }
+
+    // The new rule referenced its redirect targets when its actions were validated,
+    // those references now belong to the installed rule
+    decreaseNextHopRefCount();
+    m_redirect_target_next_hop = newRule.m_redirect_target_next_hop;
+    m_redirect_target_next_hop_group = newRule.m_redirect_target_next_hop_group;
+    newRule.m_redirect_target_next_hop.clear();
+    newRule.m_redirect_target_next_hop_group.clear();
+
+    return true;
+}
+
 bool AclRule::updateCounter(const AclRule& updatedRule)
 {
+    if (updatedRule.m_createCounter == hasCounter())
+    {
+        m_createCounter = updatedRule.m_createCounter;
+        return true;
+    }
+
     if (updatedRule.m_createCounter)
     {
         if (!enableCounter())
@@ -1627,7 +1750,6 @@ bool AclRule::createCounter()
 {
     SWSS_LOG_ENTER();
 
-    sai_attribute_t attr;
     vector<sai_attribute_t> counter_attrs;
 
     if (m_counterOid != SAI_NULL_OBJECT_ID)
@@ -1635,16 +1757,7 @@ bool AclRule::createCounter()
         return true;
     }
 
-    attr.id = SAI_ACL_COUNTER_ATTR_TABLE_ID;
-    attr.value.oid = m_pTable->getOid();
-    counter_attrs.push_back(attr);
-
-    for (const auto& counterAttrPair: aclCounterLookup)
-    {
-        tie(attr.id, std::ignore) = counterAttrPair;
-        attr.value.booldata = true;
-        counter_attrs.push_back(attr);
-    }
+    getCounterAttributes(counter_attrs);
 
     if (sai_acl_api->create_acl_counter(&m_counterOid, gSwitchId, (uint32_t)counter_attrs.size(), counter_attrs.data()) != SAI_STATUS_SUCCESS)
     {
@@ -1659,6 +1772,22 @@ bool AclRule::createCounter()
     return true;
 }
 
+void AclRule::getCounterAttributes(vector<sai_attribute_t> &counter_attrs)
+{
+    sai_attribute_t attr;
+
+    attr.id = SAI_ACL_COUNTER_ATTR_TABLE_ID;
+    attr.value.oid = m_pTable->getOid();
+    counter_attrs.push_back(attr);
+
+    for (const auto& counterAttrPair: aclCounterLookup)
+    {
+        tie(attr.id, std::ignore) = counterAttrPair;
+        attr.value.booldata = true;
+        counter_attrs.push_back(attr);
+    }
+}
+
 bool AclRule::removeRanges()
 {
     SWSS_LOG_ENTER();
@@ -2028,7 +2157,7 @@ bool AclRuleMirror::update(const AclRule& rule)
         return false;
     }
 
-    SWSS_LOG_ERROR("Updating mirror rule is currently not implemented");
+    // Mirror rules are replaced rather than updated, see isInPlaceUpdateSupported()
     return false;
 }
 
@@ -2824,7 +2953,7 @@ bool AclRuleDTelWatchListEntry::update(const AclRule& rule)
         return false;
     }
 
-    SWSS_LOG_ERROR("Updating DTEL watch list rule is currently not implemented");
+    // DTEL watch list rules are replaced rather than updated, see isInPlaceUpdateSupported()
     return false;
 }
 
@@ -3928,6 +4057,96 @@ bool AclOrch::addAclRule(shared_ptr<AclRule> newRule, string table_id)
     return true;
 }
 
+bool AclOrch::addAclRules(vector<AclRuleBulkContext> &contexts)
+{
+    SWSS_LOG_ENTER();
+
+    ObjectBulker<sai_acl_api_t> counterBulker(sai_acl_api, SAI_OBJECT_TYPE_ACL_COUNTER, gSwitchId, gMaxBulkSize);
+    ObjectBulker<sai_acl_api_t> ruleBulker(sai_acl_api, SAI_OBJECT_TYPE_ACL_ENTRY, gSwitchId, gMaxBulkSize);
+    vector<AclRuleBulkContext*> queued;
+    bool success = true;
+
+    for (auto &ctx : contexts)
+    {
+        ctx.success = false;
+
+        sai_object_id_t table_oid = getTableById(ctx.table_id);
+        if (table_oid == SAI_NULL_OBJECT_ID)
+        {
+            SWSS_LOG_ERROR("Failed to add ACL rule in ACL table %s. Table doesn't exist", ctx.table_id.c_str());
+            success = false;
+            continue;
+        }
+
+        auto &rules = m_AclTables[table_oid].rules;
+        auto ruleIter = rules.find(ctx.rule->getId());
+        if (ruleIter != rules.end())
+        {
+            // Update the installed entry so it keeps its counter, recreate it only if that is not possible
+            if (ruleIter->second->updateInPlace(*ctx.rule))
+            {
+                SWSS_LOG_NOTICE("Successfully updated ACL rule %s in table %s",
+                        ctx.rule->getId().c_str(), ctx.table_id.c_str());
+                ctx.success = true;
+                continue;
+            }
+
+            if (ruleIter->second->remove())
+            {
+                rules.erase(ruleIter);
+                SWSS_LOG_NOTICE("Successfully deleted ACL rule %s in table %s",
+                        ctx.rule->getId().c_str(), ctx.table_id.c_str());
+            }
+        }
+
+        ctx.rule->bulkCreateCounter(counterBulker);
+        queued.push_back(&ctx);
+    }
+
+    counterBulker.flush();
+
+    auto it = queued.begin();
+    while (it != queued.end())
+    {
+        if ((*it)->rule->bulkCreateRule(ruleBulker))
+        {
+            it++;
+            continue;
+        }
+
+        SWSS_LOG_ERROR("Failed to create ACL rule %s in table %s",
+                (*it)->rule->getId().c_str(), (*it)->table_id.c_str());
+        success = false;
+        it = queued.erase(it);
+    }
+
+    ruleBulker.flush();
+
+    for (auto ctx : queued)
+    {
+        if (!ctx->rule->bulkCreateDone())
+        {
+            SWSS_LOG_ERROR("Failed to create ACL rule %s in table %s",
+                    ctx->rule->getId().c_str(), ctx->table_id.c_str());
+            success = false;
+            continue;
+        }
+
+        m_AclTables[getTableById(ctx->table_id)].rules[ctx->rule->getId()] = ctx->rule;
+        SWSS_LOG_NOTICE("Successfully created ACL rule %s in table %s",
+                ctx->rule->getId().c_str(), ctx->table_id.c_str());
+
+        if (ctx->rule->hasCounter())
+        {
+            registerFlexCounter(*ctx->rule);
+        }
+
+        ctx->success = true;
+    }
+
+    return success;
+}
+
 bool AclOrch::removeAclRule(string table_id, string rule_id)
 {
     sai_object_id_t table_oid = getTableById(table_id);
@@ -4325,6 +4544,10 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
 {
     SWSS_LOG_ENTER();
 
+    // Rules created through the bulkers, with the m_toSync entries they come from
+    vector<AclRuleBulkContext> bulkRules;
+    vector<decltype(consumer.m_toSync.begin())> bulkIters;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -4385,7 +4608,7 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
             {
                 SWSS_LOG_ERROR("Error while creating ACL rule %s: %s", rule_id.c_str(), e.what());
                 it = consumer.m_toSync.erase(it);
-                return;
+                continue;
             }
             bool bHasTCPFlag = false;
             bool bHasIPProtocol = false;
@@ -4450,7 +4673,12 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
             // validate and create ACL rule
             if (bAllAttributesOk && newRule->validate())
             {
-                if (addAclRule(newRule, table_id))
+                if (newRule->isBulkCreateSupported())
+                {
+                    bulkRules.push_back({newRule, table_id});
+                    bulkIters.push_back(it++);
+                }
+                else if (addAclRule(newRule, table_id))
                     it = consumer.m_toSync.erase(it);
                 else
                     it++;
@@ -4474,6 +4702,22 @@ void AclOrch::doAclRuleTask(Consumer &consumer)
             SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
         }
     }
+
+    if (bulkRules.empty())
+    {
+        return;
+    }
+
+    addAclRules(bulkRules);
+
+    // Failed rules stay in m_toSync and are retried on the next drain
+    for (size_t i = 0; i < bulkRules.size(); i++)
+    {
+        if (bulkRules[i].success)
+        {
+            consumer.m_toSync.erase(bulkIters[i]);
+        }
+    }
 }
 
 void AclOrch::doAclTableTypeTask(Consumer &consumer)
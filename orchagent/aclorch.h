@@ -16,6 +16,7 @@
 #include "dtelorch.h"
 #include "observer.h"
 #include "flex_counter_manager.h"
+#include "bulker.h"
 
 #include "acltable.h"
 
@@ -250,6 +251,9 @@ public:
 
     virtual bool create();
     virtual bool update(const AclRule& updatedRule);
+    // Whether update() can apply a rule of the same type to the installed entry
+    virtual bool isInPlaceUpdateSupported() const { return true; }
+    bool updateInPlace(AclRule& newRule);
     virtual bool remove();
     virtual void onUpdate(SubjectType, void *) = 0;
     virtual void updateInPorts();
@@ -266,6 +270,13 @@ public:
     bool getCreateCounter() const;
 
     const vector<AclRangeConfig>& getRangeConfig() const;
+
+    // Bulk creation: counters of all rules are queued and flushed first, then the rules
+    virtual bool isBulkCreateSupported() const { return true; }
+    bool bulkCreateCounter(ObjectBulker<sai_acl_api_t> &bulker);
+    bool bulkCreateRule(ObjectBulker<sai_acl_api_t> &bulker);
+    bool bulkCreateDone();
+
     static shared_ptr<AclRule> makeShared(AclOrch *acl, MirrorOrch *mirror, DTelOrch *dtel, const string& rule, const string& table, const KeyOpFieldsValuesTuple&);
     virtual ~AclRule() {}
 
@@ -276,6 +287,10 @@ protected:
     virtual bool removeRanges();
     virtual bool removeRule();
 
+    void getCounterAttributes(vector<sai_attribute_t> &counter_attrs);
+    bool getRuleAttributes(vector<sai_attribute_t> &rule_attrs);
+    bool processCreateRuleStatus(sai_status_t status);
+
     virtual bool updatePriority(const AclRule& updatedRule);
     virtual bool updateMatches(const AclRule& updatedRule);
     virtual bool updateActions(const AclRule& updatedRule);
@@ -306,9 +321,12 @@ protected:
 
     vector<AclRangeConfig> m_rangeConfig;
     vector<AclRange*> m_ranges;
+    // Range list referenced by the rule attributes until the rule is created
+    vector<sai_object_id_t> m_rangeOids;
 
 private:
     bool m_createCounter;
+    bool m_bulkCounter {false};
 };
 
 class AclRulePacket: public AclRule
@@ -333,6 +351,8 @@ public:
     bool createRule();
     bool removeRule();
     void onUpdate(SubjectType, void *) override;
+    bool isBulkCreateSupported() const override { return false; }
+    bool isInPlaceUpdateSupported() const override { return false; }
 
     bool activate();
     bool deactivate();
@@ -353,6 +373,8 @@ public:
     bool createRule();
     bool removeRule();
     void onUpdate(SubjectType, void *) override;
+    bool isBulkCreateSupported() const override { return false; }
+    bool isInPlaceUpdateSupported() const override { return false; }
 
     bool activate();
     bool deactivate();
@@ -444,6 +466,13 @@ private:
     AclOrch *m_pAclOrch = nullptr;
 };
 
+struct AclRuleBulkContext
+{
+    shared_ptr<AclRule> rule;
+    string table_id;
+    bool success = false;
+};
+
 class AclOrch : public Orch, public Observer
 {
 public:
@@ -480,6 +509,7 @@ public:
     bool updateAclTable(AclTable &currentTable, AclTable &newTable);
     bool updateAclTable(string table_id, AclTable &table);
     bool addAclRule(shared_ptr<AclRule> aclRule, string table_id);
+    bool addAclRules(vector<AclRuleBulkContext> &contexts);
     bool removeAclRule(string table_id, string rule_id);
     bool updateAclRule(shared_ptr<AclRule> updatedAclRule);
     bool updateAclRule(string table_id, string rule_id, string attr_name, void *data, bool oper);
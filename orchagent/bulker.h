@@ -2,6 +2,7 @@
 
 #include <assert.h>
 #include <vector>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <stdexcept>
@@ -33,6 +34,24 @@ static inline bool operator==(const sai_ip_prefix_t& a, const sai_ip_prefix_t& b
     }
 }
 
+static inline bool operator==(const sai_ip_address_t& a, const sai_ip_address_t& b)
+{
+    if (a.addr_family != b.addr_family) return false;
+
+    if (a.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+    {
+        return a.addr.ip4 == b.addr.ip4;
+    }
+    else if (a.addr_family == SAI_IP_ADDR_FAMILY_IPV6)
+    {
+        return memcmp(a.addr.ip6, b.addr.ip6, sizeof(a.addr.ip6)) == 0;
+    }
+    else
+    {
+        throw std::invalid_argument("a has invalid addr_family");
+    }
+}
+
 static inline bool operator==(const sai_route_entry_t& a, const sai_route_entry_t& b)
 {
     return a.switch_id == b.switch_id
@@ -48,6 +67,52 @@ static inline bool operator==(const sai_inseg_entry_t& a, const sai_inseg_entry_
         ;
 }
 
+static inline bool operator==(const sai_fdb_entry_t& a, const sai_fdb_entry_t& b)
+{
+    return a.switch_id == b.switch_id
+        && memcmp(a.mac_address, b.mac_address, sizeof(a.mac_address)) == 0
+        && a.bv_id == b.bv_id
+        ;
+}
+
+static inline bool operator==(const sai_neighbor_entry_t& a, const sai_neighbor_entry_t& b)
+{
+    return a.switch_id == b.switch_id
+        && a.rif_id == b.rif_id
+        && a.ip_address == b.ip_address
+        ;
+}
+
+static inline bool operator==(const sai_nat_entry_key_t& a, const sai_nat_entry_key_t& b)
+{
+    return a.src_ip == b.src_ip
+        && a.dst_ip == b.dst_ip
+        && a.proto == b.proto
+        && a.l4_src_port == b.l4_src_port
+        && a.l4_dst_port == b.l4_dst_port
+        ;
+}
+
+static inline bool operator==(const sai_nat_entry_mask_t& a, const sai_nat_entry_mask_t& b)
+{
+    return a.src_ip == b.src_ip
+        && a.dst_ip == b.dst_ip
+        && a.proto == b.proto
+        && a.l4_src_port == b.l4_src_port
+        && a.l4_dst_port == b.l4_dst_port
+        ;
+}
+
+static inline bool operator==(const sai_nat_entry_t& a, const sai_nat_entry_t& b)
+{
+    return a.switch_id == b.switch_id
+        && a.vr_id == b.vr_id
+        && a.nat_type == b.nat_type
+        && a.data.key == b.data.key
+        && a.data.mask == b.data.mask
+        ;
+}
+
 static inline std::size_t hash_value(const sai_ip_prefix_t& a)
 {
     size_t seed = 0;
@@ -65,6 +130,21 @@ static inline std::size_t hash_value(const sai_ip_prefix_t& a)
     return seed;
 }
 
+static inline std::size_t hash_value(const sai_ip_address_t& a)
+{
+    size_t seed = 0;
+    boost::hash_combine(seed, a.addr_family);
+    if (a.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+    {
+        boost::hash_combine(seed, a.addr.ip4);
+    }
+    else if (a.addr_family == SAI_IP_ADDR_FAMILY_IPV6)
+    {
+        boost::hash_combine(seed, a.addr.ip6);
+    }
+    return seed;
+}
+
 namespace std
 {
     template <>
@@ -93,6 +173,19 @@ namespace std
         }
     };
 
+    template <>
+    struct hash<sai_neighbor_entry_t>
+    {
+        size_t operator()(const sai_neighbor_entry_t& a) const noexcept
+        {
+            size_t seed = 0;
+            boost::hash_combine(seed, a.switch_id);
+            boost::hash_combine(seed, a.rif_id);
+            boost::hash_combine(seed, a.ip_address);
+            return seed;
+        }
+    };
+
     template <>
     struct hash<sai_inseg_entry_t>
     {
@@ -104,6 +197,24 @@ namespace std
             return seed;
         }
     };
+
+    template <>
+    struct hash<sai_nat_entry_t>
+    {
+        size_t operator()(const sai_nat_entry_t& a) const noexcept
+        {
+            size_t seed = 0;
+            boost::hash_combine(seed, a.switch_id);
+            boost::hash_combine(seed, a.vr_id);
+            boost::hash_combine(seed, a.nat_type);
+            boost::hash_combine(seed, a.data.key.src_ip);
+            boost::hash_combine(seed, a.data.key.dst_ip);
+            boost::hash_combine(seed, a.data.key.proto);
+            boost::hash_combine(seed, a.data.key.l4_src_port);
+            boost::hash_combine(seed, a.data.key.l4_dst_port);
+            return seed;
+        }
+    };
 }
 
 // SAI typedef which is not available in SAI 1.5
@@ -156,6 +267,19 @@ struct SaiBulkerTraits<sai_fdb_api_t>
     using bulk_set_entry_attribute_fn = sai_bulk_set_fdb_entry_attribute_fn;
 };
 
+template<>
+struct SaiBulkerTraits<sai_neighbor_api_t>
+{
+    using entry_t = sai_neighbor_entry_t;
+    using api_t = sai_neighbor_api_t;
+    using create_entry_fn = sai_create_neighbor_entry_fn;
+    using remove_entry_fn = sai_remove_neighbor_entry_fn;
+    using set_entry_attribute_fn = sai_set_neighbor_entry_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_create_neighbor_entry_fn;
+    using bulk_remove_entry_fn = sai_bulk_remove_neighbor_entry_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_set_neighbor_entry_attribute_fn;
+};
+
 template<>
 struct SaiBulkerTraits<sai_next_hop_group_api_t>
 {
@@ -170,6 +294,18 @@ struct SaiBulkerTraits<sai_next_hop_group_api_t>
     //using bulk_set_entry_attribute_fn = sai_bulk_object_set_attribute_fn;
 };
 
+template<>
+struct SaiBulkerTraits<sai_next_hop_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_next_hop_api_t;
+    using create_entry_fn = sai_create_next_hop_fn;
+    using remove_entry_fn = sai_remove_next_hop_fn;
+    using set_entry_attribute_fn = sai_set_next_hop_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+};
+
 template<>
 struct SaiBulkerTraits<sai_mpls_api_t>
 {
@@ -183,6 +319,31 @@ struct SaiBulkerTraits<sai_mpls_api_t>
     using bulk_set_entry_attribute_fn = sai_bulk_set_inseg_entry_attribute_fn;
 };
 
+template<>
+struct SaiBulkerTraits<sai_nat_api_t>
+{
+    using entry_t = sai_nat_entry_t;
+    using api_t = sai_nat_api_t;
+    using create_entry_fn = sai_create_nat_entry_fn;
+    using remove_entry_fn = sai_remove_nat_entry_fn;
+    using set_entry_attribute_fn = sai_set_nat_entry_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_create_nat_entry_fn;
+    using bulk_remove_entry_fn = sai_bulk_remove_nat_entry_fn;
+    using bulk_set_entry_attribute_fn = sai_bulk_set_nat_entry_attribute_fn;
+};
+
+template<>
+struct SaiBulkerTraits<sai_acl_api_t>
+{
+    using entry_t = sai_object_id_t;
+    using api_t = sai_acl_api_t;
+    using create_entry_fn = sai_create_acl_entry_fn;
+    using remove_entry_fn = sai_remove_acl_entry_fn;
+    using set_entry_attribute_fn = sai_set_acl_entry_attribute_fn;
+    using bulk_create_entry_fn = sai_bulk_object_create_fn;
+    using bulk_remove_entry_fn = sai_bulk_object_remove_fn;
+};
+
 template <typename T>
 class EntityBulker
 {
@@ -578,13 +739,18 @@ template <>
 inline EntityBulker<sai_fdb_api_t>::EntityBulker(sai_fdb_api_t *api, size_t max_bulk_size) :
     max_bulk_size(max_bulk_size)
 {
-    // TODO: implement after create_fdb_entries() is available in SAI
-    throw std::logic_error("Not implemented");
-    /*
     create_entries = api->create_fdb_entries;
     remove_entries = api->remove_fdb_entries;
     set_entries_attribute = api->set_fdb_entries_attribute;
-    */
+}
+
+template <>
+inline EntityBulker<sai_neighbor_api_t>::EntityBulker(sai_neighbor_api_t *api, size_t max_bulk_size) :
+    max_bulk_size(max_bulk_size)
+{
+    create_entries = api->create_neighbor_entries;
+    remove_entries = api->remove_neighbor_entries;
+    set_entries_attribute = api->set_neighbor_entries_attribute;
 }
 
 template <>
@@ -596,6 +762,15 @@ inline EntityBulker<sai_mpls_api_t>::EntityBulker(sai_mpls_api_t *api, size_t ma
     set_entries_attribute = api->set_inseg_entries_attribute;
 }
 
+template <>
+inline EntityBulker<sai_nat_api_t>::EntityBulker(sai_nat_api_t *api, size_t max_bulk_size) :
+    max_bulk_size(max_bulk_size)
+{
+    create_entries = api->create_nat_entries;
+    remove_entries = api->remove_nat_entries;
+    set_entries_attribute = api->set_nat_entries_attribute;
+}
+
 template <typename T>
 class ObjectBulker
 {
@@ -608,22 +783,43 @@ public:
         throw std::logic_error("Not implemented");
     }
 
+    /* For APIs that own several object types, object_type selects the one this bulker creates */
+    ObjectBulker(typename Ts::api_t* api, sai_object_type_t object_type, sai_object_id_t switch_id, size_t max_bulk_size) :
+        max_bulk_size(max_bulk_size)
+    {
+        throw std::logic_error("Not implemented");
+    }
+
     sai_status_t create_entry(
         _Out_ sai_object_id_t *object_id,
         _In_ uint32_t attr_count,
         _In_ const sai_attribute_t *attr_list)
+    {
+        return create_entry(object_id, nullptr, attr_count, attr_list);
+    }
+
+    /* object_status, if not null, receives the status of this object when the bulker is flushed */
+    sai_status_t create_entry(
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_status,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
     {
         assert(object_id);
         if (!object_id) throw std::invalid_argument("object_id is null");
         assert(attr_list);
         if (!attr_list) throw std::invalid_argument("attr_list is null");
 
-        creating_entries.emplace_back(std::piecewise_construct, std::forward_as_tuple(object_id), std::forward_as_tuple(attr_list, attr_list + attr_count));
+        creating_entries.emplace_back(object_id, object_status, std::vector<sai_attribute_t>(attr_list, attr_list + attr_count));
 
-        auto& last_attrs = std::get<1>(creating_entries.back());
+        auto& last_attrs = std::get<2>(creating_entries.back());
         SWSS_LOG_INFO("ObjectBulker.create_entry %zu, %zu, %u\n", creating_entries.size(), last_attrs.size(), last_attrs[0].id);
 
         *object_id = SAI_NULL_OBJECT_ID; // not created immediately, postponed until flush
+        if (object_status)
+        {
+            *object_status = SAI_STATUS_NOT_EXECUTED;
+        }
         return SAI_STATUS_NOT_EXECUTED;
     }
 
@@ -700,26 +896,28 @@ public:
         if (!creating_entries.empty())
         {
             std::vector<sai_object_id_t *> rs;
+            std::vector<sai_status_t *> ss;
             std::vector<sai_attribute_t const*> tss;
             std::vector<uint32_t> cs;
 
             for (auto const& i: creating_entries)
             {
                 sai_object_id_t *pid = std::get<0>(i);
-                auto const& attrs = std::get<1>(i);
+                auto const& attrs = std::get<2>(i);
                 if (*pid == SAI_NULL_OBJECT_ID)
                 {
                     rs.push_back(pid);
+                    ss.push_back(std::get<1>(i));
                     tss.push_back(attrs.data());
                     cs.push_back((uint32_t)attrs.size());
 
                     if (rs.size() >= max_bulk_size)
                     {
-                        flush_creating_entries(rs, tss, cs);
+                        flush_creating_entries(rs, ss, tss, cs);
                     }
                 }
             }
-            flush_creating_entries(rs, tss, cs);
+            flush_creating_entries(rs, ss, tss, cs);
 
             creating_entries.clear();
         }
@@ -793,8 +991,11 @@ private:
 
     size_t max_bulk_size;
 
-    std::vector<std::pair<                                  // A vector of pair of
+    sai_bulk_op_error_mode_t error_mode = SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR;
+
+    std::vector<std::tuple<                                 // A vector of tuple of
             sai_object_id_t *,                              // - object_id
+            sai_status_t *,                                 // - OUT object_status, may be null
             std::vector<sai_attribute_t>                    // - attrs
     >>                                                      creating_entries;
 
@@ -824,7 +1025,7 @@ private:
         }
         size_t count = rs.size();
         std::vector<sai_status_t> statuses(count);
-        sai_status_t status = (*remove_entries)((uint32_t)count, rs.data(), SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, statuses.data());
+        sai_status_t status = (*remove_entries)((uint32_t)count, rs.data(), error_mode, statuses.data());
         if (status == SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_INFO("ObjectBulker.flush removing_entries %zu rc=%d statuses[0]=%d\n", removing_entries.size(), status, statuses[0]);
@@ -849,6 +1050,7 @@ private:
 
     sai_status_t flush_creating_entries(
         _Inout_ std::vector<sai_object_id_t *> &rs,
+        _Inout_ std::vector<sai_status_t *> &ss,
         _Inout_ std::vector<sai_attribute_t const*> &tss,
         _Inout_ std::vector<uint32_t> &cs)
     {
@@ -860,7 +1062,7 @@ private:
         std::vector<sai_object_id_t> object_ids(count);
         std::vector<sai_status_t> statuses(count);
         sai_status_t status = (*create_entries)(switch_id, (uint32_t)count, cs.data(), tss.data()
-            , SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, object_ids.data(), statuses.data());
+            , error_mode, object_ids.data(), statuses.data());
         if (status == SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_INFO("ObjectBulker.flush creating_entries %zu\n", count);
@@ -875,9 +1077,14 @@ private:
         {
             sai_object_id_t *pid = rs[i];
             *pid = (statuses[i] == SAI_STATUS_SUCCESS) ? object_ids[i] : SAI_NULL_OBJECT_ID;
+            if (ss[i])
+            {
+                *ss[i] = statuses[i];
+            }
         }
 
         rs.clear();
+        ss.clear();
         tss.clear();
         cs.clear();
 
@@ -897,7 +1104,7 @@ private:
         size_t count = rs.size();
         std::vector<sai_status_t> statuses(count);
         sai_status_t status = (*set_entries_attribute)((uint32_t)count, rs.data(), ts.data()
-            , SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR, statuses.data());
+            , error_mode, statuses.data());
         if (status == SAI_STATUS_SUCCESS)
         {
             SWSS_LOG_INFO("ObjectBulker.flush setting_entries %zu\n", count);
@@ -926,3 +1133,153 @@ inline ObjectBulker<sai_next_hop_group_api_t>::ObjectBulker(SaiBulkerTraits<sai_
     // TODO: wait until available in SAI
     //set_entries_attribute = ;
 }
+
+template <>
+inline ObjectBulker<sai_next_hop_api_t>::ObjectBulker(SaiBulkerTraits<sai_next_hop_api_t>::api_t *api, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    create_entries = api->create_next_hops;
+    remove_entries = api->remove_next_hops;
+}
+
+extern sai_acl_api_t *sai_acl_api;
+
+/*
+ * sai_acl_api_t has no bulk entry points, ACL counters and entries are created
+ * and removed through the generic SAI bulk object API. If the SAI does not
+ * implement it for the object type, this is remembered and the objects are
+ * created and removed one by one through sai_acl_api_t instead.
+ */
+template <sai_object_type_t object_type>
+inline bool &acl_bulk_supported()
+{
+    static bool supported = true;
+    return supported;
+}
+
+template <sai_object_type_t object_type>
+static inline bool acl_bulk_fallback(sai_status_t status)
+{
+    if (status != SAI_STATUS_NOT_IMPLEMENTED && status != SAI_STATUS_NOT_SUPPORTED)
+    {
+        return false;
+    }
+
+    SWSS_LOG_NOTICE("Bulk API is not supported for %s, falling back to per object calls",
+                    sai_serialize_object_type(object_type).c_str());
+    acl_bulk_supported<object_type>() = false;
+    return true;
+}
+
+template <sai_object_type_t object_type>
+static inline sai_status_t acl_bulk_create(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_statuses)
+{
+    if (acl_bulk_supported<object_type>())
+    {
+        sai_status_t status = sai_bulk_object_create(switch_id, object_type, object_count, attr_count, attr_list,
+                                                     mode, object_id, object_statuses);
+        if (!acl_bulk_fallback<object_type>(status))
+        {
+            return status;
+        }
+    }
+
+    sai_status_t status = SAI_STATUS_SUCCESS;
+    for (uint32_t i = 0; i < object_count; i++)
+    {
+        if (status != SAI_STATUS_SUCCESS && mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR)
+        {
+            object_id[i] = SAI_NULL_OBJECT_ID;
+            object_statuses[i] = SAI_STATUS_NOT_EXECUTED;
+            continue;
+        }
+
+        if (object_type == SAI_OBJECT_TYPE_ACL_ENTRY)
+        {
+            object_statuses[i] = sai_acl_api->create_acl_entry(&object_id[i], switch_id, attr_count[i], attr_list[i]);
+        }
+        else
+        {
+            object_statuses[i] = sai_acl_api->create_acl_counter(&object_id[i], switch_id, attr_count[i], attr_list[i]);
+        }
+
+        if (object_statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            status = SAI_STATUS_FAILURE;
+        }
+    }
+    return status;
+}
+
+template <sai_object_type_t object_type>
+static inline sai_status_t acl_bulk_remove(
+        _In_ uint32_t object_count,
+        _In_ const sai_object_id_t *object_id,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+{
+    if (acl_bulk_supported<object_type>())
+    {
+        sai_status_t status = sai_bulk_object_remove(object_type, object_count, object_id, mode, object_statuses);
+        if (!acl_bulk_fallback<object_type>(status))
+        {
+            return status;
+        }
+    }
+
+    sai_status_t status = SAI_STATUS_SUCCESS;
+    for (uint32_t i = 0; i < object_count; i++)
+    {
+        if (status != SAI_STATUS_SUCCESS && mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR)
+        {
+            object_statuses[i] = SAI_STATUS_NOT_EXECUTED;
+            continue;
+        }
+
+        if (object_type == SAI_OBJECT_TYPE_ACL_ENTRY)
+        {
+            object_statuses[i] = sai_acl_api->remove_acl_entry(object_id[i]);
+        }
+        else
+        {
+            object_statuses[i] = sai_acl_api->remove_acl_counter(object_id[i]);
+        }
+
+        if (object_statuses[i] != SAI_STATUS_SUCCESS)
+        {
+            status = SAI_STATUS_FAILURE;
+        }
+    }
+    return status;
+}
+
+template <>
+inline ObjectBulker<sai_acl_api_t>::ObjectBulker(SaiBulkerTraits<sai_acl_api_t>::api_t *api, sai_object_type_t object_type, sai_object_id_t switch_id, size_t max_bulk_size) :
+    switch_id(switch_id),
+    max_bulk_size(max_bulk_size)
+{
+    switch (object_type)
+    {
+        case SAI_OBJECT_TYPE_ACL_ENTRY:
+            create_entries = acl_bulk_create<SAI_OBJECT_TYPE_ACL_ENTRY>;
+            remove_entries = acl_bulk_remove<SAI_OBJECT_TYPE_ACL_ENTRY>;
+            break;
+        case SAI_OBJECT_TYPE_ACL_COUNTER:
+            create_entries = acl_bulk_create<SAI_OBJECT_TYPE_ACL_COUNTER>;
+            remove_entries = acl_bulk_remove<SAI_OBJECT_TYPE_ACL_COUNTER>;
+            break;
+        default:
+            throw std::invalid_argument("ObjectBulker<sai_acl_api_t> does not support object type " + std::to_string(object_type));
+    }
+
+    // Rules are independent, a failed one must not hold back the rest of the batch
+    error_mode = SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR;
+}
@@ -1146,31 +1146,6 @@ bool CoppOrch::trapGroupUpdatePolicer (string trap_group_name,
     return true;
 }
 
-void CoppOrch::initTrapRatePlugin()
-{
-    if (m_trap_rate_plugin_loaded)
-    {
-        return;
-    }
-
-    std::string trapRatePluginName = "trap_rates.lua";
-    try
-    {
-        std::string trapLuaScript = swss::loadLuaScript(trapRatePluginName);
-        std::string trapSha = swss::loadRedisScript(m_counter_db.get(), trapLuaScript);
-
-        vector<FieldValueTuple> fieldValues;
-        fieldValues.emplace_back(FLOW_COUNTER_PLUGIN_FIELD, trapSha);
-        fieldValues.emplace_back(STATS_MODE_FIELD, STATS_MODE_READ);
-        m_flex_counter_group_table->set(HOSTIF_TRAP_COUNTER_FLEX_COUNTER_GROUP, fieldValues);
-    }
-    catch (const runtime_error &e)
-    {
-        SWSS_LOG_ERROR("Trap flex counter groups were not set successfully: %s", e.what());
-    }
-    m_trap_rate_plugin_loaded = true;
-}
-
 bool CoppOrch::removeTrap(sai_object_id_t hostif_trap_id)
 {
     unbindTrapCounter(hostif_trap_id);
@@ -1204,8 +1179,6 @@ bool CoppOrch::bindTrapCounter(sai_object_id_t hostif_trap_id, sai_hostif_trap_t
         return true;
     }
 
-    initTrapRatePlugin();
-
     // Create generic counter
     sai_object_id_t counter_id;
     if (!FlowCounterHandler::createGenericCounter(counter_id))
@@ -1229,6 +1202,7 @@ bool CoppOrch::bindTrapCounter(sai_object_id_t hostif_trap_id, sai_hostif_trap_t
     vector<FieldValueTuple> nameMapFvs;
     nameMapFvs.emplace_back(trap_name, sai_serialize_object_id(counter_id));
     m_counter_table->set("", nameMapFvs);
+    flex_counters_orch->refreshRateCounterObjects(COUNTERS_TRAP_NAME_MAP);
 
     auto was_empty = m_pendingAddToFlexCntr.empty();
     m_pendingAddToFlexCntr[counter_id] = trap_name;
@@ -1268,6 +1242,11 @@ void CoppOrch::unbindTrapCounter(sai_object_id_t hostif_trap_id)
 
     // Remove trap from COUNTERS_TRAP_NAME_MAP
     m_counter_table->hdel("", iter->second);
+    auto flex_counters_orch = gDirectory.get<FlexCounterOrch*>();
+    if (flex_counters_orch)
+    {
+        flex_counters_orch->refreshRateCounterObjects(COUNTERS_TRAP_NAME_MAP);
+    }
 
     // Unbind generic counter to trap
     sai_attribute_t trap_attr;
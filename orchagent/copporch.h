@@ -96,14 +96,11 @@ protected:
 
     FlexCounterManager m_trap_counter_manager;
 
-    bool m_trap_rate_plugin_loaded = false;
-
     SelectableTimer* m_FlexCounterUpdTimer = nullptr;
 
     void initDefaultHostIntfTable();
     void initDefaultTrapGroup();
     void initDefaultTrapIds();
-    void initTrapRatePlugin();
 
     task_process_status processCoppRule(Consumer& consumer);
     bool isValidList(std::vector<std::string> &trap_id_list, std::vector<std::string> &all_items) const;
@@ -245,7 +245,8 @@ const map<string, CrmResourceType> crmUsedCntsTableMap =
 CrmOrch::CrmOrch(DBConnector *db, string tableName):
     Orch(db, tableName),
     m_countersDb(new DBConnector("COUNTERS_DB", 0)),
-    m_countersCrmTable(new Table(m_countersDb.get(), COUNTERS_CRM_TABLE)),
+    m_countersPipeline(new RedisPipeline(m_countersDb.get())),
+    m_countersCrmTable(new Table(m_countersPipeline.get(), COUNTERS_CRM_TABLE, true)),
     m_timer(new SelectableTimer(timespec { .tv_sec = CRM_POLLING_INTERVAL_DEFAULT, .tv_nsec = 0 }))
 {
     SWSS_LOG_ENTER();
@@ -259,6 +260,7 @@ CrmOrch::CrmOrch(DBConnector *db, string tableName):
 
     // The CRM stats needs to be populated again
     m_countersCrmTable->del(CRM_COUNTERS_TABLE_KEY);
+    m_countersPipeline->flush();
 
     // Note: ExecutableTimer will hold m_timer pointer and release the object later
     auto executor = new ExecutableTimer(m_timer, this, "CRM_COUNTERS_POLL");
@@ -392,7 +394,8 @@ void CrmOrch::incCrmResUsedCounter(CrmResourceType resource)
 
     try
     {
-        m_resourcesMap.at(resource).countersMap[CRM_COUNTERS_TABLE_KEY].usedCounter++;
+        auto &res = m_resourcesMap.at(resource);
+        incResUsedCounter(res, res.countersMap[CRM_COUNTERS_TABLE_KEY]);
     }
     catch (...)
     {
@@ -407,7 +410,8 @@ void CrmOrch::decCrmResUsedCounter(CrmResourceType resource)
 
     try
     {
-        m_resourcesMap.at(resource).countersMap[CRM_COUNTERS_TABLE_KEY].usedCounter--;
+        auto &res = m_resourcesMap.at(resource);
+        decResUsedCounter(res, res.countersMap[CRM_COUNTERS_TABLE_KEY]);
     }
     catch (...)
     {
@@ -422,7 +426,8 @@ void CrmOrch::incCrmAclUsedCounter(CrmResourceType resource, sai_acl_stage_t sta
 
     try
     {
-        m_resourcesMap.at(resource).countersMap[getCrmAclKey(stage, point)].usedCounter++;
+        auto &res = m_resourcesMap.at(resource);
+        incResUsedCounter(res, res.countersMap[getCrmAclKey(stage, point)]);
     }
     catch (...)
     {
@@ -437,7 +442,8 @@ void CrmOrch::decCrmAclUsedCounter(CrmResourceType resource, sai_acl_stage_t sta
 
     try
     {
-        m_resourcesMap.at(resource).countersMap[getCrmAclKey(stage, point)].usedCounter--;
+        auto &res = m_resourcesMap.at(resource);
+        decResUsedCounter(res, res.countersMap[getCrmAclKey(stage, point)]);
 
         // remove acl_entry and acl_counter in this acl table
         if (resource == CrmResourceType::CRM_ACL_TABLE)
@@ -461,6 +467,7 @@ void CrmOrch::decCrmAclUsedCounter(CrmResourceType resource, sai_acl_stage_t sta
 
             // remove ACL_TABLE_STATS in crm database
             m_countersCrmTable->del(getCrmAclTableKey(oid));
+            m_countersPipeline->flush();
         }
     }
     catch (...)
@@ -476,8 +483,10 @@ void CrmOrch::incCrmAclTableUsedCounter(CrmResourceType resource, sai_object_id_
 
     try
     {
-        m_resourcesMap.at(resource).countersMap[getCrmAclTableKey(tableId)].usedCounter++;
-        m_resourcesMap.at(resource).countersMap[getCrmAclTableKey(tableId)].id = tableId;
+        auto &res = m_resourcesMap.at(resource);
+        auto &cnt = res.countersMap[getCrmAclTableKey(tableId)];
+        cnt.id = tableId;
+        incResUsedCounter(res, cnt);
     }
     catch (...)
     {
@@ -492,7 +501,8 @@ void CrmOrch::decCrmAclTableUsedCounter(CrmResourceType resource, sai_object_id_
 
     try
     {
-        m_resourcesMap.at(resource).countersMap[getCrmAclTableKey(tableId)].usedCounter--;
+        auto &res = m_resourcesMap.at(resource);
+        decResUsedCounter(res, res.countersMap[getCrmAclTableKey(tableId)]);
     }
     catch (...)
     {
@@ -501,6 +511,38 @@ void CrmOrch::decCrmAclTableUsedCounter(CrmResourceType resource, sai_object_id_
     }
 }
 
+void CrmOrch::incResUsedCounter(CrmResourceEntry &res, CrmResourceCounter &cnt)
+{
+    cnt.usedCounter++;
+
+    if (!cnt.availableRead)
+    {
+        return;
+    }
+
+    // Assume each object takes one entry until the next poll reads the actual availability
+    if (cnt.availableCounter > 0)
+    {
+        cnt.availableCounter--;
+    }
+
+    checkCrmThreshold(res, cnt, true);
+}
+
+void CrmOrch::decResUsedCounter(CrmResourceEntry &res, CrmResourceCounter &cnt)
+{
+    cnt.usedCounter--;
+
+    if (!cnt.availableRead)
+    {
+        return;
+    }
+
+    cnt.availableCounter++;
+
+    checkCrmThreshold(res, cnt, true);
+}
+
 void CrmOrch::doTask(SelectableTimer &timer)
 {
     SWSS_LOG_ENTER();
@@ -510,78 +552,171 @@ void CrmOrch::doTask(SelectableTimer &timer)
     checkCrmThresholds();
 }
 
-bool CrmOrch::getResAvailability(CrmResourceType type, CrmResourceEntry &res)
+sai_status_t CrmOrch::getResAvailability(CrmResourceType type, CrmResourceEntry &res)
 {
     sai_attribute_t attr;
     uint64_t availCount = 0;
-    sai_status_t status = SAI_STATUS_SUCCESS;
+    uint32_t attrCount = 0;
 
     sai_object_type_t objType = crmResSaiObjAttrMap.at(type);
 
-    if (objType != SAI_OBJECT_TYPE_NULL)
+    if (objType == SAI_OBJECT_TYPE_NULL)
     {
-        uint32_t attrCount = 0;
+        return SAI_STATUS_NOT_SUPPORTED;
+    }
+
+    if ((type == CrmResourceType::CRM_IPV4_ROUTE) || (type == CrmResourceType::CRM_IPV6_ROUTE) ||
+        (type == CrmResourceType::CRM_IPV4_NEIGHBOR) || (type == CrmResourceType::CRM_IPV6_NEIGHBOR))
+    {
+        attr.id = crmResAddrFamilyAttrMap.at(type);
+        attr.value.s32 = crmResAddrFamilyValMap.at(type);
+        attrCount = 1;
+    }
+    else if (type == CrmResourceType::CRM_MPLS_NEXTHOP)
+    {
+        attr.id = SAI_NEXT_HOP_ATTR_TYPE;
+        attr.value.s32 = SAI_NEXT_HOP_TYPE_MPLS;
+        attrCount = 1;
+    }
+    else if (type == CrmResourceType::CRM_SRV6_NEXTHOP)
+    {
+        attr.id = SAI_NEXT_HOP_ATTR_TYPE;
+        attr.value.s32 = SAI_NEXT_HOP_TYPE_SRV6_SIDLIST;
+        attrCount = 1;
+    }
 
-        if ((type == CrmResourceType::CRM_IPV4_ROUTE) || (type == CrmResourceType::CRM_IPV6_ROUTE) ||
-            (type == CrmResourceType::CRM_IPV4_NEIGHBOR) || (type == CrmResourceType::CRM_IPV6_NEIGHBOR))
+    sai_status_t status = sai_object_type_get_availability(gSwitchId, objType, attrCount, &attr, &availCount);
+    if (status == SAI_STATUS_SUCCESS)
+    {
+        auto &cnt = res.countersMap[CRM_COUNTERS_TABLE_KEY];
+        cnt.availableCounter = static_cast<uint32_t>(availCount);
+        cnt.availableRead = true;
+    }
+
+    return status;
+}
+
+void CrmOrch::getSwitchResAvailability(const vector<CrmResourceType> &types)
+{
+    SWSS_LOG_ENTER();
+
+    if (types.empty())
+    {
+        return;
+    }
+
+    vector<sai_attribute_t> attrs(types.size());
+    for (size_t i = 0; i < types.size(); i++)
+    {
+        attrs[i].id = crmResSaiAvailAttrMap.at(types[i]);
+    }
+
+    sai_status_t status = sai_switch_api->get_switch_attribute(gSwitchId, static_cast<uint32_t>(attrs.size()), attrs.data());
+
+    for (size_t i = 0; i < types.size(); i++)
+    {
+        auto &res = m_resourcesMap.at(types[i]);
+
+        // A single unsupported attribute fails the whole query, read them one by one then
+        if (status != SAI_STATUS_SUCCESS)
         {
-            attr.id = crmResAddrFamilyAttrMap.at(type);
-            attr.value.s32 = crmResAddrFamilyValMap.at(type);
-            attrCount = 1;
+            sai_status_t attrStatus = sai_switch_api->get_switch_attribute(gSwitchId, 1, &attrs[i]);
+            if (attrStatus != SAI_STATUS_SUCCESS)
+            {
+                handleResAvailabilityStatus(types[i], res, attrStatus);
+                continue;
+            }
         }
-        else if (type == CrmResourceType::CRM_MPLS_NEXTHOP)
+
+        auto &cnt = res.countersMap[CRM_COUNTERS_TABLE_KEY];
+        cnt.availableCounter = attrs[i].value.u32;
+        cnt.availableRead = true;
+    }
+}
+
+void CrmOrch::getAclTableResAvailability()
+{
+    SWSS_LOG_ENTER();
+
+    auto &entries = m_resourcesMap.at(CrmResourceType::CRM_ACL_ENTRY).countersMap;
+    auto &counters = m_resourcesMap.at(CrmResourceType::CRM_ACL_COUNTER).countersMap;
+
+    // Entries and counters of the same ACL table are read with one query
+    for (auto &entry : entries)
+    {
+        sai_attribute_t attrs[2];
+        uint32_t attrCount = 0;
+
+        attrs[attrCount++].id = crmResSaiAvailAttrMap.at(CrmResourceType::CRM_ACL_ENTRY);
+
+        auto counter = counters.find(entry.first);
+        if (counter != counters.end())
         {
-            attr.id = SAI_NEXT_HOP_ATTR_TYPE;
-            attr.value.s32 = SAI_NEXT_HOP_TYPE_MPLS;
-            attrCount = 1;
+            attrs[attrCount++].id = crmResSaiAvailAttrMap.at(CrmResourceType::CRM_ACL_COUNTER);
         }
-        else if (type == CrmResourceType::CRM_SRV6_NEXTHOP)
+
+        sai_status_t status = sai_acl_api->get_acl_table_attribute(entry.second.id, attrCount, attrs);
+        if (status != SAI_STATUS_SUCCESS)
         {
-            attr.id = SAI_NEXT_HOP_ATTR_TYPE;
-            attr.value.s32 = SAI_NEXT_HOP_TYPE_SRV6_SIDLIST;
-            attrCount = 1;
+            SWSS_LOG_ERROR("Failed to get ACL table attribute %u , rv:%d", attrs[0].id, status);
+            continue;
         }
 
-        status = sai_object_type_get_availability(gSwitchId, objType, attrCount, &attr, &availCount);
-    }
+        entry.second.availableCounter = attrs[0].value.u32;
+        entry.second.availableRead = true;
 
-    if ((status != SAI_STATUS_SUCCESS) || (objType == SAI_OBJECT_TYPE_NULL))
-    {
-        if (crmResSaiAvailAttrMap.find(type) != crmResSaiAvailAttrMap.end())
+        if (counter != counters.end())
         {
-            attr.id = crmResSaiAvailAttrMap.at(type);
-            status = sai_switch_api->get_switch_attribute(gSwitchId, 1, &attr);
+            counter->second.availableCounter = attrs[1].value.u32;
+            counter->second.availableRead = true;
         }
+    }
 
-        if ((status == SAI_STATUS_NOT_SUPPORTED) ||
-            (status == SAI_STATUS_NOT_IMPLEMENTED) ||
-            SAI_STATUS_IS_ATTR_NOT_SUPPORTED(status) ||
-            SAI_STATUS_IS_ATTR_NOT_IMPLEMENTED(status))
+    for (auto &counter : counters)
+    {
+        if (entries.find(counter.first) != entries.end())
         {
-            // mark unsupported resources
-            res.resStatus = CrmResourceStatus::CRM_RES_NOT_SUPPORTED;
-            SWSS_LOG_NOTICE("CRM resource %s not supported", crmResTypeNameMap.at(type).c_str());
-            return false;
+            continue;
         }
 
+        sai_attribute_t attr;
+        attr.id = crmResSaiAvailAttrMap.at(CrmResourceType::CRM_ACL_COUNTER);
+
+        sai_status_t status = sai_acl_api->get_acl_table_attribute(counter.second.id, 1, &attr);
         if (status != SAI_STATUS_SUCCESS)
         {
-            SWSS_LOG_ERROR("Failed to get availability counter for %s CRM resourse", crmResTypeNameMap.at(type).c_str());
-            return false;
+            SWSS_LOG_ERROR("Failed to get ACL table attribute %u , rv:%d", attr.id, status);
+            continue;
         }
 
-        availCount = attr.value.u32;
+        counter.second.availableCounter = attr.value.u32;
+        counter.second.availableRead = true;
     }
+}
 
-    res.countersMap[CRM_COUNTERS_TABLE_KEY].availableCounter = static_cast<uint32_t>(availCount);
+void CrmOrch::handleResAvailabilityStatus(CrmResourceType type, CrmResourceEntry &res, sai_status_t status)
+{
+    if ((status == SAI_STATUS_NOT_SUPPORTED) ||
+        (status == SAI_STATUS_NOT_IMPLEMENTED) ||
+        SAI_STATUS_IS_ATTR_NOT_SUPPORTED(status) ||
+        SAI_STATUS_IS_ATTR_NOT_IMPLEMENTED(status))
+    {
+        // mark unsupported resources
+        res.resStatus = CrmResourceStatus::CRM_RES_NOT_SUPPORTED;
+        SWSS_LOG_NOTICE("CRM resource %s not supported", crmResTypeNameMap.at(type).c_str());
+        return;
+    }
 
-    return true;
+    SWSS_LOG_ERROR("Failed to get availability counter for %s CRM resourse", crmResTypeNameMap.at(type).c_str());
 }
 
 void CrmOrch::getResAvailableCounters()
 {
     SWSS_LOG_ENTER();
 
+    // Resources read from switch attributes, queried together after the loop
+    vector<CrmResourceType> switchResources;
+
     for (auto &res : m_resourcesMap)
     {
         // ignore unsupported resources
@@ -610,7 +745,28 @@ void CrmOrch::getResAvailableCounters()
             case CrmResourceType::CRM_MPLS_NEXTHOP:
             case CrmResourceType::CRM_SRV6_NEXTHOP:
             {
-                getResAvailability(res.first, res.second);
+                if (!res.second.switchAvailability)
+                {
+                    sai_status_t status = getResAvailability(res.first, res.second);
+                    if (status == SAI_STATUS_SUCCESS)
+                    {
+                        break;
+                    }
+
+                    if (crmResSaiAvailAttrMap.find(res.first) == crmResSaiAvailAttrMap.end())
+                    {
+                        handleResAvailabilityStatus(res.first, res.second, status);
+                        break;
+                    }
+
+                    // Do not query the object type again if it can't be queried at all
+                    if ((status == SAI_STATUS_NOT_SUPPORTED) || (status == SAI_STATUS_NOT_IMPLEMENTED))
+                    {
+                        res.second.switchAvailability = true;
+                    }
+                }
+
+                switchResources.push_back(res.first);
                 break;
             }
 
@@ -646,53 +802,55 @@ void CrmOrch::getResAvailableCounters()
                 {
                     string key = getCrmAclKey(attr.value.aclresource.list[i].stage, attr.value.aclresource.list[i].bind_point);
                     res.second.countersMap[key].availableCounter = attr.value.aclresource.list[i].avail_num;
+                    res.second.countersMap[key].availableRead = true;
                 }
 
                 break;
             }
 
             case CrmResourceType::CRM_ACL_ENTRY:
-            case CrmResourceType::CRM_ACL_COUNTER:
             {
-                sai_attribute_t attr;
-                attr.id = crmResSaiAvailAttrMap.at(res.first);
-
-                for (auto &cnt : res.second.countersMap)
-                {
-                    sai_status_t status = sai_acl_api->get_acl_table_attribute(cnt.second.id, 1, &attr);
-                    if (status != SAI_STATUS_SUCCESS)
-                    {
-                        SWSS_LOG_ERROR("Failed to get ACL table attribute %u , rv:%d", attr.id, status);
-                        break;
-                    }
-
-                    cnt.second.availableCounter = attr.value.u32;
-                }
+                getAclTableResAvailability();
+                break;
+            }
 
+            case CrmResourceType::CRM_ACL_COUNTER:
+            {
+                // Read together with the ACL entries
                 break;
             }
 
             default:
                 SWSS_LOG_ERROR("Failed to get CRM resource type %u. Unknown resource type.\n", static_cast<uint32_t>(res.first));
-                return;
+                break;
         }
     }
+
+    getSwitchResAvailability(switchResources);
 }
 
 void CrmOrch::updateCrmCountersTable()
 {
     SWSS_LOG_ENTER();
 
+    // Only the counters which changed since the last update are written, one HSET per key
+    map<string, vector<FieldValueTuple>> updates;
+
     // Update CRM used counters in COUNTERS_DB
     for (const auto &i : crmUsedCntsTableMap)
     {
         try
         {
-            for (const auto &cnt : m_resourcesMap.at(i.second).countersMap)
+            for (auto &cnt : m_resourcesMap.at(i.second).countersMap)
             {
-                FieldValueTuple attr(i.first, to_string(cnt.second.usedCounter));
-                vector<FieldValueTuple> attrs = { attr };
-                m_countersCrmTable->set(cnt.first, attrs);
+                if (cnt.second.usedPublished && cnt.second.publishedUsedCounter == cnt.second.usedCounter)
+                {
+                    continue;
+                }
+
+                updates[cnt.first].emplace_back(i.first, to_string(cnt.second.usedCounter));
+                cnt.second.publishedUsedCounter = cnt.second.usedCounter;
+                cnt.second.usedPublished = true;
             }
         }
         catch(const out_of_range &e)
@@ -706,11 +864,16 @@ void CrmOrch::updateCrmCountersTable()
     {
         try
         {
-            for (const auto &cnt : m_resourcesMap.at(i.second).countersMap)
+            for (auto &cnt : m_resourcesMap.at(i.second).countersMap)
             {
-                FieldValueTuple attr(i.first, to_string(cnt.second.availableCounter));
-                vector<FieldValueTuple> attrs = { attr };
-                m_countersCrmTable->set(cnt.first, attrs);
+                if (cnt.second.availablePublished && cnt.second.publishedAvailableCounter == cnt.second.availableCounter)
+                {
+                    continue;
+                }
+
+                updates[cnt.first].emplace_back(i.first, to_string(cnt.second.availableCounter));
+                cnt.second.publishedAvailableCounter = cnt.second.availableCounter;
+                cnt.second.availablePublished = true;
             }
         }
         catch(const out_of_range &e)
@@ -718,6 +881,13 @@ void CrmOrch::updateCrmCountersTable()
             // expected when a resource is unavailable
         }
     }
+
+    for (const auto &update : updates)
+    {
+        m_countersCrmTable->set(update.first, update.second);
+    }
+
+    m_countersPipeline->flush();
 }
 
 void CrmOrch::checkCrmThresholds()
@@ -726,69 +896,77 @@ void CrmOrch::checkCrmThresholds()
 
     for (auto &i : m_resourcesMap)
     {
-        auto &res = i.second;
-
         for (auto &j : i.second.countersMap)
         {
-            auto &cnt = j.second;
-            uint64_t utilization = 0;
-            uint32_t percentageUtil = 0;
-            string threshType = "";
+            checkCrmThreshold(i.second, j.second, false);
+        }
+    }
+}
 
-            if (cnt.usedCounter != 0)
-            {
-                uint32_t dvsr = cnt.usedCounter + cnt.availableCounter;
-                if (dvsr != 0)
-                {
-                    percentageUtil = (cnt.usedCounter * 100) / dvsr;
-                }
-                else
-                {
-                    SWSS_LOG_WARN("%s Exception occurred (div by Zero): Used count %u free count %u",
-                                  res.name.c_str(), cnt.usedCounter, cnt.availableCounter);
-                }
-            }
+/*
+ * Check a counter against the thresholds of its resource. On used counter
+ * updates only the crossing of a threshold is reported, the periodic check
+ * keeps reporting an exceeded threshold up to CRM_EXCEEDED_MSG_MAX times.
+ */
+void CrmOrch::checkCrmThreshold(CrmResourceEntry &res, CrmResourceCounter &cnt, bool transitionOnly)
+{
+    uint64_t utilization = 0;
+    uint32_t percentageUtil = 0;
+    string threshType = "";
 
-            switch (res.thresholdType)
-            {
-                case CrmThresholdType::CRM_PERCENTAGE:
-                    utilization = percentageUtil;
-                    threshType = "TH_PERCENTAGE";
-                    break;
-                case CrmThresholdType::CRM_USED:
-                    utilization = cnt.usedCounter;
-                    threshType = "TH_USED";
-                    break;
-                case CrmThresholdType::CRM_FREE:
-                    utilization = cnt.availableCounter;
-                    threshType = "TH_FREE";
-                    break;
-                default:
-                    throw runtime_error("Unknown threshold type for CRM resource");
-            }
+    if (cnt.usedCounter != 0)
+    {
+        uint32_t dvsr = cnt.usedCounter + cnt.availableCounter;
+        if (dvsr != 0)
+        {
+            percentageUtil = (cnt.usedCounter * 100) / dvsr;
+        }
+        else
+        {
+            SWSS_LOG_WARN("%s Exception occurred (div by Zero): Used count %u free count %u",
+                          res.name.c_str(), cnt.usedCounter, cnt.availableCounter);
+        }
+    }
 
-            if ((utilization >= res.highThreshold) && (cnt.exceededLogCounter < CRM_EXCEEDED_MSG_MAX))
-            {
-                event_params_t params = {
-                    { "percent", to_string(percentageUtil) },
-                    { "used_cnt", to_string(cnt.usedCounter) },
-                    { "free_cnt", to_string(cnt.availableCounter) }};
+    switch (res.thresholdType)
+    {
+        case CrmThresholdType::CRM_PERCENTAGE:
+            utilization = percentageUtil;
+            threshType = "TH_PERCENTAGE";
+            break;
+        case CrmThresholdType::CRM_USED:
+            utilization = cnt.usedCounter;
+            threshType = "TH_USED";
+            break;
+        case CrmThresholdType::CRM_FREE:
+            utilization = cnt.availableCounter;
+            threshType = "TH_FREE";
+            break;
+        default:
+            throw runtime_error("Unknown threshold type for CRM resource");
+    }
 
-                SWSS_LOG_WARN("%s THRESHOLD_EXCEEDED for %s %u%% Used count %u free count %u",
-                              res.name.c_str(), threshType.c_str(), percentageUtil, cnt.usedCounter, cnt.availableCounter);
+    if ((utilization >= res.highThreshold) && (cnt.exceededLogCounter < CRM_EXCEEDED_MSG_MAX) &&
+        (!transitionOnly || (cnt.exceededLogCounter == 0)))
+    {
+        event_params_t params = {
+            { "percent", to_string(percentageUtil) },
+            { "used_cnt", to_string(cnt.usedCounter) },
+            { "free_cnt", to_string(cnt.availableCounter) }};
 
-                event_publish(g_events_handle, "chk_crm_threshold", &params);
-                cnt.exceededLogCounter++;
-            }
-            else if ((utilization <= res.lowThreshold) && (cnt.exceededLogCounter > 0) && (res.highThreshold != res.lowThreshold))
-            {
-                SWSS_LOG_WARN("%s THRESHOLD_CLEAR for %s %u%% Used count %u free count %u",
-                              res.name.c_str(), threshType.c_str(), percentageUtil, cnt.usedCounter, cnt.availableCounter);
+        SWSS_LOG_WARN("%s THRESHOLD_EXCEEDED for %s %u%% Used count %u free count %u",
+                      res.name.c_str(), threshType.c_str(), percentageUtil, cnt.usedCounter, cnt.availableCounter);
 
-                cnt.exceededLogCounter = 0;
-            }
-        } // end of counters loop
-    } // end of resources loop
+        event_publish(g_events_handle, "chk_crm_threshold", &params);
+        cnt.exceededLogCounter++;
+    }
+    else if ((utilization <= res.lowThreshold) && (cnt.exceededLogCounter > 0) && (res.highThreshold != res.lowThreshold))
+    {
+        SWSS_LOG_WARN("%s THRESHOLD_CLEAR for %s %u%% Used count %u free count %u",
+                      res.name.c_str(), threshType.c_str(), percentageUtil, cnt.usedCounter, cnt.availableCounter);
+
+        cnt.exceededLogCounter = 0;
+    }
 }
 
 
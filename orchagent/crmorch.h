@@ -5,6 +5,7 @@
 #include <map>
 #include "orch.h"
 #include "port.h"
+#include "redispipeline.h"
 #include "events.h"
 
 extern "C" {
@@ -66,6 +67,7 @@ public:
 
 private:
     std::shared_ptr<swss::DBConnector> m_countersDb = nullptr;
+    std::shared_ptr<swss::RedisPipeline> m_countersPipeline = nullptr;
     std::shared_ptr<swss::Table> m_countersCrmTable = nullptr;
     swss::SelectableTimer *m_timer = nullptr;
 
@@ -75,6 +77,14 @@ private:
         uint32_t availableCounter = 0;
         uint32_t usedCounter = 0;
         uint32_t exceededLogCounter = 0;
+        // Set once availableCounter has been read from SAI
+        bool availableRead = false;
+
+        // Values last written to COUNTERS_DB
+        bool usedPublished = false;
+        bool availablePublished = false;
+        uint32_t publishedUsedCounter = 0;
+        uint32_t publishedAvailableCounter = 0;
     };
 
     struct CrmResourceEntry
@@ -90,6 +100,8 @@ private:
         std::map<std::string, CrmResourceCounter> countersMap;
 
         CrmResourceStatus resStatus = CrmResourceStatus::CRM_RES_SUPPORTED;
+        // Availability is read from a switch attribute rather than the object type
+        bool switchAvailability = false;
     };
 
     std::chrono::seconds m_pollingInterval;
@@ -99,10 +111,16 @@ private:
     void doTask(Consumer &consumer);
     void handleSetCommand(const std::string& key, const std::vector<swss::FieldValueTuple>& data);
     void doTask(swss::SelectableTimer &timer);
-    bool getResAvailability(CrmResourceType type, CrmResourceEntry &res);
+    sai_status_t getResAvailability(CrmResourceType type, CrmResourceEntry &res);
+    void getSwitchResAvailability(const std::vector<CrmResourceType> &types);
+    void getAclTableResAvailability();
+    void handleResAvailabilityStatus(CrmResourceType type, CrmResourceEntry &res, sai_status_t status);
     void getResAvailableCounters();
     void updateCrmCountersTable();
+    void incResUsedCounter(CrmResourceEntry &res, CrmResourceCounter &cnt);
+    void decResUsedCounter(CrmResourceEntry &res, CrmResourceCounter &cnt);
     void checkCrmThresholds();
+    void checkCrmThreshold(CrmResourceEntry &res, CrmResourceCounter &cnt, bool transitionOnly);
     std::string getCrmAclKey(sai_acl_stage_t stage, sai_acl_bind_point_type_t bindPoint);
     std::string getCrmAclTableKey(sai_object_id_t id);
 };
@@ -19,6 +19,7 @@ extern sai_fdb_api_t    *sai_fdb_api;
 
 extern sai_object_id_t  gSwitchId;
 extern CrmOrch *        gCrmOrch;
+extern size_t           gMaxBulkSize;
 extern MlagOrch*        gMlagOrch;
 extern Directory<Orch*> gDirectory;
 
@@ -29,7 +30,8 @@ FdbOrch::FdbOrch(DBConnector* applDbConnector, vector<table_name_with_pri_t> app
     Orch(applDbConnector, appFdbTables),
     m_portsOrch(port),
     m_fdbStateTable(stateDbFdbConnector.first, stateDbFdbConnector.second),
-    m_mclagFdbStateTable(stateDbMclagFdbConnector.first, stateDbMclagFdbConnector.second)
+    m_mclagFdbStateTable(stateDbMclagFdbConnector.first, stateDbMclagFdbConnector.second),
+    gFdbBulker(sai_fdb_api, gMaxBulkSize)
 {
     for(auto it: appFdbTables)
     {
@@ -114,7 +116,7 @@ bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
         fdbdata.esi = "";
         fdbdata.vni = 0;
 
-        m_entries[entry] = fdbdata;
+        setFdbEntry(entry, fdbdata);
         SWSS_LOG_INFO("FdbOrch notification: mac %s was inserted in port %s into bv_id 0x%" PRIx64,
                         entry.mac.to_string().c_str(), portName.c_str(), entry.bv_id);
         SWSS_LOG_INFO("m_entries size=%zu mac=%s port=0x%" PRIx64,
@@ -147,7 +149,7 @@ bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
             oldFdbData = it->second;
         }
 
-        size_t erased = m_entries.erase(entry);
+        size_t erased = eraseFdbEntry(entry) ? 1 : 0;
         SWSS_LOG_DEBUG("FdbOrch notification: mac %s was removed from bv_id 0x%" PRIx64, entry.mac.to_string().c_str(), entry.bv_id);
 
         if (erased == 0)
@@ -174,6 +176,129 @@ bool FdbOrch::storeFdbEntryState(const FdbUpdate& update)
     }
 }
 
+/*
+Inserts or updates the FdbEntry in the internal cache and keeps the per bridge port and per vlan indices in sync
+*/
+void FdbOrch::setFdbEntry(const FdbEntry& entry, const FdbData& fdbData)
+{
+    auto it = m_entries.find(entry);
+    if (it != m_entries.end())
+    {
+        if (it->second.bridge_port_id != fdbData.bridge_port_id)
+        {
+            auto old_port = m_entriesByBridgePort.find(it->second.bridge_port_id);
+            if (old_port != m_entriesByBridgePort.end())
+            {
+                old_port->second.erase(entry);
+                if (old_port->second.empty())
+                {
+                    m_entriesByBridgePort.erase(old_port);
+                }
+            }
+            m_entriesByBridgePort[fdbData.bridge_port_id].insert(it->first);
+        }
+        it->second = fdbData;
+        return;
+    }
+
+    it = m_entries.emplace(entry, fdbData).first;
+    m_entriesByBridgePort[fdbData.bridge_port_id].insert(it->first);
+    m_entriesByBvId[entry.bv_id].insert(it->first);
+}
+
+/*
+Removes the FdbEntry from the internal cache and from the per bridge port and per vlan indices
+*/
+bool FdbOrch::eraseFdbEntry(const FdbEntry& entry)
+{
+    auto it = m_entries.find(entry);
+    if (it == m_entries.end())
+    {
+        return false;
+    }
+
+    auto port = m_entriesByBridgePort.find(it->second.bridge_port_id);
+    if (port != m_entriesByBridgePort.end())
+    {
+        port->second.erase(entry);
+        if (port->second.empty())
+        {
+            m_entriesByBridgePort.erase(port);
+        }
+    }
+
+    auto vlan = m_entriesByBvId.find(entry.bv_id);
+    if (vlan != m_entriesByBvId.end())
+    {
+        vlan->second.erase(entry);
+        if (vlan->second.empty())
+        {
+            m_entriesByBvId.erase(vlan);
+        }
+    }
+
+    m_entries.erase(it);
+    return true;
+}
+
+/*
+Returns the cached FdbEntries on a bridge port and/or vlan, SAI_NULL_OBJECT_ID matches any
+*/
+vector<FdbEntry> FdbOrch::getFdbEntries(sai_object_id_t bridge_port_id, sai_object_id_t bv_id) const
+{
+    vector<FdbEntry> entries;
+
+    if (bridge_port_id == SAI_NULL_OBJECT_ID && bv_id == SAI_NULL_OBJECT_ID)
+    {
+        entries.reserve(m_entries.size());
+        for (const auto& it : m_entries)
+        {
+            entries.push_back(it.first);
+        }
+        return entries;
+    }
+
+    /* Walk the smaller index when both the bridge port and the vlan are given */
+    const set<FdbEntry> *index = nullptr;
+    auto port = m_entriesByBridgePort.find(bridge_port_id);
+    auto vlan = m_entriesByBvId.find(bv_id);
+    if (bridge_port_id != SAI_NULL_OBJECT_ID)
+    {
+        if (port == m_entriesByBridgePort.end())
+        {
+            return entries;
+        }
+        index = &port->second;
+    }
+    if (bv_id != SAI_NULL_OBJECT_ID)
+    {
+        if (vlan == m_entriesByBvId.end())
+        {
+            return entries;
+        }
+        if (!index || vlan->second.size() < index->size())
+        {
+            index = &vlan->second;
+        }
+    }
+
+    for (const auto& entry : *index)
+    {
+        auto it = m_entries.find(entry);
+        if (it == m_entries.end())
+        {
+            continue;
+        }
+        if ((bridge_port_id == SAI_NULL_OBJECT_ID || it->second.bridge_port_id == bridge_port_id) &&
+            (bv_id == SAI_NULL_OBJECT_ID || it->first.bv_id == bv_id))
+        {
+            entries.push_back(it->first);
+        }
+    }
+
+    return entries;
+}
+
 /*
 clears stateDb and decrements corresponding internal fdb counters
 */
@@ -214,60 +339,18 @@ void FdbOrch::handleSyncdFlushNotif(const sai_object_id_t& bv_id,
     /* TODO: Read the SAI_FDB_FLUSH_ATTR_ENTRY_TYPE attr from the flush notif
     and clear the entries accordingly, currently only non-static entries are flushed
     */
-    if (bridge_port_id == SAI_NULL_OBJECT_ID && bv_id == SAI_NULL_OBJECT_ID)
-    {
-        for (auto itr = m_entries.begin(); itr != m_entries.end();)
-        {
-            auto curr = itr++;
-            if (curr->second.type != "static" && (curr->first.mac == mac || mac == flush_mac) && curr->second.is_flush_pending)
-            {
-                clearFdbEntry(curr->first);
-            }
-        }
-    }
-    else if (bv_id == SAI_NULL_OBJECT_ID)
-    {
-        /* FLUSH based on PORT */
-        for (auto itr = m_entries.begin(); itr != m_entries.end();)
-        {
-            auto curr = itr++;
-            if (curr->second.bridge_port_id == bridge_port_id)
-            {
-                if (curr->second.type != "static" && (curr->first.mac == mac || mac == flush_mac) && curr->second.is_flush_pending)
-                {
-                    clearFdbEntry(curr->first);
-                }
-            }
-        }
-    }
-    else if (bridge_port_id == SAI_NULL_OBJECT_ID)
+
+    /* Only the entries on the flushed bridge port and/or vlan are visited */
+    for (const auto& entry : getFdbEntries(bridge_port_id, bv_id))
     {
-        /* FLUSH based on BV_ID */
-        for (auto itr = m_entries.begin(); itr != m_entries.end();)
+        auto curr = m_entries.find(entry);
+        if (curr == m_entries.end())
         {
-            auto curr = itr++;
-            if (curr->first.bv_id == bv_id)
-            {
-                if (curr->second.type != "static" && (curr->first.mac == mac || mac == flush_mac) && curr->second.is_flush_pending)
-                {
-                    clearFdbEntry(curr->first);
-                }
-            }
+            continue;
         }
-    }
-    else
-    {
-        /* FLUSH based on port and VLAN */
-        for (auto itr = m_entries.begin(); itr != m_entries.end();)
+        if (curr->second.type != "static" && (curr->first.mac == mac || mac == flush_mac) && curr->second.is_flush_pending)
         {
-            auto curr = itr++;
-            if (curr->first.bv_id == bv_id && curr->second.bridge_port_id == bridge_port_id)
-            {
-                if (curr->second.type != "static" && (curr->first.mac == mac || mac == flush_mac) && curr->second.is_flush_pending)
-                {
-                    clearFdbEntry(curr->first);
-                }
-            }
+            clearFdbEntry(curr->first);
         }
     }
 }
@@ -340,10 +423,8 @@ void FdbOrch::update(sai_fdb_event_t        type,
                     }
                     else
                     {
-                        port.m_fdb_count--;
-                        m_portsOrch->setPort(port.m_alias, port);
-                        vlan.m_fdb_count--;
-                        m_portsOrch->setPort(vlan.m_alias, vlan);
+                        m_portsOrch->updateFdbCount(port, -1);
+                        m_portsOrch->updateFdbCount(vlan, -1);
                     }
                     // Continue to add (update/move) the MAC
                 }
@@ -400,10 +481,8 @@ void FdbOrch::update(sai_fdb_event_t        type,
         update.add = true;
         update.entry.port_name = update.port.m_alias;
         update.type = "dynamic";
-        update.port.m_fdb_count++;
-        m_portsOrch->setPort(update.port.m_alias, update.port);
-        vlan.m_fdb_count++;
-        m_portsOrch->setPort(vlan.m_alias, vlan);
+        m_portsOrch->updateFdbCount(update.port, 1);
+        m_portsOrch->updateFdbCount(vlan, 1);
 
         storeFdbEntryState(update);
         notify(SUBJECT_TYPE_FDB_CHANGE, &update);
@@ -525,13 +604,11 @@ void FdbOrch::update(sai_fdb_event_t        type,
         update.add = false;
         if (!update.port.m_alias.empty())
         {
-            update.port.m_fdb_count--;
-            m_portsOrch->setPort(update.port.m_alias, update.port);
+            m_portsOrch->updateFdbCount(update.port, -1);
         }
         if (!vlan.m_alias.empty())
         {
-            vlan.m_fdb_count--;
-            m_portsOrch->setPort(vlan.m_alias, vlan);
+            m_portsOrch->updateFdbCount(vlan, -1);
         }
         storeFdbEntryState(update);
 
@@ -564,11 +641,9 @@ void FdbOrch::update(sai_fdb_event_t        type,
 	update.entry.port_name = update.port.m_alias;
         if (!port_old.m_alias.empty())
         {
-            port_old.m_fdb_count--;
-            m_portsOrch->setPort(port_old.m_alias, port_old);
+            m_portsOrch->updateFdbCount(port_old, -1);
         }
-        update.port.m_fdb_count++;
-        m_portsOrch->setPort(update.port.m_alias, update.port);
+        m_portsOrch->updateFdbCount(update.port, 1);
         storeFdbEntryState(update);
 
         notify(SUBJECT_TYPE_FDB_CHANGE, &update);
@@ -615,8 +690,11 @@ void FdbOrch::update(SubjectType type, void *cntx)
         }
         case SUBJECT_TYPE_PORT_OPER_STATE_CHANGE:
         {
-            PortOperStateUpdate *update = reinterpret_cast<PortOperStateUpdate *>(cntx);
-            updatePortOperState(*update);
+            PortOperStateUpdates *updates = reinterpret_cast<PortOperStateUpdates *>(cntx);
+            for (const auto &update : updates->updates)
+            {
+                updatePortOperState(update);
+            }
             break;
         }
         default:
@@ -690,187 +768,270 @@ void FdbOrch::doTask(Consumer& consumer)
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
-        KeyOpFieldsValuesTuple t = it->second;
+        // FDB bulk results will be stored in a map
+        std::map<
+                std::pair<
+                        std::string,            // Key
+                        std::string             // Op
+                >,
+                FdbBulkContext
+        >                                       toBulk;
+
+        // Add or remove FDB entries with a FDB bulker
+        while (it != consumer.m_toSync.end())
+        {
+            KeyOpFieldsValuesTuple t = it->second;
 
-        /* format: <VLAN_name>:<MAC_address> */
-        vector<string> keys = tokenize(kfvKey(t), ':', 1);
-        string op = kfvOp(t);
+            /* format: <VLAN_name>:<MAC_address> */
+            vector<string> keys = tokenize(kfvKey(t), ':', 1);
+            string op = kfvOp(t);
 
-        Port vlan;
-        if (!m_portsOrch->getPort(keys[0], vlan))
-        {
-            SWSS_LOG_INFO("Failed to locate %s", keys[0].c_str());
-            if(op == DEL_COMMAND)
+            Port vlan;
+            if (!m_portsOrch->getPort(keys[0], vlan))
             {
-                /* Delete if it is in saved_fdb_entry */
-                unsigned short vlan_id;
-                try {
-                    vlan_id = (unsigned short) stoi(keys[0].substr(4));
-                } catch(exception &e) {
+                SWSS_LOG_INFO("Failed to locate %s", keys[0].c_str());
+                if(op == DEL_COMMAND)
+                {
+                    /* Delete if it is in saved_fdb_entry */
+                    unsigned short vlan_id;
+                    try {
+                        vlan_id = (unsigned short) stoi(keys[0].substr(4));
+                    } catch(exception &e) {
+                        it = consumer.m_toSync.erase(it);
+                        continue;
+                    }
+                    deleteFdbEntryFromSavedFDB(MacAddress(keys[1]), vlan_id, origin);
+
                     it = consumer.m_toSync.erase(it);
-                    continue;
                 }
-                deleteFdbEntryFromSavedFDB(MacAddress(keys[1]), vlan_id, origin);
-
-                it = consumer.m_toSync.erase(it);
-            }
-            else
-            {
-                it++;
+                else
+                {
+                    it++;
+                }
+                continue;
             }
-            continue;
-        }
 
-        FdbEntry entry;
-        entry.mac = MacAddress(keys[1]);
-        entry.bv_id = vlan.m_vlan_info.vlan_oid;
+            FdbEntry entry;
+            entry.mac = MacAddress(keys[1]);
+            entry.bv_id = vlan.m_vlan_info.vlan_oid;
 
-        if (op == SET_COMMAND)
-        {
-            string port = "";
-            string type = "dynamic";
-            string remote_ip = "";
-            string esi = "";
-            unsigned int vni = 0;
-            string sticky = "";
-
-            for (auto i : kfvFieldsValues(t))
+            /* The pending SAI call on the same entry has to be flushed first, e.g. DEL then SET */
+            sai_fdb_entry_t fdb_entry;
+            fdb_entry.switch_id = gSwitchId;
+            memcpy(fdb_entry.mac_address, entry.mac.getMac(), sizeof(sai_mac_t));
+            fdb_entry.bv_id = entry.bv_id;
+            if (gFdbBulker.bulk_entry_pending_removal(fdb_entry) ||
+                gFdbBulker.creating_entries_count(fdb_entry) > 0)
             {
-                if (fvField(i) == "port")
-                {
-                    port = fvValue(i);
-                }
+                break;
+            }
 
-                if (fvField(i) == "type")
-                {
-                    type = fvValue(i);
-                }
+            auto& ctx = toBulk.emplace(std::piecewise_construct,
+                    std::forward_as_tuple(kfvKey(t), op),
+                    std::forward_as_tuple()).first->second;
 
-                if(origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
+            if (op == SET_COMMAND)
+            {
+                string port = "";
+                string type = "dynamic";
+                string remote_ip = "";
+                string esi = "";
+                unsigned int vni = 0;
+                string sticky = "";
+
+                for (auto i : kfvFieldsValues(t))
                 {
-                    if (fvField(i) == "remote_vtep")
+                    if (fvField(i) == "port")
                     {
-                        remote_ip = fvValue(i);
-                        // Creating an IpAddress object to validate if remote_ip is valid
-                        // if invalid it will throw the exception and we will ignore the
-                        // event
-                        try {
-                            IpAddress valid_ip = IpAddress(remote_ip);
-                            (void)valid_ip; // To avoid g++ warning
-                        } catch(exception &e) {
-                            SWSS_LOG_NOTICE("Invalid IP address in remote MAC %s", remote_ip.c_str());
-                            remote_ip = "";
-                            break;
-                        }
+                        port = fvValue(i);
                     }
 
-                    if (fvField(i) == "esi")
+                    if (fvField(i) == "type")
                     {
-                        esi = fvValue(i);
+                        type = fvValue(i);
                     }
 
-                    if (fvField(i) == "vni")
+                    if(origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
                     {
-                        try {
-                            vni = (unsigned int) stoi(fvValue(i));
-                        } catch(exception &e) {
-                            SWSS_LOG_INFO("Invalid VNI in remote MAC %s", fvValue(i).c_str());
-                            vni = 0;
-                            break;
+                        if (fvField(i) == "remote_vtep")
+                        {
+                            remote_ip = fvValue(i);
+                            // Creating an IpAddress object to validate if remote_ip is valid
+                            // if invalid it will throw the exception and we will ignore the
+                            // event
+                            try {
+                                IpAddress valid_ip = IpAddress(remote_ip);
+                                (void)valid_ip; // To avoid g++ warning
+                            } catch(exception &e) {
+                                SWSS_LOG_NOTICE("Invalid IP address in remote MAC %s", remote_ip.c_str());
+                                remote_ip = "";
+                                break;
+                            }
+                        }
+
+                        if (fvField(i) == "esi")
+                        {
+                            esi = fvValue(i);
+                        }
+
+                        if (fvField(i) == "vni")
+                        {
+                            try {
+                                vni = (unsigned int) stoi(fvValue(i));
+                            } catch(exception &e) {
+                                SWSS_LOG_INFO("Invalid VNI in remote MAC %s", fvValue(i).c_str());
+                                vni = 0;
+                                break;
+                            }
                         }
                     }
                 }
-            }
-
-            /* FDB type is either dynamic or static */
-            assert(type == "dynamic" || type == "dynamic_local" || type == "static" );
 
-            if(origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
-            {
-                VxlanTunnelOrch* tunnel_orch = gDirectory.get<VxlanTunnelOrch*>();
+                /* FDB type is either dynamic or static */
+                assert(type == "dynamic" || type == "dynamic_local" || type == "static" );
 
-                if (tunnel_orch->isDipTunnelsSupported())
+                if(origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
                 {
-                    if(!remote_ip.length())
+                    VxlanTunnelOrch* tunnel_orch = gDirectory.get<VxlanTunnelOrch*>();
+
+                    if (tunnel_orch->isDipTunnelsSupported())
                     {
-                        it = consumer.m_toSync.erase(it);
-                        continue;
+                        if(!remote_ip.length())
+                        {
+                            it = consumer.m_toSync.erase(it);
+                            continue;
+                        }
+                        port = tunnel_orch->getTunnelPortName(remote_ip);
+                    }
+                    else
+                    {
+                        EvpnNvoOrch* evpn_nvo_orch = gDirectory.get<EvpnNvoOrch*>();
+                        VxlanTunnel* sip_tunnel = evpn_nvo_orch->getEVPNVtep();
+                        if (sip_tunnel == NULL)
+                        {
+                            it = consumer.m_toSync.erase(it);
+                            continue;
+                        }
+                        port = tunnel_orch->getTunnelPortName(sip_tunnel->getSrcIP().to_string(), true);
                     }
-                    port = tunnel_orch->getTunnelPortName(remote_ip);
                 }
-                else
+
+
+                FdbData fdbData;
+                fdbData.bridge_port_id = SAI_NULL_OBJECT_ID;
+                fdbData.type = type;
+                fdbData.origin = origin;
+                fdbData.remote_ip = remote_ip;
+                fdbData.esi = esi;
+                fdbData.vni = vni;
+                fdbData.is_flush_pending = false;
+                if (addFdbEntry(entry, port, fdbData, &ctx))
                 {
-                    EvpnNvoOrch* evpn_nvo_orch = gDirectory.get<EvpnNvoOrch*>();
-                    VxlanTunnel* sip_tunnel = evpn_nvo_orch->getEVPNVtep();
-                    if (sip_tunnel == NULL)
+                    /* New entries are created when the bulker is flushed */
+                    if (ctx.bulked)
                     {
-                        it = consumer.m_toSync.erase(it);
+                        it++;
                         continue;
                     }
-                    port = tunnel_orch->getTunnelPortName(sip_tunnel->getSrcIP().to_string(), true);
-                }
-            }
 
+                    if (origin == FDB_ORIGIN_MCLAG_ADVERTIZED)
+                    {
+                        clearMclagFdbState(entry, op, type);
+                    }
 
-            FdbData fdbData;
-            fdbData.bridge_port_id = SAI_NULL_OBJECT_ID;
-            fdbData.type = type;
-            fdbData.origin = origin;
-            fdbData.remote_ip = remote_ip;
-            fdbData.esi = esi;
-            fdbData.vni = vni;
-            fdbData.is_flush_pending = false;
-            if (addFdbEntry(entry, port, fdbData))
+                    it = consumer.m_toSync.erase(it);
+                }
+                else
+                    it++;
+            }
+            else if (op == DEL_COMMAND)
             {
-                if (origin == FDB_ORIGIN_MCLAG_ADVERTIZED)
+                if (removeFdbEntry(entry, origin, &ctx))
                 {
-                    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
-                    if (type == "dynamic_local")
+                    if (ctx.bulked)
                     {
-                        m_mclagFdbStateTable.del(key);
+                        it++;
+                        continue;
                     }
-                }
-
-                if(origin == FDB_ORIGIN_VXLAN_ADVERTIZED)
-                {
-                    VxlanTunnelOrch* tunnel_orch = gDirectory.get<VxlanTunnelOrch*>();
 
-                    if(!remote_ip.length())
+                    if (origin == FDB_ORIGIN_MCLAG_ADVERTIZED)
                     {
-                        it = consumer.m_toSync.erase(it);
-                        continue;
+                        clearMclagFdbState(entry, op, "");
                     }
-                    port = tunnel_orch->getTunnelPortName(remote_ip);
+
+                    it = consumer.m_toSync.erase(it);
                 }
-                it = consumer.m_toSync.erase(it);
+                else
+                    it++;
+
             }
             else
-                it++;
+            {
+                SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
+                it = consumer.m_toSync.erase(it);
+            }
         }
-        else if (op == DEL_COMMAND)
+
+        // Flush the FDB bulker, so FDB entries will be written to syncd and ASIC
+        gFdbBulker.flush();
+
+        // Go through the bulker results
+        auto it_prev = consumer.m_toSync.begin();
+        while (it_prev != it)
         {
-            if (removeFdbEntry(entry, origin))
+            KeyOpFieldsValuesTuple t = it_prev->second;
+
+            string op = kfvOp(t);
+            auto found = toBulk.find(make_pair(kfvKey(t), op));
+            if (found == toBulk.end() || !found->second.bulked)
+            {
+                it_prev++;
+                continue;
+            }
+
+            const auto& ctx = found->second;
+
+            bool done = (op == SET_COMMAND) ? addFdbEntryPost(ctx) : removeFdbEntryPost(ctx);
+            if (done)
             {
                 if (origin == FDB_ORIGIN_MCLAG_ADVERTIZED)
                 {
-                    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
-                    m_mclagFdbStateTable.del(key);
-                    SWSS_LOG_NOTICE("fdbEvent: do Task Delete MCLAG FDB from state mclag remote fdb table: "
-                            "Mac: %s Vlan: %d ",entry.mac.to_string().c_str(), vlan.m_vlan_info.vlan_id );
+                    clearMclagFdbState(ctx.entry, op, ctx.fdbData.type);
                 }
 
-                it = consumer.m_toSync.erase(it);
+                it_prev = consumer.m_toSync.erase(it_prev);
             }
             else
-                it++;
-
+                it_prev++;
         }
-        else
+    }
+}
+
+/* Clean up the MCLAG remote FDB state once a task from MCLAG_FDB_TABLE is done */
+void FdbOrch::clearMclagFdbState(const FdbEntry& entry, const string& op, const string& type)
+{
+    Port vlan;
+    if (!m_portsOrch->getPort(entry.bv_id, vlan))
+    {
+        SWSS_LOG_NOTICE("Failed to locate vlan port from bv_id 0x%" PRIx64, entry.bv_id);
+        return;
+    }
+
+    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
+
+    if (op == SET_COMMAND)
+    {
+        if (type == "dynamic_local")
         {
-            SWSS_LOG_ERROR("Unknown operation type %s", op.c_str());
-            it = consumer.m_toSync.erase(it);
+            m_mclagFdbStateTable.del(key);
         }
     }
+    else
+    {
+        m_mclagFdbStateTable.del(key);
+        SWSS_LOG_NOTICE("fdbEvent: do Task Delete MCLAG FDB from state mclag remote fdb table: "
+                "Mac: %s Vlan: %d ",entry.mac.to_string().c_str(), vlan.m_vlan_info.vlan_id );
+    }
 }
 
 void FdbOrch::doTask(NotificationConsumer& consumer)
@@ -1082,15 +1243,26 @@ void FdbOrch::flushFDBEntries(sai_object_id_t bridge_port_oid,
     }
 
     if (SAI_STATUS_SUCCESS == rv) {
-        for (map<FdbEntry, FdbData>::iterator it = m_entries.begin();
-                it != m_entries.end(); it++)
+        if (bridge_port_oid != SAI_NULL_OBJECT_ID)
         {
-            if ((bridge_port_oid != SAI_NULL_OBJECT_ID &&
-                    it->second.bridge_port_id == bridge_port_oid) ||
-                    (vlan_oid != SAI_NULL_OBJECT_ID &&
-                    it->first.bv_id == vlan_oid))
+            auto port = m_entriesByBridgePort.find(bridge_port_oid);
+            if (port != m_entriesByBridgePort.end())
             {
-                it->second.is_flush_pending = true;
+                for (const auto& entry : port->second)
+                {
+                    m_entries[entry].is_flush_pending = true;
+                }
+            }
+        }
+        if (vlan_oid != SAI_NULL_OBJECT_ID)
+        {
+            auto vlan = m_entriesByBvId.find(vlan_oid);
+            if (vlan != m_entriesByBvId.end())
+            {
+                for (const auto& entry : vlan->second)
+                {
+                    m_entries[entry].is_flush_pending = true;
+                }
             }
         }
     }
@@ -1101,9 +1273,17 @@ void FdbOrch::notifyObserversFDBFlush(Port &port, sai_object_id_t& bvid)
     FdbFlushUpdate flushUpdate;
     flushUpdate.port = port;
 
-    for (auto itr = m_entries.begin(); itr != m_entries.end(); ++itr)
+    auto vlan = m_entriesByBvId.find(bvid);
+    if (vlan == m_entriesByBvId.end())
     {
-        if ((itr->first.port_name == port.m_alias) &&
+        return;
+    }
+
+    for (const auto& vlanEntry : vlan->second)
+    {
+        auto itr = m_entries.find(vlanEntry);
+        if ((itr != m_entries.end()) &&
+            (itr->first.port_name == port.m_alias) &&
             (itr->first.bv_id == bvid))
         {
             SWSS_LOG_INFO("Adding MAC learnt on [ port:%s , bvid:0x%" PRIx64 "]\
@@ -1187,7 +1367,7 @@ void FdbOrch::updateVlanMember(const VlanMemberUpdate& update)
 }
 
 bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
-        FdbData fdbData)
+        FdbData fdbData, FdbBulkContext *ctx)
 {
     Port vlan;
     Port port;
@@ -1427,16 +1607,25 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
         }
         if (oldPort.m_bridge_port_id != port.m_bridge_port_id)
         {
-            oldPort.m_fdb_count--;
-            m_portsOrch->setPort(oldPort.m_alias, oldPort);
-            port.m_fdb_count++;
-            m_portsOrch->setPort(port.m_alias, port);
+            m_portsOrch->updateFdbCount(oldPort, -1);
+            m_portsOrch->updateFdbCount(port, 1);
         }
     }
     else
     {
         SWSS_LOG_INFO("MAC-Create %s FDB %s in %s on %s", fdbData.type.c_str(), entry.mac.to_string().c_str(), vlan.m_alias.c_str(), port_name.c_str());
 
+        /* Create the entry in bulk, addFdbEntryPost() completes it after the flush */
+        if (ctx)
+        {
+            ctx->bulked = true;
+            ctx->entry = entry;
+            ctx->port_name = port_name;
+            ctx->fdbData = fdbData;
+            gFdbBulker.create_entry(&ctx->object_status, &fdb_entry, (uint32_t)attrs.size(), attrs.data());
+            return true;
+        }
+
         status = sai_fdb_api->create_fdb_entry(&fdb_entry, (uint32_t)attrs.size(), attrs.data());
         if (status != SAI_STATUS_SUCCESS)
         {
@@ -1449,10 +1638,52 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
                 return parseHandleSaiStatusFailure(handle_status);
             }
         }
-        port.m_fdb_count++;
-        m_portsOrch->setPort(port.m_alias, port);
-        vlan.m_fdb_count++;
-        m_portsOrch->setPort(vlan.m_alias, vlan);
+    }
+
+    completeFdbEntryAdd(entry, port_name, fdbData, macUpdate, oldOrigin);
+
+    return true;
+}
+
+bool FdbOrch::addFdbEntryPost(const FdbBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    if (ctx.object_status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("Failed to create %s FDB %s bv_id=0x%" PRIx64 " on %s, rv:%d",
+                ctx.fdbData.type.c_str(), ctx.entry.mac.to_string().c_str(),
+                ctx.entry.bv_id, ctx.port_name.c_str(), ctx.object_status);
+        task_process_status handle_status = handleSaiCreateStatus(SAI_API_FDB, ctx.object_status);
+        if (handle_status != task_success)
+        {
+            return parseHandleSaiStatusFailure(handle_status);
+        }
+    }
+
+    completeFdbEntryAdd(ctx.entry, ctx.port_name, ctx.fdbData, false, FDB_ORIGIN_INVALID);
+
+    return true;
+}
+
+/* Update the local state once the FDB entry is created or updated in SAI */
+void FdbOrch::completeFdbEntryAdd(const FdbEntry& entry, const string& port_name,
+        const FdbData& fdbData, bool macUpdate, FdbOrigin oldOrigin)
+{
+    Port vlan;
+    Port port;
+
+    if (!m_portsOrch->getPort(entry.bv_id, vlan) || !m_portsOrch->getPort(port_name, port))
+    {
+        SWSS_LOG_ERROR("Failed to locate vlan 0x%" PRIx64 " or port %s of FDB %s",
+                entry.bv_id, port_name.c_str(), entry.mac.to_string().c_str());
+        return;
+    }
+
+    if (!macUpdate)
+    {
+        m_portsOrch->updateFdbCount(port, 1);
+        m_portsOrch->updateFdbCount(vlan, 1);
     }
 
     FdbData storeFdbData = fdbData;
@@ -1466,7 +1697,7 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
         storeFdbData.type = "dynamic";
     }
 
-    m_entries[entry] = storeFdbData;
+    setFdbEntry(entry, storeFdbData);
 
     string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
 
@@ -1526,11 +1757,9 @@ bool FdbOrch::addFdbEntry(const FdbEntry& entry, const string& port_name,
     update.add = true;
 
     notify(SUBJECT_TYPE_FDB_CHANGE, &update);
-
-    return true;
 }
 
-bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
+bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin, FdbBulkContext *ctx)
 {
     Port vlan;
     Port port;
@@ -1592,14 +1821,21 @@ bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
         }
     }
 
-    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
-
     sai_status_t status;
     sai_fdb_entry_t fdb_entry;
     fdb_entry.switch_id = gSwitchId;
     memcpy(fdb_entry.mac_address, entry.mac.getMac(), sizeof(sai_mac_t));
     fdb_entry.bv_id = entry.bv_id;
 
+    /* Remove the entry in bulk, removeFdbEntryPost() completes it after the flush */
+    if (ctx)
+    {
+        ctx->bulked = true;
+        ctx->entry = entry;
+        gFdbBulker.remove_entry(&ctx->object_status, &fdb_entry);
+        return true;
+    }
+
     status = sai_fdb_api->remove_fdb_entry(&fdb_entry);
     if (status != SAI_STATUS_SUCCESS)
     {
@@ -1612,14 +1848,60 @@ bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
         }
     }
 
+    completeFdbEntryRemove(entry);
+
+    return true;
+}
+
+bool FdbOrch::removeFdbEntryPost(const FdbBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    if (ctx.object_status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("FdbOrch RemoveFDBEntry: Failed to remove FDB entry. mac=%s, bv_id=0x%" PRIx64 ", rv:%d",
+                       ctx.entry.mac.to_string().c_str(), ctx.entry.bv_id, ctx.object_status);
+        task_process_status handle_status = handleSaiRemoveStatus(SAI_API_FDB, ctx.object_status);
+        if (handle_status != task_success)
+        {
+            return parseHandleSaiStatusFailure(handle_status);
+        }
+    }
+
+    completeFdbEntryRemove(ctx.entry);
+
+    return true;
+}
+
+/* Update the local state once the FDB entry is removed from SAI */
+void FdbOrch::completeFdbEntryRemove(const FdbEntry& entry)
+{
+    Port vlan;
+    Port port;
+
+    auto it = m_entries.find(entry);
+    if (it == m_entries.end())
+    {
+        return;
+    }
+
+    FdbData fdbData = it->second;
+    if (!m_portsOrch->getPort(entry.bv_id, vlan) ||
+        !m_portsOrch->getPortByBridgePortId(fdbData.bridge_port_id, port))
+    {
+        SWSS_LOG_ERROR("Failed to locate vlan 0x%" PRIx64 " or bridge port 0x%" PRIx64 " of FDB %s",
+                entry.bv_id, fdbData.bridge_port_id, entry.mac.to_string().c_str());
+        return;
+    }
+
+    string key = "Vlan" + to_string(vlan.m_vlan_info.vlan_id) + ":" + entry.mac.to_string();
+
     SWSS_LOG_INFO("Removed mac=%s bv_id=0x%" PRIx64 " port:%s",
             entry.mac.to_string().c_str(), entry.bv_id, port.m_alias.c_str());
 
-    port.m_fdb_count--;
-    m_portsOrch->setPort(port.m_alias, port);
-    vlan.m_fdb_count--;
-    m_portsOrch->setPort(vlan.m_alias, vlan);
-    (void)m_entries.erase(entry);
+    m_portsOrch->updateFdbCount(port, -1);
+    m_portsOrch->updateFdbCount(vlan, -1);
+    (void)eraseFdbEntry(entry);
 
     // Remove in StateDb
     if ((fdbData.origin != FDB_ORIGIN_VXLAN_ADVERTIZED) && (fdbData.origin != FDB_ORIGIN_MCLAG_ADVERTIZED))
@@ -1638,8 +1920,6 @@ bool FdbOrch::removeFdbEntry(const FdbEntry& entry, FdbOrigin origin)
     notify(SUBJECT_TYPE_FDB_CHANGE, &update);
 
     notifyTunnelOrch(update.port);
-
-    return true;
 }
 
 void FdbOrch::deleteFdbEntryFromSavedFDB(const MacAddress &mac,
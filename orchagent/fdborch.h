@@ -4,6 +4,7 @@
 #include "orch.h"
 #include "observer.h"
 #include "portsorch.h"
+#include "bulker.h"
 
 enum FdbOrigin
 {
@@ -78,6 +79,24 @@ struct SavedFdbEntry
 
 typedef unordered_map<string, vector<SavedFdbEntry>> fdb_entries_by_port_t;
 
+struct FdbBulkContext
+{
+    sai_status_t                        object_status;      // Bulk status
+    bool                                bulked;             // SAI call is pending in the bulker
+    FdbEntry                            entry;
+    string                              port_name;
+    FdbData                             fdbData;
+
+    FdbBulkContext()
+        : object_status(SAI_STATUS_NOT_EXECUTED), bulked(false)
+    {
+    }
+
+    // Disable any copy constructors
+    FdbBulkContext(const FdbBulkContext&) = delete;
+    FdbBulkContext(FdbBulkContext&&) = delete;
+};
+
 class FdbOrch: public Orch, public Subject, public Observer
 {
 public:
@@ -95,7 +114,7 @@ public:
     void update(SubjectType type, void *cntx);
     bool getPort(const MacAddress&, uint16_t, Port&);
 
-    bool removeFdbEntry(const FdbEntry& entry, FdbOrigin origin=FDB_ORIGIN_PROVISIONED);
+    bool removeFdbEntry(const FdbEntry& entry, FdbOrigin origin=FDB_ORIGIN_PROVISIONED, FdbBulkContext *ctx=nullptr);
 
     static const int fdborch_pri;
     void flushFDBEntries(sai_object_id_t bridge_port_oid,
@@ -105,12 +124,16 @@ public:
 private:
     PortsOrch *m_portsOrch;
     map<FdbEntry, FdbData> m_entries;
+    /* Secondary indices of m_entries, maintained by setFdbEntry() and eraseFdbEntry() */
+    map<sai_object_id_t, set<FdbEntry>> m_entriesByBridgePort;
+    map<sai_object_id_t, set<FdbEntry>> m_entriesByBvId;
     fdb_entries_by_port_t saved_fdb_entries;
     vector<Table*> m_appTables;
     Table m_fdbStateTable;
     Table m_mclagFdbStateTable;
     NotificationConsumer* m_flushNotificationsConsumer;
     NotificationConsumer* m_fdbNotificationConsumer;
+    EntityBulker<sai_fdb_api_t> gFdbBulker;
 
     void doTask(Consumer& consumer);
     void doTask(NotificationConsumer& consumer);
@@ -118,10 +141,18 @@ private:
     void updateVlanMember(const VlanMemberUpdate&);
     void updatePortOperState(const PortOperStateUpdate&);
 
-    bool addFdbEntry(const FdbEntry&, const string&, FdbData fdbData);
+    bool addFdbEntry(const FdbEntry&, const string&, FdbData fdbData, FdbBulkContext *ctx=nullptr);
+    bool addFdbEntryPost(const FdbBulkContext& ctx);
+    bool removeFdbEntryPost(const FdbBulkContext& ctx);
+    void completeFdbEntryAdd(const FdbEntry&, const string&, const FdbData&, bool macUpdate, FdbOrigin oldOrigin);
+    void completeFdbEntryRemove(const FdbEntry&);
+    void clearMclagFdbState(const FdbEntry&, const string& op, const string& type);
     void deleteFdbEntryFromSavedFDB(const MacAddress &mac, const unsigned short &vlanId, FdbOrigin origin, const string portName="");
 
     bool storeFdbEntryState(const FdbUpdate& update);
+    void setFdbEntry(const FdbEntry&, const FdbData&);
+    bool eraseFdbEntry(const FdbEntry&);
+    vector<FdbEntry> getFdbEntries(sai_object_id_t bridge_port_id, sai_object_id_t bv_id) const;
     void notifyTunnelOrch(Port& port);
 
     void clearFdbEntry(const FdbEntry&);
@@ -43,67 +43,77 @@ void FgNhgOrch::update(SubjectType type, void *cntx)
     switch(type) {
         case SUBJECT_TYPE_PORT_OPER_STATE_CHANGE:
         {
-            PortOperStateUpdate *update = reinterpret_cast<PortOperStateUpdate *>(cntx);
-            for (auto &fgNhgEntry : m_FgNhgs)
+            PortOperStateUpdates *updates = reinterpret_cast<PortOperStateUpdates *>(cntx);
+            for (const auto &update : updates->updates)
             {
-                auto entry = fgNhgEntry.second.links.find(update->port.m_alias);
-                if (entry != fgNhgEntry.second.links.end())
+                updatePortOperState(update);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void FgNhgOrch::updatePortOperState(const PortOperStateUpdate &update)
+{
+    SWSS_LOG_ENTER();
+
+    for (auto &fgNhgEntry : m_FgNhgs)
+    {
+        auto entry = fgNhgEntry.second.links.find(update.port.m_alias);
+        if (entry != fgNhgEntry.second.links.end())
+        {
+            for (auto ip : entry->second)
+            {
+                NextHopKey nhk;
+                MacAddress macAddress;
+                auto nexthop_entry = fgNhgEntry.second.next_hops.find(ip);
+
+                if (update.operStatus == SAI_PORT_OPER_STATUS_UP)
                 {
-                    for (auto ip : entry->second)
+                    if (nexthop_entry == fgNhgEntry.second.next_hops.end())
                     {
-                        NextHopKey nhk;
-                        MacAddress macAddress;
-                        auto nexthop_entry = fgNhgEntry.second.next_hops.find(ip);
-
-                        if (update->operStatus == SAI_PORT_OPER_STATUS_UP)
-                        {
-                            if (nexthop_entry == fgNhgEntry.second.next_hops.end())
-                            {
-                                SWSS_LOG_WARN("Hit unexpected condition where structs are out of sync");
-                            }
-                            nexthop_entry->second.link_oper_state = LINK_UP;
-                            SWSS_LOG_INFO("Updated %s associated with %s to state up",
-                                    update->port.m_alias.c_str(), ip.to_string().c_str());
-
-                            if (!m_neighOrch->getNeighborEntry(ip, nhk, macAddress))
-                            {
-                                continue;
-                            }
- 
-                            if (!validNextHopInNextHopGroup(nhk))
-                            {
-                                SWSS_LOG_WARN("Failed validNextHopInNextHopGroup for nh %s ip %s",
-                                        nhk.to_string().c_str(), ip.to_string().c_str());
-                            }
-                        }
-                        else if (update->operStatus == SAI_PORT_OPER_STATUS_DOWN)
-                        {
-                            if (nexthop_entry == fgNhgEntry.second.next_hops.end())
-                            {
-                                SWSS_LOG_WARN("Hit unexpected condition where structs are out of sync");
-                            }
-                            nexthop_entry->second.link_oper_state = LINK_DOWN;
-                            SWSS_LOG_INFO("Updated %s associated with %s to state down",
-                                    update->port.m_alias.c_str(), ip.to_string().c_str());
-
-                            if (!m_neighOrch->getNeighborEntry(ip, nhk, macAddress))
-                            {
-                                continue;
-                            }
-
-                            if (!invalidNextHopInNextHopGroup(nhk))
-                            {
-                                SWSS_LOG_WARN("Failed validNextHopInNextHopGroup for nh %s ip %s",
-                                        nhk.to_string().c_str(), ip.to_string().c_str());
-                            }
-                        }
+                        SWSS_LOG_WARN("Hit unexpected condition where structs are out of sync");
+                    }
+                    nexthop_entry->second.link_oper_state = LINK_UP;
+                    SWSS_LOG_INFO("Updated %s associated with %s to state up",
+                            update.port.m_alias.c_str(), ip.to_string().c_str());
+
+                    if (!m_neighOrch->getNeighborEntry(ip, nhk, macAddress))
+                    {
+                        continue;
+                    }
+
+                    if (!validNextHopInNextHopGroup(nhk))
+                    {
+                        SWSS_LOG_WARN("Failed validNextHopInNextHopGroup for nh %s ip %s",
+                                nhk.to_string().c_str(), ip.to_string().c_str());
+                    }
+                }
+                else if (update.operStatus == SAI_PORT_OPER_STATUS_DOWN)
+                {
+                    if (nexthop_entry == fgNhgEntry.second.next_hops.end())
+                    {
+                        SWSS_LOG_WARN("Hit unexpected condition where structs are out of sync");
+                    }
+                    nexthop_entry->second.link_oper_state = LINK_DOWN;
+                    SWSS_LOG_INFO("Updated %s associated with %s to state down",
+                            update.port.m_alias.c_str(), ip.to_string().c_str());
+
+                    if (!m_neighOrch->getNeighborEntry(ip, nhk, macAddress))
+                    {
+                        continue;
+                    }
+
+                    if (!invalidNextHopInNextHopGroup(nhk))
+                    {
+                        SWSS_LOG_WARN("Failed validNextHopInNextHopGroup for nh %s ip %s",
+                                nhk.to_string().c_str(), ip.to_string().c_str());
                     }
                 }
             }
-            break;
         }
-        default:
-            break;
     }
 }
 
@@ -630,25 +630,28 @@ void FlowCounterRouteOrch::createRouteFlowCounterByPattern(const RoutePattern &r
     {
         SWSS_LOG_NOTICE("Creating route flow counter for pattern %s", route_pattern.to_string().c_str());
 
-        for (auto &entry : iter->second)
+        /* Only routes within the pattern prefix can match, walk that subtree
+         * until the pattern has bound max_match_count routes */
+        iter->second.forEachInSubnet(route_pattern.ip_prefix, [&](const RouteTable::value_type &entry)
         {
-            if (current_bound_count == route_pattern.max_match_count)
+            if (current_bound_count >= route_pattern.max_match_count)
             {
-                return;
+                return false;
             }
 
-            if (route_pattern.is_match(route_pattern.vrf_id, entry.first))
+            if (route_pattern.is_match(route_pattern.vrf_id, entry.first) &&
+                !isRouteAlreadyBound(route_pattern, entry.first) &&
+                bindFlowCounter(route_pattern, route_pattern.vrf_id, entry.first))
             {
-                if (isRouteAlreadyBound(route_pattern, entry.first))
-                {
-                    continue;
-                }
-
-                if (bindFlowCounter(route_pattern, route_pattern.vrf_id, entry.first))
-                {
-                    ++current_bound_count;
-                }
+                ++current_bound_count;
             }
+
+            return current_bound_count < route_pattern.max_match_count;
+        });
+
+        if (current_bound_count == route_pattern.max_match_count)
+        {
+            return;
         }
     }
 
@@ -0,0 +1,482 @@
+#include "rate_counter_manager.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <unordered_set>
+
+#include "schema.h"
+#include "rediscommand.h"
+#include "redisreply.h"
+#include "logger.h"
+
+using std::string;
+using std::unordered_set;
+using std::vector;
+using swss::DBConnector;
+using swss::FieldValueTuple;
+using swss::RedisCommand;
+using swss::RedisPipeline;
+using swss::RedisReply;
+using swss::Table;
+
+#define RATES_TABLE         "RATES"
+#define RATES_INIT_FIELD    "INIT_DONE"
+#define RATES_INIT_LAST     "COUNTERS_LAST"
+#define RATES_INIT_DONE     "DONE"
+#define RATES_LAST_SUFFIX   "_last"
+#define RATES_ALPHA_SUFFIX  "_ALPHA"
+#define RATES_POLL_TIME_SUFFIX  "_POLL_TIME"
+
+namespace
+{
+    // Same representation as tostring() of a Lua number
+    string formatRate(double value)
+    {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%.14g", value);
+        return buf;
+    }
+
+    void appendCommand(redisContext *ctx, const RedisCommand& command)
+    {
+        if (redisAppendFormattedCommand(ctx, command.c_str(), command.length()) != REDIS_OK)
+        {
+            throw std::runtime_error("Failed to queue rates read");
+        }
+    }
+
+    redisReply *getReply(redisContext *ctx)
+    {
+        redisReply *reply = nullptr;
+        if (redisGetReply(ctx, reinterpret_cast<void **>(&reply)) != REDIS_OK)
+        {
+            throw std::runtime_error("Failed to read rates");
+        }
+        return reply;
+    }
+
+    bool getString(const redisReply *reply, string& value)
+    {
+        if (reply->type != REDIS_REPLY_STRING)
+        {
+            return false;
+        }
+
+        value.assign(reply->str, reply->len);
+        return true;
+    }
+}
+
+RateCounterManager::RateCounterManager(
+        const string& rate_type,
+        const string& name_map,
+        const vector<RateCounterSpec>& rates,
+        const bool missing_as_zero) :
+    rate_type(rate_type),
+    name_map(name_map),
+    missing_as_zero(missing_as_zero)
+{
+    SWSS_LOG_ENTER();
+
+    for (const auto& rate : rates)
+    {
+        rate_fields.push_back(rate.rate_field);
+        rate_offsets.push_back(rate_counters.size());
+
+        for (const auto& stat : rate.counter_stats)
+        {
+            size_t index = 0;
+            while (index < counter_stats.size() && counter_stats[index] != stat)
+            {
+                index++;
+            }
+
+            if (index == counter_stats.size())
+            {
+                counter_stats.push_back(stat);
+            }
+
+            rate_counters.push_back(index);
+        }
+    }
+    rate_offsets.push_back(rate_counters.size());
+
+    counters_db = std::make_shared<DBConnector>("COUNTERS_DB", 0);
+    rates_pipeline = std::unique_ptr<RedisPipeline>(new RedisPipeline(counters_db.get()));
+    rates_table = std::unique_ptr<Table>(new Table(rates_pipeline.get(), RATES_TABLE, true));
+    name_map_table = std::unique_ptr<Table>(new Table(counters_db.get(), name_map));
+}
+
+void RateCounterManager::poll()
+{
+    SWSS_LOG_ENTER();
+
+    if (objects_changed)
+    {
+        refreshObjects();
+        objects_changed = false;
+    }
+
+    if (object_ids.empty())
+    {
+        return;
+    }
+
+    double alpha;
+    uint64_t poll_time;
+    if (!readCounters(alpha, poll_time))
+    {
+        return;
+    }
+
+    double delta = polled ? static_cast<double>(poll_time - last_poll_time) : 0;
+    last_poll_time = poll_time;
+    polled = true;
+
+    const size_t counter_count = counter_stats.size();
+    const size_t rate_count = rate_fields.size();
+    const size_t object_count = object_ids.size();
+
+    // Objects whose RATES entries are to be written
+    vector<bool> dirty(object_count, false);
+
+    for (size_t i = 0; i < object_count; i++)
+    {
+        if (!valid[i])
+        {
+            continue;
+        }
+
+        string *raw = &current_raw[i * counter_count];
+        string *read = &read_raw[i * counter_count];
+        double *cur = &current[i * counter_count];
+        double *prev = &last[i * counter_count];
+
+        for (size_t c = 0; c < counter_count; c++)
+        {
+            prev[c] = cur[c];
+            if (raw[c] != read[c])
+            {
+                raw[c].swap(read[c]);
+                cur[c] = strtod(raw[c].c_str(), nullptr);
+                dirty[i] = true;
+            }
+        }
+    }
+
+    if (delta > 0)
+    {
+        for (size_t i = 0; i < object_count; i++)
+        {
+            if (!valid[i] || init_state[i] == InitState::NONE)
+            {
+                continue;
+            }
+
+            double *smoothed = &rates[i * rate_count];
+
+            // Nothing to update for an idle object whose rates have already decayed
+            if (!dirty[i] && init_state[i] == InitState::DONE &&
+                std::all_of(smoothed, smoothed + rate_count, [](double rate) { return rate == 0; }))
+            {
+                continue;
+            }
+
+            const double *cur = &current[i * counter_count];
+            const double *prev = &last[i * counter_count];
+            double *out = &new_rates[i * rate_count];
+
+            for (size_t r = 0; r < rate_count; r++)
+            {
+                double diff = 0;
+                for (size_t k = rate_offsets[r]; k < rate_offsets[r + 1]; k++)
+                {
+                    diff += cur[rate_counters[k]] - prev[rate_counters[k]];
+                }
+                out[r] = diff / delta * 1000;
+            }
+
+            // The first rates of an object are stored unsmoothed
+            const double weight = init_state[i] == InitState::DONE ? alpha : 1.0;
+
+            for (size_t r = 0; r < rate_count; r++)
+            {
+                smoothed[r] = weight * out[r] + (1.0 - weight) * smoothed[r];
+            }
+            dirty[i] = true;
+        }
+    }
+
+    writeRates(dirty);
+}
+
+void RateCounterManager::clear()
+{
+    SWSS_LOG_ENTER();
+
+    object_index.clear();
+    object_ids.clear();
+    init_state.clear();
+    valid.clear();
+    read_raw.clear();
+    current_raw.clear();
+    current.clear();
+    last.clear();
+    rates.clear();
+    new_rates.clear();
+    polled = false;
+    objects_changed = true;
+}
+
+void RateCounterManager::invalidateObjects()
+{
+    objects_changed = true;
+}
+
+void RateCounterManager::refreshObjects()
+{
+    vector<FieldValueTuple> fvs;
+    name_map_table->get("", fvs);
+
+    unordered_set<string> oids;
+    for (const auto& fv : fvs)
+    {
+        oids.insert(fvValue(fv));
+    }
+
+    for (size_t i = object_ids.size(); i > 0; i--)
+    {
+        if (!oids.count(object_ids[i - 1]))
+        {
+            removeObject(i - 1);
+        }
+    }
+
+    for (const auto& oid : oids)
+    {
+        if (!object_index.count(oid))
+        {
+            addObject(oid);
+        }
+    }
+}
+
+void RateCounterManager::addObject(const string& oid)
+{
+    object_index[oid] = object_ids.size();
+    object_ids.push_back(oid);
+    init_state.push_back(InitState::NONE);
+    valid.push_back(false);
+    read_raw.resize(read_raw.size() + counter_stats.size());
+    current_raw.resize(current_raw.size() + counter_stats.size());
+    current.resize(current.size() + counter_stats.size(), 0);
+    last.resize(last.size() + counter_stats.size(), 0);
+    rates.resize(rates.size() + rate_fields.size(), 0);
+    new_rates.resize(new_rates.size() + rate_fields.size(), 0);
+}
+
+void RateCounterManager::removeObject(size_t index)
+{
+    const size_t back = object_ids.size() - 1;
+    const size_t counter_count = counter_stats.size();
+    const size_t rate_count = rate_fields.size();
+
+    object_index.erase(object_ids[index]);
+
+    // Move the last object into the freed slot to keep the arrays contiguous
+    if (index != back)
+    {
+        object_ids[index] = std::move(object_ids[back]);
+        object_index[object_ids[index]] = index;
+        init_state[index] = init_state[back];
+        valid[index] = valid[back];
+
+        for (size_t c = 0; c < counter_count; c++)
+        {
+            current_raw[index * counter_count + c] = std::move(current_raw[back * counter_count + c]);
+            current[index * counter_count + c] = current[back * counter_count + c];
+            last[index * counter_count + c] = last[back * counter_count + c];
+        }
+
+        for (size_t r = 0; r < rate_count; r++)
+        {
+            rates[index * rate_count + r] = rates[back * rate_count + r];
+            new_rates[index * rate_count + r] = new_rates[back * rate_count + r];
+        }
+    }
+
+    object_ids.pop_back();
+    init_state.pop_back();
+    valid.pop_back();
+    read_raw.resize(back * counter_count);
+    current_raw.resize(back * counter_count);
+    current.resize(back * counter_count);
+    last.resize(back * counter_count);
+    rates.resize(back * rate_count);
+    new_rates.resize(back * rate_count);
+}
+
+bool RateCounterManager::readCounters(double& alpha, uint64_t& poll_time)
+{
+    const size_t counter_count = counter_stats.size();
+    const string rates_key = string(RATES_TABLE) + ":" + rate_type;
+    const string alpha_field = rate_type + RATES_ALPHA_SUFFIX;
+    const string poll_time_field = rate_type + RATES_POLL_TIME_SUFFIX;
+    redisContext *ctx = counters_db->getContext();
+
+    vector<const char *> argv(counter_count + 2);
+    vector<size_t> argvlen(counter_count + 2);
+
+    argv[0] = "HMGET";
+    argvlen[0] = 5;
+    for (size_t c = 0; c < counter_count; c++)
+    {
+        argv[c + 2] = counter_stats[c].c_str();
+        argvlen[c + 2] = counter_stats[c].size();
+    }
+
+    // Queue the reads of all objects between two reads of the syncd poll
+    // time, then collect the replies in one round trip
+    RedisCommand config;
+    config.format("HMGET %s %s %s", rates_key.c_str(), alpha_field.c_str(), poll_time_field.c_str());
+    appendCommand(ctx, config);
+
+    for (const auto& oid : object_ids)
+    {
+        string key = string(COUNTERS_TABLE) + ":" + oid;
+        argv[1] = key.c_str();
+        argvlen[1] = key.size();
+
+        RedisCommand command;
+        command.formatArgv(static_cast<int>(argv.size()), argv.data(), argvlen.data());
+        appendCommand(ctx, command);
+    }
+
+    RedisCommand check;
+    check.format("HGET %s %s", rates_key.c_str(), poll_time_field.c_str());
+    appendCommand(ctx, check);
+
+    string alpha_value;
+    string poll_time_value;
+    {
+        RedisReply r(getReply(ctx));
+        redisReply *reply = r.getContext();
+
+        if (reply->type == REDIS_REPLY_ARRAY && reply->elements == 2)
+        {
+            getString(reply->element[0], alpha_value);
+            getString(reply->element[1], poll_time_value);
+        }
+    }
+
+    for (size_t i = 0; i < object_ids.size(); i++)
+    {
+        RedisReply r(getReply(ctx));
+        redisReply *reply = r.getContext();
+
+        valid[i] = reply->type == REDIS_REPLY_ARRAY && reply->elements == counter_count;
+
+        for (size_t c = 0; valid[i] && c < counter_count; c++)
+        {
+            string &raw = read_raw[i * counter_count + c];
+
+            if (getString(reply->element[c], raw))
+            {
+                continue;
+            }
+
+            if (missing_as_zero)
+            {
+                raw = "0";
+            }
+            else
+            {
+                SWSS_LOG_INFO("Not found some counters on %s", object_ids[i].c_str());
+                valid[i] = false;
+            }
+        }
+    }
+
+    string poll_time_check;
+    {
+        RedisReply r(getReply(ctx));
+        getString(r.getContext(), poll_time_check);
+    }
+
+    if (alpha_value.empty())
+    {
+        SWSS_LOG_INFO("%s alpha is not defined", rate_type.c_str());
+        return false;
+    }
+
+    if (poll_time_value.empty())
+    {
+        SWSS_LOG_INFO("%s poll time is not recorded yet", rate_type.c_str());
+        return false;
+    }
+
+    // A syncd poll that completed during the read may have updated only some of the objects
+    if (poll_time_check != poll_time_value)
+    {
+        SWSS_LOG_INFO("%s counters were polled during the read", rate_type.c_str());
+        return false;
+    }
+
+    poll_time = strtoull(poll_time_value.c_str(), nullptr, 10);
+    if (polled && poll_time <= last_poll_time)
+    {
+        return false;
+    }
+
+    alpha = strtod(alpha_value.c_str(), nullptr);
+    return true;
+}
+
+void RateCounterManager::writeRates(const vector<bool>& dirty)
+{
+    const size_t counter_count = counter_stats.size();
+    const size_t rate_count = rate_fields.size();
+
+    for (size_t i = 0; i < object_ids.size(); i++)
+    {
+        if (!valid[i] || (!dirty[i] && init_state[i] == InitState::DONE))
+        {
+            continue;
+        }
+
+        const double *smoothed = &rates[i * rate_count];
+
+        const string& oid = object_ids[i];
+        vector<FieldValueTuple> fvs;
+
+        if (init_state[i] != InitState::NONE)
+        {
+            for (size_t r = 0; r < rate_count; r++)
+            {
+                fvs.emplace_back(rate_fields[r], formatRate(smoothed[r]));
+            }
+        }
+
+        for (size_t c = 0; c < counter_count; c++)
+        {
+            fvs.emplace_back(counter_stats[c] + RATES_LAST_SUFFIX, current_raw[i * counter_count + c]);
+        }
+
+        rates_table->set(oid, fvs);
+
+        if (init_state[i] == InitState::NONE)
+        {
+            rates_table->set(oid + ":" + rate_type, { { RATES_INIT_FIELD, RATES_INIT_LAST } });
+            init_state[i] = InitState::COUNTERS_LAST;
+        }
+        else if (init_state[i] == InitState::COUNTERS_LAST)
+        {
+            rates_table->set(oid + ":" + rate_type, { { RATES_INIT_FIELD, RATES_INIT_DONE } });
+            init_state[i] = InitState::DONE;
+        }
+    }
+
+    rates_pipeline->flush();
+}
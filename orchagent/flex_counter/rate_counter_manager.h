@@ -0,0 +1,109 @@
+#ifndef ORCHAGENT_RATE_COUNTER_MANAGER_H
+#define ORCHAGENT_RATE_COUNTER_MANAGER_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "dbconnector.h"
+#include "redispipeline.h"
+#include "table.h"
+
+// A rate computed from the sum of the deltas of one or more counters.
+struct RateCounterSpec
+{
+    std::string rate_field;
+    std::vector<std::string> counter_stats;
+};
+
+// RateCounterManager computes the RATES table of a group of flex counters
+// from the counters syncd polls into COUNTERS_DB.
+//
+// It replaces the rates Lua plugins that ran inside redis after every poll.
+// The output is the same: RATES:<oid> holds the smoothed rates and the
+// <stat>_last counter values, RATES:<oid>:<type> holds INIT_DONE, and the
+// smoothing factor is read from <type>_ALPHA of RATES:<type>. Counter values
+// and rates are kept in contiguous per-object arrays. Each poll reads the
+// counters of all objects in one pipelined round trip and writes all rates
+// back in one pipelined batch.
+//
+// The rates plugin of the group only records the time of each syncd poll in
+// <type>_POLL_TIME of RATES:<type>. Rates are computed when that time has
+// moved, over the time between the two syncd polls.
+class RateCounterManager
+{
+    public:
+        RateCounterManager(
+                const std::string& rate_type,
+                const std::string& name_map,
+                const std::vector<RateCounterSpec>& rates,
+                const bool missing_as_zero = false);
+
+        RateCounterManager(const RateCounterManager&) = delete;
+        RateCounterManager& operator=(const RateCounterManager&) = delete;
+
+        // Objects are those of the COUNTERS_DB name map of the group
+        void poll();
+        void clear();
+        // The name map is read again on the next poll
+        void invalidateObjects();
+
+        const std::string& getRateType() const
+        {
+            return rate_type;
+        }
+
+        const std::string& getNameMap() const
+        {
+            return name_map;
+        }
+
+    private:
+        enum class InitState : uint8_t
+        {
+            NONE,
+            COUNTERS_LAST,
+            DONE
+        };
+
+        void refreshObjects();
+        void addObject(const std::string& oid);
+        void removeObject(size_t index);
+        bool readCounters(double& alpha, uint64_t& poll_time);
+        void writeRates(const std::vector<bool>& dirty);
+
+        std::string rate_type;
+        std::string name_map;
+        bool missing_as_zero;
+
+        std::vector<std::string> counter_stats;
+        std::vector<std::string> rate_fields;
+        // Per rate, index of the first counter of the rate in rate_counters
+        std::vector<size_t> rate_offsets;
+        std::vector<size_t> rate_counters;
+
+        std::unordered_map<std::string, size_t> object_index;
+        std::vector<std::string> object_ids;
+        std::vector<InitState> init_state;
+        std::vector<bool> valid;
+        // Per object arrays of counter_stats.size() and rate_fields.size() values
+        std::vector<std::string> read_raw;
+        std::vector<std::string> current_raw;
+        std::vector<double> current;
+        std::vector<double> last;
+        std::vector<double> rates;
+        std::vector<double> new_rates;
+
+        // Time in milliseconds of the last syncd poll the rates were computed for
+        uint64_t last_poll_time = 0;
+        bool polled = false;
+        bool objects_changed = true;
+
+        std::shared_ptr<swss::DBConnector> counters_db;
+        std::unique_ptr<swss::RedisPipeline> rates_pipeline;
+        std::unique_ptr<swss::Table> rates_table;
+        std::unique_ptr<swss::Table> name_map_table;
+};
+
+#endif // ORCHAGENT_RATE_COUNTER_MANAGER_H
@@ -3,6 +3,7 @@
 #include "fabricportsorch.h"
 #include "select.h"
 #include "notifier.h"
+#include "redisapi.h"
 #include "sai_serialize.h"
 #include "pfcwdorch.h"
 #include "bufferorch.h"
@@ -36,6 +37,11 @@ extern FlowCounterRouteOrch *gFlowCounterRouteOrch;
 #define FLOW_CNT_TRAP_KEY           "FLOW_CNT_TRAP"
 #define FLOW_CNT_ROUTE_KEY          "FLOW_CNT_ROUTE"
 
+#define PORT_RATE_POLL_MSECS        1000
+#define RIF_RATE_POLL_MSECS         1000
+#define TUNNEL_RATE_POLL_MSECS      10000
+#define TRAP_RATE_POLL_MSECS        10000
+
 unordered_map<string, string> flexCounterGroupMap =
 {
     {"PORT", PORT_STAT_COUNTER_FLEX_COUNTER_GROUP},
@@ -68,9 +74,37 @@ FlexCounterOrch::FlexCounterOrch(DBConnector *db, vector<string> &tableNames):
     m_flexCounterDb(new DBConnector("FLEX_COUNTER_DB", 0)),
     m_flexCounterGroupTable(new ProducerTable(m_flexCounterDb.get(), FLEX_COUNTER_GROUP_TABLE)),
     m_gbflexCounterDb(new DBConnector("GB_FLEX_COUNTER_DB", 0)),
-    m_gbflexCounterGroupTable(new ProducerTable(m_gbflexCounterDb.get(), FLEX_COUNTER_GROUP_TABLE))
+    m_gbflexCounterGroupTable(new ProducerTable(m_gbflexCounterDb.get(), FLEX_COUNTER_GROUP_TABLE)),
+    m_countersDb(new DBConnector("COUNTERS_DB", 0))
 {
     SWSS_LOG_ENTER();
+
+    /* The rates plugin only records the time of each syncd poll, the rates are computed here */
+    addRateCounterPoller(PORT_KEY, PORT_PLUGIN_FIELD, new RateCounterManager("PORT", COUNTERS_PORT_NAME_MAP, {
+            { "RX_BPS", { "SAI_PORT_STAT_IF_IN_OCTETS" } },
+            { "RX_PPS", { "SAI_PORT_STAT_IF_IN_UCAST_PKTS", "SAI_PORT_STAT_IF_IN_NON_UCAST_PKTS" } },
+            { "TX_BPS", { "SAI_PORT_STAT_IF_OUT_OCTETS" } },
+            { "TX_PPS", { "SAI_PORT_STAT_IF_OUT_UCAST_PKTS", "SAI_PORT_STAT_IF_OUT_NON_UCAST_PKTS" } },
+        }), PORT_RATE_POLL_MSECS);
+
+    addRateCounterPoller(RIF_KEY, RIF_PLUGIN_FIELD, new RateCounterManager("RIF", COUNTERS_RIF_NAME_MAP, {
+            { "RX_BPS", { "SAI_ROUTER_INTERFACE_STAT_IN_OCTETS" } },
+            { "RX_PPS", { "SAI_ROUTER_INTERFACE_STAT_IN_PACKETS" } },
+            { "TX_BPS", { "SAI_ROUTER_INTERFACE_STAT_OUT_OCTETS" } },
+            { "TX_PPS", { "SAI_ROUTER_INTERFACE_STAT_OUT_PACKETS" } },
+        }), RIF_RATE_POLL_MSECS);
+
+    /* Tunnels may not support all the stats, missing ones count as zero */
+    addRateCounterPoller(TUNNEL_KEY, TUNNEL_PLUGIN_FIELD, new RateCounterManager("TUNNEL", COUNTERS_TUNNEL_NAME_MAP, {
+            { "RX_BPS", { "SAI_TUNNEL_STAT_IN_OCTETS" } },
+            { "RX_PPS", { "SAI_TUNNEL_STAT_IN_PACKETS" } },
+            { "TX_BPS", { "SAI_TUNNEL_STAT_OUT_OCTETS" } },
+            { "TX_PPS", { "SAI_TUNNEL_STAT_OUT_PACKETS" } },
+        }, true), TUNNEL_RATE_POLL_MSECS);
+
+    addRateCounterPoller(FLOW_CNT_TRAP_KEY, FLOW_COUNTER_PLUGIN_FIELD, new RateCounterManager("TRAP", COUNTERS_TRAP_NAME_MAP, {
+            { "RX_PPS", { "SAI_COUNTER_STAT_PACKETS" } },
+        }), TRAP_RATE_POLL_MSECS);
 }
 
 FlexCounterOrch::~FlexCounterOrch(void)
@@ -78,6 +112,106 @@ FlexCounterOrch::~FlexCounterOrch(void)
     SWSS_LOG_ENTER();
 }
 
+void FlexCounterOrch::addRateCounterPoller(const string &key, const string &pluginField,
+                                           RateCounterManager *manager, uint32_t pollIntervalMs)
+{
+    try
+    {
+        /* syncd passes no counter type to plugins, so each type loads the
+         * shared plugin with its type defined ahead of it */
+        string rateLuaScript = "local rate_type = '" + manager->getRateType() + "'\n" +
+                               swss::loadLuaScript("rates.lua");
+        string rateSha = swss::loadRedisScript(m_countersDb.get(), rateLuaScript);
+
+        vector<FieldValueTuple> fieldValues;
+        fieldValues.emplace_back(pluginField, rateSha);
+        m_flexCounterGroupTable->set(flexCounterGroupMap[key], fieldValues);
+    }
+    catch (const runtime_error &e)
+    {
+        SWSS_LOG_WARN("%s flex counter group plugin was not set successfully: %s", key.c_str(), e.what());
+    }
+
+    auto interval = timespec { .tv_sec = (time_t)(pollIntervalMs / 1000), .tv_nsec = (long)(pollIntervalMs % 1000) * 1000000 };
+    auto timer = new SelectableTimer(interval);
+    Orch::addExecutor(new ExecutableTimer(timer, this, manager->getRateType() + "_RATES_TIMER"));
+
+    auto &poller = m_rateCounterPollers[key];
+    poller.manager = unique_ptr<RateCounterManager>(manager);
+    poller.timer = timer;
+    poller.enabled = false;
+}
+
+void FlexCounterOrch::refreshRateCounterObjects(const string &nameMap)
+{
+    for (auto &it : m_rateCounterPollers)
+    {
+        if (it.second.manager->getNameMap() == nameMap)
+        {
+            it.second.manager->invalidateObjects();
+        }
+    }
+}
+
+void FlexCounterOrch::setRateCounterInterval(const string &key, const string &pollIntervalMs)
+{
+    auto it = m_rateCounterPollers.find(key);
+    if (it == m_rateCounterPollers.end())
+    {
+        return;
+    }
+
+    uint32_t interval = static_cast<uint32_t>(strtoul(pollIntervalMs.c_str(), nullptr, 10));
+    if (interval == 0)
+    {
+        SWSS_LOG_WARN("Invalid %s poll interval %s", key.c_str(), pollIntervalMs.c_str());
+        return;
+    }
+
+    auto &poller = it->second;
+    poller.timer->setInterval(timespec { .tv_sec = (time_t)(interval / 1000), .tv_nsec = (long)(interval % 1000) * 1000000 });
+    if (poller.enabled)
+    {
+        poller.timer->reset();
+    }
+}
+
+void FlexCounterOrch::setRateCounterStatus(const string &key, const string &status)
+{
+    auto it = m_rateCounterPollers.find(key);
+    if (it == m_rateCounterPollers.end())
+    {
+        return;
+    }
+
+    auto &poller = it->second;
+    if (status == "enable" && !poller.enabled)
+    {
+        poller.timer->start();
+        poller.enabled = true;
+    }
+    else if (status == "disable" && poller.enabled)
+    {
+        poller.timer->stop();
+        poller.manager->clear();
+        poller.enabled = false;
+    }
+}
+
+void FlexCounterOrch::doTask(SelectableTimer &timer)
+{
+    SWSS_LOG_ENTER();
+
+    for (auto &it : m_rateCounterPollers)
+    {
+        if (it.second.timer == &timer)
+        {
+            it.second.manager->poll();
+            return;
+        }
+    }
+}
+
 void FlexCounterOrch::doTask(Consumer &consumer)
 {
     SWSS_LOG_ENTER();
@@ -128,6 +262,7 @@ void FlexCounterOrch::doTask(Consumer &consumer)
                     vector<FieldValueTuple> fieldValues;
                     fieldValues.emplace_back(POLL_INTERVAL_FIELD, value);
                     m_flexCounterGroupTable->set(flexCounterGroupMap[key], fieldValues);
+                    setRateCounterInterval(key, value);
                     if (gPortsOrch && gPortsOrch->isGearboxEnabled())
                     {
                         if (key == PORT_KEY || key.rfind("MACSEC", 0) == 0)
@@ -214,6 +349,7 @@ void FlexCounterOrch::doTask(Consumer &consumer)
                     vector<FieldValueTuple> fieldValues;
                     fieldValues.emplace_back(FLEX_COUNTER_STATUS_FIELD, value);
                     m_flexCounterGroupTable->set(flexCounterGroupMap[key], fieldValues);
+                    setRateCounterStatus(key, value);
 
                     if (gPortsOrch && gPortsOrch->isGearboxEnabled())
                     {
@@ -5,6 +5,8 @@
 #include "port.h"
 #include "producertable.h"
 #include "table.h"
+#include "selectabletimer.h"
+#include "rate_counter_manager.h"
 
 extern "C" {
 #include "sai.h"
@@ -38,6 +40,7 @@ class FlexCounterOrch: public Orch
 {
 public:
     void doTask(Consumer &consumer);
+    void doTask(swss::SelectableTimer &timer);
     FlexCounterOrch(swss::DBConnector *db, std::vector<std::string> &tableNames);
     virtual ~FlexCounterOrch(void);
     bool getPortCountersState() const;
@@ -48,13 +51,28 @@ public:
     std::map<std::string, FlexCounterPgStates> getPgConfigurations();
     bool getHostIfTrapCounterState() const {return m_hostif_trap_counter_enabled;}
     bool getRouteFlowCountersState() const {return m_route_flow_counter_enabled;}
+    /* Read the objects of the rates computed from a COUNTERS_DB name map again */
+    void refreshRateCounterObjects(const std::string &nameMap);
     bool bake() override;
 
 private:
+    struct RateCounterPoller
+    {
+        std::unique_ptr<RateCounterManager> manager;
+        swss::SelectableTimer *timer;
+        bool enabled;
+    };
+
+    void addRateCounterPoller(const std::string &key, const std::string &pluginField,
+                              RateCounterManager *manager, uint32_t pollIntervalMs);
+    void setRateCounterInterval(const std::string &key, const std::string &pollIntervalMs);
+    void setRateCounterStatus(const std::string &key, const std::string &status);
+
     std::shared_ptr<swss::DBConnector> m_flexCounterDb = nullptr;
     std::shared_ptr<swss::ProducerTable> m_flexCounterGroupTable = nullptr;
     std::shared_ptr<swss::DBConnector> m_gbflexCounterDb = nullptr;
     std::shared_ptr<ProducerTable> m_gbflexCounterGroupTable = nullptr;
+    std::shared_ptr<swss::DBConnector> m_countersDb = nullptr;
     bool m_port_counter_enabled = false;
     bool m_port_buffer_drop_counter_enabled = false;
     bool m_pg_watermark_enabled = false;
@@ -64,6 +82,8 @@ private:
     Table m_flexCounterConfigTable;
     Table m_bufferQueueConfigTable;
     Table m_bufferPgConfigTable;
+    /* Rates of the counters of a CONFIG_DB FLEX_COUNTER_TABLE key, by key */
+    std::map<std::string, RateCounterPoller> m_rateCounterPollers;
 };
 
 #endif
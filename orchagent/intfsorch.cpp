@@ -16,6 +16,7 @@
 #include "crmorch.h"
 #include "bufferorch.h"
 #include "directory.h"
+#include "flexcounterorch.h"
 #include "vnetorch.h"
 #include "subscriberstatetable.h"
 
@@ -84,24 +85,6 @@ IntfsOrch::IntfsOrch(DBConnector *db, string tableName, VRFOrch *vrf_orch, DBCon
     fieldValues.emplace_back(STATS_MODE_FIELD, STATS_MODE_READ);
     m_flexCounterGroupTable->set(RIF_STAT_COUNTER_FLEX_COUNTER_GROUP, fieldValues);
 
-    string rifRatePluginName = "rif_rates.lua";
-
-    try
-    {
-        string rifRateLuaScript = swss::loadLuaScript(rifRatePluginName);
-        string rifRateSha = swss::loadRedisScript(m_counter_db.get(), rifRateLuaScript);
-
-        vector<FieldValueTuple> fieldValues;
-        fieldValues.emplace_back(RIF_PLUGIN_FIELD, rifRateSha);
-        fieldValues.emplace_back(POLL_INTERVAL_FIELD, RIF_FLEX_STAT_COUNTER_POLL_MSECS);
-        fieldValues.emplace_back(STATS_MODE_FIELD, STATS_MODE_READ);
-        m_flexCounterGroupTable->set(RIF_STAT_COUNTER_FLEX_COUNTER_GROUP, fieldValues);
-    }
-    catch (const runtime_error &e)
-    {
-        SWSS_LOG_WARN("RIF flex counter group plugins was not set successfully: %s", e.what());
-    }
-
     if(gMySwitchType == "voq")
     {
         //Add subscriber to process VOQ system interface
@@ -135,6 +118,11 @@ bool IntfsOrch::isPrefixSubnet(const IpPrefix &ip_prefix, const string &alias)
     return false;
 }
 
+string IntfsOrch::getRouterIntfDependency(const string &alias)
+{
+    return "router interface " + alias;
+}
+
 string IntfsOrch::getRouterIntfsAlias(const IpAddress &ip, const string &vrf_name)
 {
     sai_object_id_t vrf_id = gVirtualRouterId;
@@ -1256,6 +1244,8 @@ bool IntfsOrch::addRouterIntfs(sai_object_id_t vrf_id, Port &port, string loopba
 
     SWSS_LOG_NOTICE("Create router interface %s MTU %u", port.m_alias.c_str(), port.m_mtu);
 
+    Consumer::wake(getRouterIntfDependency(port.m_alias));
+
     if(gMySwitchType == "voq")
     {
         // Sync the interface of local port/LAG to the SYSTEM_INTERFACE table of CHASSIS_APP_DB
@@ -1468,6 +1458,11 @@ void IntfsOrch::addRifToFlexCounter(const string &id, const string &name, const
 
     m_rifNameTable->set("", rifNameVector);
     m_rifTypeTable->set("", rifTypeVector);
+    auto flex_counters_orch = gDirectory.get<FlexCounterOrch*>();
+    if (flex_counters_orch)
+    {
+        flex_counters_orch->refreshRateCounterObjects(COUNTERS_RIF_NAME_MAP);
+    }
 
     /* update RIF in FLEX_COUNTER_DB */
     string key = getRifFlexCounterTableKey(id);
@@ -1491,6 +1486,11 @@ void IntfsOrch::removeRifFromFlexCounter(const string &id, const string &name)
     /* remove it from COUNTERS_DB maps */
     m_rifNameTable->hdel("", name);
     m_rifTypeTable->hdel("", id);
+    auto flex_counters_orch = gDirectory.get<FlexCounterOrch*>();
+    if (flex_counters_orch)
+    {
+        flex_counters_orch->refreshRateCounterObjects(COUNTERS_RIF_NAME_MAP);
+    }
 
     /* remove it from FLEX_COUNTER_DB */
     string key = getRifFlexCounterTableKey(id);
@@ -39,6 +39,8 @@ public:
     bool isInbandIntfInMgmtVrf(const string& alias);
     string getRouterIntfsAlias(const IpAddress &ip, const string &vrf_name = "");
     string getRifRateFlexCounterTableKey(string key);
+    // Name of the dependency consumers wait on until the router interface exists
+    static string getRouterIntfDependency(const string &alias);
     void increaseRouterIntfsRefCount(const string&);
     void decreaseRouterIntfsRefCount(const string&);
 
@@ -50,6 +50,7 @@ MacAddress gMacAddress;
 MacAddress gVxlanMacAddress;
 
 extern size_t gMaxBulkSize;
+extern uint32_t gPortOperStatusCoalesceMs;
 
 #define DEFAULT_BATCH_SIZE  128
 int gBatchSize = DEFAULT_BATCH_SIZE;
@@ -83,7 +84,7 @@ string gMyAsicName = "";
 
 void usage()
 {
-    cout << "usage: orchagent [-h] [-r record_type] [-d record_location] [-f swss_rec_filename] [-j sairedis_rec_filename] [-b batch_size] [-m MAC] [-i INST_ID] [-s] [-z mode] [-k bulk_size]" << endl;
+    cout << "usage: orchagent [-h] [-r record_type] [-d record_location] [-f swss_rec_filename] [-j sairedis_rec_filename] [-b batch_size] [-m MAC] [-i INST_ID] [-s] [-z mode] [-k bulk_size] [-c msec]" << endl;
     cout << "    -h: display this message" << endl;
     cout << "    -r record_type: record orchagent logs with type (default 3)" << endl;
     cout << "                    Bit 0: sairedis.rec, Bit 1: swss.rec, Bit 2: responsepublisher.rec. For example:" << endl;
@@ -101,6 +102,7 @@ void usage()
     cout << "    -f swss_rec_filename: swss record log filename(default 'swss.rec')" << endl;
     cout << "    -j sairedis_rec_filename: sairedis record log filename(default sairedis.rec)" << endl;
     cout << "    -k max bulk size in bulk mode (default 1000)" << endl;
+    cout << "    -c msec: coalesce port oper status notifications over msec milliseconds (default 0, disabled)" << endl;
 }
 
 void sighup_handler(int signo)
@@ -336,7 +338,7 @@ int main(int argc, char **argv)
     string responsepublisher_rec_filename = "responsepublisher.rec";
     int record_type = 3; // Only swss and sairedis recordings enabled by default.
 
-    while ((opt = getopt(argc, argv, "b:m:r:f:j:d:i:hsz:k:")) != -1)
+    while ((opt = getopt(argc, argv, "b:m:r:f:j:d:i:hsz:k:c:")) != -1)
     {
         switch (opt)
         {
@@ -414,6 +416,20 @@ int main(int argc, char **argv)
                 }
             }
             break;
+        case 'c':
+            {
+                auto window = atoi(optarg);
+                if (window >= 0)
+                {
+                    gPortOperStatusCoalesceMs = static_cast<uint32_t>(window);
+                    SWSS_LOG_NOTICE("Setting port oper status coalescing window as %u ms", gPortOperStatusCoalesceMs);
+                }
+                else
+                {
+                    SWSS_LOG_ERROR("Invalid input for port oper status coalescing window: %d. Ignoring.", window);
+                }
+            }
+            break;
         default: /* '?' */
             exit(EXIT_FAILURE);
         }
@@ -42,6 +42,7 @@ extern sai_route_api_t* sai_route_api;
 extern sai_tunnel_api_t* sai_tunnel_api;
 extern sai_next_hop_api_t* sai_next_hop_api;
 extern sai_router_interface_api_t* sai_router_intfs_api;
+extern size_t gMaxBulkSize;
 
 /* Constants */
 #define MUX_ACL_TABLE_NAME INGRESS_TABLE_DROP
@@ -94,7 +95,7 @@ static inline MuxStateChange mux_state_change (MuxState prev, MuxState curr)
     return MuxStateChange::MUX_STATE_UNKNOWN_STATE;
 }
 
-static sai_status_t create_route(IpPrefix &pfx, sai_object_id_t nh)
+static sai_route_entry_t tunnel_route_entry(IpPrefix &pfx)
 {
     sai_route_entry_t route_entry;
     route_entry.switch_id = gSwitchId;
@@ -102,6 +103,27 @@ static sai_status_t create_route(IpPrefix &pfx, sai_object_id_t nh)
     copy(route_entry.destination, pfx);
     subnet(route_entry.destination, route_entry.destination);
 
+    return route_entry;
+}
+
+static void update_tunnel_route_crm(IpPrefix &pfx, bool add)
+{
+    CrmResourceType type = pfx.isV4() ? CrmResourceType::CRM_IPV4_ROUTE : CrmResourceType::CRM_IPV6_ROUTE;
+
+    if (add)
+    {
+        gCrmOrch->incCrmResUsedCounter(type);
+    }
+    else
+    {
+        gCrmOrch->decCrmResUsedCounter(type);
+    }
+}
+
+static sai_status_t create_route(IpPrefix &pfx, sai_object_id_t nh)
+{
+    sai_route_entry_t route_entry = tunnel_route_entry(pfx);
+
     sai_attribute_t attr;
     vector<sai_attribute_t> attrs;
 
@@ -121,14 +143,7 @@ static sai_status_t create_route(IpPrefix &pfx, sai_object_id_t nh)
         return status;
     }
 
-    if (route_entry.destination.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
-    {
-        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
-    }
-    else
-    {
-        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_ROUTE);
-    }
+    update_tunnel_route_crm(pfx, true);
 
     SWSS_LOG_NOTICE("Created tunnel route to %s ", pfx.to_string().c_str());
     return status;
@@ -136,11 +151,7 @@ static sai_status_t create_route(IpPrefix &pfx, sai_object_id_t nh)
 
 static sai_status_t remove_route(IpPrefix &pfx)
 {
-    sai_route_entry_t route_entry;
-    route_entry.switch_id = gSwitchId;
-    route_entry.vr_id = gVirtualRouterId;
-    copy(route_entry.destination, pfx);
-    subnet(route_entry.destination, route_entry.destination);
+    sai_route_entry_t route_entry = tunnel_route_entry(pfx);
 
     sai_status_t status = sai_route_api->remove_route_entry(&route_entry);
     if (status != SAI_STATUS_SUCCESS)
@@ -150,14 +161,7 @@ static sai_status_t remove_route(IpPrefix &pfx)
         return status;
     }
 
-    if (route_entry.destination.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
-    {
-        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
-    }
-    else
-    {
-        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV6_ROUTE);
-    }
+    update_tunnel_route_crm(pfx, false);
 
     SWSS_LOG_NOTICE("Removed tunnel route to %s ", pfx.to_string().c_str());
     return status;
@@ -351,6 +355,115 @@ static bool remove_nh_tunnel(sai_object_id_t nh_id, IpAddress& ipAddr)
     return true;
 }
 
+MuxSwitchover::MuxSwitchover() :
+    route_bulker_(sai_route_api, gMaxBulkSize)
+{
+}
+
+void MuxSwitchover::begin(MuxCable* cable, MuxState prev_state, const string& new_state)
+{
+    changes_.push_back({ cable, prev_state, new_state, false, false });
+}
+
+void MuxSwitchover::abort()
+{
+    assert(!changes_.empty());
+    changes_.back().aborted = true;
+}
+
+void MuxSwitchover::createRoute(IpPrefix& pfx, const NextHopKey& nh_key, sai_object_id_t nh)
+{
+    assert(!changes_.empty());
+
+    sai_route_entry_t route_entry = tunnel_route_entry(pfx);
+    sai_attribute_t attrs[2];
+
+    attrs[0].id = SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION;
+    attrs[0].value.s32 = SAI_PACKET_ACTION_FORWARD;
+    attrs[1].id = SAI_ROUTE_ENTRY_ATTR_NEXT_HOP_ID;
+    attrs[1].value.oid = nh;
+
+    routes_.push_back({ changes_.size() - 1, pfx, nh_key, nh, true, SAI_STATUS_NOT_EXECUTED });
+    route_bulker_.create_entry(&routes_.back().status, &route_entry, 2, attrs);
+}
+
+void MuxSwitchover::removeRoute(IpPrefix& pfx, const NextHopKey& nh_key, sai_object_id_t nh)
+{
+    assert(!changes_.empty());
+
+    sai_route_entry_t route_entry = tunnel_route_entry(pfx);
+
+    routes_.push_back({ changes_.size() - 1, pfx, nh_key, nh, false, SAI_STATUS_NOT_EXECUTED });
+    route_bulker_.remove_entry(&routes_.back().status, &route_entry);
+}
+
+void MuxSwitchover::commit()
+{
+    SWSS_LOG_INFO("Switchover of %zu mux cables, %zu tunnel routes", changes_.size(), routes_.size());
+
+    route_bulker_.flush();
+
+    for (auto& route : routes_)
+    {
+        if (route.status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to %s tunnel route %s, rv:%d", route.add ? "create" : "remove",
+                           route.pfx.getIp().to_string().c_str(), route.status);
+            changes_[route.change].failed = true;
+            continue;
+        }
+
+        update_tunnel_route_crm(route.pfx, route.add);
+
+        SWSS_LOG_NOTICE("%s tunnel route to %s ", route.add ? "Created" : "Removed", route.pfx.to_string().c_str());
+    }
+
+    MuxCableOrch* mux_cb_orch = gDirectory.get<MuxCableOrch*>();
+
+    for (auto& route : routes_)
+    {
+        const auto& change = changes_[route.change];
+
+        /*
+         * An aborted change keeps what its handler did before failing, as a serial one does.
+         * APPL_DB tunnel routes are removed after their SAI routes.
+         */
+        if (!change.failed || change.aborted)
+        {
+            if (!route.add && route.status == SAI_STATUS_SUCCESS)
+            {
+                mux_cb_orch->removeTunnelRoute(route.nh_key);
+            }
+            continue;
+        }
+
+        /* Roll back the tunnel routes of a failed cable, its neighbors are rolled back next */
+        if (route.add)
+        {
+            if (route.status == SAI_STATUS_SUCCESS && remove_route(route.pfx) != SAI_STATUS_SUCCESS)
+            {
+                SWSS_LOG_ERROR("Failed to roll back tunnel route %s", route.pfx.to_string().c_str());
+            }
+            mux_cb_orch->removeTunnelRoute(route.nh_key);
+        }
+        else if (route.status == SAI_STATUS_SUCCESS && create_route(route.pfx, route.nh) != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_ERROR("Failed to roll back tunnel route %s", route.pfx.to_string().c_str());
+        }
+    }
+
+    for (auto& change : changes_)
+    {
+        if (!change.aborted)
+        {
+            change.cable->completeSwitchover(change.prev_state, change.new_state, !change.failed);
+        }
+    }
+
+    routes_.clear();
+    changes_.clear();
+}
+
 MuxCable::MuxCable(string name, IpPrefix& srv_ip4, IpPrefix& srv_ip6, IpAddress peer_ip, std::set<IpAddress> skip_neighbors)
          :mux_name_(name), srv_ip4_(srv_ip4), srv_ip6_(srv_ip6), peer_ip4_(peer_ip), skip_neighbors_(skip_neighbors)
 {
@@ -423,6 +536,12 @@ bool MuxCable::stateStandby()
         return false;
     }
 
+    /* Within a switchover the drop rule is added after the tunnel routes */
+    if (switchover_)
+    {
+        return true;
+    }
+
     if (!aclHandler(port.m_port_id, mux_name_))
     {
         SWSS_LOG_INFO("Add ACL drop rule failed for %s", mux_name_.c_str());
@@ -432,7 +551,7 @@ bool MuxCable::stateStandby()
     return true;
 }
 
-void MuxCable::setState(string new_state)
+void MuxCable::setState(string new_state, MuxSwitchover* switchover)
 {
     SWSS_LOG_NOTICE("[%s] Set MUX state from %s to %s", mux_name_.c_str(),
                      muxStateValToString.at(state_).c_str(), new_state.c_str());
@@ -460,8 +579,22 @@ void MuxCable::setState(string new_state)
 
     st_chg_in_progress_ = true;
 
-    if (!(this->*(state_machine_handlers_[it->second]))())
+    if (switchover)
     {
+        switchover->begin(this, state, new_state);
+    }
+
+    switchover_ = switchover;
+    bool success = (this->*(state_machine_handlers_[it->second]))();
+    switchover_ = nullptr;
+
+    if (!success)
+    {
+        if (switchover)
+        {
+            switchover->abort();
+        }
+
         //Reset back to original state
         state_ = state;
         st_chg_in_progress_ = false;
@@ -469,6 +602,77 @@ void MuxCable::setState(string new_state)
         throw std::runtime_error("Failed to handle state transition");
     }
 
+    /* Within a switchover the state is completed once its tunnel routes are programmed */
+    if (!switchover)
+    {
+        completeState(state, new_state, true);
+    }
+}
+
+/* Finish the state change once the tunnel routes of the switchover are programmed */
+void MuxCable::completeSwitchover(MuxState prev_state, string new_state, bool success)
+{
+    MuxStateChange change = mux_state_change(prev_state, state_);
+
+    if (!success)
+    {
+        if (!rollbackState(prev_state))
+        {
+            SWSS_LOG_ERROR("Failed to roll back mux %s to %s", mux_name_.c_str(),
+                           muxStateValToString.at(prev_state).c_str());
+        }
+    }
+    else if (change == MuxStateChange::MUX_STATE_ACTIVE_STANDBY || change == MuxStateChange::MUX_STATE_INIT_STANDBY)
+    {
+        Port port;
+        if (!gPortsOrch->getPort(mux_name_, port) || !aclHandler(port.m_port_id, mux_name_))
+        {
+            SWSS_LOG_INFO("Add ACL drop rule failed for %s", mux_name_.c_str());
+            success = false;
+        }
+    }
+
+    completeState(prev_state, new_state, success);
+}
+
+/* Undo the neighbor and ACL steps of a state change whose tunnel routes failed */
+bool MuxCable::rollbackState(MuxState prev_state)
+{
+    switch (mux_state_change(prev_state, state_))
+    {
+    case MuxStateChange::MUX_STATE_ACTIVE_STANDBY:
+    case MuxStateChange::MUX_STATE_INIT_STANDBY:
+        /* The drop rule isn't added yet, the neighbors were disabled */
+        return nbr_handler_->enable(false);
+    case MuxStateChange::MUX_STATE_STANDBY_ACTIVE:
+    {
+        sai_object_id_t tnh = mux_orch_->getNextHopTunnelId(MUX_TUNNEL, peer_ip4_);
+        if (!nbr_handler_->disable(tnh, nullptr, false))
+        {
+            return false;
+        }
+
+        Port port;
+        return gPortsOrch->getPort(mux_name_, port) && aclHandler(port.m_port_id, mux_name_);
+    }
+    default:
+        return true;
+    }
+}
+
+void MuxCable::completeState(MuxState prev_state, string new_state, bool success)
+{
+    if (!success)
+    {
+        //Reset back to original state
+        state_ = prev_state;
+        st_chg_in_progress_ = false;
+        st_chg_failed_ = true;
+        SWSS_LOG_ERROR("Mux Error setting state %s for port %s",
+                        new_state.c_str(), mux_name_.c_str());
+        return;
+    }
+
     mux_cb_orch_->updateMuxMetricState(mux_name_, new_state, false);
 
     st_chg_in_progress_ = false;
@@ -476,7 +680,6 @@ void MuxCable::setState(string new_state)
     SWSS_LOG_INFO("Changed state to %s", new_state.c_str());
 
     mux_cb_orch_->updateMuxState(mux_name_, new_state);
-    return;
 }
 
 string MuxCable::getState()
@@ -517,7 +720,7 @@ bool MuxCable::nbrHandler(bool enable, bool update_rt)
 {
     if (enable)
     {
-        return nbr_handler_->enable(update_rt);
+        return nbr_handler_->enable(update_rt, switchover_);
     }
     else
     {
@@ -528,7 +731,7 @@ bool MuxCable::nbrHandler(bool enable, bool update_rt)
             return false;
         }
 
-        return nbr_handler_->disable(tnh);
+        return nbr_handler_->disable(tnh, switchover_);
     }
 }
 
@@ -604,7 +807,7 @@ void MuxNbrHandler::update(NextHopKey nh, sai_object_id_t tunnelId, bool add, Mu
     }
 }
 
-bool MuxNbrHandler::enable(bool update_rt)
+bool MuxNbrHandler::enable(bool update_rt, MuxSwitchover* switchover)
 {
     NeighborEntry neigh;
     MuxCableOrch* mux_cb_orch = gDirectory.get<MuxCableOrch*>();
@@ -614,6 +817,7 @@ bool MuxNbrHandler::enable(bool update_rt)
     {
         SWSS_LOG_INFO("Enabling neigh %s on %s", it->first.to_string().c_str(), alias_.c_str());
 
+        sai_object_id_t tnh = it->second;
         neigh = NeighborEntry(it->first, alias_);
         if (!gNeighOrch->enableNeighbor(neigh))
         {
@@ -659,11 +863,19 @@ bool MuxNbrHandler::enable(bool update_rt)
         IpPrefix pfx = it->first.to_string();
         if (update_rt)
         {
-            if (remove_route(pfx) != SAI_STATUS_SUCCESS)
+            /* Within a switchover the APPL_DB tunnel route is removed with the SAI one */
+            if (switchover)
+            {
+                switchover->removeRoute(pfx, nh_key, tnh);
+            }
+            else if (remove_route(pfx) != SAI_STATUS_SUCCESS)
             {
                 return false;
             }
-            mux_cb_orch->removeTunnelRoute(nh_key);
+            else
+            {
+                mux_cb_orch->removeTunnelRoute(nh_key);
+            }
         }
 
         it++;
@@ -672,7 +884,7 @@ bool MuxNbrHandler::enable(bool update_rt)
     return true;
 }
 
-bool MuxNbrHandler::disable(sai_object_id_t tnh)
+bool MuxNbrHandler::disable(sai_object_id_t tnh, MuxSwitchover* switchover, bool update_rt)
 {
     NeighborEntry neigh;
     MuxCableOrch* mux_cb_orch = gDirectory.get<MuxCableOrch*>();
@@ -721,12 +933,19 @@ bool MuxNbrHandler::disable(sai_object_id_t tnh)
             return false;
         }
 
-        mux_cb_orch->addTunnelRoute(nh_key);
-
-        IpPrefix pfx = it->first.to_string();
-        if (create_route(pfx, it->second) != SAI_STATUS_SUCCESS)
+        if (update_rt)
         {
-            return false;
+            mux_cb_orch->addTunnelRoute(nh_key);
+
+            IpPrefix pfx = it->first.to_string();
+            if (switchover)
+            {
+                switchover->createRoute(pfx, nh_key, it->second);
+            }
+            else if (create_route(pfx, it->second) != SAI_STATUS_SUCCESS)
+            {
+                return false;
+            }
         }
 
         it++;
@@ -940,16 +1159,33 @@ sai_object_id_t MuxOrch::getNextHopTunnelId(std::string tunnelKey, IpAddress& ip
 
 MuxCable* MuxOrch::findMuxCableInSubnet(IpAddress ip)
 {
-    for (auto it = mux_cable_tb_.begin(); it != mux_cable_tb_.end(); it++)
+    auto it = mux_cable_subnets_.longestMatch(ip);
+    if (it == mux_cable_subnets_.end())
     {
-       MuxCable* ptr = it->second.get();
-       if (ptr->isIpInSubnet(ip))
-       {
-           return ptr;
-       }
+        return nullptr;
     }
 
-    return nullptr;
+    return getMuxCable(*it->second.begin());
+}
+
+void MuxOrch::addMuxCableSubnet(const IpPrefix& subnet, const string& port_name)
+{
+    mux_cable_subnets_[subnet].insert(port_name);
+}
+
+void MuxOrch::removeMuxCableSubnet(const IpPrefix& subnet, const string& port_name)
+{
+    auto it = mux_cable_subnets_.find(subnet);
+    if (it == mux_cable_subnets_.end())
+    {
+        return;
+    }
+
+    it->second.erase(port_name);
+    if (it->second.empty())
+    {
+        mux_cable_subnets_.erase(it);
+    }
 }
 
 bool MuxOrch::isNeighborActive(const IpAddress& nbr, const MacAddress& mac, string& alias)
@@ -1100,14 +1336,11 @@ void MuxOrch::updateNeighbor(const NeighborUpdate& update)
         removeStandaloneTunnelRoute(update.entry.ip_address);
     }
 
-    for (auto it = mux_cable_tb_.begin(); it != mux_cable_tb_.end(); it++)
+    MuxCable* ptr = findMuxCableInSubnet(update.entry.ip_address);
+    if (ptr)
     {
-        MuxCable* ptr = it->second.get();
-        if (ptr->isIpInSubnet(update.entry.ip_address))
-        {
-            ptr->updateNeighbor(update.entry, update.add);
-            return;
-        }
+        ptr->updateNeighbor(update.entry, update.add);
+        return;
     }
 
     string port, old_port;
@@ -1141,7 +1374,6 @@ void MuxOrch::updateNeighbor(const NeighborUpdate& update)
         }
     }
 
-    MuxCable* ptr;
     if (!old_port.empty() && old_port != port && isMuxExists(old_port))
     {
         ptr = getMuxCable(old_port);
@@ -1282,6 +1514,8 @@ bool MuxOrch::handleMuxCfg(const Request& request)
 
         mux_cable_tb_[port_name] = std::make_unique<MuxCable>
                                    (MuxCable(port_name, srv_ip, srv_ip6, mux_peer_switch_, skip_neighbors));
+        addMuxCableSubnet(srv_ip, port_name);
+        addMuxCableSubnet(srv_ip6, port_name);
 
         SWSS_LOG_NOTICE("Mux entry for port '%s' was added", port_name.c_str());
     }
@@ -1293,6 +1527,10 @@ bool MuxOrch::handleMuxCfg(const Request& request)
             return true;
         }
 
+        MuxCable* ptr = getMuxCable(port_name);
+        removeMuxCableSubnet(ptr->getServerIpv4(), port_name);
+        removeMuxCableSubnet(ptr->getServerIpv6(), port_name);
+
         mux_cable_tb_.erase(port_name);
 
         SWSS_LOG_NOTICE("Mux cable for port '%s' was removed", port_name.c_str());
@@ -1430,10 +1668,34 @@ void MuxOrch::removeStandaloneTunnelRoute(IpAddress neighborIp)
 
 MuxCableOrch::MuxCableOrch(DBConnector *db, DBConnector *sdb, const std::string& tableName):
               Orch2(db, tableName, request_),
-              app_tunnel_route_table_(db, APP_TUNNEL_ROUTE_TABLE_NAME),
+              app_pipeline_(db),
+              app_tunnel_route_table_(&app_pipeline_, APP_TUNNEL_ROUTE_TABLE_NAME, true),
               mux_metric_table_(sdb, STATE_MUX_METRICS_TABLE_NAME)
 {
-    mux_table_ = unique_ptr<Table>(new Table(db, APP_HW_MUX_CABLE_TABLE_NAME));
+    mux_table_ = unique_ptr<Table>(new Table(&app_pipeline_, APP_HW_MUX_CABLE_TABLE_NAME, true));
+}
+
+void MuxCableOrch::doTask(Consumer& consumer)
+{
+    SWSS_LOG_ENTER();
+
+    /* All cables whose state is set in this drain are switched together */
+    MuxSwitchover switchover;
+
+    switchover_ = &switchover;
+    Orch2::doTask(consumer);
+    switchover.commit();
+    switchover_ = nullptr;
+
+    flushAppDb();
+}
+
+void MuxCableOrch::flushAppDb()
+{
+    if (!switchover_)
+    {
+        app_pipeline_.flush();
+    }
 }
 
 void MuxCableOrch::updateMuxState(string portName, string muxState)
@@ -1442,6 +1704,8 @@ void MuxCableOrch::updateMuxState(string portName, string muxState)
     FieldValueTuple tuple("state", muxState);
     tuples.push_back(tuple);
     mux_table_->set(portName, tuples);
+
+    flushAppDb();
 }
 
 void MuxCableOrch::updateMuxMetricState(string portName, string muxState, bool start)
@@ -1488,6 +1752,8 @@ void MuxCableOrch::addTunnelRoute(const NextHopKey &nhKey)
 
     SWSS_LOG_INFO("Add tunnel route DB '%s:%s'", alias.c_str(), key.c_str());
     app_tunnel_route_table_.set(key, data);
+
+    flushAppDb();
 }
 
 void MuxCableOrch::removeTunnelRoute(const NextHopKey &nhKey)
@@ -1499,6 +1765,8 @@ void MuxCableOrch::removeTunnelRoute(const NextHopKey &nhKey)
 
     SWSS_LOG_INFO("Remove tunnel route DB '%s:%s'", alias.c_str(), key.c_str());
     app_tunnel_route_table_.del(key);
+
+    flushAppDb();
 }
 
 bool MuxCableOrch::addOperation(const Request& request)
@@ -1519,7 +1787,7 @@ bool MuxCableOrch::addOperation(const Request& request)
 
     try
     {
-        mux_obj->setState(state);
+        mux_obj->setState(state, switchover_);
     }
     catch(const std::runtime_error& error)
     {
@@ -4,12 +4,17 @@
 #include <unordered_map>
 #include <set>
 #include <memory>
+#include <deque>
+#include <vector>
 
+#include "redispipeline.h"
 #include "request_parser.h"
 #include "portsorch.h"
 #include "tunneldecaporch.h"
 #include "aclorch.h"
 #include "neighorch.h"
+#include "prefixtable.h"
+#include "bulker.h"
 
 enum MuxState
 {
@@ -33,6 +38,55 @@ enum MuxStateChange
 class MuxOrch;
 class MuxCableOrch;
 class MuxStateOrch;
+class MuxCable;
+
+/*
+ * Switchover of the mux cables whose state changes in one drain of
+ * MUX_CABLE_TABLE. Neighbors are switched cable by cable, the tunnel routes of
+ * all of them are queued and programmed with bulk SAI calls at commit. Each
+ * cable then finishes its steps in the order of a serial state change, or is
+ * rolled back to its previous state when one of its tunnel routes failed.
+ */
+class MuxSwitchover
+{
+public:
+    MuxSwitchover();
+
+    /* Start the state change of a cable, routes queued next belong to it */
+    void begin(MuxCable* cable, MuxState prev_state, const string& new_state);
+    /* Drop the state change started last, its handler failed */
+    void abort();
+
+    void createRoute(IpPrefix& pfx, const NextHopKey& nh_key, sai_object_id_t nh);
+    /* nh is the tunnel next hop the route is created back with on a rollback */
+    void removeRoute(IpPrefix& pfx, const NextHopKey& nh_key, sai_object_id_t nh);
+
+    void commit();
+
+private:
+    struct StateChange
+    {
+        MuxCable* cable;
+        MuxState prev_state;
+        string new_state;
+        bool aborted;
+        bool failed;
+    };
+
+    struct RouteOp
+    {
+        size_t change;
+        IpPrefix pfx;
+        NextHopKey nh_key;
+        sai_object_id_t nh;
+        bool add;
+        sai_status_t status;
+    };
+
+    EntityBulker<sai_route_api_t> route_bulker_;
+    std::vector<StateChange> changes_;
+    std::deque<RouteOp> routes_;
+};
 
 // Mux ACL Handler for adding/removing ACLs
 class MuxAclHandler
@@ -61,8 +115,8 @@ class MuxNbrHandler
 public:
     MuxNbrHandler() = default;
 
-    bool enable(bool update_rt);
-    bool disable(sai_object_id_t);
+    bool enable(bool update_rt, MuxSwitchover* switchover = nullptr);
+    bool disable(sai_object_id_t, MuxSwitchover* switchover = nullptr, bool update_rt = true);
     void update(NextHopKey nh, sai_object_id_t, bool = true, MuxState = MuxState::MUX_STATE_INIT);
 
     sai_object_id_t getNextHopId(const NextHopKey);
@@ -86,12 +140,15 @@ public:
     using handler_pair = pair<MuxStateChange, bool (MuxCable::*)()>;
     using state_machine_handlers = map<MuxStateChange, bool (MuxCable::*)()>;
 
-    void setState(string state);
+    void setState(string state, MuxSwitchover* switchover = nullptr);
+    void completeSwitchover(MuxState prev_state, string new_state, bool success);
     string getState();
     bool isStateChangeInProgress() { return st_chg_in_progress_; }
     bool isStateChangeFailed() { return st_chg_failed_; }
 
     bool isIpInSubnet(IpAddress ip);
+    const IpPrefix& getServerIpv4() const { return srv_ip4_; }
+    const IpPrefix& getServerIpv6() const { return srv_ip6_; }
     void updateNeighbor(NextHopKey nh, bool add);
     sai_object_id_t getNextHopId(const NextHopKey nh)
     {
@@ -110,11 +167,15 @@ private:
     bool aclHandler(sai_object_id_t port, string alias, bool add = true);
     bool nbrHandler(bool enable, bool update_routes = true);
 
+    void completeState(MuxState prev_state, string new_state, bool success);
+    bool rollbackState(MuxState prev_state);
+
     string mux_name_;
 
     MuxState state_ = MuxState::MUX_STATE_INIT;
     bool st_chg_in_progress_ = false;
     bool st_chg_failed_ = false;
+    MuxSwitchover* switchover_ = nullptr;
 
     IpPrefix srv_ip4_, srv_ip6_;
     IpAddress peer_ip4_;
@@ -152,6 +213,8 @@ struct NHTunnel
 
 typedef std::unique_ptr<MuxCable> MuxCable_T;
 typedef std::map<std::string, MuxCable_T> MuxCableTb;
+// Server subnets of the mux cables, to the names of the cables configured with them
+typedef PrefixTable<std::set<std::string>> MuxCableSubnets;
 typedef std::map<IpAddress, NHTunnel> MuxTunnelNHs;
 typedef std::map<NextHopKey, std::string> NextHopTb;
 
@@ -212,10 +275,14 @@ private:
     void createStandaloneTunnelRoute(IpAddress neighborIp);
     void removeStandaloneTunnelRoute(IpAddress neighborIp);
 
+    void addMuxCableSubnet(const IpPrefix& subnet, const string& port_name);
+    void removeMuxCableSubnet(const IpPrefix& subnet, const string& port_name);
+
     IpAddress mux_peer_switch_ = 0x0;
     sai_object_id_t mux_tunnel_id_ = SAI_NULL_OBJECT_ID;
 
     MuxCableTb mux_cable_tb_;
+    MuxCableSubnets mux_cable_subnets_;
     MuxTunnelNHs mux_tunnel_nh_;
     NextHopTb mux_nexthop_tb_;
 
@@ -253,14 +320,22 @@ public:
     void addTunnelRoute(const NextHopKey &nhKey);
     void removeTunnelRoute(const NextHopKey &nhKey);
 
+    using Orch::doTask;  // Allow access to the basic doTask
+
 private:
+    void doTask(Consumer& consumer) override;
     virtual bool addOperation(const Request& request);
     virtual bool delOperation(const Request& request);
 
+    void flushAppDb();
+
+    /* APPL_DB writes are buffered in the pipeline and flushed once per switchover */
+    swss::RedisPipeline app_pipeline_;
     unique_ptr<Table> mux_table_;
     MuxCableRequest request_;
     swss::Table mux_metric_table_;
     ProducerStateTable app_tunnel_route_table_;
+    MuxSwitchover* switchover_ = nullptr;
 };
 
 const request_description_t mux_state_request_description = {
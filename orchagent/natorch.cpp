@@ -36,17 +36,30 @@ extern sai_object_id_t     gVirtualRouterId;
 extern sai_nat_api_t      *sai_nat_api;
 extern sai_hostif_api_t   *sai_hostif_api;
 extern bool               gIsNatSupported;
+extern size_t             gMaxBulkSize;
 #ifdef DEBUG_FRAMEWORK
 extern DebugDumpOrch      *gDebugDumpOrch;
 #endif
-uint32_t  natTimerTickCntr  = 0;
 bool      gNhTrackingSupported = false;
 
+static time_t getMonotonicTime(void)
+{
+    struct timespec  time_now = {};
+
+    clock_gettime(CLOCK_MONOTONIC, &time_now);
+
+    return time_now.tv_sec;
+}
+
 NatOrch::NatOrch(DBConnector *appDb, DBConnector *stateDb, vector<table_name_with_pri_t> &tableNames,
          RouteOrch *routeOrch, NeighOrch *neighOrch):
          Orch(appDb, tableNames),
          m_neighOrch(neighOrch),
          m_routeOrch(routeOrch),
+         m_natAgingWheel(NAT_HITBIT_N_CNTRS_QUERY_PERIOD, getMonotonicTime()),
+         m_naptAgingWheel(NAT_HITBIT_N_CNTRS_QUERY_PERIOD, getMonotonicTime()),
+         m_twiceNatAgingWheel(NAT_HITBIT_N_CNTRS_QUERY_PERIOD, getMonotonicTime()),
+         m_twiceNaptAgingWheel(NAT_HITBIT_N_CNTRS_QUERY_PERIOD, getMonotonicTime()),
          m_countersDb("COUNTERS_DB", 0),
          m_countersNatTable(&m_countersDb, COUNTERS_NAT_TABLE),
          m_countersNaptTable(&m_countersDb, COUNTERS_NAPT_TABLE),
@@ -89,7 +102,7 @@ NatOrch::NatOrch(DBConnector *appDb, DBConnector *stateDb, vector<table_name_wit
     auto cleanupNotifier = new Notifier(m_cleanupNotificationConsumer, this, "NAT_DB_CLEANUP_NOTIFICATION");
     Orch::addExecutor(cleanupNotifier);
 
-    /* Start the timer to query NAT entry statistics every 5 secs and hitbits every 30 secs */
+    /* Start the timer to query NAT entry statistics and the hitbits of the entries due for it every 5 secs */
     SWSS_LOG_INFO("Start the HITBIT Timer ");
     auto interval      = timespec { .tv_sec = NAT_HITBIT_N_CNTRS_QUERY_PERIOD, .tv_nsec = 0 };
     m_natQueryTimer = new SelectableTimer(interval);
@@ -146,6 +159,12 @@ NatOrch::NatOrch(DBConnector *appDb, DBConnector *stateDb, vector<table_name_wit
         gNhTrackingSupported = true; 
     }
     SWSS_LOG_NOTICE("DNAT nexthop tracking is %s", ((gNhTrackingSupported == true) ? "enabled" : "disabled"));
+
+    if (sai_nat_api && sai_nat_api->create_nat_entries && sai_nat_api->remove_nat_entries)
+    {
+        m_natBulker = std::make_unique<EntityBulker<sai_nat_api_t>>(sai_nat_api, gMaxBulkSize);
+    }
+    SWSS_LOG_NOTICE("NAT entry bulk programming is %s", (m_natBulker ? "enabled" : "disabled"));
 }
 
 /* Process notifications for changes in Neighbor entries and route entries
@@ -733,6 +752,126 @@ void NatOrch::removeTwiceNaptFromNhCache(const IpAddress &translatedIp, const Tw
     }
 }
 
+static sai_nat_entry_t getSnaptSaiEntry(const NaptEntryKey &key)
+{
+    sai_nat_entry_t snat_entry = {};
+
+    snat_entry.vr_id = gVirtualRouterId;
+    snat_entry.switch_id = gSwitchId;
+    snat_entry.nat_type = SAI_NAT_TYPE_SOURCE_NAT;
+    snat_entry.data.key.src_ip = key.ip_address.getV4Addr();
+    snat_entry.data.key.l4_src_port = (uint16_t)(key.l4_port);
+    snat_entry.data.mask.src_ip = 0xffffffff;
+    snat_entry.data.mask.l4_src_port = 0xffff;
+    snat_entry.data.key.proto = ((key.prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
+    snat_entry.data.mask.proto = 0xff;
+
+    return snat_entry;
+}
+
+static sai_nat_entry_t getDnaptSaiEntry(const NaptEntryKey &key)
+{
+    sai_nat_entry_t dnat_entry = {};
+
+    dnat_entry.vr_id = gVirtualRouterId;
+    dnat_entry.switch_id = gSwitchId;
+    dnat_entry.nat_type = SAI_NAT_TYPE_DESTINATION_NAT;
+    dnat_entry.data.key.dst_ip = key.ip_address.getV4Addr();
+    dnat_entry.data.key.l4_dst_port = (uint16_t)(key.l4_port);
+    dnat_entry.data.mask.dst_ip = 0xffffffff;
+    dnat_entry.data.mask.l4_dst_port = 0xffff;
+    dnat_entry.data.key.proto = ((key.prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
+    dnat_entry.data.mask.proto = 0xff;
+
+    return dnat_entry;
+}
+
+static sai_nat_entry_t getTwiceNaptSaiEntry(const TwiceNaptEntryKey &key)
+{
+    sai_nat_entry_t dbl_nat_entry = {};
+
+    dbl_nat_entry.vr_id = gVirtualRouterId;
+    dbl_nat_entry.switch_id = gSwitchId;
+    dbl_nat_entry.nat_type = SAI_NAT_TYPE_DOUBLE_NAT;
+    dbl_nat_entry.data.key.src_ip = key.src_ip.getV4Addr();
+    dbl_nat_entry.data.mask.src_ip = 0xffffffff;
+    dbl_nat_entry.data.key.l4_src_port = (uint16_t)(key.src_l4_port);
+    dbl_nat_entry.data.mask.l4_src_port = 0xffff;
+    dbl_nat_entry.data.key.dst_ip = key.dst_ip.getV4Addr();
+    dbl_nat_entry.data.mask.dst_ip = 0xffffffff;
+    dbl_nat_entry.data.key.l4_dst_port = (uint16_t)(key.dst_l4_port);
+    dbl_nat_entry.data.mask.l4_dst_port = 0xffff;
+    dbl_nat_entry.data.key.proto = ((key.prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
+    dbl_nat_entry.data.mask.proto = 0xff;
+
+    return dbl_nat_entry;
+}
+
+/* Create the NAT entry right away, or with the next flush of the bulker in bulk mode.
+ * post is called with the status of the creation and returns false when it needs a retry.
+ * Outside of bulk mode that result is returned, a queued creation returns true.
+ */
+bool NatOrch::bulkCreateNatEntry(const sai_nat_entry_t &entry, uint32_t attr_count, const sai_attribute_t *attr_list,
+                                 std::function<bool(sai_status_t)> post)
+{
+    if (!m_natBulkMode || !m_natBulker)
+    {
+        return post(sai_nat_api->create_nat_entry(&entry, attr_count, attr_list));
+    }
+
+    /* The bulker holds one creation per entry, a second one goes to the SAI after the first as it would serially */
+    flushNatBulkerIfPending(entry);
+
+    m_natBulkOps.push_back({SAI_STATUS_NOT_EXECUTED, post});
+    m_natBulker->create_entry(&m_natBulkOps.back().status, &entry, attr_count, attr_list);
+
+    return true;
+}
+
+/* Remove the NAT entry right away, or with the next flush of the bulker in bulk mode.
+ * post is called with the status of the removal, as for bulkCreateNatEntry.
+ */
+bool NatOrch::bulkRemoveNatEntry(const sai_nat_entry_t &entry, std::function<bool(sai_status_t)> post)
+{
+    if (!m_natBulkMode || !m_natBulker)
+    {
+        return post(sai_nat_api->remove_nat_entry(&entry));
+    }
+
+    m_natBulkOps.push_back({SAI_STATUS_NOT_EXECUTED, post});
+    m_natBulker->remove_entry(&m_natBulkOps.back().status, &entry);
+
+    return true;
+}
+
+void NatOrch::flushNatBulker(void)
+{
+    if (m_natBulkOps.empty())
+    {
+        return;
+    }
+
+    SWSS_LOG_INFO("Flushing %zu NAT entry operations", m_natBulkOps.size());
+
+    m_natBulker->flush();
+
+    std::deque<NatBulkOp> ops;
+    ops.swap(m_natBulkOps);
+    for (auto &op : ops)
+    {
+        op.post(op.status);
+    }
+}
+
+/* A removal must see the outcome of a pending creation of the same entry */
+void NatOrch::flushNatBulkerIfPending(const sai_nat_entry_t &entry)
+{
+    if (m_natBulker && m_natBulker->creating_entries_count(entry))
+    {
+        flushNatBulker();
+    }
+}
+
 // Add the DNAT entry after nexthop resolution, to the hardware
 bool NatOrch::addHwDnatEntry(const IpAddress &ip_address)
 {
@@ -810,10 +949,8 @@ bool NatOrch::addHwDnatEntry(const IpAddress &ip_address)
 bool NatOrch::addHwDnaptEntry(const NaptEntryKey &key)
 {
     uint32_t        attr_count;
-    sai_nat_entry_t dnat_entry = {};
+    sai_nat_entry_t dnat_entry = getDnaptSaiEntry(key);
     sai_attribute_t nat_entry_attr[5] = {};
-    uint8_t         ip_protocol = ((key.prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
-    sai_status_t    status;
 
     SWSS_LOG_ENTER();
     SWSS_LOG_INFO("Create DNAPT entry for proto %s, dest-ip %s, l4-port %d, as nexthop is resolved",
@@ -841,52 +978,48 @@ bool NatOrch::addHwDnaptEntry(const NaptEntryKey &key)
 
     attr_count = 5;
 
-    dnat_entry.vr_id = gVirtualRouterId;
-    dnat_entry.switch_id = gSwitchId;
-    dnat_entry.nat_type = SAI_NAT_TYPE_DESTINATION_NAT;
-    dnat_entry.data.key.dst_ip = key.ip_address.getV4Addr();
-    dnat_entry.data.key.l4_dst_port = (uint16_t)(key.l4_port);
-    dnat_entry.data.mask.dst_ip = 0xffffffff;
-    dnat_entry.data.mask.l4_dst_port = 0xffff;
-    dnat_entry.data.key.proto = ip_protocol;
-    dnat_entry.data.mask.proto = 0xff;
-
-    status = sai_nat_api->create_nat_entry(&dnat_entry, attr_count, nat_entry_attr);
-    if (status != SAI_STATUS_SUCCESS)
+    return bulkCreateNatEntry(dnat_entry, attr_count, nat_entry_attr, [this, key, entry](sai_status_t status)
     {
-        SWSS_LOG_ERROR("Failed to create %s DNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
-                       entry.entry_type.c_str(), key.ip_address.to_string().c_str(), key.l4_port, key.prototype.c_str(),
-                       entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
-        task_process_status handle_status = handleSaiCreateStatus(SAI_API_NAT, status);
-        if (handle_status != task_success)
+        if (status != SAI_STATUS_SUCCESS)
         {
-            return parseHandleSaiStatusFailure(handle_status);
+            SWSS_LOG_ERROR("Failed to create %s DNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
+                           entry.entry_type.c_str(), key.ip_address.to_string().c_str(), key.l4_port, key.prototype.c_str(),
+                           entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
+            task_process_status handle_status = handleSaiCreateStatus(SAI_API_NAT, status);
+            if (handle_status != task_success)
+            {
+                return parseHandleSaiStatusFailure(handle_status);
+            }
         }
-    }
 
-    SWSS_LOG_NOTICE("Created %s DNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
-                    entry.entry_type.c_str(), key.ip_address.to_string().c_str(), key.l4_port, key.prototype.c_str(),
-                    entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
+        SWSS_LOG_NOTICE("Created %s DNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
+                        entry.entry_type.c_str(), key.ip_address.to_string().c_str(), key.l4_port, key.prototype.c_str(),
+                        entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
 
-    m_naptEntries[key].addedToHw = true;
-    updateNaptCounters(key.prototype.c_str(), key.ip_address, key.l4_port, 0, 0);
-    gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_DNAT_ENTRY);
+        auto iter = m_naptEntries.find(key);
+        if (iter != m_naptEntries.end())
+        {
+            iter->second.addedToHw = true;
+        }
+        updateNaptCounters(key.prototype.c_str(), key.ip_address, key.l4_port, 0, 0);
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_DNAT_ENTRY);
 
-    if (entry.entry_type == "static")
-    {
-        totalStaticNaptEntries++;
-        updateStaticNaptCounters(totalStaticNaptEntries);
-    }
-    else
-    {
-        totalDynamicNaptEntries++;
-        updateDynamicNaptCounters(totalDynamicNaptEntries);
-    }
-    totalDnatEntries++;
-    updateDnatCounters(totalDnatEntries);
-    totalEntries++;
+        if (entry.entry_type == "static")
+        {
+            totalStaticNaptEntries++;
+            updateStaticNaptCounters(totalStaticNaptEntries);
+        }
+        else
+        {
+            totalDynamicNaptEntries++;
+            updateDynamicNaptCounters(totalDynamicNaptEntries);
+        }
+        totalDnatEntries++;
+        updateDnatCounters(totalDnatEntries);
+        totalEntries++;
 
-    return true;
+        return true;
+    });
 }
 
 // Remove the DNAT entry from the hardware
@@ -1071,14 +1204,14 @@ bool NatOrch::removeHwTwiceNatEntry(const TwiceNatEntryKey &key)
 // Remove the DNAPT entry from the hardware
 bool NatOrch::removeHwDnaptEntry(const NaptEntryKey &key)
 {
-    sai_nat_entry_t dnat_entry = {};
-    sai_status_t    status;
-    uint8_t         ip_protocol = ((key.prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
+    sai_nat_entry_t dnat_entry = getDnaptSaiEntry(key);
 
     SWSS_LOG_ENTER();
     SWSS_LOG_INFO("Delete DNAPT entry for proto %s, dest-ip %s, l4-port %d",
                    key.prototype.c_str(), key.ip_address.to_string().c_str(), key.l4_port);
 
+    flushNatBulkerIfPending(dnat_entry);
+
     /* Check the entry is present in cache */
     if (m_naptEntries.find(key) == m_naptEntries.end())
     {
@@ -1098,81 +1231,72 @@ bool NatOrch::removeHwDnaptEntry(const NaptEntryKey &key)
 
     m_naptEntries[key].addedToHw = false;
 
-    dnat_entry.vr_id = gVirtualRouterId;
-    dnat_entry.switch_id = gSwitchId;
-    dnat_entry.nat_type = SAI_NAT_TYPE_DESTINATION_NAT;
-    dnat_entry.data.key.dst_ip = key.ip_address.getV4Addr();
-    dnat_entry.data.key.l4_dst_port = (uint16_t)(key.l4_port);
-    dnat_entry.data.mask.dst_ip = 0xffffffff;
-    dnat_entry.data.mask.l4_dst_port = 0xffff;
-    dnat_entry.data.key.proto = ip_protocol;
-    dnat_entry.data.mask.proto = 0xff;
-
-    status = sai_nat_api->remove_nat_entry(&dnat_entry);
-    if (status != SAI_STATUS_SUCCESS)
+    return bulkRemoveNatEntry(dnat_entry, [this, key, entry](sai_status_t status)
     {
-        SWSS_LOG_INFO("Failed to remove %s DNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
-                      entry.entry_type.c_str(), key.ip_address.to_string().c_str(), key.l4_port, key.prototype.c_str(),
-                      entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
-
-
-        task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NAT, status);
-        if (handle_status != task_success)
+        if (status != SAI_STATUS_SUCCESS)
         {
-            return parseHandleSaiStatusFailure(handle_status);
+            SWSS_LOG_INFO("Failed to remove %s DNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
+                          entry.entry_type.c_str(), key.ip_address.to_string().c_str(), key.l4_port, key.prototype.c_str(),
+                          entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
+
+            task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NAT, status);
+            if (handle_status != task_success)
+            {
+                return parseHandleSaiStatusFailure(handle_status);
+            }
         }
-    }
 
-    SWSS_LOG_NOTICE("Removed %s DNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
-                    entry.entry_type.c_str(), key.ip_address.to_string().c_str(), key.l4_port, key.prototype.c_str(), 
-                    entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
+        SWSS_LOG_NOTICE("Removed %s DNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
+                        entry.entry_type.c_str(), key.ip_address.to_string().c_str(), key.l4_port, key.prototype.c_str(),
+                        entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
 
-    deleteNaptCounters(key.prototype.c_str(), key.ip_address, key.l4_port);
-    gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_DNAT_ENTRY);
+        deleteNaptCounters(key.prototype.c_str(), key.ip_address, key.l4_port);
+        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_DNAT_ENTRY);
 
-    if (entry.entry_type == "static")
-    {
-        if (totalStaticNaptEntries)
+        if (entry.entry_type == "static")
         {
-            totalStaticNaptEntries--;
-            updateStaticNaptCounters(totalStaticNaptEntries);
+            if (totalStaticNaptEntries)
+            {
+                totalStaticNaptEntries--;
+                updateStaticNaptCounters(totalStaticNaptEntries);
+            }
         }
-    }
-    else
-    {
-        if (totalDynamicNaptEntries)
+        else
         {
-            totalDynamicNaptEntries--;
-            updateDynamicNaptCounters(totalDynamicNaptEntries);
+            if (totalDynamicNaptEntries)
+            {
+                totalDynamicNaptEntries--;
+                updateDynamicNaptCounters(totalDynamicNaptEntries);
+            }
         }
-    }
 
-    if (totalDnatEntries)
-    {
-        totalDnatEntries--;
-        updateDnatCounters(totalDnatEntries);
-    }
+        if (totalDnatEntries)
+        {
+            totalDnatEntries--;
+            updateDnatCounters(totalDnatEntries);
+        }
 
-    if (totalEntries)
-    {
-        totalEntries--;
-    }
+        if (totalEntries)
+        {
+            totalEntries--;
+        }
 
-    return true;
+        return true;
+    });
 }
 
 // Remove the Twice NAPT entry from the hardware
 bool NatOrch::removeHwTwiceNaptEntry(const TwiceNaptEntryKey &key)
 {
-    sai_nat_entry_t dbl_nat_entry = {};
-    sai_status_t    status;
-    uint8_t         protoType = ((key.prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
+    sai_nat_entry_t dbl_nat_entry = getTwiceNaptSaiEntry(key);
 
     SWSS_LOG_ENTER();
     SWSS_LOG_INFO("Delete Twice NAPT entry for proto %s, src-ip %s, src port %d, dst-ip %s, dst port %d",
                    key.prototype.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port,
                    key.dst_ip.to_string().c_str(), key.dst_l4_port);
 
+    flushNatBulkerIfPending(dbl_nat_entry);
+
     /* Check the entry is present in cache */
     if (m_twiceNaptEntries.find(key) == m_twiceNaptEntries.end())
     {
@@ -1192,78 +1316,65 @@ bool NatOrch::removeHwTwiceNaptEntry(const TwiceNaptEntryKey &key)
 
     TwiceNaptEntryValue value = m_twiceNaptEntries[key];
 
-    m_twiceNaptEntries[key].addedToHw = false;
-
-    dbl_nat_entry.vr_id = gVirtualRouterId;
-    dbl_nat_entry.switch_id = gSwitchId;
-    dbl_nat_entry.nat_type = SAI_NAT_TYPE_DOUBLE_NAT;
-    dbl_nat_entry.data.key.src_ip = key.src_ip.getV4Addr();
-    dbl_nat_entry.data.mask.src_ip = 0xffffffff;
-    dbl_nat_entry.data.key.l4_src_port = (uint16_t)(key.src_l4_port);
-    dbl_nat_entry.data.mask.l4_src_port = 0xffff;
-    dbl_nat_entry.data.key.dst_ip = key.dst_ip.getV4Addr();
-    dbl_nat_entry.data.mask.dst_ip = 0xffffffff;
-    dbl_nat_entry.data.key.l4_dst_port = (uint16_t)(key.dst_l4_port);
-    dbl_nat_entry.data.mask.l4_dst_port = 0xffff;
-    dbl_nat_entry.data.key.proto = protoType;
-    dbl_nat_entry.data.mask.proto = 0xff;
+    m_twiceNaptEntries.erase(key);
 
-    status = sai_nat_api->remove_nat_entry(&dbl_nat_entry);
-    if (status != SAI_STATUS_SUCCESS)
+    return bulkRemoveNatEntry(dbl_nat_entry, [this, key, value](sai_status_t status)
     {
-        SWSS_LOG_INFO("Failed to remove Twice NAPT entry with prototype %s, src-ip %s, src port %d, dst-ip %s, dst port %d",
-                       key.prototype.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port,
-                       key.dst_ip.to_string().c_str(), key.dst_l4_port);
-        task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NAT, status);
-        if (handle_status != task_success)
+        if (status != SAI_STATUS_SUCCESS)
         {
-            return parseHandleSaiStatusFailure(handle_status);
+            SWSS_LOG_INFO("Failed to remove Twice NAPT entry with prototype %s, src-ip %s, src port %d, dst-ip %s, dst port %d",
+                           key.prototype.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port,
+                           key.dst_ip.to_string().c_str(), key.dst_l4_port);
+            task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NAT, status);
+            if (handle_status != task_success)
+            {
+                return parseHandleSaiStatusFailure(handle_status);
+            }
         }
-    }
 
-    SWSS_LOG_NOTICE("Removed Twice NAPT entry with prototype %s, src-ip %s, src port %d, dst-ip %s, dst port %d",
-                    key.prototype.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port,
-                    key.dst_ip.to_string().c_str(), key.dst_l4_port);
+        SWSS_LOG_NOTICE("Removed Twice NAPT entry with prototype %s, src-ip %s, src port %d, dst-ip %s, dst port %d",
+                        key.prototype.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port,
+                        key.dst_ip.to_string().c_str(), key.dst_l4_port);
 
-    deleteTwiceNaptCounters(key);
-    m_twiceNaptEntries.erase(key);
+        deleteTwiceNaptCounters(key);
 
-    if (value.entry_type == "static")
-    {
-        if (totalStaticTwiceNaptEntries)
+        if (value.entry_type == "static")
         {
-            totalStaticTwiceNaptEntries--;
-            updateStaticTwiceNaptCounters(totalStaticTwiceNaptEntries);
+            if (totalStaticTwiceNaptEntries)
+            {
+                totalStaticTwiceNaptEntries--;
+                updateStaticTwiceNaptCounters(totalStaticTwiceNaptEntries);
+            }
         }
-    }
-    else
-    {
-        if (totalDynamicTwiceNaptEntries)
+        else
         {
-            totalDynamicTwiceNaptEntries--;
-            updateDynamicTwiceNaptCounters(totalDynamicTwiceNaptEntries);
+            if (totalDynamicTwiceNaptEntries)
+            {
+                totalDynamicTwiceNaptEntries--;
+                updateDynamicTwiceNaptCounters(totalDynamicTwiceNaptEntries);
+            }
         }
-    }
 
-    if (totalSnatEntries)
-    {
-        totalSnatEntries--;
-        updateSnatCounters(totalSnatEntries);
-    }
+        if (totalSnatEntries)
+        {
+            totalSnatEntries--;
+            updateSnatCounters(totalSnatEntries);
+        }
 
-    if (totalDnatEntries)
-    {
-        totalDnatEntries--;
-        updateDnatCounters(totalDnatEntries);
-    }
+        if (totalDnatEntries)
+        {
+            totalDnatEntries--;
+            updateDnatCounters(totalDnatEntries);
+        }
 
-    if (totalEntries >= 2)
-    {
-        // Each Twice NAT entry is equivalent to 1 SNAT and 1 DNAT entry together
-        totalEntries -= 2;
-    }
+        if (totalEntries >= 2)
+        {
+            // Each Twice NAT entry is equivalent to 1 SNAT and 1 DNAT entry together
+            totalEntries -= 2;
+        }
 
-    return true;
+        return true;
+    });
 }
 
 // Add the SNAT entry to the hardware
@@ -1321,6 +1432,11 @@ bool NatOrch::addHwSnatEntry(const IpAddress &ip_address)
     updateNatCounters(ip_address, 0, 0);
     m_natEntries[ip_address].addedToHw = true;
     m_natEntries[ip_address].activeTime = time_now.tv_sec;
+    m_natEntries[ip_address].ageOutTime = time_now.tv_sec + timeout;
+    if (entry.entry_type != "static")
+    {
+        scheduleHitBitCheck(m_natAgingWheel, m_natEntries.find(ip_address), time_now.tv_sec + getHitBitCheckInterval(timeout));
+    }
     gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_SNAT_ENTRY);
 
     if (entry.entry_type == "static")
@@ -1403,6 +1519,11 @@ bool NatOrch::addHwTwiceNatEntry(const TwiceNatEntryKey &key)
     updateTwiceNatCounters(key, 0, 0);
     m_twiceNatEntries[key].addedToHw = true; 
     m_twiceNatEntries[key].activeTime = time_now.tv_sec;
+    m_twiceNatEntries[key].ageOutTime = time_now.tv_sec + timeout;
+    if (value.entry_type != "static")
+    {
+        scheduleHitBitCheck(m_twiceNatAgingWheel, m_twiceNatEntries.find(key), time_now.tv_sec + getHitBitCheckInterval(timeout));
+    }
 
     totalDnatEntries++;
     updateDnatCounters(totalDnatEntries);
@@ -1430,10 +1551,8 @@ bool NatOrch::addHwTwiceNatEntry(const TwiceNatEntryKey &key)
 bool NatOrch::addHwSnaptEntry(const NaptEntryKey &keyEntry)
 {
     uint32_t        attr_count;
-    sai_nat_entry_t snat_entry = {};
+    sai_nat_entry_t snat_entry = getSnaptSaiEntry(keyEntry);
     sai_attribute_t nat_entry_attr[5] = {};
-    uint8_t         ip_protocol = ((keyEntry.prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
-    sai_status_t    status;
     struct timespec  time_now;
 
     SWSS_LOG_ENTER();
@@ -1460,63 +1579,66 @@ bool NatOrch::addHwSnaptEntry(const NaptEntryKey &keyEntry)
 
     attr_count = 5;
 
-    snat_entry.vr_id = gVirtualRouterId;
-    snat_entry.switch_id = gSwitchId;
-    snat_entry.nat_type = SAI_NAT_TYPE_SOURCE_NAT;
-    snat_entry.data.key.src_ip = keyEntry.ip_address.getV4Addr();
-    snat_entry.data.key.l4_src_port = (uint16_t)(keyEntry.l4_port);
-    snat_entry.data.mask.src_ip = 0xffffffff;
-    snat_entry.data.mask.l4_src_port = 0xffff;
-    snat_entry.data.key.proto = ip_protocol;
-    snat_entry.data.mask.proto = 0xff;
+    time_t now = time_now.tv_sec;
 
-    status = sai_nat_api->create_nat_entry(&snat_entry, attr_count, nat_entry_attr);
-    if (status != SAI_STATUS_SUCCESS)
+    return bulkCreateNatEntry(snat_entry, attr_count, nat_entry_attr, [this, keyEntry, entry, now](sai_status_t status)
     {
-        SWSS_LOG_ERROR("Failed to create %s SNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
-                       entry.entry_type.c_str(), keyEntry.ip_address.to_string().c_str(), keyEntry.l4_port, keyEntry.prototype.c_str(),
-                       entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
-
-        task_process_status handle_status = handleSaiCreateStatus(SAI_API_NAT, status);
-        if (handle_status != task_success)
+        if (status != SAI_STATUS_SUCCESS)
         {
-            return parseHandleSaiStatusFailure(handle_status);
+            SWSS_LOG_ERROR("Failed to create %s SNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
+                           entry.entry_type.c_str(), keyEntry.ip_address.to_string().c_str(), keyEntry.l4_port, keyEntry.prototype.c_str(),
+                           entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
+
+            task_process_status handle_status = handleSaiCreateStatus(SAI_API_NAT, status);
+            if (handle_status != task_success)
+            {
+                return parseHandleSaiStatusFailure(handle_status);
+            }
         }
-     }
 
-     SWSS_LOG_NOTICE("Created %s SNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
-                     entry.entry_type.c_str(), keyEntry.ip_address.to_string().c_str(), keyEntry.l4_port, keyEntry.prototype.c_str(),
-                     entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
+        SWSS_LOG_NOTICE("Created %s SNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
+                        entry.entry_type.c_str(), keyEntry.ip_address.to_string().c_str(), keyEntry.l4_port, keyEntry.prototype.c_str(),
+                        entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
 
-     m_naptEntries[keyEntry].addedToHw = true;
-     m_naptEntries[keyEntry].activeTime = time_now.tv_sec;
+        auto iter = m_naptEntries.find(keyEntry);
+        if (iter != m_naptEntries.end())
+        {
+            int entryTimeout = ((keyEntry.prototype == "TCP") ? tcp_timeout : udp_timeout);
 
-     updateNaptCounters(keyEntry.prototype.c_str(), keyEntry.ip_address, keyEntry.l4_port, 0, 0);
-     gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_SNAT_ENTRY);
+            iter->second.addedToHw = true;
+            iter->second.activeTime = now;
+            iter->second.ageOutTime = now + entryTimeout;
+            if (entry.entry_type != "static")
+            {
+                scheduleHitBitCheck(m_naptAgingWheel, iter, now + getHitBitCheckInterval(entryTimeout));
+            }
+        }
 
-     if (entry.entry_type == "static")
-     {
-         totalStaticNaptEntries++;
-         updateStaticNaptCounters(totalStaticNaptEntries);
-     }
-     else
-     {
-         totalDynamicNaptEntries++;
-         updateDynamicNaptCounters(totalDynamicNaptEntries);
-     }
-     totalEntries++;
+        updateNaptCounters(keyEntry.prototype.c_str(), keyEntry.ip_address, keyEntry.l4_port, 0, 0);
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_SNAT_ENTRY);
 
-    return true;
+        if (entry.entry_type == "static")
+        {
+            totalStaticNaptEntries++;
+            updateStaticNaptCounters(totalStaticNaptEntries);
+        }
+        else
+        {
+            totalDynamicNaptEntries++;
+            updateDynamicNaptCounters(totalDynamicNaptEntries);
+        }
+        totalEntries++;
+
+        return true;
+    });
 }
 
 // Add the Twice NAPT entry to the hardware
 bool NatOrch::addHwTwiceNaptEntry(const TwiceNaptEntryKey &key)
 {
     uint32_t        attr_count;
-    sai_nat_entry_t dbl_nat_entry = {};
+    sai_nat_entry_t dbl_nat_entry = getTwiceNaptSaiEntry(key);
     sai_attribute_t nat_entry_attr[8] = {};
-    uint8_t         protoType = ((key.prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
-    sai_status_t    status;
     struct timespec  time_now;
 
     SWSS_LOG_ENTER();
@@ -1550,67 +1672,68 @@ bool NatOrch::addHwTwiceNaptEntry(const TwiceNaptEntryKey &key)
 
     attr_count = 8;
 
-    dbl_nat_entry.vr_id = gVirtualRouterId;
-    dbl_nat_entry.switch_id = gSwitchId;
-    dbl_nat_entry.nat_type = SAI_NAT_TYPE_DOUBLE_NAT;
-    dbl_nat_entry.data.key.src_ip = key.src_ip.getV4Addr();
-    dbl_nat_entry.data.mask.src_ip = 0xffffffff;
-    dbl_nat_entry.data.key.l4_src_port = (uint16_t)(key.src_l4_port);
-    dbl_nat_entry.data.mask.l4_src_port = 0xffff;
-    dbl_nat_entry.data.key.dst_ip = key.dst_ip.getV4Addr();
-    dbl_nat_entry.data.mask.dst_ip = 0xffffffff;
-    dbl_nat_entry.data.key.l4_dst_port = (uint16_t)(key.dst_l4_port);
-    dbl_nat_entry.data.mask.l4_dst_port = 0xffff;
-    dbl_nat_entry.data.key.proto = protoType;
-    dbl_nat_entry.data.mask.proto = 0xff;
+    time_t now = time_now.tv_sec;
 
-    status = sai_nat_api->create_nat_entry(&dbl_nat_entry, attr_count, nat_entry_attr);
-    if (status != SAI_STATUS_SUCCESS)
+    return bulkCreateNatEntry(dbl_nat_entry, attr_count, nat_entry_attr, [this, key, value, now](sai_status_t status)
     {
-        SWSS_LOG_ERROR("Failed to create %s Twice NAPT entry with src ip %s, src port %d, dst ip %s dst port %d, prototype %s and \
-                       it's translated src ip %s, translated src port %d, translated dst ip %s, translated dst port %d ",
-                       value.entry_type.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port, key.dst_ip.to_string().c_str(),
-                       key.dst_l4_port, key.prototype.c_str(), value.translated_src_ip.to_string().c_str(), value.translated_src_l4_port,
-                       value.translated_dst_ip.to_string().c_str(), value.translated_dst_l4_port);
-
-        task_process_status handle_status = handleSaiCreateStatus(SAI_API_NAT, status);
-        if (handle_status != task_success)
+        if (status != SAI_STATUS_SUCCESS)
         {
-            return parseHandleSaiStatusFailure(handle_status);
+            SWSS_LOG_ERROR("Failed to create %s Twice NAPT entry with src ip %s, src port %d, dst ip %s dst port %d, prototype %s and \
+                           it's translated src ip %s, translated src port %d, translated dst ip %s, translated dst port %d ",
+                           value.entry_type.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port, key.dst_ip.to_string().c_str(),
+                           key.dst_l4_port, key.prototype.c_str(), value.translated_src_ip.to_string().c_str(), value.translated_src_l4_port,
+                           value.translated_dst_ip.to_string().c_str(), value.translated_dst_l4_port);
+
+            task_process_status handle_status = handleSaiCreateStatus(SAI_API_NAT, status);
+            if (handle_status != task_success)
+            {
+                return parseHandleSaiStatusFailure(handle_status);
+            }
         }
-     }
 
+        SWSS_LOG_NOTICE("Created %s Twice NAPT entry with src ip %s, src port %d, dst ip %s dst port %d, prototype %s and \
+                        it's translated src ip %s, translated src port %d, translated dst ip %s, translated dst port %d ",
+                        value.entry_type.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port, key.dst_ip.to_string().c_str(),
+                        key.dst_l4_port, key.prototype.c_str(), value.translated_src_ip.to_string().c_str(), value.translated_src_l4_port,
+                        value.translated_dst_ip.to_string().c_str(), value.translated_dst_l4_port);
 
-     SWSS_LOG_NOTICE("Created %s Twice NAPT entry with src ip %s, src port %d, dst ip %s dst port %d, prototype %s and \
-                     it's translated src ip %s, translated src port %d, translated dst ip %s, translated dst port %d ",
-                     value.entry_type.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port, key.dst_ip.to_string().c_str(),
-                     key.dst_l4_port, key.prototype.c_str(), value.translated_src_ip.to_string().c_str(), value.translated_src_l4_port,
-                     value.translated_dst_ip.to_string().c_str(), value.translated_dst_l4_port);
+        updateTwiceNaptCounters(key, 0, 0);
 
-     updateTwiceNaptCounters(key, 0, 0);
-     m_twiceNaptEntries[key].addedToHw = true;
-     m_twiceNaptEntries[key].activeTime = time_now.tv_sec;
+        auto iter = m_twiceNaptEntries.find(key);
+        if (iter != m_twiceNaptEntries.end())
+        {
+            int entryTimeout = ((key.prototype == "TCP") ? tcp_timeout : udp_timeout);
 
-     totalDnatEntries++;
-     updateDnatCounters(totalDnatEntries);
-     totalEntries++;
+            iter->second.addedToHw = true;
+            iter->second.activeTime = now;
+            iter->second.ageOutTime = now + entryTimeout;
+            if (value.entry_type != "static")
+            {
+                scheduleHitBitCheck(m_twiceNaptAgingWheel, iter, now + getHitBitCheckInterval(entryTimeout));
+            }
+        }
 
-     totalSnatEntries++;
-     updateSnatCounters(totalSnatEntries);
-     totalEntries++;
+        totalDnatEntries++;
+        updateDnatCounters(totalDnatEntries);
+        totalEntries++;
 
-     if (value.entry_type == "static")
-     {
-         totalStaticTwiceNaptEntries++;
-         updateStaticTwiceNaptCounters(totalStaticTwiceNaptEntries);
-     }
-     else
-     {
-         totalDynamicTwiceNaptEntries++;
-         updateDynamicTwiceNaptCounters(totalDynamicTwiceNaptEntries);
-     }
+        totalSnatEntries++;
+        updateSnatCounters(totalSnatEntries);
+        totalEntries++;
 
-    return true;
+        if (value.entry_type == "static")
+        {
+            totalStaticTwiceNaptEntries++;
+            updateStaticTwiceNaptCounters(totalStaticTwiceNaptEntries);
+        }
+        else
+        {
+            totalDynamicTwiceNaptEntries++;
+            updateDynamicTwiceNaptCounters(totalDynamicTwiceNaptEntries);
+        }
+
+        return true;
+    });
 }
 
 // Remove the SNAT entry from the hardware
@@ -1689,14 +1812,14 @@ bool NatOrch::removeHwSnatEntry(const IpAddress &ip_address)
 // Remove the SNAPT entry from the hardware
 bool NatOrch::removeHwSnaptEntry(const NaptEntryKey &keyEntry)
 {
-    sai_nat_entry_t snat_entry = {};
-    sai_status_t    status;
-    uint8_t         ip_protocol = ((keyEntry.prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
+    sai_nat_entry_t snat_entry = getSnaptSaiEntry(keyEntry);
 
     SWSS_LOG_ENTER();
     SWSS_LOG_INFO("Delete SNAPT entry for proto %s, src-ip %s, l4-port %d",
                    keyEntry.prototype.c_str(), keyEntry.ip_address.to_string().c_str(), keyEntry.l4_port);
 
+    flushNatBulkerIfPending(snat_entry);
+
     /* Check the entry is present in cache */
     if (m_naptEntries.find(keyEntry) == m_naptEntries.end())
     {
@@ -1707,31 +1830,27 @@ bool NatOrch::removeHwSnaptEntry(const NaptEntryKey &keyEntry)
 
     NaptEntryValue entry = m_naptEntries[keyEntry];
 
-    snat_entry.vr_id = gVirtualRouterId;
-    snat_entry.switch_id = gSwitchId;
-    snat_entry.nat_type = SAI_NAT_TYPE_SOURCE_NAT;
-    snat_entry.data.key.src_ip = keyEntry.ip_address.getV4Addr();
-    snat_entry.data.key.l4_src_port = (uint16_t)(keyEntry.l4_port);
-    snat_entry.data.mask.src_ip = 0xffffffff;
-    snat_entry.data.mask.l4_src_port = 0xffff;
-    snat_entry.data.key.proto = ip_protocol;
-    snat_entry.data.mask.proto = 0xff;
+    m_naptEntries.erase(keyEntry);
 
-    status = sai_nat_api->remove_nat_entry(&snat_entry);
-    if (status != SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_INFO("Failed to removed %s SNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
-                      entry.entry_type.c_str(), keyEntry.ip_address.to_string().c_str(), keyEntry.l4_port, keyEntry.prototype.c_str(),
-                      entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
-    }
-    else
+    bulkRemoveNatEntry(snat_entry, [this, keyEntry, entry](sai_status_t status)
     {
-        SWSS_LOG_NOTICE("Removed %s SNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
-                      entry.entry_type.c_str(), keyEntry.ip_address.to_string().c_str(), keyEntry.l4_port, keyEntry.prototype.c_str(),
-                      entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
-    }
+        if (status != SAI_STATUS_SUCCESS)
+        {
+            SWSS_LOG_INFO("Failed to removed %s SNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
+                          entry.entry_type.c_str(), keyEntry.ip_address.to_string().c_str(), keyEntry.l4_port, keyEntry.prototype.c_str(),
+                          entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
+        }
+        else
+        {
+            SWSS_LOG_NOTICE("Removed %s SNAT NAPT entry with ip %s, port %d, prototype %s and it's translated ip %s, translated port %d",
+                          entry.entry_type.c_str(), keyEntry.ip_address.to_string().c_str(), keyEntry.l4_port, keyEntry.prototype.c_str(),
+                          entry.translated_ip.to_string().c_str(), entry.translated_l4_port);
+        }
+
+        return true;
+    });
+
     deleteNaptCounters(keyEntry.prototype.c_str(), keyEntry.ip_address, keyEntry.l4_port);
-    m_naptEntries.erase(keyEntry);
     gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_SNAT_ENTRY);
 
     if (entry.entry_type == "static")
@@ -2362,6 +2481,9 @@ void NatOrch::clearAllDnatEntries(void)
     TwiceNaptEntryKey  twiceNaptKey;
     TwiceNaptEntryValue twiceNaptValue;
 
+    /* DNAPT and Twice NAPT entries are removed from the hardware in bulk */
+    m_natBulkMode = true;
+
     NatEntry::iterator natIter = m_natEntries.begin();
     while (natIter != m_natEntries.end())
     {
@@ -2451,6 +2573,9 @@ void NatOrch::clearAllDnatEntries(void)
             } 
         }
     }
+
+    flushNatBulker();
+    m_natBulkMode = false;
 }
 
 void NatOrch::cleanupAppDbEntries(void)
@@ -2681,6 +2806,9 @@ void NatOrch::doNatTableTask(Consumer& consumer)
 
 void NatOrch::doNaptTableTask(Consumer& consumer)
 {
+    /* SNAPT and DNAPT entries of this drain are created and removed in bulk */
+    m_natBulkMode = true;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -2751,6 +2879,9 @@ void NatOrch::doNaptTableTask(Consumer& consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    flushNatBulker();
+    m_natBulkMode = false;
 }
 
 void NatOrch::doTwiceNatTableTask(Consumer& consumer)
@@ -2823,6 +2954,9 @@ void NatOrch::doTwiceNatTableTask(Consumer& consumer)
 
 void NatOrch::doTwiceNaptTableTask(Consumer& consumer)
 {
+    /* Twice NAPT entries of this drain are created and removed in bulk */
+    m_natBulkMode = true;
+
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -2898,6 +3032,9 @@ void NatOrch::doTwiceNaptTableTask(Consumer& consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    flushNatBulker();
+    m_natBulkMode = false;
 }
 
 void NatOrch::doNatGlobalTableTask(Consumer& consumer)
@@ -2927,6 +3064,8 @@ void NatOrch::doNatGlobalTableTask(Consumer& consumer)
             continue;
         }
 
+        int old_timeout = timeout, old_tcp_timeout = tcp_timeout, old_udp_timeout = udp_timeout;
+
         for (auto i : kfvFieldsValues(t))
         {
             if (fvField(i) == "admin_mode")
@@ -2960,6 +3099,12 @@ void NatOrch::doNatGlobalTableTask(Consumer& consumer)
 
         SWSS_LOG_INFO("Global Values - Admin mode - %s, TCP - %d, UDP - %d and Both - %d", admin_mode.c_str(), tcp_timeout, udp_timeout, timeout);
 
+        if ((timeout != old_timeout) or (tcp_timeout != old_tcp_timeout) or (udp_timeout != old_udp_timeout))
+        {
+            /* Hit bit checks were scheduled with the old timeouts */
+            rescheduleAllHitBitChecks(getMonotonicTime());
+        }
+
         it = consumer.m_toSync.erase(it);
     }
 }
@@ -3097,10 +3242,7 @@ void NatOrch::doTask(SelectableTimer &timer)
 
     if (timer.getFd() == m_natQueryTimer->getFd())
     {
-        if (((natTimerTickCntr++) % NAT_HITBIT_QUERY_MULTIPLE) == 0)
-        {
-            queryHitBits();
-        }
+        queryHitBits();
         queryCounters();
     }
     else if (timer.getFd() == m_natTimeoutTimer->getFd())
@@ -3178,6 +3320,9 @@ void NatOrch::addAllNatEntries(void)
 {
     SWSS_LOG_ENTER();
 
+    /* NAPT and Twice NAPT entries are replayed to the hardware in bulk */
+    m_natBulkMode = true;
+
     NatEntry::iterator natIter = m_natEntries.begin();
     while (natIter != m_natEntries.end())
     {
@@ -3265,6 +3410,9 @@ void NatOrch::addAllNatEntries(void)
         }
         twiceNaptIter++;
     }
+
+    flushNatBulker();
+    m_natBulkMode = false;
 }
 
 void NatOrch::clearCounters(void)
@@ -3300,216 +3448,537 @@ void NatOrch::clearCounters(void)
     }
 }
 
-void NatOrch::queryHitBits(void)
+/* Hit bits of a batch of NAT entries, queried with a single bulk get when the SAI supports it.
+ * Entries the bulk get failed for are queried one by one, entries whose query fails are reported
+ * as unknown. The hit bits are cleared after they are read. */
+void NatOrch::getHitBits(const vector<sai_nat_entry_t> &entries, vector<NatHitBitState> &hitBits)
 {
-    SWSS_LOG_ENTER();
-
-    uint32_t         queried_entries = 0;
-    struct timespec  time_now, time_end, time_spent;
+    uint32_t                   count = (uint32_t)entries.size();
+    vector<sai_attribute_t>    attrs(count * 2);
+    vector<sai_attribute_t *>  attrLists(count);
+    vector<uint32_t>           attrCounts(count, 2);
+    vector<sai_status_t>       statuses(count, SAI_STATUS_NOT_EXECUTED);
+    sai_status_t               status;
+    uint32_t                   failed = 0;
 
-    if (clock_gettime (CLOCK_MONOTONIC, &time_now) < 0)
+    hitBits.assign(count, NAT_HITBIT_UNKNOWN);
+    if (count == 0)
     {
         return;
     }
 
-    /* Remove the NAT entries that are aged out.
-     * Query the NAT entries for their activity in the hardware
-     * and update the active timeout. */
-    NatEntry::iterator natIter = m_natEntries.begin();
-    while (natIter != m_natEntries.end())
+    for (uint32_t i = 0; i < count; i++)
     {
-        if (checkIfNatEntryIsActive(natIter, time_now.tv_sec))
-        {
-            /* Since the entry is active in the hardware, reset the active time */
-            natIter->second.activeTime = time_now.tv_sec;
-        }
-        else
-        {
-            if ((natIter->second.nat_type == "snat") and (natIter->second.addedToHw == true) and
-                (natIter->second.entry_type != "static"))
-            {
-                if (time_now.tv_sec - natIter->second.activeTime >= timeout)
-                {
-                    std::vector<FieldValueTuple> fvVector;
-                    std::string key = natIter->first.to_string();
-                    setTimeoutNotifier->send("AGEOUT-SINGLE-NAT", key, fvVector);
-                }
-            } 
-        }
-        queried_entries++;
-        natIter++;
+        attrLists[i] = &attrs[2 * i];
     }
 
-    /* Remove the NAPT entries that are aged out.
-     * Query the NAPT entries for their activity in the hardware
-     * and update the active timeout. */
-    NaptEntry::iterator naptIter = m_naptEntries.begin();
-    while (naptIter != m_naptEntries.end())
+    auto resetAttrs = [&](uint32_t i)
     {
-        if (checkIfNaptEntryIsActive(naptIter, time_now.tv_sec))
-        {
-            /* Since the entry is active in the hardware, reset the active time */
-            naptIter->second.activeTime = time_now.tv_sec;
-        }
-        else
+        attrs[2 * i].id                   = SAI_NAT_ENTRY_ATTR_HIT_BIT;  /* Get the Hit bit */
+        attrs[2 * i].value.booldata       = 0;
+        attrs[2 * i + 1].id               = SAI_NAT_ENTRY_ATTR_HIT_BIT_COR; /* clear the hit bit after returning the value */
+        attrs[2 * i + 1].value.booldata   = 1;
+    };
+
+    if (m_natBulkGetSupported and sai_nat_api->get_nat_entries_attribute)
+    {
+        for (uint32_t i = 0; i < count; i++)
         {
-            if ((naptIter->second.nat_type == "snat") and (naptIter->second.addedToHw == true) and
-                (naptIter->second.entry_type != "static"))
-            {
-                int timeout = naptIter->first.prototype == string("TCP") ? tcp_timeout : udp_timeout;
-                if (time_now.tv_sec - naptIter->second.activeTime >= timeout)
-                {
-                    std::vector<FieldValueTuple> fvVector;
-                    std::string key = (naptIter->first.prototype + ":" + naptIter->first.ip_address.to_string() + ":" + to_string(naptIter->first.l4_port));
-                    setTimeoutNotifier->send("AGEOUT-SINGLE-NAPT", key, fvVector);
-                }
-            }
+            resetAttrs(i);
         }
-        queried_entries++;
-        naptIter++;
-    }
 
-    /* Remove the Twice NAT entries that are aged out.
-     * Query the Twice NAT entries for their activity in the hardware
-     * and update the active timeout. */
-    TwiceNatEntry::iterator twiceNatIter = m_twiceNatEntries.begin();
-    while (twiceNatIter != m_twiceNatEntries.end())
-    {
-        if (checkIfTwiceNatEntryIsActive(twiceNatIter, time_now.tv_sec))
+        status = sai_nat_api->get_nat_entries_attribute(count, entries.data(), attrCounts.data(), attrLists.data(),
+                                                        SAI_BULK_OP_ERROR_MODE_IGNORE_ERROR, statuses.data());
+        if ((status == SAI_STATUS_NOT_IMPLEMENTED) or (status == SAI_STATUS_NOT_SUPPORTED))
         {
-            /* Since the entry is active in the hardware, reset the active time */
-            twiceNatIter->second.activeTime = time_now.tv_sec;
+            SWSS_LOG_NOTICE("Bulk get of NAT entries is not supported, querying hit bits entry by entry");
+            m_natBulkGetSupported = false;
+            statuses.assign(count, SAI_STATUS_NOT_EXECUTED);
         }
-        else
+        else if (status != SAI_STATUS_SUCCESS)
         {
-            if ((twiceNatIter->second.addedToHw == true) and
-                (twiceNatIter->second.entry_type != "static"))
-            {
-                if (time_now.tv_sec - twiceNatIter->second.activeTime >= timeout)
-                {
-                    std::vector<FieldValueTuple> fvVector;
-                    std::string key = (twiceNatIter->first.src_ip.to_string() + ":" + twiceNatIter->first.dst_ip.to_string());
-                    setTimeoutNotifier->send("AGEOUT-TWICE-NAT", key, fvVector);
-                }
-            }
+            SWSS_LOG_WARN("Bulk get of %u NAT entries failed, rv:%d, querying the failed entries one by one", count, status);
         }
-        queried_entries++;
-        twiceNatIter++;
+    }
+    else
+    {
+        m_natBulkGetSupported = false;
     }
 
-    /* Remove the Twice NAPT entries that are aged out.
-     * Query the Twice NAPT entries for their activity in the hardware
-     * and update the active timeout. */
-    TwiceNaptEntry::iterator twiceNaptIter = m_twiceNaptEntries.begin();
-    while (twiceNaptIter != m_twiceNaptEntries.end())
+    for (uint32_t i = 0; i < count; i++)
     {
-        if (checkIfTwiceNaptEntryIsActive(twiceNaptIter, time_now.tv_sec))
+        /* The hit bits returned by the bulk get are already cleared, only the other entries are queried again */
+        if (statuses[i] != SAI_STATUS_SUCCESS)
         {
-            /* Since the entry is active in the hardware, reset the active time */
-            twiceNaptIter->second.activeTime = time_now.tv_sec;
+            resetAttrs(i);
+            statuses[i] = sai_nat_api->get_nat_entry_attribute(&entries[i], attrCounts[i], attrLists[i]);
+        }
+
+        if (statuses[i] == SAI_STATUS_SUCCESS)
+        {
+            hitBits[i] = attrs[2 * i].value.booldata ? NAT_HITBIT_SET : NAT_HITBIT_CLEAR;
         }
         else
         {
-            if ((twiceNaptIter->second.addedToHw == true) and
-                (twiceNaptIter->second.entry_type != "static"))
-            {
-                int timeout = twiceNaptIter->first.prototype == string("TCP") ? tcp_timeout : udp_timeout;
-                if (time_now.tv_sec - twiceNaptIter->second.activeTime >= timeout)
-                {
-                    std::vector<FieldValueTuple> fvVector;
-                    std::string key = (twiceNaptIter->first.prototype + ":" + twiceNaptIter->first.src_ip.to_string() + ":" + to_string(twiceNaptIter->first.src_l4_port) + 
-                                       ":" + twiceNaptIter->first.dst_ip.to_string() + ":" + to_string(twiceNaptIter->first.dst_l4_port));
-                    setTimeoutNotifier->send("AGEOUT-TWICE-NAPT", key, fvVector);
-                }
-            }
+            failed++;
         }
-        queried_entries++;
-        twiceNaptIter++;
     }
-    if (clock_gettime (CLOCK_MONOTONIC, &time_end) < 0)
+
+    if (failed)
     {
-        return;
+        SWSS_LOG_NOTICE("Failed to query the hit bits of %u of %u NAT entries, they are queried again later", failed, count);
     }
-    time_spent = getTimeDiff(time_now, time_end);
+}
 
-    if (queried_entries)
+/* Combined hit bits of the two directions of an entry */
+static NatHitBitState combineHitBits(NatHitBitState forward, NatHitBitState reverse)
+{
+    if ((forward == NAT_HITBIT_SET) or (reverse == NAT_HITBIT_SET))
     {
-        SWSS_LOG_DEBUG("Time spent in querying hardware hit-bits for %u NAT/NAPT entries = %lu secs, %lu msecs",
-                       queried_entries, time_spent.tv_sec, (time_spent.tv_nsec / 1000000UL));
+        return NAT_HITBIT_SET;
+    }
+    if ((forward == NAT_HITBIT_UNKNOWN) or (reverse == NAT_HITBIT_UNKNOWN))
+    {
+        return NAT_HITBIT_UNKNOWN;
     }
+    return NAT_HITBIT_CLEAR;
 }
 
-void NatOrch::updateAllConntrackEntries(void)
+/* Interval between two hit bit queries of an active entry */
+time_t NatOrch::getHitBitCheckInterval(int timeout)
 {
-    SWSS_LOG_ENTER();
+    return max((time_t)(timeout / NAT_HITBIT_CHECKS_PER_TIMEOUT),
+               (time_t)(NAT_HITBIT_N_CNTRS_QUERY_PERIOD * NAT_HITBIT_QUERY_MULTIPLE));
+}
 
-    /* Send notifications for the Single NAT entries to set timeout */
-    NatEntry::iterator natIter = m_natEntries.begin();
-    while (natIter != m_natEntries.end())
+template <typename Key, typename Iter>
+void NatOrch::scheduleHitBitCheck(TimerWheel<Key> &wheel, Iter iter, time_t checkTime)
+{
+    iter->second.hitBitCheckTime = checkTime;
+    wheel.schedule(iter->first, checkTime);
+}
+
+/* Update the activity of an entry whose hit bits were queried and schedule its next query.
+ * An entry whose hit bits could not be read keeps its activity and is queried again soon.
+ * Returns true if the entry aged out. */
+template <typename Key, typename Iter>
+bool NatOrch::updateEntryActivity(TimerWheel<Key> &wheel, Iter iter, NatHitBitState hitBit, time_t now, int timeout)
+{
+    auto     &entry = iter->second;
+    time_t   interval = getHitBitCheckInterval(timeout);
+    bool     agedOut = false;
+
+    if (hitBit == NAT_HITBIT_UNKNOWN)
+    {
+        scheduleHitBitCheck(wheel, iter, now + NAT_HITBIT_N_CNTRS_QUERY_PERIOD * NAT_HITBIT_QUERY_MULTIPLE);
+    }
+    else if (hitBit == NAT_HITBIT_SET)
+    {
+        /* Since the entry is active in the hardware, reset the active time */
+        entry.activeTime = now;
+        entry.ageOutTime = now + timeout;
+        scheduleHitBitCheck(wheel, iter, now + interval);
+    }
+    else if (now - entry.activeTime >= timeout)
+    {
+        /* Notify again if the entry is still present at the next query */
+        agedOut = true;
+        scheduleHitBitCheck(wheel, iter, now + NAT_HITBIT_N_CNTRS_QUERY_PERIOD * NAT_HITBIT_QUERY_MULTIPLE);
+    }
+    else
     {
+        scheduleHitBitCheck(wheel, iter, min(entry.activeTime + timeout, now + interval));
+    }
+
+    return agedOut;
+}
+
+void NatOrch::rescheduleAllHitBitChecks(time_t now)
+{
+    SWSS_LOG_ENTER();
+
+    /* Start from empty wheels, so the checks scheduled with the old timeouts are not left behind */
+    m_natAgingWheel = TimerWheel<IpAddress>(NAT_HITBIT_N_CNTRS_QUERY_PERIOD, now);
+    m_naptAgingWheel = TimerWheel<NaptEntryKey>(NAT_HITBIT_N_CNTRS_QUERY_PERIOD, now);
+    m_twiceNatAgingWheel = TimerWheel<TwiceNatEntryKey>(NAT_HITBIT_N_CNTRS_QUERY_PERIOD, now);
+    m_twiceNaptAgingWheel = TimerWheel<TwiceNaptEntryKey>(NAT_HITBIT_N_CNTRS_QUERY_PERIOD, now);
 
+    for (auto natIter = m_natEntries.begin(); natIter != m_natEntries.end(); natIter++)
+    {
         if ((natIter->second.nat_type == "snat") and (natIter->second.addedToHw == true) and
             (natIter->second.entry_type != "static"))
         {
-            SWSS_LOG_ERROR("Update %s NAT entry [ip %s]", natIter->second.nat_type.c_str(), natIter->first.to_string().c_str());
-            std::vector<FieldValueTuple> fvVector;
-            std::string key = natIter->first.to_string();
-            setTimeoutNotifier->send("SET-SINGLE-NAT", key, fvVector);
+            scheduleHitBitCheck(m_natAgingWheel, natIter, now);
         }
-        natIter++;
     }
 
-    /* Send notifications for the Single NAPT entries to set timeout */
-    NaptEntry::iterator naptIter = m_naptEntries.begin();
-    while (naptIter != m_naptEntries.end())
+    for (auto naptIter = m_naptEntries.begin(); naptIter != m_naptEntries.end(); naptIter++)
     {
         if ((naptIter->second.nat_type == "snat") and (naptIter->second.addedToHw == true) and
             (naptIter->second.entry_type != "static"))
         {
-            std::vector<FieldValueTuple> fvVector;
-            std::string key = (naptIter->first.prototype + ":" + naptIter->first.ip_address.to_string() + ":" + to_string(naptIter->first.l4_port));
-            setTimeoutNotifier->send("SET-SINGLE-NAPT", key, fvVector);
+            scheduleHitBitCheck(m_naptAgingWheel, naptIter, now);
         }
-        naptIter++;
     }
 
-    /* Send notifications for the Twice NAT entries to set timeout */
-    TwiceNatEntry::iterator twiceNatIter = m_twiceNatEntries.begin();
-    while (twiceNatIter != m_twiceNatEntries.end())
+    for (auto twiceNatIter = m_twiceNatEntries.begin(); twiceNatIter != m_twiceNatEntries.end(); twiceNatIter++)
     {
-        if ((twiceNatIter->second.addedToHw == true) and
-            (twiceNatIter->second.entry_type != "static"))
+        if ((twiceNatIter->second.addedToHw == true) and (twiceNatIter->second.entry_type != "static"))
         {
-            std::vector<FieldValueTuple> fvVector;
-            std::string key = (twiceNatIter->first.src_ip.to_string() + ":" + twiceNatIter->first.dst_ip.to_string());
-            setTimeoutNotifier->send("SET-TWICE-NAT", key, fvVector);
+            scheduleHitBitCheck(m_twiceNatAgingWheel, twiceNatIter, now);
         }
-        twiceNatIter++;
     }
-   
-    /* Send notifications for the Twice NAPT entries to set timeout */
-    TwiceNaptEntry::iterator twiceNaptIter = m_twiceNaptEntries.begin();
-    while (twiceNaptIter != m_twiceNaptEntries.end())
+
+    for (auto twiceNaptIter = m_twiceNaptEntries.begin(); twiceNaptIter != m_twiceNaptEntries.end(); twiceNaptIter++)
     {
-        if ((twiceNaptIter->second.addedToHw == true) and
-            (twiceNaptIter->second.entry_type != "static"))
+        if ((twiceNaptIter->second.addedToHw == true) and (twiceNaptIter->second.entry_type != "static"))
         {
-            std::vector<FieldValueTuple> fvVector;
-            std::string key = (twiceNaptIter->first.prototype + ":" + twiceNaptIter->first.src_ip.to_string() + ":" + to_string(twiceNaptIter->first.src_l4_port) +
-                               ":" + twiceNaptIter->first.dst_ip.to_string() + ":" + to_string(twiceNaptIter->first.dst_l4_port));
-            setTimeoutNotifier->send("SET-TWICE-NAPT", key, fvVector);
+            scheduleHitBitCheck(m_twiceNaptAgingWheel, twiceNaptIter, now);
         }
-        twiceNaptIter++;
     }
 }
 
-bool NatOrch::getNatCounters(const NatEntry::iterator &iter)
+static sai_nat_entry_t getSnatEntryKey(const IpAddress &srcIp, const string &prototype = "", int srcPort = -1)
 {
-    const IpAddress   &ipAddr = iter->first;
-    NatEntryValue     &entry  = iter->second;
-    uint32_t          attr_count;
-    sai_attribute_t   nat_entry_attr[4] = {};
-    sai_nat_entry_t   nat_entry = {};
+    sai_nat_entry_t snat_entry = {};
+
+    snat_entry.vr_id                 = gVirtualRouterId;
+    snat_entry.switch_id             = gSwitchId;
+    snat_entry.nat_type              = SAI_NAT_TYPE_SOURCE_NAT;
+    snat_entry.data.key.src_ip       = srcIp.getV4Addr();
+    snat_entry.data.mask.src_ip      = 0xffffffff;
+
+    if (srcPort >= 0)
+    {
+        snat_entry.data.key.l4_src_port  = (uint16_t)srcPort;
+        snat_entry.data.mask.l4_src_port = 0xffff;
+        snat_entry.data.key.proto        = (uint8_t)((prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
+        snat_entry.data.mask.proto       = 0xff;
+    }
+
+    return snat_entry;
+}
+
+static sai_nat_entry_t getDnatEntryKey(const IpAddress &dstIp, const string &prototype = "", int dstPort = -1)
+{
+    sai_nat_entry_t dnat_entry = {};
+
+    dnat_entry.vr_id                 = gVirtualRouterId;
+    dnat_entry.switch_id             = gSwitchId;
+    dnat_entry.nat_type              = SAI_NAT_TYPE_DESTINATION_NAT;
+    dnat_entry.data.key.dst_ip       = dstIp.getV4Addr();
+    dnat_entry.data.mask.dst_ip      = 0xffffffff;
+
+    if (dstPort >= 0)
+    {
+        dnat_entry.data.key.l4_dst_port  = (uint16_t)dstPort;
+        dnat_entry.data.mask.l4_dst_port = 0xffff;
+        dnat_entry.data.key.proto        = (uint8_t)((prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
+        dnat_entry.data.mask.proto       = 0xff;
+    }
+
+    return dnat_entry;
+}
+
+static sai_nat_entry_t getDoubleNatEntryKey(const IpAddress &srcIp, const IpAddress &dstIp,
+                                            const string &prototype = "", int srcPort = -1, int dstPort = -1)
+{
+    sai_nat_entry_t dbl_nat_entry = {};
+
+    dbl_nat_entry.vr_id              = gVirtualRouterId;
+    dbl_nat_entry.switch_id          = gSwitchId;
+    dbl_nat_entry.nat_type           = SAI_NAT_TYPE_DOUBLE_NAT;
+    dbl_nat_entry.data.key.src_ip    = srcIp.getV4Addr();
+    dbl_nat_entry.data.mask.src_ip   = 0xffffffff;
+    dbl_nat_entry.data.key.dst_ip    = dstIp.getV4Addr();
+    dbl_nat_entry.data.mask.dst_ip   = 0xffffffff;
+
+    if ((srcPort >= 0) and (dstPort >= 0))
+    {
+        dbl_nat_entry.data.key.l4_src_port  = (uint16_t)srcPort;
+        dbl_nat_entry.data.mask.l4_src_port = 0xffff;
+        dbl_nat_entry.data.key.l4_dst_port  = (uint16_t)dstPort;
+        dbl_nat_entry.data.mask.l4_dst_port = 0xffff;
+        dbl_nat_entry.data.key.proto        = (uint8_t)((prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
+        dbl_nat_entry.data.mask.proto       = 0xff;
+    }
+
+    return dbl_nat_entry;
+}
+
+void NatOrch::queryHitBits(void)
+{
+    SWSS_LOG_ENTER();
+
+    struct timespec                  time_now, time_end, time_spent;
+    vector<NatEntry::iterator>       natDue;
+    vector<NaptEntry::iterator>      naptDue;
+    vector<TwiceNatEntry::iterator>  twiceNatDue;
+    vector<TwiceNaptEntry::iterator> twiceNaptDue;
+    vector<sai_nat_entry_t>          queries;
+    vector<NatHitBitState>           hitBits;
+
+    if (clock_gettime (CLOCK_MONOTONIC, &time_now) < 0)
+    {
+        return;
+    }
+
+    /* Collect the dynamic entries whose hit bits are due for a query.
+     * Expirations for entries that were removed or rescheduled meanwhile are stale and dropped.
+     * A collected entry is marked as not scheduled, so a duplicate expiration is dropped too.
+     * Entries that left the hardware are scheduled again when they are added back. */
+    m_natAgingWheel.advance(time_now.tv_sec, [&](const IpAddress &key, time_t checkTime)
+    {
+        auto natIter = m_natEntries.find(key);
+        if ((natIter != m_natEntries.end()) and (natIter->second.hitBitCheckTime == checkTime) and
+            (natIter->second.nat_type == "snat") and (natIter->second.addedToHw == true) and
+            (natIter->second.entry_type != "static"))
+        {
+            natIter->second.hitBitCheckTime = 0;
+            natDue.push_back(natIter);
+        }
+    });
+    m_naptAgingWheel.advance(time_now.tv_sec, [&](const NaptEntryKey &key, time_t checkTime)
+    {
+        auto naptIter = m_naptEntries.find(key);
+        if ((naptIter != m_naptEntries.end()) and (naptIter->second.hitBitCheckTime == checkTime) and
+            (naptIter->second.nat_type == "snat") and (naptIter->second.addedToHw == true) and
+            (naptIter->second.entry_type != "static"))
+        {
+            naptIter->second.hitBitCheckTime = 0;
+            naptDue.push_back(naptIter);
+        }
+    });
+    m_twiceNatAgingWheel.advance(time_now.tv_sec, [&](const TwiceNatEntryKey &key, time_t checkTime)
+    {
+        auto twiceNatIter = m_twiceNatEntries.find(key);
+        if ((twiceNatIter != m_twiceNatEntries.end()) and (twiceNatIter->second.hitBitCheckTime == checkTime) and
+            (twiceNatIter->second.addedToHw == true) and (twiceNatIter->second.entry_type != "static"))
+        {
+            twiceNatIter->second.hitBitCheckTime = 0;
+            twiceNatDue.push_back(twiceNatIter);
+        }
+    });
+    m_twiceNaptAgingWheel.advance(time_now.tv_sec, [&](const TwiceNaptEntryKey &key, time_t checkTime)
+    {
+        auto twiceNaptIter = m_twiceNaptEntries.find(key);
+        if ((twiceNaptIter != m_twiceNaptEntries.end()) and (twiceNaptIter->second.hitBitCheckTime == checkTime) and
+            (twiceNaptIter->second.addedToHw == true) and (twiceNaptIter->second.entry_type != "static"))
+        {
+            twiceNaptIter->second.hitBitCheckTime = 0;
+            twiceNaptDue.push_back(twiceNaptIter);
+        }
+    });
+
+    size_t queried_entries = natDue.size() + naptDue.size() + twiceNatDue.size() + twiceNaptDue.size();
+    if (queried_entries == 0)
+    {
+        return;
+    }
+
+    /* First round: SNAT direction of the single NAT/NAPT entries and the Twice NAT/NAPT entries */
+    for (const auto &natIter : natDue)
+    {
+        queries.push_back(getSnatEntryKey(natIter->first));
+    }
+    for (const auto &naptIter : naptDue)
+    {
+        queries.push_back(getSnatEntryKey(naptIter->first.ip_address, naptIter->first.prototype, naptIter->first.l4_port));
+    }
+    for (const auto &twiceNatIter : twiceNatDue)
+    {
+        queries.push_back(getDoubleNatEntryKey(twiceNatIter->first.src_ip, twiceNatIter->first.dst_ip));
+    }
+    for (const auto &twiceNaptIter : twiceNaptDue)
+    {
+        queries.push_back(getDoubleNatEntryKey(twiceNaptIter->first.src_ip, twiceNaptIter->first.dst_ip, twiceNaptIter->first.prototype,
+                                               twiceNaptIter->first.src_l4_port, twiceNaptIter->first.dst_l4_port));
+    }
+
+    getHitBits(queries, hitBits);
+
+    vector<NatHitBitState> natActive(hitBits.begin(), hitBits.begin() + natDue.size());
+    vector<NatHitBitState> naptActive(hitBits.begin() + natDue.size(), hitBits.begin() + natDue.size() + naptDue.size());
+    vector<NatHitBitState> twiceActive(hitBits.begin() + natDue.size() + naptDue.size(), hitBits.end());
+
+    /* Second round: if the SNAT HitBit is not known to be set, check for the HitBit in the reverse direction */
+    vector<size_t> natReverse, naptReverse;
+
+    queries.clear();
+    for (size_t i = 0; i < natDue.size(); i++)
+    {
+        if (natActive[i] == NAT_HITBIT_SET)
+        {
+            continue;
+        }
+
+        auto dnatIter = m_natEntries.find(natDue[i]->second.translated_ip);
+        if ((dnatIter != m_natEntries.end()) and ((dnatIter->second).addedToHw == true))
+        {
+            natReverse.push_back(i);
+            queries.push_back(getDnatEntryKey(natDue[i]->second.translated_ip));
+        }
+    }
+    for (size_t i = 0; i < naptDue.size(); i++)
+    {
+        if (naptActive[i] == NAT_HITBIT_SET)
+        {
+            continue;
+        }
+
+        NaptEntryKey dnaptKey;
+        dnaptKey.ip_address = naptDue[i]->second.translated_ip;
+        dnaptKey.l4_port    = naptDue[i]->second.translated_l4_port;
+        dnaptKey.prototype  = naptDue[i]->first.prototype;
+
+        auto dnaptIter = m_naptEntries.find(dnaptKey);
+        if ((dnaptIter != m_naptEntries.end()) and ((dnaptIter->second).addedToHw == true))
+        {
+            naptReverse.push_back(i);
+            queries.push_back(getDnatEntryKey(dnaptKey.ip_address, dnaptKey.prototype, dnaptKey.l4_port));
+        }
+    }
+
+    getHitBits(queries, hitBits);
+
+    for (size_t i = 0; i < natReverse.size(); i++)
+    {
+        natActive[natReverse[i]] = combineHitBits(natActive[natReverse[i]], hitBits[i]);
+    }
+    for (size_t i = 0; i < naptReverse.size(); i++)
+    {
+        naptActive[naptReverse[i]] = combineHitBits(naptActive[naptReverse[i]], hitBits[natReverse.size() + i]);
+    }
+
+    /* Update the active time of the queried entries and notify the ones that aged out */
+    for (size_t i = 0; i < natDue.size(); i++)
+    {
+        auto &natIter = natDue[i];
+        if (updateEntryActivity(m_natAgingWheel, natIter, natActive[i], time_now.tv_sec, timeout))
+        {
+            std::vector<FieldValueTuple> fvVector;
+            std::string key = natIter->first.to_string();
+            setTimeoutNotifier->send("AGEOUT-SINGLE-NAT", key, fvVector);
+        }
+    }
+
+    for (size_t i = 0; i < naptDue.size(); i++)
+    {
+        auto &naptIter = naptDue[i];
+        int timeout = naptIter->first.prototype == string("TCP") ? tcp_timeout : udp_timeout;
+        if (updateEntryActivity(m_naptAgingWheel, naptIter, naptActive[i], time_now.tv_sec, timeout))
+        {
+            std::vector<FieldValueTuple> fvVector;
+            std::string key = (naptIter->first.prototype + ":" + naptIter->first.ip_address.to_string() + ":" + to_string(naptIter->first.l4_port));
+            setTimeoutNotifier->send("AGEOUT-SINGLE-NAPT", key, fvVector);
+        }
+    }
+
+    for (size_t i = 0; i < twiceNatDue.size(); i++)
+    {
+        auto &twiceNatIter = twiceNatDue[i];
+        if (updateEntryActivity(m_twiceNatAgingWheel, twiceNatIter, twiceActive[i], time_now.tv_sec, timeout))
+        {
+            std::vector<FieldValueTuple> fvVector;
+            std::string key = (twiceNatIter->first.src_ip.to_string() + ":" + twiceNatIter->first.dst_ip.to_string());
+            setTimeoutNotifier->send("AGEOUT-TWICE-NAT", key, fvVector);
+        }
+    }
+
+    for (size_t i = 0; i < twiceNaptDue.size(); i++)
+    {
+        auto &twiceNaptIter = twiceNaptDue[i];
+        int timeout = twiceNaptIter->first.prototype == string("TCP") ? tcp_timeout : udp_timeout;
+        if (updateEntryActivity(m_twiceNaptAgingWheel, twiceNaptIter, twiceActive[twiceNatDue.size() + i], time_now.tv_sec, timeout))
+        {
+            std::vector<FieldValueTuple> fvVector;
+            std::string key = (twiceNaptIter->first.prototype + ":" + twiceNaptIter->first.src_ip.to_string() + ":" + to_string(twiceNaptIter->first.src_l4_port) +
+                               ":" + twiceNaptIter->first.dst_ip.to_string() + ":" + to_string(twiceNaptIter->first.dst_l4_port));
+            setTimeoutNotifier->send("AGEOUT-TWICE-NAPT", key, fvVector);
+        }
+    }
+
+    if (clock_gettime (CLOCK_MONOTONIC, &time_end) < 0)
+    {
+        return;
+    }
+    time_spent = getTimeDiff(time_now, time_end);
+
+    SWSS_LOG_DEBUG("Time spent in querying hardware hit-bits for %zu NAT/NAPT entries = %lu secs, %lu msecs",
+                   queried_entries, time_spent.tv_sec, (time_spent.tv_nsec / 1000000UL));
+}
+
+void NatOrch::updateAllConntrackEntries(void)
+{
+    SWSS_LOG_ENTER();
+
+    /* Send notifications for the Single NAT entries to set timeout */
+    NatEntry::iterator natIter = m_natEntries.begin();
+    while (natIter != m_natEntries.end())
+    {
+
+        if ((natIter->second.nat_type == "snat") and (natIter->second.addedToHw == true) and
+            (natIter->second.entry_type != "static"))
+        {
+            SWSS_LOG_ERROR("Update %s NAT entry [ip %s]", natIter->second.nat_type.c_str(), natIter->first.to_string().c_str());
+            std::vector<FieldValueTuple> fvVector;
+            std::string key = natIter->first.to_string();
+            setTimeoutNotifier->send("SET-SINGLE-NAT", key, fvVector);
+        }
+        natIter++;
+    }
+
+    /* Send notifications for the Single NAPT entries to set timeout */
+    NaptEntry::iterator naptIter = m_naptEntries.begin();
+    while (naptIter != m_naptEntries.end())
+    {
+        if ((naptIter->second.nat_type == "snat") and (naptIter->second.addedToHw == true) and
+            (naptIter->second.entry_type != "static"))
+        {
+            std::vector<FieldValueTuple> fvVector;
+            std::string key = (naptIter->first.prototype + ":" + naptIter->first.ip_address.to_string() + ":" + to_string(naptIter->first.l4_port));
+            setTimeoutNotifier->send("SET-SINGLE-NAPT", key, fvVector);
+        }
+        naptIter++;
+    }
+
+    /* Send notifications for the Twice NAT entries to set timeout */
+    TwiceNatEntry::iterator twiceNatIter = m_twiceNatEntries.begin();
+    while (twiceNatIter != m_twiceNatEntries.end())
+    {
+        if ((twiceNatIter->second.addedToHw == true) and
+            (twiceNatIter->second.entry_type != "static"))
+        {
+            std::vector<FieldValueTuple> fvVector;
+            std::string key = (twiceNatIter->first.src_ip.to_string() + ":" + twiceNatIter->first.dst_ip.to_string());
+            setTimeoutNotifier->send("SET-TWICE-NAT", key, fvVector);
+        }
+        twiceNatIter++;
+    }
+   
+    /* Send notifications for the Twice NAPT entries to set timeout */
+    TwiceNaptEntry::iterator twiceNaptIter = m_twiceNaptEntries.begin();
+    while (twiceNaptIter != m_twiceNaptEntries.end())
+    {
+        if ((twiceNaptIter->second.addedToHw == true) and
+            (twiceNaptIter->second.entry_type != "static"))
+        {
+            std::vector<FieldValueTuple> fvVector;
+            std::string key = (twiceNaptIter->first.prototype + ":" + twiceNaptIter->first.src_ip.to_string() + ":" + to_string(twiceNaptIter->first.src_l4_port) +
+                               ":" + twiceNaptIter->first.dst_ip.to_string() + ":" + to_string(twiceNaptIter->first.dst_l4_port));
+            setTimeoutNotifier->send("SET-TWICE-NAPT", key, fvVector);
+        }
+        twiceNaptIter++;
+    }
+}
+
+bool NatOrch::getNatCounters(const NatEntry::iterator &iter)
+{
+    const IpAddress   &ipAddr = iter->first;
+    NatEntryValue     &entry  = iter->second;
+    uint32_t          attr_count;
+    sai_attribute_t   nat_entry_attr[4] = {};
+    sai_nat_entry_t   nat_entry = {};
     sai_status_t      status;
     uint64_t          nat_translations_pkts = 0, nat_translations_bytes = 0;
 
@@ -4133,319 +4602,6 @@ void NatOrch::updateTwiceNaptCounters(const TwiceNaptEntryKey &key,
     m_countersTwiceNaptTable.set(naptKey, values);
 }
 
-bool NatOrch::checkIfNatEntryIsActive(const NatEntry::iterator &iter, time_t now)
-{
-    const IpAddress   &ipAddr = iter->first;
-    NatEntryValue     &entry  = iter->second;
-    uint32_t          attr_count;
-    IpAddress         srcIp;
-    sai_attribute_t   nat_entry_attr[4] = {};
-    sai_nat_entry_t   snat_entry = {};
-    sai_nat_entry_t   dnat_entry;
-    sai_status_t      status;
-
-    if (entry.nat_type == "dnat")
-    {
-        /* Hitbits are queried for both directions when SNAT entry is checked */
-        return 0;
-    }
-
-    if (entry.addedToHw == false)
-    {
-        SWSS_LOG_DEBUG("Skip get hitbits for %s NAT entry [ip %s], as not yet added to HW", entry.nat_type.c_str(), ipAddr.to_string().c_str());
-        return 0;
-    }
-
-    if (entry.entry_type == "static")
-    {
-        /* Static NAT entries are always treated active */ 
-        return 1;
-    }
-
-    nat_entry_attr[0].id             = SAI_NAT_ENTRY_ATTR_HIT_BIT;  /* Get the Hit bit */
-    nat_entry_attr[0].value.booldata = 0;
-    nat_entry_attr[1].id             = SAI_NAT_ENTRY_ATTR_HIT_BIT_COR; /* clear the hit bit after returning the value */
-    nat_entry_attr[1].value.booldata = 1;
-
-    attr_count = 2;
-
-    snat_entry.vr_id                 = gVirtualRouterId;
-    snat_entry.switch_id             = gSwitchId;
-    snat_entry.nat_type              = SAI_NAT_TYPE_SOURCE_NAT;
-    srcIp     = ipAddr;
-    snat_entry.data.key.src_ip   = srcIp.getV4Addr();
-    snat_entry.data.mask.src_ip  = 0xffffffff;
-
-    status = sai_nat_api->get_nat_entry_attribute(&snat_entry, attr_count, nat_entry_attr);
-    if (status == SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_DEBUG("SNAT HIT BIT for src-ip %s = %d", srcIp.to_string().c_str(),
-                      nat_entry_attr[0].value.booldata);
-
-        if (nat_entry_attr[0].value.booldata)
-        {
-            entry.ageOutTime = now + timeout;
-            return 1;
-        }
-        else
-        {
-            auto dnatIter = m_natEntries.find(entry.translated_ip);
-            if (dnatIter == m_natEntries.end())
-            {
-                return 0;
-            }
-            if ((dnatIter->second).addedToHw == false)
-            {
-                return 0;
-            }
-
-            /* If SNAT HitBit is not set, check for the HitBit in the reverse direction */
-            memset(&dnat_entry, 0, sizeof(dnat_entry));
-
-            dnat_entry.vr_id             = gVirtualRouterId;
-            dnat_entry.switch_id         = gSwitchId;
-            dnat_entry.nat_type          = SAI_NAT_TYPE_DESTINATION_NAT;
-            dnat_entry.data.key.dst_ip   = entry.translated_ip.getV4Addr();
-            dnat_entry.data.mask.dst_ip  = 0xffffffff;
-
-            status = sai_nat_api->get_nat_entry_attribute(&dnat_entry, attr_count, nat_entry_attr);
-            if (status == SAI_STATUS_SUCCESS)
-            {
-                SWSS_LOG_DEBUG("DNAT HIT BIT for dst-ip %s = %d", entry.translated_ip.to_string().c_str(),
-                                nat_entry_attr[0].value.booldata);
-                if (nat_entry_attr[0].value.booldata)
-                {
-                    entry.ageOutTime = now + timeout;
-                    return 1;
-                }
-            }
-        }
-    }
-    return 0;
-}
-
-bool NatOrch::checkIfNaptEntryIsActive(const NaptEntry::iterator &iter, time_t now)
-{
-    const NaptEntryKey &naptKey    = iter->first;
-    NaptEntryValue     &entry      = iter->second;
-    int                protoType   = ((naptKey.prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
-    uint32_t           attr_count;
-    IpAddress          srcIp;
-    uint16_t           srcPort;
-    sai_attribute_t    nat_entry_attr[4] = {};
-    sai_nat_entry_t    snat_entry = {};
-    sai_nat_entry_t    dnat_entry;
-    sai_status_t       status;
-
-    if (entry.nat_type == "dnat")
-    {
-        /* Hitbits are queried for both directions when SNAT entry is checked */
-        return 0;
-    }
-
-    if (entry.addedToHw == false)
-    {
-        SWSS_LOG_DEBUG("Skip get hitbits for %s NAPT entry for [proto %s, ip %s, port %d], as not yet added to HW",
-                       entry.nat_type.c_str(), naptKey.prototype.c_str(), naptKey.ip_address.to_string().c_str(), naptKey.l4_port);
-        return 0;
-    }
-
-    if (entry.entry_type == "static")
-    {
-        /* Static NAPT entries are always treated active */
-        return 1;
-    }
-
-    nat_entry_attr[0].id             = SAI_NAT_ENTRY_ATTR_HIT_BIT;  /* Get the Hit bit */
-    nat_entry_attr[0].value.booldata = 0;
-    nat_entry_attr[1].id             = SAI_NAT_ENTRY_ATTR_HIT_BIT_COR; /* clear the hit bit after returning the value */
-    nat_entry_attr[1].value.booldata = 1;
-
-    attr_count = 2;
-
-    snat_entry.vr_id                 = gVirtualRouterId;
-    snat_entry.switch_id             = gSwitchId;
-    snat_entry.nat_type              = SAI_NAT_TYPE_SOURCE_NAT;
-
-    srcIp     = naptKey.ip_address;
-    srcPort   = (uint16_t)(naptKey.l4_port);
-    snat_entry.data.key.src_ip       = srcIp.getV4Addr();
-    snat_entry.data.key.l4_src_port  = srcPort;
-
-    snat_entry.data.mask.src_ip      = 0xffffffff;
-    snat_entry.data.mask.l4_src_port = 0xffff;
-    snat_entry.data.key.proto        = (uint8_t)protoType;
-    snat_entry.data.mask.proto       = 0xff;
-
-    status = sai_nat_api->get_nat_entry_attribute(&snat_entry, attr_count, nat_entry_attr);
-    if (status == SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_DEBUG("SNAPT HIT BIT for proto %s, src-ip %s, src-port %d = %d", naptKey.prototype.c_str(),
-                      srcIp.to_string().c_str(), srcPort, nat_entry_attr[0].value.booldata);
-        if (nat_entry_attr[0].value.booldata)
-        {
-            entry.ageOutTime = now + ((protoType == IPPROTO_TCP) ? tcp_timeout : udp_timeout);
-            return 1;
-        }
-        else
-        {
-            NaptEntryKey dnaptKey;
-            dnaptKey.ip_address = entry.translated_ip;
-            dnaptKey.l4_port    = entry.translated_l4_port;
-            dnaptKey.prototype  = naptKey.prototype;
-
-            auto dnaptIter = m_naptEntries.find(dnaptKey);
-            if (dnaptIter == m_naptEntries.end())
-            {
-                return 0;
-            }
-            if ((dnaptIter->second).addedToHw == false)
-            {
-                return 0;
-            }
-
-
-            /* If SNAPT HitBit is not set, check for the HitBit in the reverse direction */
-            memset(&dnat_entry, 0, sizeof(dnat_entry));
-
-            dnat_entry.vr_id                 = gVirtualRouterId;
-            dnat_entry.switch_id             = gSwitchId;
-            dnat_entry.nat_type              = SAI_NAT_TYPE_DESTINATION_NAT;
-
-            dnat_entry.data.key.dst_ip       = entry.translated_ip.getV4Addr();
-            dnat_entry.data.key.l4_dst_port  = (uint16_t)(entry.translated_l4_port);
-
-            dnat_entry.data.mask.dst_ip      = 0xffffffff;
-            dnat_entry.data.mask.l4_dst_port = 0xffff;
-            dnat_entry.data.key.proto        = (uint8_t)protoType;
-            dnat_entry.data.mask.proto       = 0xff;
-
-            status = sai_nat_api->get_nat_entry_attribute(&dnat_entry, attr_count, nat_entry_attr);
-            if (status == SAI_STATUS_SUCCESS)
-            {
-                SWSS_LOG_DEBUG("DNAPT HIT BIT for proto %s, dst-ip %s, dst-port %d = %d", naptKey.prototype.c_str(),
-                              entry.translated_ip.to_string().c_str(), entry.translated_l4_port, nat_entry_attr[0].value.booldata);
-                if (nat_entry_attr[0].value.booldata)
-                {
-                    entry.ageOutTime = now + ((protoType == IPPROTO_TCP) ? tcp_timeout : udp_timeout);
-                    return 1;
-                }
-            }
-        }
-    }
-    return 0;
-}
-
-bool NatOrch::checkIfTwiceNatEntryIsActive(const TwiceNatEntry::iterator &iter, time_t now)
-{
-    const TwiceNatEntryKey &key    = iter->first;
-    TwiceNatEntryValue     &entry  = iter->second;
-    uint32_t           attr_count;
-    sai_attribute_t    nat_entry_attr[4] = {};
-    sai_nat_entry_t    dbl_nat_entry = {};
-    sai_status_t       status;
-
-    if (entry.entry_type == "static")
-    {
-        /* Static NAPT entries are always treated active */
-        return 1;
-    }
-
-    if (entry.addedToHw == false)
-    {
-        SWSS_LOG_DEBUG("Skip get hitbits for Twice NAPT entry for [src ip %s, dst-ip %s], as not yet added to HW",
-                       key.src_ip.to_string().c_str(), key.dst_ip.to_string().c_str());
-        return 0;
-    }
-
-    nat_entry_attr[0].id             = SAI_NAT_ENTRY_ATTR_HIT_BIT;  /* Get the Hit bit */
-    nat_entry_attr[0].value.booldata = 0;
-    nat_entry_attr[1].id             = SAI_NAT_ENTRY_ATTR_HIT_BIT_COR; /* clear the hit bit after returning the value */
-    nat_entry_attr[1].value.booldata = 1;
-
-    attr_count = 2;
-
-    dbl_nat_entry.vr_id = gVirtualRouterId;
-    dbl_nat_entry.switch_id = gSwitchId;
-    dbl_nat_entry.nat_type = SAI_NAT_TYPE_DOUBLE_NAT;
-    dbl_nat_entry.data.key.src_ip = key.src_ip.getV4Addr();
-    dbl_nat_entry.data.mask.src_ip = 0xffffffff;
-    dbl_nat_entry.data.key.dst_ip = key.dst_ip.getV4Addr();
-    dbl_nat_entry.data.mask.dst_ip = 0xffffffff;
-
-    status = sai_nat_api->get_nat_entry_attribute(&dbl_nat_entry, attr_count, nat_entry_attr);
-    if (status == SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_DEBUG("Twice NAT HIT BIT for src-ip %s, dst-ip %s = %d",
-                       key.src_ip.to_string().c_str(), key.dst_ip.to_string().c_str(), nat_entry_attr[0].value.booldata);
-        if (nat_entry_attr[0].value.booldata)
-        {
-            entry.ageOutTime = now + timeout;
-            return 1;
-        }
-    }
-    return 0;
-}
-
-bool NatOrch::checkIfTwiceNaptEntryIsActive(const TwiceNaptEntry::iterator &iter, time_t now)
-{
-    const TwiceNaptEntryKey &key   = iter->first;
-    TwiceNaptEntryValue     &entry = iter->second;
-    uint8_t            protoType   = ((key.prototype == "TCP") ? IPPROTO_TCP : IPPROTO_UDP);
-    uint32_t           attr_count;
-    sai_attribute_t    nat_entry_attr[4] = {};
-    sai_nat_entry_t    dbl_nat_entry = {};
-    sai_status_t       status;
-
-    if (entry.addedToHw == false)
-    {
-        SWSS_LOG_DEBUG("Skip get hitbits for Twice NAPT entry for [proto %s, src ip %s, src port %d, dst ip %s, dst port %d], as not yet added to HW",
-                        key.prototype.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port, key.dst_ip.to_string().c_str(), key.dst_l4_port);
-        return 0;
-    }
-
-    if (entry.entry_type == "static")
-    {
-        /* Static NAPT entries are always treated active */
-        return 1;
-    }
-
-    nat_entry_attr[0].id             = SAI_NAT_ENTRY_ATTR_HIT_BIT;  /* Get the Hit bit */
-    nat_entry_attr[0].value.booldata = 0;
-    nat_entry_attr[1].id             = SAI_NAT_ENTRY_ATTR_HIT_BIT_COR; /* clear the hit bit after returning the value */
-    nat_entry_attr[1].value.booldata = 1;
-
-    attr_count = 2;
-
-    dbl_nat_entry.vr_id = gVirtualRouterId;
-    dbl_nat_entry.switch_id = gSwitchId;
-    dbl_nat_entry.nat_type = SAI_NAT_TYPE_DOUBLE_NAT;
-    dbl_nat_entry.data.key.src_ip = key.src_ip.getV4Addr();
-    dbl_nat_entry.data.mask.src_ip = 0xffffffff;
-    dbl_nat_entry.data.key.l4_src_port = (uint16_t)(key.src_l4_port);
-    dbl_nat_entry.data.mask.l4_src_port = 0xffff;
-    dbl_nat_entry.data.key.dst_ip = key.dst_ip.getV4Addr();
-    dbl_nat_entry.data.mask.dst_ip = 0xffffffff;
-    dbl_nat_entry.data.key.l4_dst_port = (uint16_t)(key.dst_l4_port);
-    dbl_nat_entry.data.mask.l4_dst_port = 0xffff;
-    dbl_nat_entry.data.key.proto = protoType;
-    dbl_nat_entry.data.mask.proto = 0xff;
-
-    status = sai_nat_api->get_nat_entry_attribute(&dbl_nat_entry, attr_count, nat_entry_attr);
-    if (status == SAI_STATUS_SUCCESS)
-    {
-        SWSS_LOG_DEBUG("Twice NAPT HIT BIT for [proto %s, src ip %s, src port %d, dst ip %s, dst port %d] = %d",
-                        key.prototype.c_str(), key.src_ip.to_string().c_str(), key.src_l4_port, key.dst_ip.to_string().c_str(), key.dst_l4_port,
-                        nat_entry_attr[0].value.booldata);
-        if (nat_entry_attr[0].value.booldata)
-        {
-            entry.ageOutTime = now + ((protoType == IPPROTO_TCP) ? tcp_timeout : udp_timeout);
-            return 1;
-        }
-    }
-    return 0;
-}
-
 void NatOrch::doTask(NotificationConsumer& consumer)
 {
     SWSS_LOG_ENTER();
@@ -29,6 +29,11 @@
 #include "routeorch.h"
 #include "nexthopgroupkey.h"
 #include "notificationproducer.h"
+#include "timerwheel.h"
+#include "bulker.h"
+#include <deque>
+#include <functional>
+#include <memory>
 #ifdef DEBUG_FRAMEWORK
 #include "debugdumporch.h"
 #endif
@@ -36,7 +41,16 @@
 #define VALUES                            "Values" // Global Values Key
 #define NAT_HITBIT_N_CNTRS_QUERY_PERIOD   5        // 5 secs
 #define NAT_CONNTRACK_TIMEOUT_PERIOD      86400    // 1 day
-#define NAT_HITBIT_QUERY_MULTIPLE         6        // Hit bits are queried every 30 secs
+#define NAT_HITBIT_QUERY_MULTIPLE         6        // Hit bits of an entry are queried at most every 30 secs
+#define NAT_HITBIT_CHECKS_PER_TIMEOUT     10       // Hit bits of an active entry are queried 10 times per timeout
+
+/* Result of the hit bit query of a NAT entry */
+enum NatHitBitState
+{
+    NAT_HITBIT_UNKNOWN,                // The query failed, the entry is queried again later
+    NAT_HITBIT_CLEAR,
+    NAT_HITBIT_SET
+};
 
 struct NatEntryValue
 {
@@ -45,6 +59,7 @@ struct NatEntryValue
     string         entry_type;         // Entry type - Static or Dynamic 
     time_t         activeTime;         // Timestamp in secs when the entry was last seen as active
     time_t         ageOutTime;         // Timestamp in secs when the entry expires
+    time_t         hitBitCheckTime = 0; // Timestamp in secs when the hit bits are queried next
     bool           addedToHw;          // Boolean to represent added to hardware
 
     bool operator<(const NatEntryValue& other) const
@@ -73,6 +88,7 @@ struct NaptEntryValue
     string         entry_type;         // Entry type - Static or Dynamic
     time_t         activeTime;         // Timestamp in secs when the entry was last seen as active
     time_t         ageOutTime;         // Timestamp in secs when the entry expires
+    time_t         hitBitCheckTime = 0; // Timestamp in secs when the hit bits are queried next
     bool           addedToHw;          // Boolean to represent added to hardware
 
     bool operator<(const NaptEntryValue& other) const
@@ -99,6 +115,7 @@ struct TwiceNatEntryValue
     string         entry_type;         // Entry type - Static or Dynamic 
     time_t         activeTime;         // Timestamp in secs when the entry was last seen as active
     time_t         ageOutTime;         // Timestamp in secs when the entry expires
+    time_t         hitBitCheckTime = 0; // Timestamp in secs when the hit bits are queried next
     bool           addedToHw;          // Boolean to represent added to hardware
 
     bool operator<(const TwiceNatEntryValue& other) const
@@ -130,6 +147,7 @@ struct TwiceNaptEntryValue
     string         entry_type;         // Entry type - Static or Dynamic
     time_t         activeTime;         // Timestamp in secs when the entry was last seen as active
     time_t         ageOutTime;         // Timestamp in secs when the entry expires
+    time_t         hitBitCheckTime = 0; // Timestamp in secs when the hit bits are queried next
     bool           addedToHw;          // Boolean to represent added to hardware
 
     bool operator<(const TwiceNaptEntryValue& other) const
@@ -201,6 +219,24 @@ private:
     TwiceNatEntry           m_twiceNatEntries;
     TwiceNaptEntry          m_twiceNaptEntries;
     SelectableTimer        *m_natQueryTimer;
+    /* Dynamic entries in hardware, scheduled at the time their hit bits are due for a query */
+    TimerWheel<IpAddress>         m_natAgingWheel;
+    TimerWheel<NaptEntryKey>      m_naptAgingWheel;
+    TimerWheel<TwiceNatEntryKey>  m_twiceNatAgingWheel;
+    TimerWheel<TwiceNaptEntryKey> m_twiceNaptAgingWheel;
+    bool                    m_natBulkGetSupported = true;
+    /* NAPT and Twice NAPT entries are created and removed in bulk while m_natBulkMode is set,
+     * the bookkeeping of an entry runs from its NatBulkOp once the bulker is flushed.
+     * NAT and Twice NAT entries stay serial: there is one per configured or translated IP,
+     * against one per conntrack flow for NAPT, so they are too few to gain from bulking */
+    struct NatBulkOp
+    {
+        sai_status_t                      status;
+        std::function<bool(sai_status_t)> post;
+    };
+    std::unique_ptr<EntityBulker<sai_nat_api_t>> m_natBulker;
+    std::deque<NatBulkOp>                        m_natBulkOps;
+    bool                                         m_natBulkMode = false;
     SelectableTimer        *m_natTimeoutTimer;
     DBConnector             m_countersDb;
     Table                   m_countersNatTable;
@@ -289,10 +325,19 @@ private:
     bool addHwDnatPoolEntry(const IpAddress &dstIp);
     bool removeHwDnatPoolEntry(const IpAddress &dstIp);
 
-    bool checkIfNatEntryIsActive(const NatEntry::iterator &iter, time_t now);
-    bool checkIfNaptEntryIsActive(const NaptEntry::iterator &iter, time_t now);
-    bool checkIfTwiceNatEntryIsActive(const TwiceNatEntry::iterator &iter, time_t now);
-    bool checkIfTwiceNaptEntryIsActive(const TwiceNaptEntry::iterator &iter, time_t now);
+    bool bulkCreateNatEntry(const sai_nat_entry_t &entry, uint32_t attr_count, const sai_attribute_t *attr_list,
+                            std::function<bool(sai_status_t)> post);
+    bool bulkRemoveNatEntry(const sai_nat_entry_t &entry, std::function<bool(sai_status_t)> post);
+    void flushNatBulker(void);
+    void flushNatBulkerIfPending(const sai_nat_entry_t &entry);
+
+    void getHitBits(const vector<sai_nat_entry_t> &entries, vector<NatHitBitState> &hitBits);
+    time_t getHitBitCheckInterval(int timeout);
+    template <typename Key, typename Iter>
+    void scheduleHitBitCheck(TimerWheel<Key> &wheel, Iter iter, time_t checkTime);
+    template <typename Key, typename Iter>
+    bool updateEntryActivity(TimerWheel<Key> &wheel, Iter iter, NatHitBitState hitBit, time_t now, int timeout);
+    void rescheduleAllHitBitChecks(time_t now);
 
     void enableNatFeature(void);
     void disableNatFeature(void);
@@ -21,6 +21,7 @@ extern FgNhgOrch *gFgNhgOrch;
 extern Directory<Orch*> gDirectory;
 extern string gMySwitchType;
 extern int32_t gVoqMySwitchId;
+extern size_t gMaxBulkSize;
 
 const int neighorch_pri = 30;
 
@@ -29,7 +30,9 @@ NeighOrch::NeighOrch(DBConnector *appDb, string tableName, IntfsOrch *intfsOrch,
         m_intfsOrch(intfsOrch),
         m_fdbOrch(fdbOrch),
         m_portsOrch(portsOrch),
-        m_appNeighResolveProducer(appDb, APP_NEIGH_RESOLVE_TABLE_NAME)
+        m_appNeighResolveProducer(appDb, APP_NEIGH_RESOLVE_TABLE_NAME),
+        gNeighBulker(sai_neighbor_api, gMaxBulkSize),
+        gNextHopBulker(sai_next_hop_api, gSwitchId, gMaxBulkSize)
 {
     SWSS_LOG_ENTER();
 
@@ -171,6 +174,11 @@ bool NeighOrch::hasNextHop(const NextHopKey &nexthop)
     return m_syncdNextHops.find(nexthop) != m_syncdNextHops.end();
 }
 
+string NeighOrch::getNeighborDependency(const NextHopKey &nexthop)
+{
+    return "neighbor " + NextHopKey(nexthop.ip_address, nexthop.alias).to_string();
+}
+
 // Check if the underlying neighbor is resolved for a given next hop key.
 bool NeighOrch::isNeighborResolved(const NextHopKey &nexthop)
 {
@@ -181,7 +189,7 @@ bool NeighOrch::isNeighborResolved(const NextHopKey &nexthop)
     return hasNextHop(base_nexthop);
 }
 
-bool NeighOrch::addNextHop(const NextHopKey &nh)
+bool NeighOrch::addNextHop(const NextHopKey &nh, NeighborBulkContext *ctx)
 {
     SWSS_LOG_ENTER();
 
@@ -218,7 +226,8 @@ bool NeighOrch::addNextHop(const NextHopKey &nh)
 
     vector<sai_attribute_t> next_hop_attrs;
 
-    vector<Label> label_stack;
+    vector<Label> local_label_stack;
+    vector<Label> &label_stack = ctx ? ctx->label_stack : local_label_stack;
     sai_attribute_t next_hop_attr;
     if (nexthop.isMplsNextHop())
     {
@@ -251,6 +260,15 @@ bool NeighOrch::addNextHop(const NextHopKey &nh)
     next_hop_attr.value.oid = rif_id;
     next_hop_attrs.push_back(next_hop_attr);
 
+    /* Create the next hop in bulk, addNextHopPost() completes it after the flush */
+    if (ctx)
+    {
+        ctx->next_hop_bulked = true;
+        ctx->nexthop = nexthop;
+        gNextHopBulker.create_entry(&ctx->next_hop_id, &ctx->next_hop_status, (uint32_t)next_hop_attrs.size(), next_hop_attrs.data());
+        return true;
+    }
+
     sai_object_id_t next_hop_id;
     sai_status_t status = sai_next_hop_api->create_next_hop(&next_hop_id, gSwitchId, (uint32_t)next_hop_attrs.size(), next_hop_attrs.data());
     if (status != SAI_STATUS_SUCCESS)
@@ -264,6 +282,46 @@ bool NeighOrch::addNextHop(const NextHopKey &nh)
         }
     }
 
+    completeNextHopAdd(nh, nexthop, next_hop_id);
+
+    return true;
+}
+
+bool NeighOrch::addNextHopPost(NeighborBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    if (ctx.next_hop_status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("Failed to create next hop %s on %s, rv:%d",
+                       ctx.nexthop.ip_address.to_string().c_str(), ctx.nexthop.alias.c_str(), ctx.next_hop_status);
+        task_process_status handle_status = handleSaiCreateStatus(SAI_API_NEXT_HOP, ctx.next_hop_status);
+        if (handle_status != task_success && !parseHandleSaiStatusFailure(handle_status))
+        {
+            return rollbackNeighborAdd(ctx.neighbor_entry, ctx.mac, ctx.sai_entry);
+        }
+
+        /* Same as addNeighbor(): a failure that is not retried keeps the neighbor without a next hop */
+        completeNeighborAdd(ctx.neighbor_entry, ctx.mac, true, ctx.sai_entry);
+        return true;
+    }
+
+    completeNextHopAdd(ctx.neighbor_entry, ctx.nexthop, ctx.next_hop_id);
+    completeNeighborAdd(ctx.neighbor_entry, ctx.mac, true, ctx.sai_entry);
+
+    return true;
+}
+
+/* Update the local state once the next hop is created in SAI */
+void NeighOrch::completeNextHopAdd(const NextHopKey &nh, const NextHopKey &nexthop, sai_object_id_t next_hop_id)
+{
+    Port p;
+    bool port_found = gPortsOrch->getPort(nh.alias, p);
+    if (port_found && p.m_type == Port::SUBPORT)
+    {
+        port_found = gPortsOrch->getPort(p.m_parent_port_id, p);
+    }
+
     SWSS_LOG_NOTICE("Created next hop %s on %s",
                     nexthop.ip_address.to_string().c_str(), nexthop.alias.c_str());
     if (m_neighborToResolve.find(nexthop) != m_neighborToResolve.end())
@@ -299,11 +357,13 @@ bool NeighOrch::addNextHop(const NextHopKey &nh)
 
     gFgNhgOrch->validNextHopInNextHopGroup(nexthop);
 
+    Consumer::wake(getNeighborDependency(nh));
+
     // For nexthop with incoming port which has down oper status, NHFLAGS_IFDOWN
     // flag should be set on it.
     // This scenario may happen under race condition where buffered neighbor event
     // is processed after incoming port is down.
-    if (p.m_oper_status == SAI_PORT_OPER_STATUS_DOWN)
+    if (port_found && p.m_oper_status == SAI_PORT_OPER_STATUS_DOWN)
     {
         if (setNextHopFlag(nexthop, NHFLAGS_IFDOWN) == false)
         {
@@ -311,7 +371,6 @@ bool NeighOrch::addNextHop(const NextHopKey &nh)
                 nexthop.ip_address.to_string().c_str(), nexthop.alias.c_str());
         }
     }
-    return true;
 }
 
 bool NeighOrch::setNextHopFlag(const NextHopKey &nexthop, const uint32_t nh_flag)
@@ -662,6 +721,16 @@ void NeighOrch::doTask(Consumer &consumer)
         return;
     }
 
+    // Neighbor bulk results will be stored in a map
+    std::map<
+            std::pair<
+                    std::string,            // Key
+                    std::string             // Op
+            >,
+            NeighborBulkContext
+    >                                       toBulk;
+
+    // Add neighbors with a neighbor bulker, other operations are done synchronously
     auto it = consumer.m_toSync.begin();
     while (it != consumer.m_toSync.end())
     {
@@ -712,6 +781,7 @@ void NeighOrch::doTask(Consumer &consumer)
             if (!gPortsOrch->getPort(alias, p))
             {
                 SWSS_LOG_INFO("Port %s doesn't exist", alias.c_str());
+                consumer.waitFor(IntfsOrch::getRouterIntfDependency(alias));
                 it++;
                 continue;
             }
@@ -719,6 +789,7 @@ void NeighOrch::doTask(Consumer &consumer)
             if (!p.m_rif_id)
             {
                 SWSS_LOG_INFO("Router interface doesn't exist on %s", alias.c_str());
+                consumer.waitFor(IntfsOrch::getRouterIntfDependency(alias));
                 it++;
                 continue;
             }
@@ -743,14 +814,26 @@ void NeighOrch::doTask(Consumer &consumer)
                     }
                     it = consumer.m_toSync.erase(it);
                 }
-                else if (addNeighbor(neighbor_entry, mac_address))
-                {
-                    it = consumer.m_toSync.erase(it);
-                }
                 else
                 {
-                    it++;
-                    continue;
+                    auto& ctx = toBulk.emplace(std::piecewise_construct,
+                            std::forward_as_tuple(key, op),
+                            std::forward_as_tuple()).first->second;
+
+                    if (!addNeighbor(neighbor_entry, mac_address, &ctx))
+                    {
+                        it++;
+                        continue;
+                    }
+
+                    /* New neighbors are created when the bulker is flushed */
+                    if (ctx.bulked)
+                    {
+                        it++;
+                        continue;
+                    }
+
+                    it = consumer.m_toSync.erase(it);
                 }
             }
             else
@@ -759,16 +842,7 @@ void NeighOrch::doTask(Consumer &consumer)
                 it = consumer.m_toSync.erase(it);
             }
 
-            /* Remove remaining DEL operation in m_toSync for the same neighbor.
-             * Since DEL operation is supposed to be executed before SET for the same neighbor
-             * A remaining DEL after the SET operation means the DEL operation failed previously and should not be executed anymore
-             */
-            auto rit = make_reverse_iterator(it);
-            while (rit != consumer.m_toSync.rend() && rit->first == key && kfvOp(rit->second) == DEL_COMMAND)
-            {
-                consumer.m_toSync.erase(next(rit).base());
-                SWSS_LOG_NOTICE("Removed pending neighbor DEL operation for %s after SET operation", key.c_str());
-            }
+            eraseStaleNeighborDel(consumer, it, key);
         }
         else if (op == DEL_COMMAND)
         {
@@ -793,9 +867,75 @@ void NeighOrch::doTask(Consumer &consumer)
             it = consumer.m_toSync.erase(it);
         }
     }
+
+    if (toBulk.empty())
+    {
+        return;
+    }
+
+    // Flush the neighbor bulker, then queue the next hops of the created neighbors
+    gNeighBulker.flush();
+
+    auto it_prev = consumer.m_toSync.begin();
+    while (it_prev != consumer.m_toSync.end())
+    {
+        string key = kfvKey(it_prev->second);
+        auto found = toBulk.find(make_pair(key, kfvOp(it_prev->second)));
+        if (found == toBulk.end() || !found->second.bulked)
+        {
+            it_prev++;
+            continue;
+        }
+
+        auto& ctx = found->second;
+        if (addNeighborPost(ctx) && !ctx.next_hop_bulked)
+        {
+            it_prev = consumer.m_toSync.erase(it_prev);
+            eraseStaleNeighborDel(consumer, it_prev, key);
+        }
+        else
+            it_prev++;
+    }
+
+    // Flush the next hop bulker, so the neighbors become usable next hops
+    gNextHopBulker.flush();
+
+    it_prev = consumer.m_toSync.begin();
+    while (it_prev != consumer.m_toSync.end())
+    {
+        string key = kfvKey(it_prev->second);
+        auto found = toBulk.find(make_pair(key, kfvOp(it_prev->second)));
+        if (found == toBulk.end() || !found->second.next_hop_bulked)
+        {
+            it_prev++;
+            continue;
+        }
+
+        if (addNextHopPost(found->second))
+        {
+            it_prev = consumer.m_toSync.erase(it_prev);
+            eraseStaleNeighborDel(consumer, it_prev, key);
+        }
+        else
+            it_prev++;
+    }
+}
+
+/* Remove remaining DEL operation in m_toSync for the same neighbor.
+ * Since DEL operation is supposed to be executed before SET for the same neighbor
+ * A remaining DEL after the SET operation means the DEL operation failed previously and should not be executed anymore
+ */
+void NeighOrch::eraseStaleNeighborDel(Consumer &consumer, SyncMap::iterator it, const string &key)
+{
+    auto rit = make_reverse_iterator(it);
+    while (rit != consumer.m_toSync.rend() && rit->first == key && kfvOp(rit->second) == DEL_COMMAND)
+    {
+        consumer.m_toSync.erase(next(rit).base());
+        SWSS_LOG_NOTICE("Removed pending neighbor DEL operation for %s after SET operation", key.c_str());
+    }
 }
 
-bool NeighOrch::addNeighbor(const NeighborEntry &neighborEntry, const MacAddress &macAddress)
+bool NeighOrch::addNeighbor(const NeighborEntry &neighborEntry, const MacAddress &macAddress, NeighborBulkContext *ctx)
 {
     SWSS_LOG_ENTER();
 
@@ -847,6 +987,18 @@ bool NeighOrch::addNeighbor(const NeighborEntry &neighborEntry, const MacAddress
 
     if (!hw_config && mux_orch->isNeighborActive(ip_address, macAddress, alias))
     {
+        /* Create the neighbor in bulk, addNeighborPost() completes it after the flush */
+        if (ctx)
+        {
+            ctx->bulked = true;
+            ctx->neighbor_entry = neighborEntry;
+            ctx->mac = macAddress;
+            ctx->sai_entry = neighbor_entry;
+            gNeighBulker.create_entry(&ctx->neighbor_status, &neighbor_entry,
+                                      (uint32_t)neighbor_attrs.size(), neighbor_attrs.data());
+            return true;
+        }
+
         status = sai_neighbor_api->create_neighbor_entry(&neighbor_entry,
                                    (uint32_t)neighbor_attrs.size(), neighbor_attrs.data());
         if (status != SAI_STATUS_SUCCESS)
@@ -884,29 +1036,7 @@ bool NeighOrch::addNeighbor(const NeighborEntry &neighborEntry, const MacAddress
 
         if (!addNextHop(NextHopKey(ip_address, alias)))
         {
-            status = sai_neighbor_api->remove_neighbor_entry(&neighbor_entry);
-            if (status != SAI_STATUS_SUCCESS)
-            {
-                SWSS_LOG_ERROR("Failed to remove neighbor %s on %s, rv:%d",
-                               macAddress.to_string().c_str(), alias.c_str(), status);
-                task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NEIGHBOR, status);
-                if (handle_status != task_success)
-                {
-                    return parseHandleSaiStatusFailure(handle_status);
-                }
-            }
-            m_intfsOrch->decreaseRouterIntfsRefCount(alias);
-
-            if (neighbor_entry.ip_address.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
-            {
-                gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEIGHBOR);
-            }
-            else
-            {
-                gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEIGHBOR);
-            }
-
-            return false;
+            return rollbackNeighborAdd(neighborEntry, macAddress, neighbor_entry);
         }
         hw_config = true;
     }
@@ -926,18 +1056,106 @@ bool NeighOrch::addNeighbor(const NeighborEntry &neighborEntry, const MacAddress
         SWSS_LOG_NOTICE("Updated neighbor %s on %s", macAddress.to_string().c_str(), alias.c_str());
     }
 
+    completeNeighborAdd(neighborEntry, macAddress, hw_config, neighbor_entry);
+
+    return true;
+}
+
+bool NeighOrch::addNeighborPost(NeighborBulkContext& ctx)
+{
+    SWSS_LOG_ENTER();
+
+    const auto& alias = ctx.neighbor_entry.alias;
+    const auto& ip_address = ctx.neighbor_entry.ip_address;
+
+    if (ctx.neighbor_status != SAI_STATUS_SUCCESS)
+    {
+        if (ctx.neighbor_status == SAI_STATUS_ITEM_ALREADY_EXISTS)
+        {
+            SWSS_LOG_ERROR("Entry exists: neighbor %s on %s, rv:%d",
+                       ctx.mac.to_string().c_str(), alias.c_str(), ctx.neighbor_status);
+            /* Returning True so as to skip retry */
+            return true;
+        }
+        else
+        {
+            SWSS_LOG_ERROR("Failed to create neighbor %s on %s, rv:%d",
+                       ctx.mac.to_string().c_str(), alias.c_str(), ctx.neighbor_status);
+            task_process_status handle_status = handleSaiCreateStatus(SAI_API_NEIGHBOR, ctx.neighbor_status);
+            if (handle_status != task_success)
+            {
+                return parseHandleSaiStatusFailure(handle_status);
+            }
+        }
+    }
+    SWSS_LOG_NOTICE("Created neighbor ip %s, %s on %s", ip_address.to_string().c_str(),
+            ctx.mac.to_string().c_str(), alias.c_str());
+    m_intfsOrch->increaseRouterIntfsRefCount(alias);
+
+    if (ctx.sai_entry.ip_address.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+    {
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEIGHBOR);
+    }
+    else
+    {
+        gCrmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEIGHBOR);
+    }
+
+    if (!addNextHop(NextHopKey(ip_address, alias), &ctx))
+    {
+        return rollbackNeighborAdd(ctx.neighbor_entry, ctx.mac, ctx.sai_entry);
+    }
+
+    return true;
+}
+
+/* Remove the neighbor entry again when its next hop could not be created */
+bool NeighOrch::rollbackNeighborAdd(const NeighborEntry &neighborEntry, const MacAddress &macAddress,
+                                    const sai_neighbor_entry_t &neighbor_entry)
+{
+    sai_status_t status = sai_neighbor_api->remove_neighbor_entry(&neighbor_entry);
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_ERROR("Failed to remove neighbor %s on %s, rv:%d",
+                       macAddress.to_string().c_str(), neighborEntry.alias.c_str(), status);
+        task_process_status handle_status = handleSaiRemoveStatus(SAI_API_NEIGHBOR, status);
+        if (handle_status != task_success)
+        {
+            return parseHandleSaiStatusFailure(handle_status);
+        }
+    }
+    m_intfsOrch->decreaseRouterIntfsRefCount(neighborEntry.alias);
+
+    if (neighbor_entry.ip_address.addr_family == SAI_IP_ADDR_FAMILY_IPV4)
+    {
+        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_NEIGHBOR);
+    }
+    else
+    {
+        gCrmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV6_NEIGHBOR);
+    }
+
+    return false;
+}
+
+/* Record the neighbor and let the observers know once it is programmed */
+void NeighOrch::completeNeighborAdd(const NeighborEntry &neighborEntry, const MacAddress &macAddress,
+                                    bool hw_config, sai_neighbor_entry_t &neighbor_entry)
+{
+    IpAddress ip_address = neighborEntry.ip_address;
+    string alias = neighborEntry.alias;
+
     m_syncdNeighbors[neighborEntry] = { macAddress, hw_config };
 
     NeighborUpdate update = { neighborEntry, macAddress, true };
     notify(SUBJECT_TYPE_NEIGH_CHANGE, static_cast<void *>(&update));
+    Consumer::wake(getNeighborDependency(NextHopKey(ip_address, alias)));
 
     if(gMySwitchType == "voq")
     {
         //Sync the neighbor to add to the CHASSIS_APP_DB
         voqSyncAddNeigh(alias, ip_address, macAddress, neighbor_entry);
     }
-
-    return true;
 }
 
 bool NeighOrch::removeNeighbor(const NeighborEntry &neighborEntry, bool disable)
@@ -1250,6 +1468,7 @@ void NeighOrch::doVoqSystemNeighTask(Consumer &consumer)
             if (!gPortsOrch->getPort(alias, p))
             {
                 SWSS_LOG_INFO("Port %s doesn't exist", alias.c_str());
+                consumer.waitFor(IntfsOrch::getRouterIntfDependency(alias));
                 it++;
                 continue;
             }
@@ -1257,6 +1476,7 @@ void NeighOrch::doVoqSystemNeighTask(Consumer &consumer)
             if (!p.m_rif_id)
             {
                 SWSS_LOG_INFO("Router interface doesn't exist on %s", alias.c_str());
+                consumer.waitFor(IntfsOrch::getRouterIntfDependency(alias));
                 it++;
                 continue;
             }
@@ -6,6 +6,7 @@
 #include "portsorch.h"
 #include "intfsorch.h"
 #include "fdborch.h"
+#include "bulker.h"
 
 #include "ipaddress.h"
 #include "nexthopkey.h"
@@ -42,6 +43,30 @@ struct NeighborUpdate
     bool add;
 };
 
+struct NeighborBulkContext
+{
+    sai_status_t                        neighbor_status;    // Bulk status of the neighbor entry
+    sai_status_t                        next_hop_status;    // Bulk status of the next hop
+    sai_object_id_t                     next_hop_id;        // Next hop id, set when the next hop bulker is flushed
+    bool                                bulked;             // Neighbor creation is pending in the bulker
+    bool                                next_hop_bulked;    // Next hop creation is pending in the bulker
+    NeighborEntry                       neighbor_entry;
+    MacAddress                          mac;
+    sai_neighbor_entry_t                sai_entry;
+    NextHopKey                          nexthop;
+    vector<Label>                       label_stack;        // Backing storage of SAI_NEXT_HOP_ATTR_LABELSTACK
+
+    NeighborBulkContext()
+        : neighbor_status(SAI_STATUS_NOT_EXECUTED), next_hop_status(SAI_STATUS_NOT_EXECUTED),
+          next_hop_id(SAI_NULL_OBJECT_ID), bulked(false), next_hop_bulked(false)
+    {
+    }
+
+    // Disable any copy constructors
+    NeighborBulkContext(const NeighborBulkContext&) = delete;
+    NeighborBulkContext(NeighborBulkContext&&) = delete;
+};
+
 class NeighOrch : public Orch, public Subject, public Observer
 {
 public:
@@ -49,8 +74,10 @@ public:
     ~NeighOrch();
 
     bool hasNextHop(const NextHopKey&);
+    // Name of the dependency consumers park tasks on until the neighbor is resolved
+    static string getNeighborDependency(const NextHopKey&);
     bool isNeighborResolved(const NextHopKey&);
-    bool addNextHop(const NextHopKey&);
+    bool addNextHop(const NextHopKey&, NeighborBulkContext *ctx = nullptr);
     bool removeMplsNextHop(const NextHopKey&);
 
     sai_object_id_t getNextHopId(const NextHopKey&);
@@ -92,9 +119,18 @@ private:
 
     std::set<NextHopKey> m_neighborToResolve;
 
+    EntityBulker<sai_neighbor_api_t> gNeighBulker;
+    ObjectBulker<sai_next_hop_api_t> gNextHopBulker;
+
     bool removeNextHop(const IpAddress&, const string&);
 
-    bool addNeighbor(const NeighborEntry&, const MacAddress&);
+    bool addNeighbor(const NeighborEntry&, const MacAddress&, NeighborBulkContext *ctx = nullptr);
+    bool addNeighborPost(NeighborBulkContext& ctx);
+    bool addNextHopPost(NeighborBulkContext& ctx);
+    void completeNextHopAdd(const NextHopKey &nh, const NextHopKey &nexthop, sai_object_id_t next_hop_id);
+    bool rollbackNeighborAdd(const NeighborEntry&, const MacAddress&, const sai_neighbor_entry_t&);
+    void completeNeighborAdd(const NeighborEntry&, const MacAddress&, bool hw_config, sai_neighbor_entry_t&);
+    void eraseStaleNeighborDel(Consumer &consumer, SyncMap::iterator it, const string &key);
     bool removeNeighbor(const NeighborEntry&, bool disable = false);
 
     bool setNextHopFlag(const NextHopKey &, const uint32_t);
@@ -1,8 +1,117 @@
 #ifndef SWSS_NEXTHOPGROUPKEY_H
 #define SWSS_NEXTHOPGROUPKEY_H
 
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
+
 #include "nexthopkey.h"
 
+/*
+ * Interned next hop table. Every distinct next hop, as identified by
+ * NextHopKey::operator<, is given a compact id while at least one
+ * NextHopGroupKey references it. Ids are reference counted and released ids
+ * are reused, so the table is bounded by the number of next hops in use.
+ * An id is only reused once no key holds it, so reuse never changes the
+ * relative order of live keys.
+ */
+class NextHopKeyTable
+{
+public:
+    /* Returns the id of the next hop and takes a reference on it */
+    static uint32_t acquire(const NextHopKey &nh)
+    {
+        auto &table = getTable();
+        auto it = table.ids.find(nh);
+        if (it != table.ids.end())
+        {
+            table.entries[it->second].refs++;
+            return it->second;
+        }
+
+        uint32_t id;
+        if (!table.free_ids.empty())
+        {
+            id = table.free_ids.back();
+            table.free_ids.pop_back();
+        }
+        else
+        {
+            id = static_cast<uint32_t>(table.entries.size());
+            table.entries.emplace_back();
+        }
+
+        it = table.ids.emplace(nh, id).first;
+        table.entries[id] = { it, 1 };
+        return id;
+    }
+
+    static void acquire(uint32_t id)
+    {
+        getTable().entries[id].refs++;
+    }
+
+    static void release(uint32_t id)
+    {
+        auto &table = getTable();
+        auto &entry = table.entries[id];
+        if (--entry.refs == 0)
+        {
+            table.ids.erase(entry.key);
+            table.free_ids.push_back(id);
+        }
+    }
+
+    /* Looks the next hop up without taking a reference */
+    static bool find(const NextHopKey &nh, uint32_t &id)
+    {
+        auto &table = getTable();
+        auto it = table.ids.find(nh);
+        if (it == table.ids.end())
+        {
+            return false;
+        }
+        id = it->second;
+        return true;
+    }
+
+    static const NextHopKey &get(uint32_t id)
+    {
+        return getTable().entries[id].key->first;
+    }
+
+    /* Number of next hops currently referenced */
+    static size_t size()
+    {
+        return getTable().ids.size();
+    }
+
+private:
+    struct Entry
+    {
+        std::map<NextHopKey, uint32_t>::iterator key;
+        uint32_t refs;
+    };
+
+    struct Table
+    {
+        std::map<NextHopKey, uint32_t> ids;
+        std::vector<Entry> entries;
+        std::vector<uint32_t> free_ids;
+    };
+
+    static Table &getTable()
+    {
+        /* Never destroyed, so keys with static storage can release their ids at exit */
+        static Table *table = new Table();
+        return *table;
+    }
+};
+
 class NextHopGroupKey
 {
 public:
@@ -16,7 +125,7 @@ public:
         auto nhv = tokenize(nexthops, NHG_DELIMITER);
         for (const auto &nh : nhv)
         {
-            m_nexthops.insert(nh);
+            add(NextHopKey(nh));
         }
     }
 
@@ -30,8 +139,7 @@ public:
             auto nhv = tokenize(nexthops, NHG_DELIMITER);
             for (const auto &nh_str : nhv)
             {
-                auto nh = NextHopKey(nh_str, overlay_nh, srv6_nh);
-                m_nexthops.insert(nh);
+                add(NextHopKey(nh_str, overlay_nh, srv6_nh));
             }
         }
         else if (srv6_nh)
@@ -41,8 +149,7 @@ public:
             auto nhv = tokenize(nexthops, NHG_DELIMITER);
             for (const auto &nh_str : nhv)
             {
-                auto nh = NextHopKey(nh_str, overlay_nh, srv6_nh);
-                m_nexthops.insert(nh);
+                add(NextHopKey(nh_str, overlay_nh, srv6_nh));
             }
         }
     }
@@ -58,61 +165,87 @@ public:
         {
             NextHopKey nh(nhv[i]);
             nh.weight = set_weight? (uint32_t)std::stoi(wtv[i]) : 0;
-            m_nexthops.insert(nh);
+            add(nh);
         }
     }
 
-    inline const std::set<NextHopKey> &getNextHops() const
+    NextHopGroupKey(const NextHopGroupKey &o) :
+        m_members(o.m_members),
+        m_nexthops(o.m_nexthops),
+        m_hash(o.m_hash),
+        m_overlay_nexthops(o.m_overlay_nexthops),
+        m_srv6_nexthops(o.m_srv6_nexthops)
     {
-        return m_nexthops;
+        for (const auto &member : m_members)
+        {
+            NextHopKeyTable::acquire(member.first);
+        }
     }
 
-    inline size_t getSize() const
+    NextHopGroupKey(NextHopGroupKey &&o) :
+        m_hash(o.m_hash),
+        m_overlay_nexthops(o.m_overlay_nexthops),
+        m_srv6_nexthops(o.m_srv6_nexthops)
     {
-        return m_nexthops.size();
+        m_members.swap(o.m_members);
+        m_nexthops.swap(o.m_nexthops);
+        o.updateHash();
     }
 
-    inline bool operator<(const NextHopGroupKey &o) const
+    NextHopGroupKey &operator=(NextHopGroupKey o)
     {
-        if (m_nexthops < o.m_nexthops)
-        {
-            return true;
-        }
-        else if (m_nexthops == o.m_nexthops)
+        std::swap(m_members, o.m_members);
+        std::swap(m_nexthops, o.m_nexthops);
+        std::swap(m_hash, o.m_hash);
+        m_overlay_nexthops = o.m_overlay_nexthops;
+        m_srv6_nexthops = o.m_srv6_nexthops;
+        return *this;
+    }
+
+    ~NextHopGroupKey()
+    {
+        releaseMembers();
+    }
+
+    /*
+     * The next hops are only materialized from the interned ids when asked
+     * for, and shared between copies of the key until it is modified.
+     */
+    inline const std::set<NextHopKey> &getNextHops() const
+    {
+        if (!m_nexthops)
         {
-            auto it1 = m_nexthops.begin();
-            for (auto& it2 : o.m_nexthops)
+            auto nexthops = std::make_shared<std::set<NextHopKey>>();
+            for (const auto &member : m_members)
             {
-                if (it1->weight < it2.weight)
-                {
-                    return true;
-                }
-                else if(it1->weight > it2.weight)
-                {
-                    return false;
-                }
-                it1++;
+                NextHopKey nh = NextHopKeyTable::get(member.first);
+                nh.weight = member.second;
+                nexthops->insert(nexthops->end(), nh);
             }
+            m_nexthops = nexthops;
         }
-        return false;
+        return *m_nexthops;
+    }
+
+    inline size_t getSize() const
+    {
+        return m_members.size();
+    }
+
+    /* Hash of the interned members, stable for the lifetime of the key */
+    inline size_t getHash() const
+    {
+        return m_hash;
+    }
+
+    inline bool operator<(const NextHopGroupKey &o) const
+    {
+        return m_members < o.m_members;
     }
 
     inline bool operator==(const NextHopGroupKey &o) const
     {
-        if (m_nexthops != o.m_nexthops)
-        {
-            return false;
-        }
-        auto it1 = m_nexthops.begin();
-        for (auto& it2 : o.m_nexthops)
-        {
-            if (it2.weight != it1->weight)
-            {
-                return false;
-            }
-            it1++;
-        }
-        return true;
+        return m_hash == o.m_hash && m_members == o.m_members;
     }
 
     inline bool operator!=(const NextHopGroupKey &o) const
@@ -122,40 +255,46 @@ public:
 
     void add(const std::string &ip, const std::string &alias)
     {
-        m_nexthops.emplace(ip, alias);
+        add(NextHopKey(ip, alias));
     }
 
     void add(const std::string &nh)
     {
-        m_nexthops.insert(nh);
+        add(NextHopKey(nh));
     }
 
     void add(const NextHopKey &nh)
     {
-        m_nexthops.insert(nh);
+        if (contains(nh))
+        {
+            return;
+        }
+
+        Member member(NextHopKeyTable::acquire(nh), nh.weight);
+        m_members.insert(std::lower_bound(m_members.begin(), m_members.end(), member), member);
+        updateHash();
     }
 
     bool contains(const std::string &ip, const std::string &alias) const
     {
-        NextHopKey nh(ip, alias);
-        return m_nexthops.find(nh) != m_nexthops.end();
+        return contains(NextHopKey(ip, alias));
     }
 
     bool contains(const std::string &nh) const
     {
-        return m_nexthops.find(nh) != m_nexthops.end();
+        return contains(NextHopKey(nh));
     }
 
     bool contains(const NextHopKey &nh) const
     {
-        return m_nexthops.find(nh) != m_nexthops.end();
+        return findMember(nh) != m_members.end();
     }
 
     bool contains(const NextHopGroupKey &nhs) const
     {
-        for (const auto &nh : nhs.getNextHops())
+        for (const auto &member : nhs.m_members)
         {
-            if (!contains(nh))
+            if (findMember(member.first) == m_members.end())
             {
                 return false;
             }
@@ -165,9 +304,9 @@ public:
 
     bool hasIntfNextHop() const
     {
-        for (const auto &nh : m_nexthops)
+        for (const auto &member : m_members)
         {
-            if (nh.isIntfNextHop())
+            if (NextHopKeyTable::get(member.first).isIntfNextHop())
             {
                 return true;
             }
@@ -177,27 +316,36 @@ public:
 
     void remove(const std::string &ip, const std::string &alias)
     {
-        NextHopKey nh(ip, alias);
-        m_nexthops.erase(nh);
+        remove(NextHopKey(ip, alias));
     }
 
     void remove(const std::string &nh)
     {
-        m_nexthops.erase(nh);
+        remove(NextHopKey(nh));
     }
 
     void remove(const NextHopKey &nh)
     {
-        m_nexthops.erase(nh);
+        auto it = findMember(nh);
+        if (it == m_members.end())
+        {
+            return;
+        }
+
+        uint32_t id = it->first;
+        m_members.erase(it);
+        NextHopKeyTable::release(id);
+        updateHash();
     }
 
     const std::string to_string() const
     {
         string nhs_str;
+        const auto &nexthops = getNextHops();
 
-        for (auto it = m_nexthops.begin(); it != m_nexthops.end(); ++it)
+        for (auto it = nexthops.begin(); it != nexthops.end(); ++it)
         {
-            if (it != m_nexthops.begin())
+            if (it != nexthops.begin())
             {
                 nhs_str += NHG_DELIMITER;
             }
@@ -223,13 +371,69 @@ public:
 
     void clear()
     {
-        m_nexthops.clear();
+        releaseMembers();
+        m_members.clear();
+        updateHash();
     }
 
 private:
-    std::set<NextHopKey> m_nexthops;
-    bool m_overlay_nexthops;
-    bool m_srv6_nexthops;
+    /* Interned next hop id and its weight, kept sorted by id */
+    typedef std::pair<uint32_t, uint32_t> Member;
+
+    std::vector<Member> m_members;
+    /* Cache of the next hops built from m_members, reset on every change */
+    mutable std::shared_ptr<const std::set<NextHopKey>> m_nexthops;
+    size_t m_hash = 0;
+    bool m_overlay_nexthops = false;
+    bool m_srv6_nexthops = false;
+
+    std::vector<Member>::const_iterator findMember(uint32_t id) const
+    {
+        auto it = std::lower_bound(m_members.begin(), m_members.end(), Member(id, 0));
+        return (it != m_members.end() && it->first == id) ? it : m_members.end();
+    }
+
+    std::vector<Member>::const_iterator findMember(const NextHopKey &nh) const
+    {
+        uint32_t id;
+        if (!NextHopKeyTable::find(nh, id))
+        {
+            return m_members.end();
+        }
+        return findMember(id);
+    }
+
+    void releaseMembers()
+    {
+        for (const auto &member : m_members)
+        {
+            NextHopKeyTable::release(member.first);
+        }
+    }
+
+    void updateHash()
+    {
+        size_t hash = m_members.size();
+        for (const auto &member : m_members)
+        {
+            uint64_t value = (static_cast<uint64_t>(member.first) << 32) | member.second;
+            hash ^= std::hash<uint64_t>()(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        }
+        m_hash = hash;
+        m_nexthops.reset();
+    }
 };
 
+namespace std
+{
+    template <>
+    struct hash<NextHopGroupKey>
+    {
+        size_t operator()(const NextHopGroupKey &key) const
+        {
+            return key.getHash();
+        }
+    };
+}
+
 #endif /* SWSS_NEXTHOPGROUPKEY_H */
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <inttypes.h>
@@ -23,6 +24,13 @@ extern ofstream gRecordOfs;
 extern bool gLogRotate;
 extern string gRecordFile;
 
+bool Consumer::s_dirtyScheduling = false;
+uint64_t Consumer::s_retryEpoch = 0;
+uint64_t Consumer::s_sweepsAvoided = 0;
+const string Consumer::PROGRESS_DEPENDENCY = "progress";
+map<string, set<Consumer *>> Consumer::s_waitingConsumers;
+map<string, set<Consumer *>> Consumer::s_parkedConsumers;
+
 Orch::Orch(DBConnector *db, const string tableName, int pri)
 {
     addConsumer(db, tableName, pri);
@@ -60,6 +68,26 @@ Orch::~Orch()
     }
 }
 
+Consumer::~Consumer()
+{
+    stopWaiting();
+
+    for (const auto &it : m_parkedByDependency)
+    {
+        auto consumers = s_parkedConsumers.find(it.first);
+        if (consumers == s_parkedConsumers.end())
+        {
+            continue;
+        }
+
+        consumers->second.erase(this);
+        if (consumers->second.empty())
+        {
+            s_parkedConsumers.erase(consumers);
+        }
+    }
+}
+
 vector<Selectable *> Orch::getSelectables()
 {
     vector<Selectable *> selectables;
@@ -70,13 +98,72 @@ vector<Selectable *> Orch::getSelectables()
     return selectables;
 }
 
+/*
+ * Merge the fields of a SET into the pending SET of the same key. A field set
+ * again is moved to the end with its latest value, as if it was erased and the
+ * new field-value appended. Runs in O(n + m) instead of O(n * m).
+ */
+static void mergeFieldsValues(vector<FieldValueTuple> &existing_values, const vector<FieldValueTuple> &new_values)
+{
+    const size_t linear_lookup_limit = 8;
+
+    /* Index of the last occurrence of each field in new_values */
+    unordered_map<string, size_t> last_index;
+    if (new_values.size() > linear_lookup_limit)
+    {
+        last_index.reserve(new_values.size());
+        for (size_t i = 0; i < new_values.size(); i++)
+        {
+            last_index[fvField(new_values[i])] = i;
+        }
+    }
+
+    auto findLast = [&](const string &field) -> ssize_t
+    {
+        if (new_values.size() > linear_lookup_limit)
+        {
+            auto found = last_index.find(field);
+            return found == last_index.end() ? -1 : static_cast<ssize_t>(found->second);
+        }
+
+        for (size_t i = new_values.size(); i > 0; i--)
+        {
+            if (fvField(new_values[i - 1]) == field)
+            {
+                return static_cast<ssize_t>(i - 1);
+            }
+        }
+        return -1;
+    };
+
+    existing_values.erase(
+            remove_if(existing_values.begin(), existing_values.end(),
+                [&](const FieldValueTuple &fv) { return findLast(fvField(fv)) >= 0; }),
+            existing_values.end());
+
+    for (size_t i = 0; i < new_values.size(); i++)
+    {
+        if (findLast(fvField(new_values[i])) == static_cast<ssize_t>(i))
+        {
+            existing_values.push_back(new_values[i]);
+        }
+    }
+}
+
 void Consumer::addToSync(const KeyOpFieldsValuesTuple &entry)
 {
     SWSS_LOG_ENTER();
 
+    const string &key = kfvKey(entry);
+    const string &op  = kfvOp(entry);
 
-    string key = kfvKey(entry);
-    string op  = kfvOp(entry);
+    m_dirty = true;
+
+    /* The new task supersedes the wait, bring back the parked one to merge with */
+    if (!m_parked.empty() && m_parked.find(key) != m_parked.end())
+    {
+        unparkToSync(key);
+    }
 
     /* Record incoming tasks */
     if (gSwssRecord)
@@ -88,19 +175,23 @@ void Consumer::addToSync(const KeyOpFieldsValuesTuple &entry)
     * m_toSync is a multimap which will allow one key with multiple values,
     * Also, the order of the key-value pairs whose keys compare equivalent
     * is the order of insertion and does not change. (since C++11)
+    * A single lookup gives the range of the key, which is then used as the
+    * insertion hint: emplace_hint() inserts just prior to the hint, i.e.
+    * after the existing values of the key.
     */
+    auto range = m_toSync.equal_range(key);
 
     /* If a new task comes we directly put it into getConsumerTable().m_toSync map */
-    if (m_toSync.find(key) == m_toSync.end())
+    if (range.first == range.second)
     {
-        m_toSync.emplace(key, entry);
+        m_toSync.emplace_hint(range.second, key, entry);
     }
 
     /* if a DEL task comes, we overwrite the old key */
     else if (op == DEL_COMMAND)
     {
-        m_toSync.erase(key);
-        m_toSync.emplace(key, entry);
+        auto next = m_toSync.erase(range.first, range.second);
+        m_toSync.emplace_hint(next, key, entry);
     }
     else
     {
@@ -113,48 +204,176 @@ void Consumer::addToSync(const KeyOpFieldsValuesTuple &entry)
         * We iterate the values with the key, we skip the value with DEL and then
         * check if that was the only one (I,E, the iter pointer now points to end or next key),
         * in such case, we insert the key-value with SET.
-        * If there was a SET already (I,E, the pointer still points to the same key), we combine the kfv.
+        * If there was a SET already (I,E, the pointer still points to the same key), we merge
+        * the new fields into it in place.
         */
-        auto ret = m_toSync.equal_range(key);
-        auto iter = ret.first;
-        for (; iter != ret.second; ++iter)
+        auto iter = range.first;
+        for (; iter != range.second; ++iter)
         {
-            auto old_op = kfvOp(iter->second);
-            if (old_op == SET_COMMAND)
+            if (kfvOp(iter->second) == SET_COMMAND)
                 break;
         }
-        if (iter == ret.second)
+        if (iter == range.second)
         {
-            m_toSync.emplace(key, entry);
+            m_toSync.emplace_hint(range.second, key, entry);
         }
         else
         {
-            KeyOpFieldsValuesTuple existing_data = iter->second;
+            mergeFieldsValues(kfvFieldsValues(iter->second), kfvFieldsValues(entry));
+        }
+    }
 
-            auto new_values = kfvFieldsValues(entry);
-            auto existing_values = kfvFieldsValues(existing_data);
+}
 
+SyncMap::iterator Consumer::parkToSync(SyncMap::iterator it, const string &dependency)
+{
+    SWSS_LOG_ENTER();
 
-            for (auto it : new_values)
-            {
-                string field = fvField(it);
-                string value = fvValue(it);
+    string key = it->first;
+
+    /* Only one task per key can be parked, keep retrying the others */
+    if (m_parked.find(key) != m_parked.end())
+    {
+        return ++it;
+    }
+
+    m_parked.emplace(key, make_pair(dependency, it->second));
+    m_parkedByDependency[dependency].insert(key);
+    s_parkedConsumers[dependency].insert(this);
+    m_parkedCount++;
 
-                auto iu = existing_values.begin();
-                while (iu != existing_values.end())
+    SWSS_LOG_INFO("Park %s:%s until %s, parked %zu", getTableName().c_str(),
+            key.c_str(), dependency.c_str(), m_parked.size());
+
+    return m_toSync.erase(it);
+}
+
+void Consumer::unparkToSync(const string &key)
+{
+    auto parked = m_parked.find(key);
+    if (parked == m_parked.end())
+    {
+        return;
+    }
+
+    const string &dependency = parked->second.first;
+
+    auto keys = m_parkedByDependency.find(dependency);
+    if (keys != m_parkedByDependency.end())
+    {
+        keys->second.erase(key);
+        if (keys->second.empty())
+        {
+            m_parkedByDependency.erase(keys);
+
+            auto consumers = s_parkedConsumers.find(dependency);
+            if (consumers != s_parkedConsumers.end())
+            {
+                consumers->second.erase(this);
+                if (consumers->second.empty())
                 {
-                    string ofield = fvField(*iu);
-                    if (field == ofield)
-                        iu = existing_values.erase(iu);
-                    else
-                        iu++;
+                    s_parkedConsumers.erase(consumers);
                 }
-                existing_values.push_back(FieldValueTuple(field, value));
             }
-            iter->second = KeyOpFieldsValuesTuple(key, op, existing_values);
         }
     }
 
+    /*
+     * Only SETs are parked. A DEL of the key still pending for retry came
+     * before the parked SET, so the woken SET goes after it. No newer SET can
+     * be pending: addToSync() unparks the task before adding one.
+     */
+    m_toSync.emplace_hint(m_toSync.upper_bound(key), key, parked->second.second);
+    m_parked.erase(parked);
+    m_dirty = true;
+}
+
+void Consumer::wakeToSync(const string &dependency)
+{
+    auto keys = m_parkedByDependency.find(dependency);
+    if (keys == m_parkedByDependency.end())
+    {
+        return;
+    }
+
+    /* unparkToSync() drops the key set once it is empty */
+    vector<string> woken(keys->second.begin(), keys->second.end());
+    for (const auto &key : woken)
+    {
+        unparkToSync(key);
+    }
+    m_wokenCount += woken.size();
+
+    SWSS_LOG_INFO("Wake %zu tasks of %s on %s, woken %" PRIu64 ", parked %zu", woken.size(),
+            getTableName().c_str(), dependency.c_str(), m_wokenCount, m_parked.size());
+}
+
+void Consumer::wake(const string &dependency)
+{
+    SWSS_LOG_ENTER();
+
+    auto waiting = s_waitingConsumers.find(dependency);
+    if (waiting != s_waitingConsumers.end())
+    {
+        for (auto consumer : waiting->second)
+        {
+            consumer->m_dirty = true;
+        }
+    }
+
+    auto consumers = s_parkedConsumers.find(dependency);
+    if (consumers == s_parkedConsumers.end())
+    {
+        return;
+    }
+
+    /* wakeToSync() updates s_parkedConsumers */
+    set<Consumer *> parked = consumers->second;
+    for (auto consumer : parked)
+    {
+        consumer->wakeToSync(dependency);
+    }
+}
+
+void Consumer::waitFor(const string &dependency)
+{
+    m_waitingOn.insert(dependency);
+    m_waitCount++;
+}
+
+void Consumer::startWaiting()
+{
+    /* A task left without a named dependency may be unblocked by anything */
+    if (m_waitCount < m_toSync.size())
+    {
+        m_waitingOn.insert(PROGRESS_DEPENDENCY);
+    }
+
+    for (const auto &dependency : m_waitingOn)
+    {
+        s_waitingConsumers[dependency].insert(this);
+    }
+}
+
+void Consumer::stopWaiting()
+{
+    for (const auto &dependency : m_waitingOn)
+    {
+        auto consumers = s_waitingConsumers.find(dependency);
+        if (consumers == s_waitingConsumers.end())
+        {
+            continue;
+        }
+
+        consumers->second.erase(this);
+        if (consumers->second.empty())
+        {
+            s_waitingConsumers.erase(consumers);
+        }
+    }
+
+    m_waitingOn.clear();
+    m_waitCount = 0;
 }
 
 size_t Consumer::addToSync(const std::deque<KeyOpFieldsValuesTuple> &entries)
@@ -235,10 +454,39 @@ void Consumer::execute()
     drain();
 }
 
+bool Consumer::isDirty() const
+{
+    return !m_toSync.empty() && (m_dirty || m_epoch != s_retryEpoch);
+}
+
 void Consumer::drain()
 {
-    if (!m_toSync.empty())
-        m_orch->doTask(*this);
+    if (m_toSync.empty())
+        return;
+
+    if (s_dirtyScheduling && !isDirty())
+    {
+        /* Nothing changed since the last attempt, the tasks would fail again */
+        s_sweepsAvoided++;
+        return;
+    }
+
+    /* Parking a task is not progress */
+    size_t pending = m_toSync.size() + m_parked.size();
+
+    /* doTask() names again what the tasks it leaves wait on */
+    stopWaiting();
+    m_dirty = false;
+    m_orch->doTask(*this);
+    m_orch->flushResponses();
+
+    /* Progress here may unblock tasks of unknown dependency in other consumers */
+    if (m_toSync.size() + m_parked.size() < pending)
+    {
+        wake(PROGRESS_DEPENDENCY);
+    }
+    startWaiting();
+    m_epoch = s_retryEpoch;
 }
 
 string Consumer::dumpTuple(const KeyOpFieldsValuesTuple &tuple)
@@ -263,6 +511,11 @@ void Consumer::dumpPendingTasks(vector<string> &ts)
 
         ts.push_back(s);
     }
+
+    for (auto &tm : m_parked)
+    {
+        ts.push_back(dumpTuple(tm.second.second) + "|parked:" + tm.second.first);
+    }
 }
 
 size_t Orch::addExistingData(const string& tableName)
@@ -545,6 +798,14 @@ void Orch::doTask()
     {
         it.second->drain();
     }
+
+    /* Responses published outside of a drain, e.g. from timers */
+    flushResponses();
+}
+
+void Orch::flushResponses()
+{
+    m_publisher.flush();
 }
 
 void Orch::dumpPendingTasks(vector<string> &ts)
@@ -139,6 +139,8 @@ public:
     {
     }
 
+    ~Consumer() override;
+
     swss::ConsumerTableBase *getConsumerTable() const
     {
         return static_cast<swss::ConsumerTableBase *>(getSelectable());
@@ -175,6 +177,75 @@ public:
 
     // Returns: the number of entries added to m_toSync
     size_t addToSync(const std::deque<swss::KeyOpFieldsValuesTuple> &entries);
+
+    /*
+     * Dirty-set scheduling: with scheduling enabled, drain() skips a consumer
+     * whose pending tasks cannot make progress yet, i.e. it gained no new task
+     * and none of the dependencies its retried tasks wait on was woken since
+     * its last attempt.
+     */
+    bool isDirty() const;
+    void markDirty() { m_dirty = true; }
+
+    /*
+     * Record that a task left in m_toSync by the current doTask() waits on a
+     * named dependency (e.g. "vrf Vrf1"). Once every task left waits on a
+     * named dependency, the consumer is only retried when one of them is
+     * woken. Otherwise it also waits on PROGRESS_DEPENDENCY.
+     */
+    void waitFor(const std::string &dependency);
+
+    // Woken by any progress, notification or timer, for retries of unknown cause
+    static const std::string PROGRESS_DEPENDENCY;
+
+    // Wake the tasks waiting on a dependency, parked or retried
+    static void wake(const std::string &dependency);
+    // Wake every consumer holding tasks to retry, e.g. periodically
+    static void wakeAll() { s_retryEpoch++; }
+    static void setDirtyScheduling(bool enable) { s_dirtyScheduling = enable; }
+    static uint64_t getSweepsAvoided() { return s_sweepsAvoided; }
+
+    /*
+     * Retry parking: a task which cannot succeed before a named dependency
+     * (e.g. "neighbor 10.0.0.1@Ethernet0") changes is moved out of m_toSync
+     * and is not retried until wake() is called for the dependency.
+     * A new task for a parked key puts the parked task back first.
+     */
+    // Returns: the iterator following the parked task
+    SyncMap::iterator parkToSync(SyncMap::iterator it, const std::string &dependency);
+
+    size_t getParkedSize() const { return m_parked.size(); }
+    uint64_t getParkedCount() const { return m_parkedCount; }
+    uint64_t getWokenCount() const { return m_wokenCount; }
+
+private:
+    bool m_dirty = false;
+    uint64_t m_epoch = 0;
+
+    static bool s_dirtyScheduling;
+    static uint64_t s_retryEpoch;
+    static uint64_t s_sweepsAvoided;
+
+    // Dependencies the tasks left in m_toSync wait on, and how many tasks named one
+    std::set<std::string> m_waitingOn;
+    size_t m_waitCount = 0;
+
+    // Consumers whose tasks in m_toSync wait on each dependency
+    static std::map<std::string, std::set<Consumer *>> s_waitingConsumers;
+
+    // Parked tasks by key, along with the dependency they wait on
+    std::map<std::string, std::pair<std::string, swss::KeyOpFieldsValuesTuple>> m_parked;
+    std::map<std::string, std::set<std::string>> m_parkedByDependency;
+    uint64_t m_parkedCount = 0;
+    uint64_t m_wokenCount = 0;
+
+    // Consumers holding tasks parked on each dependency
+    static std::map<std::string, std::set<Consumer *>> s_parkedConsumers;
+
+    void unparkToSync(const std::string &key);
+    void wakeToSync(const std::string &dependency);
+    void startWaiting();
+    void stopWaiting();
 };
 
 typedef std::map<std::string, std::shared_ptr<Executor>> ConsumerMap;
@@ -219,6 +290,9 @@ public:
     virtual void doTask(swss::NotificationConsumer &consumer) { }
     virtual void doTask(swss::SelectableTimer &timer) { }
 
+    /* Send the responses buffered by m_publisher */
+    void flushResponses();
+
     /* TODO: refactor recording */
     static void recordTuple(Consumer &consumer, const swss::KeyOpFieldsValuesTuple &tuple);
 
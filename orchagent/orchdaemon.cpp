@@ -2,6 +2,7 @@
 #include <unordered_map>
 #include <chrono>
 #include <limits.h>
+#include <inttypes.h>
 #include "orchdaemon.h"
 #include "logger.h"
 #include <sairedis.h>
@@ -62,6 +63,8 @@ event_handle_t g_events_handle;
 
 #define DEFAULT_MAX_BULK_SIZE 1000
 size_t gMaxBulkSize = DEFAULT_MAX_BULK_SIZE;
+/* Window over which port oper status notifications are coalesced, 0 to process them as they come */
+uint32_t gPortOperStatusCoalesceMs = 0;
 
 OrchDaemon::OrchDaemon(DBConnector *applDb, DBConnector *configDb, DBConnector *stateDb, DBConnector *chassisAppDb) :
         m_applDb(applDb),
@@ -703,6 +706,9 @@ void OrchDaemon::start()
         m_select->addSelectables(o->getSelectables());
     }
 
+    /* Only re-run consumers whose pending tasks may make progress */
+    Consumer::setDirtyScheduling(true);
+
     auto tstart = std::chrono::high_resolution_clock::now();
 
     while (true)
@@ -721,6 +727,11 @@ void OrchDaemon::start()
             tstart = std::chrono::high_resolution_clock::now();
 
             flush();
+
+            /* Retry all pending tasks periodically in case a dependency
+             * change was not woken by name or by progress */
+            Consumer::wakeAll();
+            SWSS_LOG_INFO("Retry sweeps avoided: %" PRIu64, Consumer::getSweepsAvoided());
         }
 
         if (ret == Select::ERROR)
@@ -754,8 +765,14 @@ void OrchDaemon::start()
         auto *c = (Executor *)s;
         c->execute();
 
-        /* After each iteration, periodically check all m_toSync map to
-         * execute all the remaining tasks that need to be retried. */
+        /* Notifications and timers may change the state of unknown dependencies */
+        if (dynamic_cast<Consumer *>(c) == nullptr)
+        {
+            Consumer::wake(Consumer::PROGRESS_DEPENDENCY);
+        }
+
+        /* After each iteration, check the m_toSync map of the dirty consumers
+         * to execute the remaining tasks that need to be retried. */
 
         /* TODO: Abstract Orch class to have a specific todo list */
         for (Orch *o : m_orchList)
@@ -17,6 +17,14 @@ void FlexCounterOrch::doTask(Consumer &consumer)
 {
 }
 
+void FlexCounterOrch::doTask(swss::SelectableTimer &timer)
+{
+}
+
+void FlexCounterOrch::refreshRateCounterObjects(const std::string &nameMap)
+{
+}
+
 bool FlexCounterOrch::getPortCountersState() const
 {
     return true;
@@ -109,6 +109,33 @@ void PortsOrch::setPort(string alias, Port port)
     m_portList[alias] = port;
 }
 
+const Port *PortsOrch::findPort(const string &alias)
+{
+    auto it = m_portList.find(alias);
+    return it == m_portList.end() ? nullptr : &it->second;
+}
+
+const Port *PortsOrch::findPort(sai_object_id_t id)
+{
+    for (const auto &p : m_portList)
+    {
+        if (p.second.m_port_id == id)
+        {
+            return &p.second;
+        }
+    }
+    return nullptr;
+}
+
+const Port *PortsOrch::findPortByBridgePortId(sai_object_id_t bridge_port_id)
+{
+    return nullptr;
+}
+
+void PortsOrch::updateFdbCount(Port &port, int delta)
+{
+}
+
 void PortsOrch::getCpuPort(Port &port)
 {
 }
@@ -454,16 +454,16 @@ void PfcWdAclHandler::createPfcAclRule(shared_ptr<AclRulePacket> rule, uint8_t q
     // Add MATCH_IN_PORTS as match criteria for ingress table
     if (strTable == INGRESS_TABLE_DROP) 
     {
-        Port p;
         attr_name = MATCH_IN_PORTS;
 
-        if (!gPortsOrch->getPort(portOid, p))
+        const Port *p = gPortsOrch->findPort(portOid);
+        if (p == nullptr)
         {
             SWSS_LOG_ERROR("Failed to get port structure from port oid 0x%" PRIx64, portOid);
             return;
         }
 
-        attr_value = p.m_alias;
+        attr_value = p->m_alias;
         rule->validateAddMatch(attr_name, attr_value);
     }
 
@@ -564,14 +564,14 @@ bool PfcWdLossyHandler::getHwCounters(PfcWdHwStats& counters)
     }
 
     // PG counters not yet supported in Mellanox platform
-    Port portInstance;
-    if (!gPortsOrch->getPort(getPort(), portInstance))
+    const Port *portInstance = gPortsOrch->findPort(getPort());
+    if (portInstance == nullptr)
     {
         SWSS_LOG_ERROR("Cannot get port by ID 0x%" PRIx64, getPort());
         return false;
     }
 
-    sai_object_id_t pg = portInstance.m_priority_group_ids[static_cast <size_t> (getQueueId())];
+    sai_object_id_t pg = portInstance->m_priority_group_ids[static_cast <size_t> (getQueueId())];
     vector<uint64_t> pgStats;
     pgStats.resize(pgStatIds.size());
 
@@ -9,6 +9,7 @@
 
 #include <inttypes.h>
 #include <cassert>
+#include <chrono>
 #include <fstream>
 #include <sstream>
 #include <set>
@@ -56,6 +57,7 @@ extern int32_t gVoqMySwitchId;
 extern string gMyHostName;
 extern string gMyAsicName;
 extern event_handle_t g_events_handle;
+extern uint32_t gPortOperStatusCoalesceMs;
 
 #define DEFAULT_SYSTEM_PORT_MTU 9100
 #define VLAN_PREFIX         "Vlan"
@@ -72,6 +74,9 @@ extern event_handle_t g_events_handle;
 #define PG_DROP_FLEX_STAT_COUNTER_POLL_MSECS         "10000"
 #define PORT_RATE_FLEX_COUNTER_POLLING_INTERVAL_MS   "1000"
 
+#define STATE_PORT_INIT_TIMING_TABLE "PORT_INIT_TIMING"
+#define PORT_INIT_TIMING_KEY         "ports"
+
 
 static map<string, sai_port_fec_mode_t> fec_mode_map =
 {
@@ -380,6 +385,12 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
     /* Initialize port and vlan table */
     m_portTable = unique_ptr<Table>(new Table(db, APP_PORT_TABLE_NAME));
 
+    /* Buffered port and port state tables of the coalesced oper status updates */
+    m_applPipeline = unique_ptr<RedisPipeline>(new RedisPipeline(db));
+    m_statePipeline = unique_ptr<RedisPipeline>(new RedisPipeline(stateDb));
+    m_bufferedPortTable = unique_ptr<Table>(new Table(m_applPipeline.get(), APP_PORT_TABLE_NAME, true));
+    m_bufferedPortStateTable = unique_ptr<Table>(new Table(m_statePipeline.get(), STATE_PORT_TABLE_NAME, true));
+
     /* Initialize gearbox */
     m_gearboxTable = unique_ptr<Table>(new Table(db, "_GEARBOX_TABLE"));
 
@@ -407,7 +418,6 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
     string queueWmSha, pgWmSha;
     string queueWmPluginName = "watermark_queue.lua";
     string pgWmPluginName = "watermark_pg.lua";
-    string portRatePluginName = "port_rates.lua";
 
     try
     {
@@ -417,9 +427,6 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
         string pgLuaScript = swss::loadLuaScript(pgWmPluginName);
         pgWmSha = swss::loadRedisScript(m_counter_db.get(), pgLuaScript);
 
-        string portRateLuaScript = swss::loadLuaScript(portRatePluginName);
-        string portRateSha = swss::loadRedisScript(m_counter_db.get(), portRateLuaScript);
-
         vector<FieldValueTuple> fieldValues;
         fieldValues.emplace_back(QUEUE_PLUGIN_FIELD, queueWmSha);
         fieldValues.emplace_back(POLL_INTERVAL_FIELD, QUEUE_WATERMARK_FLEX_STAT_COUNTER_POLL_MSECS);
@@ -433,7 +440,6 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
         m_flexCounterGroupTable->set(PG_WATERMARK_STAT_COUNTER_FLEX_COUNTER_GROUP, fieldValues);
 
         fieldValues.clear();
-        fieldValues.emplace_back(PORT_PLUGIN_FIELD, portRateSha);
         fieldValues.emplace_back(POLL_INTERVAL_FIELD, PORT_RATE_FLEX_COUNTER_POLLING_INTERVAL_MS);
         fieldValues.emplace_back(STATS_MODE_FIELD, STATS_MODE_READ);
         m_flexCounterGroupTable->set(PORT_STAT_COUNTER_FLEX_COUNTER_GROUP, fieldValues);
@@ -633,6 +639,15 @@ PortsOrch::PortsOrch(DBConnector *db, DBConnector *stateDb, vector<table_name_wi
 
     auto executor = new ExecutableTimer(m_port_state_poller, this, "PORT_STATE_POLLER");
     Orch::addExecutor(executor);
+
+    if (gPortOperStatusCoalesceMs > 0)
+    {
+        timespec interval = { .tv_sec = gPortOperStatusCoalesceMs / 1000,
+                              .tv_nsec = (gPortOperStatusCoalesceMs % 1000) * 1000000 };
+        m_operStatusCoalesceTimer = new SelectableTimer(interval);
+        Orch::addExecutor(new ExecutableTimer(m_operStatusCoalesceTimer, this, "PORT_OPER_STATUS_COALESCE"));
+        SWSS_LOG_NOTICE("Coalescing port oper status notifications over %u ms", gPortOperStatusCoalesceMs);
+    }
 }
 
 void PortsOrch::removeDefaultVlanMembers()
@@ -802,40 +817,95 @@ map<string, Port>& PortsOrch::getAllPorts()
     return m_portList;
 }
 
-bool PortsOrch::getPort(string alias, Port &p)
+Port *PortsOrch::lookupPort(const string &alias)
 {
-    SWSS_LOG_ENTER();
+    auto it = m_portList.find(alias);
+    if (it == m_portList.end())
+    {
+        return nullptr;
+    }
 
-    if (m_portList.find(alias) == m_portList.end())
+    return &it->second;
+}
+
+Port *PortsOrch::lookupPort(sai_object_id_t id)
+{
+    auto cached = m_portOidCache.find(id);
+    if (cached != m_portOidCache.end())
     {
-        return false;
+        return cached->second;
     }
-    else
+
+    auto itr = saiOidToAlias.find(id);
+    if (itr == saiOidToAlias.end())
     {
-        p = m_portList[alias];
-        return true;
+        return nullptr;
+    }
+
+    Port *port = lookupPort(itr->second);
+    if (port == nullptr)
+    {
+        SWSS_LOG_THROW("Inconsistent saiOidToAlias map and m_portList map: oid=%" PRIx64, id);
     }
+
+    m_portOidCache[id] = port;
+    return port;
 }
 
-bool PortsOrch::getPort(sai_object_id_t id, Port &port)
+void PortsOrch::mapPortOid(sai_object_id_t id, const string &alias)
+{
+    saiOidToAlias[id] = alias;
+    m_portOidCache.erase(id);
+}
+
+void PortsOrch::unmapPortOid(sai_object_id_t id)
+{
+    saiOidToAlias.erase(id);
+    m_portOidCache.erase(id);
+}
+
+void PortsOrch::erasePort(const string &alias)
+{
+    m_portList.erase(alias);
+    m_portOidCache.clear();
+}
+
+const Port *PortsOrch::findPort(const string &alias)
+{
+    return lookupPort(alias);
+}
+
+const Port *PortsOrch::findPort(sai_object_id_t id)
+{
+    return lookupPort(id);
+}
+
+bool PortsOrch::getPort(string alias, Port &p)
 {
     SWSS_LOG_ENTER();
 
-    auto itr = saiOidToAlias.find(id);
-    if (itr == saiOidToAlias.end())
+    const Port *port = lookupPort(alias);
+    if (port == nullptr)
     {
         return false;
     }
-    else
+
+    p = *port;
+    return true;
+}
+
+bool PortsOrch::getPort(sai_object_id_t id, Port &port)
+{
+    SWSS_LOG_ENTER();
+
+    const Port *p = lookupPort(id);
+    if (p == nullptr)
     {
-        if (!getPort(itr->second, port))
-        {
-            SWSS_LOG_THROW("Inconsistent saiOidToAlias map and m_portList map: oid=%" PRIx64, id);
-        }
-        return true;
+        return false;
     }
 
-    return false;
+    port = *p;
+    return true;
 }
 
 void PortsOrch::increasePortRefCount(const string &alias)
@@ -872,18 +942,32 @@ bool PortsOrch::getPortByBridgePortId(sai_object_id_t bridge_port_id, Port &port
 {
     SWSS_LOG_ENTER();
 
-    auto itr = saiOidToAlias.find(bridge_port_id);
-    if (itr == saiOidToAlias.end())
+    const Port *p = lookupPort(bridge_port_id);
+    if (p == nullptr)
     {
         return false;
     }
-    else
+
+    port = *p;
+    return true;
+}
+
+const Port *PortsOrch::findPortByBridgePortId(sai_object_id_t bridge_port_id)
+{
+    return lookupPort(bridge_port_id);
+}
+
+void PortsOrch::updateFdbCount(Port &port, int delta)
+{
+    Port *p = lookupPort(port.m_alias);
+    if (p == nullptr)
     {
-        getPort(itr->second, port);
-        return true;
+        SWSS_LOG_ERROR("Failed to get port %s to update FDB count", port.m_alias.c_str());
+        return;
     }
 
-    return false;
+    p->m_fdb_count += delta;
+    port.m_fdb_count = p->m_fdb_count;
 }
 
 bool PortsOrch::addSubPort(Port &port, const string &alias, const string &vlan, const bool &adminUp, const uint32_t &mtu)
@@ -1016,7 +1100,7 @@ bool PortsOrch::removeSubPort(const string &alias)
     }
     m_portList[parentPort.m_alias] = parentPort;
 
-    m_portList.erase(it);
+    erasePort(alias);
 
     // Restore hostif vlan tag for the parent port when the last subport is removed
     if (parentPort.m_child_ports.empty())
@@ -2620,7 +2704,14 @@ void PortsOrch::updateDbPortOperStatus(const Port& port, sai_port_oper_status_t
     vector<FieldValueTuple> tuples;
     FieldValueTuple tuple("oper_status", oper_status_strings.at(status));
     tuples.push_back(tuple);
-    m_portTable->set(port.m_alias, tuples);
+    if (m_operStatusBatch)
+    {
+        m_bufferedPortTable->set(port.m_alias, tuples);
+    }
+    else
+    {
+        m_portTable->set(port.m_alias, tuples);
+    }
 }
 
 bool PortsOrch::addPort(const set<int> &lane_set, uint32_t speed, int an, string fec_mode)
@@ -2764,7 +2855,7 @@ bool PortsOrch::initPort(const string &alias, const string &role, const int inde
 
                 /* Add port to port list */
                 m_portList[alias] = p;
-                saiOidToAlias[id] = alias;
+                mapPortOid(id, alias);
                 m_port_ref_count[alias] = 0;
                 m_portOidToIndex[id] = index;
 
@@ -2776,6 +2867,7 @@ bool PortsOrch::initPort(const string &alias, const string &role, const int inde
 
                 // Install a flex counter for this port to track stats
                 auto flex_counters_orch = gDirectory.get<FlexCounterOrch*>();
+                flex_counters_orch->refreshRateCounterObjects(COUNTERS_PORT_NAME_MAP);
                 /* Delay installing the counters if they are yet enabled
                 If they are enabled, install the counters immediately */
                 if (flex_counters_orch->getPortCountersState())
@@ -2851,6 +2943,7 @@ void PortsOrch::deInitPort(string alias, sai_object_id_t port_id)
 
     /* remove port name map from counter table */
     m_counterTable->hdel("", alias);
+    flex_counters_orch->refreshRateCounterObjects(COUNTERS_PORT_NAME_MAP);
 
     /* Remove the associated port serdes attribute */
     removePortSerdesAttribute(p.m_port_id);
@@ -3213,6 +3306,15 @@ void PortsOrch::doPortTask(Consumer &consumer)
              */
             if (m_portConfigState == PORT_CONFIG_RECEIVED || m_portConfigState == PORT_CONFIG_DONE)
             {
+                auto phase_start = std::chrono::steady_clock::now();
+                vector<pair<string, double>> phases;
+                auto end_phase = [&phase_start, &phases](const string &name)
+                {
+                    auto now = std::chrono::steady_clock::now();
+                    phases.emplace_back(name, std::chrono::duration<double, std::milli>(now - phase_start).count());
+                    phase_start = now;
+                };
+
                 for (auto it = m_portListLaneMap.begin(); it != m_portListLaneMap.end();)
                 {
                     if (m_lanesAliasSpeedMap.find(it->first) == m_lanesAliasSpeedMap.end())
@@ -3229,7 +3331,8 @@ void PortsOrch::doPortTask(Consumer &consumer)
                     }
                 }
 
-                for (auto it = m_lanesAliasSpeedMap.begin(); it != m_lanesAliasSpeedMap.end();)
+                vector<sai_object_id_t> new_port_ids;
+                for (auto it = m_lanesAliasSpeedMap.begin(); it != m_lanesAliasSpeedMap.end(); it++)
                 {
                     if (m_portListLaneMap.find(it->first) == m_portListLaneMap.end())
                     {
@@ -3239,6 +3342,20 @@ void PortsOrch::doPortTask(Consumer &consumer)
                         }
                     }
 
+                    auto port_id = m_portListLaneMap.find(it->first);
+                    const Port *port = lookupPort(get<0>(it->second));
+                    if (port_id != m_portListLaneMap.end() && (port == nullptr || port->m_port_id != port_id->second))
+                    {
+                        new_port_ids.push_back(port_id->second);
+                    }
+                }
+                end_phase("add_ports");
+
+                fetchPortQosObjects(new_port_ids);
+                end_phase("qos_objects");
+
+                for (auto it = m_lanesAliasSpeedMap.begin(); it != m_lanesAliasSpeedMap.end();)
+                {
                     if (!initPort(get<0>(it->second), get<5>(it->second), get<4>(it->second), it->first))
                     {
                         // Failure has been recorded in initPort
@@ -3250,6 +3367,13 @@ void PortsOrch::doPortTask(Consumer &consumer)
                     initPortSupportedFecModes(get<0>(it->second), m_portListLaneMap[it->first]);
                     it++;
                 }
+                m_portQosObjects.clear();
+                end_phase("init_ports");
+
+                if (!new_port_ids.empty())
+                {
+                    recordPortInitTiming(new_port_ids.size(), phases);
+                }
 
                 m_portConfigState = PORT_CONFIG_DONE;
             }
@@ -3837,8 +3961,8 @@ void PortsOrch::doPortTask(Consumer &consumer)
             removePortFromPortListMap(port_id);
 
             /* Delete port from port list */
-            m_portList.erase(alias);
-            saiOidToAlias.erase(port_id);
+            erasePort(alias);
+            unmapPortOid(port_id);
         }
         else
         {
@@ -4697,15 +4821,129 @@ void PortsOrch::initializePortBufferMaximumParameters(Port &port)
     m_stateBufferMaximumValueTable->set(port.m_alias, fvVector);
 }
 
+bool PortsOrch::getPortQosObjects(sai_object_id_t port_id, PortQosObjects &qos)
+{
+    SWSS_LOG_ENTER();
+
+    sai_attribute_t counts[3];
+    counts[0].id = SAI_PORT_ATTR_NUMBER_OF_INGRESS_PRIORITY_GROUPS;
+    counts[1].id = SAI_PORT_ATTR_QOS_NUMBER_OF_QUEUES;
+    counts[2].id = SAI_PORT_ATTR_QOS_NUMBER_OF_SCHEDULER_GROUPS;
+
+    sai_status_t status = sai_port_api->get_port_attribute(port_id, 3, counts);
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_INFO("Failed to get QoS object counts of port 0x%" PRIx64 " rv:%d", port_id, status);
+        return false;
+    }
+
+    qos.priority_group_ids.resize(counts[0].value.u32);
+    qos.queue_ids.resize(counts[1].value.u32);
+    qos.scheduler_group_ids.resize(counts[2].value.u32);
+
+    vector<sai_attribute_t> lists;
+    sai_attribute_t attr;
+
+    if (!qos.priority_group_ids.empty())
+    {
+        attr.id = SAI_PORT_ATTR_INGRESS_PRIORITY_GROUP_LIST;
+        attr.value.objlist.count = (uint32_t)qos.priority_group_ids.size();
+        attr.value.objlist.list = qos.priority_group_ids.data();
+        lists.push_back(attr);
+    }
+
+    if (!qos.queue_ids.empty())
+    {
+        attr.id = SAI_PORT_ATTR_QOS_QUEUE_LIST;
+        attr.value.objlist.count = (uint32_t)qos.queue_ids.size();
+        attr.value.objlist.list = qos.queue_ids.data();
+        lists.push_back(attr);
+    }
+
+    if (!qos.scheduler_group_ids.empty())
+    {
+        attr.id = SAI_PORT_ATTR_QOS_SCHEDULER_GROUP_LIST;
+        attr.value.objlist.count = (uint32_t)qos.scheduler_group_ids.size();
+        attr.value.objlist.list = qos.scheduler_group_ids.data();
+        lists.push_back(attr);
+    }
+
+    if (lists.empty())
+    {
+        return true;
+    }
+
+    status = sai_port_api->get_port_attribute(port_id, (uint32_t)lists.size(), lists.data());
+    if (status != SAI_STATUS_SUCCESS)
+    {
+        SWSS_LOG_INFO("Failed to get QoS object lists of port 0x%" PRIx64 " rv:%d", port_id, status);
+        return false;
+    }
+
+    return true;
+}
+
+/*
+ * Fetch the priority group, queue and scheduler group lists of all ports
+ * about to be initialized, with one get for the counts and one get for the
+ * lists of each port instead of two gets per object type. initializePort()
+ * takes the lists from here and falls back to the per type gets for ports
+ * whose combined gets failed.
+ */
+void PortsOrch::fetchPortQosObjects(const vector<sai_object_id_t> &port_ids)
+{
+    SWSS_LOG_ENTER();
+
+    for (const auto &port_id : port_ids)
+    {
+        PortQosObjects qos;
+        if (getPortQosObjects(port_id, qos))
+        {
+            m_portQosObjects[port_id] = std::move(qos);
+        }
+    }
+
+    SWSS_LOG_NOTICE("Fetched QoS objects of %zu out of %zu ports", m_portQosObjects.size(), port_ids.size());
+}
+
+void PortsOrch::recordPortInitTiming(size_t port_count, const vector<pair<string, double>> &phases)
+{
+    SWSS_LOG_ENTER();
+
+    vector<FieldValueTuple> fvs;
+    fvs.emplace_back("port_count", to_string(port_count));
+
+    for (const auto &phase : phases)
+    {
+        SWSS_LOG_NOTICE("Port initialization phase %s of %zu ports took %.3f ms",
+                phase.first.c_str(), port_count, phase.second);
+        fvs.emplace_back(phase.first + "_ms", to_string(phase.second));
+    }
+
+    Table timingTable(m_state_db.get(), STATE_PORT_INIT_TIMING_TABLE);
+    timingTable.set(PORT_INIT_TIMING_KEY, fvs);
+}
+
 bool PortsOrch::initializePort(Port &port)
 {
     SWSS_LOG_ENTER();
 
     SWSS_LOG_NOTICE("Initializing port alias:%s pid:%" PRIx64, port.m_alias.c_str(), port.m_port_id);
 
-    initializePriorityGroups(port);
-    initializeQueues(port);
-    initializeSchedulerGroups(port);
+    auto qos = m_portQosObjects.find(port.m_port_id);
+    if (qos != m_portQosObjects.end())
+    {
+        port.m_priority_group_ids = std::move(qos->second.priority_group_ids);
+        port.m_queue_ids = std::move(qos->second.queue_ids);
+        port.m_queue_lock.resize(port.m_queue_ids.size());
+        m_portQosObjects.erase(qos);
+    }
+    else
+    {
+        initializePriorityGroups(port);
+        initializeQueues(port);
+        initializeSchedulerGroups(port);
+    }
     initializePortBufferMaximumParameters(port);
 
     /* Create host interface */
@@ -4939,7 +5177,7 @@ bool PortsOrch::addBridgePort(Port &port)
         return false;
     }
     m_portList[port.m_alias] = port;
-    saiOidToAlias[port.m_bridge_port_id] = port.m_alias;
+    mapPortOid(port.m_bridge_port_id, port.m_alias);
     SWSS_LOG_NOTICE("Add bridge port %s to default 1Q bridge", port.m_alias.c_str());
 
     PortUpdate update = { port, true };
@@ -4996,7 +5234,7 @@ bool PortsOrch::removeBridgePort(Port &port)
             return parseHandleSaiStatusFailure(handle_status);
         }
     }
-    saiOidToAlias.erase(port.m_bridge_port_id);
+    unmapPortOid(port.m_bridge_port_id);
     port.m_bridge_port_id = SAI_NULL_OBJECT_ID;
 
     /* Remove bridge port */
@@ -5080,7 +5318,7 @@ bool PortsOrch::addVlan(string vlan_alias)
     vlan.m_members = set<string>();
     m_portList[vlan_alias] = vlan;
     m_port_ref_count[vlan_alias] = 0;
-    saiOidToAlias[vlan_oid] =  vlan_alias;
+    mapPortOid(vlan_oid, vlan_alias);
 
     return true;
 }
@@ -5144,8 +5382,8 @@ bool PortsOrch::removeVlan(Port vlan)
     SWSS_LOG_NOTICE("Remove VLAN %s vid:%hu", vlan.m_alias.c_str(),
             vlan.m_vlan_info.vlan_id);
 
-    saiOidToAlias.erase(vlan.m_vlan_info.vlan_oid);
-    m_portList.erase(vlan.m_alias);
+    unmapPortOid(vlan.m_vlan_info.vlan_oid);
+    erasePort(vlan.m_alias);
     m_port_ref_count.erase(vlan.m_alias);
 
     return true;
@@ -5662,7 +5900,7 @@ bool PortsOrch::addLag(string lag_alias, uint32_t spa_id, int32_t switch_id)
     lag.m_members = set<string>();
     m_portList[lag_alias] = lag;
     m_port_ref_count[lag_alias] = 0;
-    saiOidToAlias[lag_id] = lag_alias;
+    mapPortOid(lag_id, lag_alias);
 
     PortUpdate update = { lag, true };
     notify(SUBJECT_TYPE_PORT_CHANGE, static_cast<void *>(&update));
@@ -5735,8 +5973,8 @@ bool PortsOrch::removeLag(Port lag)
 
     SWSS_LOG_NOTICE("Remove LAG %s lid:%" PRIx64, lag.m_alias.c_str(), lag.m_lag_id);
 
-    saiOidToAlias.erase(lag.m_lag_id);
-    m_portList.erase(lag.m_alias);
+    unmapPortOid(lag.m_lag_id);
+    erasePort(lag.m_alias);
     m_port_ref_count.erase(lag.m_alias);
 
     PortUpdate update = { lag, false };
@@ -6041,7 +6279,7 @@ bool PortsOrch::removeTunnel(Port tunnel)
 {
     SWSS_LOG_ENTER();
 
-    m_portList.erase(tunnel.m_alias);
+    erasePort(tunnel.m_alias);
 
     return true;
 }
@@ -6578,6 +6816,8 @@ void PortsOrch::doTask(NotificationConsumer &consumer)
 
         sai_deserialize_port_oper_status_ntf(data, count, &portoperstatus);
 
+        bool coalescing = !m_pendingOperStatus.empty();
+
         for (uint32_t i = 0; i < count; i++)
         {
             sai_object_id_t id = portoperstatus[i].port_id;
@@ -6585,34 +6825,85 @@ void PortsOrch::doTask(NotificationConsumer &consumer)
 
             SWSS_LOG_NOTICE("Get port state change notification id:%" PRIx64 " status:%d", id, status);
 
-            Port port;
-
-            if (!getPort(id, port))
+            Port *p = lookupPort(id);
+            if (p == nullptr)
             {
                 SWSS_LOG_NOTICE("Got port state change for port id 0x%" PRIx64 " which does not exist, possibly outdated event", id);
                 continue;
             }
 
-            updatePortOperStatus(port, status);
-            if (status == SAI_PORT_OPER_STATUS_UP)
+            /* A later status of the same port replaces the pending one */
+            m_pendingOperStatus[id] = status;
+        }
+
+        sai_deserialize_free_port_oper_status_ntf(count, portoperstatus);
+
+        if (m_operStatusCoalesceTimer == nullptr)
+        {
+            processPendingOperStatus();
+        }
+        else if (!coalescing && !m_pendingOperStatus.empty())
+        {
+            /* The window starts at the first pending status, restarting it would delay the batch */
+            m_operStatusCoalesceTimer->start();
+        }
+    }
+}
+
+void PortsOrch::processPendingOperStatus()
+{
+    SWSS_LOG_ENTER();
+
+    if (m_pendingOperStatus.empty())
+    {
+        return;
+    }
+
+    map<sai_object_id_t, sai_port_oper_status_t> pending;
+    pending.swap(m_pendingOperStatus);
+
+    m_operStatusBatch = true;
+
+    for (const auto &it : pending)
+    {
+        sai_object_id_t id = it.first;
+        sai_port_oper_status_t status = it.second;
+
+        Port *p = lookupPort(id);
+        if (p == nullptr)
+        {
+            SWSS_LOG_NOTICE("Got port state change for port id 0x%" PRIx64 " which does not exist, possibly outdated event", id);
+            continue;
+        }
+
+        /* Update the port in place, observers notified below see the new state */
+        Port &port = *p;
+        updatePortOperStatus(port, status);
+        if (status == SAI_PORT_OPER_STATUS_UP)
+        {
+            sai_uint32_t speed;
+            if (getPortOperSpeed(port, speed))
             {
-                sai_uint32_t speed;
-                if (getPortOperSpeed(port, speed))
-                {
-                    SWSS_LOG_NOTICE("%s oper speed is %d", port.m_alias.c_str(), speed);
-                    updateDbPortOperSpeed(port, speed);
-                }
-                else
-                {
-                    updateDbPortOperSpeed(port, 0);
-                }
+                SWSS_LOG_NOTICE("%s oper speed is %d", port.m_alias.c_str(), speed);
+                updateDbPortOperSpeed(port, speed);
+            }
+            else
+            {
+                updateDbPortOperSpeed(port, 0);
             }
-
-            /* update m_portList */
-            m_portList[port.m_alias] = port;
         }
+    }
 
-        sai_deserialize_free_port_oper_status_ntf(count, portoperstatus);
+    m_operStatusBatch = false;
+
+    m_applPipeline->flush();
+    m_statePipeline->flush();
+
+    if (!m_operStateUpdates.empty())
+    {
+        PortOperStateUpdates updates;
+        updates.updates.swap(m_operStateUpdates);
+        notify(SUBJECT_TYPE_PORT_OPER_STATE_CHANGE, static_cast<void *>(&updates));
     }
 }
 
@@ -6672,7 +6963,15 @@ void PortsOrch::updatePortOperStatus(Port &port, sai_port_oper_status_t status)
     }
 
     PortOperStateUpdate update = {port, status};
-    notify(SUBJECT_TYPE_PORT_OPER_STATE_CHANGE, static_cast<void *>(&update));
+    if (m_operStatusBatch)
+    {
+        m_operStateUpdates.push_back(update);
+        return;
+    }
+
+    PortOperStateUpdates updates;
+    updates.updates.push_back(update);
+    notify(SUBJECT_TYPE_PORT_OPER_STATE_CHANGE, static_cast<void *>(&updates));
 }
 
 void PortsOrch::updateDbPortOperSpeed(Port &port, sai_uint32_t speed)
@@ -6682,7 +6981,14 @@ void PortsOrch::updateDbPortOperSpeed(Port &port, sai_uint32_t speed)
     vector<FieldValueTuple> tuples;
     string speedStr = speed != 0 ? to_string(speed) : "N/A";
     tuples.emplace_back(std::make_pair("speed", speedStr));
-    m_portStateTable.set(port.m_alias, tuples);
+    if (m_operStatusBatch)
+    {
+        m_bufferedPortStateTable->set(port.m_alias, tuples);
+    }
+    else
+    {
+        m_portStateTable.set(port.m_alias, tuples);
+    }
 
     // We don't set port.m_speed = speed here, because CONFIG_DB still hold the old
     // value. If we set it here, next time configure any attributes related port will
@@ -7382,8 +7688,8 @@ bool PortsOrch::initGearboxPort(Port &port)
             SWSS_LOG_NOTICE("BOX: Connected Gearbox ports; system-side:0x%" PRIx64 " to line-side:0x%" PRIx64, systemPort, linePort);
             m_gearboxPortListLaneMap[port.m_port_id] = make_tuple(systemPort, linePort);
             port.m_line_side_id = linePort;
-            saiOidToAlias[systemPort] = port.m_alias;
-            saiOidToAlias[linePort] = port.m_alias;
+            mapPortOid(systemPort, port.m_alias);
+            mapPortOid(linePort, port.m_alias);
 
             /* Add gearbox system/line port name map to counter table */
             FieldValueTuple tuple(port.m_alias + "_system", sai_serialize_object_id(systemPort));
@@ -8012,6 +8318,13 @@ void PortsOrch::updatePortStatePoll(const Port &port, port_state_poll_t type, bo
 
 void PortsOrch::doTask(swss::SelectableTimer &timer)
 {
+    if (&timer == m_operStatusCoalesceTimer)
+    {
+        m_operStatusCoalesceTimer->stop();
+        processPendingOperStatus();
+        return;
+    }
+
     Port port;
 
     for (auto it = m_port_state_poll.begin(); it != m_port_state_poll.end(); )
@@ -9,6 +9,7 @@
 #include "observer.h"
 #include "macaddress.h"
 #include "producertable.h"
+#include "redispipeline.h"
 #include "flex_counter_manager.h"
 #include "gearboxutils.h"
 #include "saihelper.h"
@@ -61,6 +62,12 @@ struct PortOperStateUpdate
     sai_port_oper_status_t operStatus;
 };
 
+/* Oper state changes of one or more ports, notified together */
+struct PortOperStateUpdates
+{
+    vector<PortOperStateUpdate> updates;
+};
+
 struct LagMemberUpdate
 {
     Port lag;
@@ -97,6 +104,12 @@ public:
     void decreasePortRefCount(const string &alias);
     bool getPortByBridgePortId(sai_object_id_t bridge_port_id, Port &port);
     void setPort(string alias, Port port);
+    /* Copy-free lookups, the returned port is valid until it is removed */
+    const Port *findPort(const string &alias);
+    const Port *findPort(sai_object_id_t id);
+    const Port *findPortByBridgePortId(sai_object_id_t bridge_port_id);
+    /* Adjust the FDB entry count of the stored port, port gets the new count */
+    void updateFdbCount(Port &port, int delta);
     void getCpuPort(Port &port);
     void initHostTxReadyState(Port &port);
     bool getInbandPort(Port &port);
@@ -267,6 +280,8 @@ private:
      * coming from SAI
      */
     unordered_map<sai_object_id_t, string> saiOidToAlias;
+    /* Ports resolved through saiOidToAlias, entries of m_portList never move */
+    unordered_map<sai_object_id_t, Port *> m_portOidCache;
     unordered_map<sai_object_id_t, int> m_portOidToIndex;
     map<string, uint32_t> m_port_ref_count;
     unordered_set<string> m_pendingPortSet;
@@ -279,6 +294,23 @@ private:
 
     swss::SelectableTimer *m_port_state_poller = nullptr;
 
+    /*
+     * Port oper status notifications are coalesced to the last status of each
+     * port over gPortOperStatusCoalesceMs, then processed as one batch whose
+     * DB writes go through the pipelines and whose observer updates are
+     * notified together.
+     */
+    map<sai_object_id_t, sai_port_oper_status_t> m_pendingOperStatus;
+    swss::SelectableTimer *m_operStatusCoalesceTimer = nullptr;
+    bool m_operStatusBatch = false;
+    vector<PortOperStateUpdate> m_operStateUpdates;
+    unique_ptr<RedisPipeline> m_applPipeline;
+    unique_ptr<RedisPipeline> m_statePipeline;
+    unique_ptr<Table> m_bufferedPortTable;
+    unique_ptr<Table> m_bufferedPortStateTable;
+
+    void processPendingOperStatus();
+
     void doTask() override;
     void doTask(Consumer &consumer);
     void doPortTask(Consumer &consumer);
@@ -295,6 +327,19 @@ private:
     void removeDefaultVlanMembers();
     void removeDefaultBridgePorts();
 
+    /* QoS object lists of a port fetched ahead of its initialization */
+    struct PortQosObjects
+    {
+        vector<sai_object_id_t> priority_group_ids;
+        vector<sai_object_id_t> queue_ids;
+        vector<sai_object_id_t> scheduler_group_ids;
+    };
+    unordered_map<sai_object_id_t, PortQosObjects> m_portQosObjects;
+
+    void fetchPortQosObjects(const vector<sai_object_id_t> &port_ids);
+    bool getPortQosObjects(sai_object_id_t port_id, PortQosObjects &qos);
+    void recordPortInitTiming(size_t port_count, const vector<pair<string, double>> &phases);
+
     bool initializePort(Port &port);
     void initializePriorityGroups(Port &port);
     void initializePortBufferMaximumParameters(Port &port);
@@ -323,6 +368,12 @@ private:
     bool initPort(const string &alias, const string &role, const int index, const set<int> &lane_set);
     void deInitPort(string alias, sai_object_id_t port_id);
 
+    Port *lookupPort(const string &alias);
+    Port *lookupPort(sai_object_id_t id);
+    void mapPortOid(sai_object_id_t id, const string &alias);
+    void unmapPortOid(sai_object_id_t id);
+    void erasePort(const string &alias);
+
     void initPortCapAutoNeg(Port &port);
     void initPortCapLinkTraining(Port &port);
 
@@ -0,0 +1,642 @@
+#ifndef SWSS_PREFIXTABLE_H
+#define SWSS_PREFIXTABLE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <sys/socket.h>
+
+#include "ipaddress.h"
+#include "ipprefix.h"
+
+/* Number of nodes in the first pool chunk, chunks double up to the maximum */
+#define PREFIX_TABLE_MIN_CHUNK  16
+#define PREFIX_TABLE_MAX_CHUNK  4096
+
+/*
+ * Map from IP prefix to T stored as a path-compressed binary trie, one trie
+ * per address family.
+ *
+ * Besides exact match it supports longest prefix match of an address, a walk
+ * over all prefixes covering an address and a walk over all prefixes within a
+ * subnet, which are the queries std::map<IpPrefix, T> could only answer with
+ * a full scan.
+ *
+ * Iteration follows the order of std::map<IpPrefix, T>: IPv4 before IPv6,
+ * then by network address and by mask length. Prefixes are keyed by their
+ * network address, host bits are ignored.
+ *
+ * Nodes are carved from chunks owned by the table and recycled through a free
+ * list. Iterators and references stay valid until their own entry is erased.
+ */
+template <typename T>
+class PrefixTable
+{
+public:
+    typedef swss::IpPrefix key_type;
+    typedef T mapped_type;
+    typedef std::pair<const swss::IpPrefix, T> value_type;
+
+private:
+    struct Node
+    {
+        uint8_t bits[16];
+        uint8_t len;
+        bool has_value;
+        Node *parent;
+        Node *child[2];
+        typename std::aligned_storage<sizeof(value_type), alignof(value_type)>::type storage;
+
+        value_type *value()
+        {
+            return reinterpret_cast<value_type *>(&storage);
+        }
+    };
+
+    struct Key
+    {
+        uint8_t bits[16];
+        uint8_t len;
+        int family;
+    };
+
+    template <typename V, typename N>
+    class Iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef V value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef V *pointer;
+        typedef V &reference;
+
+        Iterator() = default;
+        Iterator(N *node, const PrefixTable *table) : m_node(node), m_table(table) {}
+
+        /* iterator converts to const_iterator */
+        template <typename V2, typename N2>
+        Iterator(const Iterator<V2, N2> &o) : m_node(o.m_node), m_table(o.m_table) {}
+
+        reference operator*() const { return *m_node->value(); }
+        pointer operator->() const { return m_node->value(); }
+
+        Iterator &operator++()
+        {
+            m_node = m_table->nextValue(m_node);
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator it = *this;
+            ++*this;
+            return it;
+        }
+
+        bool operator==(const Iterator &o) const { return m_node == o.m_node; }
+        bool operator!=(const Iterator &o) const { return m_node != o.m_node; }
+
+    private:
+        template <typename, typename> friend class Iterator;
+        friend class PrefixTable;
+
+        N *m_node = nullptr;
+        const PrefixTable *m_table = nullptr;
+    };
+
+public:
+    typedef Iterator<value_type, Node> iterator;
+    typedef Iterator<const value_type, Node> const_iterator;
+
+    PrefixTable() = default;
+
+    PrefixTable(const PrefixTable &o)
+    {
+        for (const auto &entry : o)
+        {
+            emplace(entry.first, entry.second);
+        }
+    }
+
+    PrefixTable(PrefixTable &&o) noexcept
+    {
+        swap(o);
+    }
+
+    PrefixTable &operator=(PrefixTable o)
+    {
+        swap(o);
+        return *this;
+    }
+
+    ~PrefixTable()
+    {
+        clear();
+    }
+
+    void swap(PrefixTable &o) noexcept
+    {
+        std::swap(m_root[0], o.m_root[0]);
+        std::swap(m_root[1], o.m_root[1]);
+        std::swap(m_size, o.m_size);
+        std::swap(m_chunks, o.m_chunks);
+        std::swap(m_free, o.m_free);
+        std::swap(m_chunkSize, o.m_chunkSize);
+    }
+
+    iterator begin() { return iterator(firstValue(), this); }
+    iterator end() { return iterator(nullptr, this); }
+    const_iterator begin() const { return const_iterator(firstValue(), this); }
+    const_iterator end() const { return const_iterator(nullptr, this); }
+
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+
+    iterator find(const swss::IpPrefix &prefix)
+    {
+        return iterator(findNode(makeKey(prefix)), this);
+    }
+
+    const_iterator find(const swss::IpPrefix &prefix) const
+    {
+        return const_iterator(findNode(makeKey(prefix)), this);
+    }
+
+    size_t count(const swss::IpPrefix &prefix) const
+    {
+        return findNode(makeKey(prefix)) ? 1 : 0;
+    }
+
+    T &at(const swss::IpPrefix &prefix)
+    {
+        Node *node = findNode(makeKey(prefix));
+        if (!node)
+        {
+            throw std::out_of_range("PrefixTable::at");
+        }
+        return node->value()->second;
+    }
+
+    const T &at(const swss::IpPrefix &prefix) const
+    {
+        return const_cast<PrefixTable *>(this)->at(prefix);
+    }
+
+    T &operator[](const swss::IpPrefix &prefix)
+    {
+        return emplace(prefix).first->second;
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(const swss::IpPrefix &prefix, Args&&... args)
+    {
+        Node *node = insertNode(makeKey(prefix));
+        if (node->has_value)
+        {
+            return std::make_pair(iterator(node, this), false);
+        }
+
+        try
+        {
+            new (node->value()) value_type(std::piecewise_construct,
+                                           std::forward_as_tuple(prefix),
+                                           std::forward_as_tuple(std::forward<Args>(args)...));
+        }
+        catch (...)
+        {
+            prune(node);
+            throw;
+        }
+
+        node->has_value = true;
+        m_size++;
+        return std::make_pair(iterator(node, this), true);
+    }
+
+    iterator erase(const_iterator it)
+    {
+        Node *node = it.m_node;
+        Node *next = nextValue(node);
+
+        node->value()->~value_type();
+        node->has_value = false;
+        m_size--;
+        prune(node);
+
+        return iterator(next, this);
+    }
+
+    size_t erase(const swss::IpPrefix &prefix)
+    {
+        Node *node = findNode(makeKey(prefix));
+        if (!node)
+        {
+            return 0;
+        }
+        erase(const_iterator(node, this));
+        return 1;
+    }
+
+    void clear()
+    {
+        for (Node *root : m_root)
+        {
+            for (Node *node = root; node; node = nextNode(node, root))
+            {
+                if (node->has_value)
+                {
+                    node->value()->~value_type();
+                }
+            }
+        }
+
+        m_root[0] = m_root[1] = nullptr;
+        m_size = 0;
+        m_chunks.clear();
+        m_free = nullptr;
+        m_chunkSize = PREFIX_TABLE_MIN_CHUNK;
+    }
+
+    /* Entry with the longest prefix covering ip, end() if none */
+    iterator longestMatch(const swss::IpAddress &ip)
+    {
+        Node *best = nullptr;
+        walkCovering(makeKey(ip), [&](Node *node) { best = node; });
+        return iterator(best, this);
+    }
+
+    const_iterator longestMatch(const swss::IpAddress &ip) const
+    {
+        return const_cast<PrefixTable *>(this)->longestMatch(ip);
+    }
+
+    /* Call f on every entry whose prefix covers ip, shortest prefix first */
+    template <typename F>
+    void forEachMatch(const swss::IpAddress &ip, F f)
+    {
+        walkCovering(makeKey(ip), [&](Node *node) { f(*node->value()); });
+    }
+
+    /* Call f on every entry whose prefix lies within subnet, in table order,
+     * until f returns false */
+    template <typename F>
+    void forEachInSubnet(const swss::IpPrefix &subnet, F f)
+    {
+        Key key = makeKey(subnet);
+        Node *top = m_root[key.family];
+
+        while (top && top->len < key.len)
+        {
+            if (!matches(top->bits, key.bits, top->len))
+            {
+                return;
+            }
+            top = top->child[bit(key.bits, top->len)];
+        }
+
+        if (!top || !matches(top->bits, key.bits, key.len))
+        {
+            return;
+        }
+
+        for (Node *node = top; node; node = nextNode(node, top))
+        {
+            if (node->has_value && !f(*node->value()))
+            {
+                return;
+            }
+        }
+    }
+
+    template <typename F>
+    void forEachMatch(const swss::IpAddress &ip, F f) const
+    {
+        const_cast<PrefixTable *>(this)->forEachMatch(ip, [&](const value_type &entry) { f(entry); });
+    }
+
+    template <typename F>
+    void forEachInSubnet(const swss::IpPrefix &subnet, F f) const
+    {
+        const_cast<PrefixTable *>(this)->forEachInSubnet(subnet, [&](const value_type &entry) { return f(entry); });
+    }
+
+private:
+    Node *m_root[2] = { nullptr, nullptr };
+    size_t m_size = 0;
+
+    std::vector<std::unique_ptr<Node[]>> m_chunks;
+    Node *m_free = nullptr;
+    size_t m_chunkSize = PREFIX_TABLE_MIN_CHUNK;
+
+    static int bit(const uint8_t *bits, uint8_t pos)
+    {
+        return (bits[pos >> 3] >> (7 - (pos & 7))) & 1;
+    }
+
+    static bool matches(const uint8_t *a, const uint8_t *b, uint8_t len)
+    {
+        return commonLength(a, b, len) == len;
+    }
+
+    /* Number of leading bits a and b have in common, at most len */
+    static uint8_t commonLength(const uint8_t *a, const uint8_t *b, uint8_t len)
+    {
+        uint8_t pos = 0;
+        while (pos < len)
+        {
+            uint8_t diff = static_cast<uint8_t>(a[pos >> 3] ^ b[pos >> 3]);
+            if (diff == 0)
+            {
+                pos = static_cast<uint8_t>(pos + 8);
+                continue;
+            }
+            while (!(diff & 0x80))
+            {
+                diff = static_cast<uint8_t>(diff << 1);
+                pos++;
+            }
+            break;
+        }
+        return pos < len ? pos : len;
+    }
+
+    static void maskBits(uint8_t *bits, uint8_t len)
+    {
+        for (int i = 0; i < 16; i++)
+        {
+            int keep = len - i * 8;
+            if (keep <= 0)
+            {
+                bits[i] = 0;
+            }
+            else if (keep < 8)
+            {
+                bits[i] = static_cast<uint8_t>(bits[i] & (0xff << (8 - keep)));
+            }
+        }
+    }
+
+    static Key makeKey(const swss::IpAddress &ip, int len = -1)
+    {
+        Key key;
+        ip_addr_t addr = ip.getIp();
+
+        memset(key.bits, 0, sizeof(key.bits));
+        if (addr.family == AF_INET)
+        {
+            memcpy(key.bits, &addr.ip_addr.ipv4_addr, 4);
+            key.family = 0;
+            key.len = static_cast<uint8_t>(len < 0 ? 32 : len);
+        }
+        else
+        {
+            memcpy(key.bits, addr.ip_addr.ipv6_addr, 16);
+            key.family = 1;
+            key.len = static_cast<uint8_t>(len < 0 ? 128 : len);
+        }
+        maskBits(key.bits, key.len);
+
+        return key;
+    }
+
+    static Key makeKey(const swss::IpPrefix &prefix)
+    {
+        return makeKey(prefix.getIp(), prefix.getMaskLength());
+    }
+
+    Node *allocate(const uint8_t *bits, uint8_t len, Node *parent)
+    {
+        if (!m_free)
+        {
+            std::unique_ptr<Node[]> chunk(new Node[m_chunkSize]);
+            for (size_t i = 0; i < m_chunkSize; i++)
+            {
+                chunk[i].parent = m_free;
+                m_free = &chunk[i];
+            }
+            m_chunks.push_back(std::move(chunk));
+            if (m_chunkSize < PREFIX_TABLE_MAX_CHUNK)
+            {
+                m_chunkSize *= 2;
+            }
+        }
+
+        Node *node = m_free;
+        m_free = node->parent;
+
+        memcpy(node->bits, bits, sizeof(node->bits));
+        maskBits(node->bits, len);
+        node->len = len;
+        node->has_value = false;
+        node->parent = parent;
+        node->child[0] = node->child[1] = nullptr;
+
+        return node;
+    }
+
+    void release(Node *node)
+    {
+        node->parent = m_free;
+        m_free = node;
+    }
+
+    Node **linkOf(Node *node)
+    {
+        if (!node->parent)
+        {
+            return m_root[0] == node ? &m_root[0] : &m_root[1];
+        }
+        return node->parent->child[0] == node ? &node->parent->child[0] : &node->parent->child[1];
+    }
+
+    Node *findNode(const Key &key) const
+    {
+        Node *node = m_root[key.family];
+        while (node && node->len <= key.len && matches(node->bits, key.bits, node->len))
+        {
+            if (node->len == key.len)
+            {
+                return node->has_value ? node : nullptr;
+            }
+            node = node->child[bit(key.bits, node->len)];
+        }
+        return nullptr;
+    }
+
+    /* Node holding key, created with no value if the trie has none */
+    Node *insertNode(const Key &key)
+    {
+        Node **link = &m_root[key.family];
+        Node *parent = nullptr;
+
+        while (true)
+        {
+            Node *node = *link;
+            if (!node)
+            {
+                *link = allocate(key.bits, key.len, parent);
+                return *link;
+            }
+
+            uint8_t common = commonLength(node->bits, key.bits, std::min(node->len, key.len));
+            if (common == node->len)
+            {
+                if (node->len == key.len)
+                {
+                    return node;
+                }
+                parent = node;
+                link = &node->child[bit(key.bits, node->len)];
+                continue;
+            }
+
+            Node *branch;
+            Node *leaf;
+            if (common == key.len)
+            {
+                /* key covers node, it takes node's place */
+                branch = allocate(key.bits, key.len, parent);
+                leaf = branch;
+            }
+            else
+            {
+                /* key and node diverge at bit common */
+                branch = allocate(key.bits, common, parent);
+                leaf = allocate(key.bits, key.len, branch);
+                branch->child[bit(key.bits, common)] = leaf;
+            }
+            branch->child[bit(node->bits, common)] = node;
+            node->parent = branch;
+            *link = branch;
+
+            return leaf;
+        }
+    }
+
+    /* Remove node and its valueless ancestors that no longer join two subtrees */
+    void prune(Node *node)
+    {
+        while (node && !node->has_value)
+        {
+            if (node->child[0] && node->child[1])
+            {
+                return;
+            }
+
+            Node *child = node->child[0] ? node->child[0] : node->child[1];
+            Node *parent = node->parent;
+
+            *linkOf(node) = child;
+            release(node);
+            if (child)
+            {
+                child->parent = parent;
+                return;
+            }
+
+            node = parent;
+        }
+    }
+
+    /* Pre-order successor of node within the subtree rooted at top */
+    static Node *nextNode(Node *node, const Node *top)
+    {
+        if (node->child[0])
+        {
+            return node->child[0];
+        }
+        if (node->child[1])
+        {
+            return node->child[1];
+        }
+
+        while (node != top)
+        {
+            Node *parent = node->parent;
+            if (parent->child[0] == node && parent->child[1])
+            {
+                return parent->child[1];
+            }
+            node = parent;
+        }
+        return nullptr;
+    }
+
+    Node *firstValue() const
+    {
+        Node *root = m_root[0] ? m_root[0] : m_root[1];
+        if (!root || root->has_value)
+        {
+            return root;
+        }
+        return nextValue(root);
+    }
+
+    /* Next node holding a value in table order, IPv6 entries follow the IPv4 ones */
+    Node *nextValue(Node *node) const
+    {
+        while (true)
+        {
+            if (node->child[0])
+            {
+                node = node->child[0];
+            }
+            else if (node->child[1])
+            {
+                node = node->child[1];
+            }
+            else
+            {
+                while (node->parent && !(node->parent->child[0] == node && node->parent->child[1]))
+                {
+                    node = node->parent;
+                }
+
+                if (node->parent)
+                {
+                    node = node->parent->child[1];
+                }
+                else if (node == m_root[0] && m_root[1])
+                {
+                    node = m_root[1];
+                }
+                else
+                {
+                    return nullptr;
+                }
+            }
+
+            if (node->has_value)
+            {
+                return node;
+            }
+        }
+    }
+
+    template <typename F>
+    void walkCovering(const Key &key, F f)
+    {
+        Node *node = m_root[key.family];
+        while (node && node->len <= key.len && matches(node->bits, key.bits, node->len))
+        {
+            if (node->has_value)
+            {
+                f(node);
+            }
+            if (node->len == key.len)
+            {
+                break;
+            }
+            node = node->child[bit(key.bits, node->len)];
+        }
+    }
+};
+
+#endif /* SWSS_PREFIXTABLE_H */
@@ -0,0 +1,23 @@
+-- KEYS - counter IDs
+-- ARGV[1] - counters db index
+-- ARGV[2] - counters table name
+-- ARGV[3] - poll time interval
+-- rate_type - counter type (PORT, RIF, ...), defined by orchagent ahead of this script
+-- return log
+
+-- The rates are computed by orchagent, this only records the time of the poll
+-- in milliseconds for it to compute the rates over
+
+local logtable = {}
+
+local counters_db = ARGV[1]
+local rates_table_name = "RATES"
+
+redis.replicate_commands()
+local now = redis.call('TIME')
+local poll_time = now[1] * 1000 + math.floor(now[2] / 1000)
+
+redis.call('SELECT', counters_db)
+redis.call('HSET', rates_table_name .. ':' .. rate_type, rate_type .. '_POLL_TIME', string.format('%.0f', poll_time))
+
+return logtable
@@ -90,10 +90,53 @@ void RecordResponse(const std::string &response_channel, const std::string &key,
 
 } // namespace
 
-ResponsePublisher::ResponsePublisher() : m_db("APPL_STATE_DB", 0)
+ResponsePublisher::ResponsePublisher(bool buffered) : m_db("APPL_STATE_DB", 0), m_buffered(buffered)
 {
 }
 
+swss::RedisPipeline *ResponsePublisher::getPipeline()
+{
+    if (!m_pipe)
+    {
+        m_pipe = std::make_unique<swss::RedisPipeline>(&m_db);
+    }
+    return m_pipe.get();
+}
+
+swss::Table *ResponsePublisher::getTable(const std::string &table)
+{
+    auto it = m_tables.find(table);
+    if (it != m_tables.end())
+    {
+        return it->second.get();
+    }
+
+    auto tbl = std::make_unique<swss::Table>(getPipeline(), table, true);
+
+    std::vector<std::string> keys;
+    tbl->getKeys(keys);
+    m_keys[table] = std::unordered_set<std::string>(keys.begin(), keys.end());
+
+    return (m_tables[table] = std::move(tbl)).get();
+}
+
+void ResponsePublisher::flush()
+{
+    if (m_pipe)
+    {
+        m_pipe->flush();
+    }
+}
+
+void ResponsePublisher::setBuffered(bool buffered)
+{
+    m_buffered = buffered;
+    if (!m_buffered)
+    {
+        flush();
+    }
+}
+
 void ResponsePublisher::publish(const std::string &table, const std::string &key,
                                 const std::vector<swss::FieldValueTuple> &intent_attrs, const ReturnCode &status,
                                 const std::vector<swss::FieldValueTuple> &state_attrs, bool replace)
@@ -109,7 +152,7 @@ void ResponsePublisher::publish(const std::string &table, const std::string &key
     std::string response_channel = "APPL_DB_" + table + "_RESPONSE_CHANNEL";
     if (m_notifiers.find(table) == m_notifiers.end())
     {
-        m_notifiers[table] = std::make_unique<swss::NotificationProducer>(&m_db, response_channel);
+        m_notifiers[table] = std::make_unique<swss::NotificationProducer>(getPipeline(), response_channel, true);
     }
 
     auto intent_attrs_copy = intent_attrs;
@@ -119,6 +162,11 @@ void ResponsePublisher::publish(const std::string &table, const std::string &key
     // Sends the response to the notification channel.
     m_notifiers[table]->send(status.codeStr(), key, intent_attrs_copy);
     RecordResponse(response_channel, key, intent_attrs_copy, status.codeStr());
+
+    if (!m_buffered)
+    {
+        flush();
+    }
 }
 
 void ResponsePublisher::publish(const std::string &table, const std::string &key,
@@ -140,17 +188,16 @@ void ResponsePublisher::publish(const std::string &table, const std::string &key
 void ResponsePublisher::writeToDB(const std::string &table, const std::string &key,
                                   const std::vector<swss::FieldValueTuple> &values, const std::string &op, bool replace)
 {
-    if (m_tables.find(table) == m_tables.end())
-    {
-        m_tables[table] = std::make_unique<swss::Table>(&m_db, table);
-    }
+    auto *tbl = getTable(table);
+    auto &keys = m_keys[table];
 
     auto attrs = values;
     if (op == SET_COMMAND)
     {
         if (replace)
         {
-            m_tables[table]->del(key);
+            tbl->del(key);
+            keys.erase(key);
         }
         if (!values.size())
         {
@@ -159,33 +206,40 @@ void ResponsePublisher::writeToDB(const std::string &table, const std::string &k
 
         // Write to DB only if the key does not exist or non-NULL attributes are
         // being written to the entry.
-        std::vector<swss::FieldValueTuple> fv;
-        if (!m_tables[table]->get(key, fv))
+        if (keys.insert(key).second)
         {
-            m_tables[table]->set(key, attrs);
+            tbl->set(key, attrs);
             RecordDBWrite(table, key, attrs, op);
-            return;
         }
-        for (auto it = attrs.cbegin(); it != attrs.cend();)
+        else
         {
-            if (it->first == "NULL")
+            for (auto it = attrs.cbegin(); it != attrs.cend();)
             {
-                it = attrs.erase(it);
+                if (it->first == "NULL")
+                {
+                    it = attrs.erase(it);
+                }
+                else
+                {
+                    it++;
+                }
             }
-            else
+            if (attrs.size())
             {
-                it++;
+                tbl->set(key, attrs);
+                RecordDBWrite(table, key, attrs, op);
             }
         }
-        if (attrs.size())
-        {
-            m_tables[table]->set(key, attrs);
-            RecordDBWrite(table, key, attrs, op);
-        }
     }
     else if (op == DEL_COMMAND)
     {
-        m_tables[table]->del(key);
+        tbl->del(key);
+        keys.erase(key);
         RecordDBWrite(table, key, {}, op);
     }
+
+    if (!m_buffered)
+    {
+        flush();
+    }
 }
@@ -3,20 +3,26 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "dbconnector.h"
 #include "notificationproducer.h"
+#include "redispipeline.h"
 #include "response_publisher_interface.h"
 #include "table.h"
 
 // This class performs two tasks when publish is called:
 // 1. Sends a notification into the redis channel.
 // 2. Writes the operation into the DB.
+//
+// Notifications and DB writes go through a redis pipeline. In buffered mode
+// they are only sent on flush(), which the owning Orch calls after each drain
+// of its consumers, so all responses of a drain cost a single round trip.
 class ResponsePublisher : public ResponsePublisherInterface
 {
   public:
-    explicit ResponsePublisher();
+    explicit ResponsePublisher(bool buffered = false);
     virtual ~ResponsePublisher() = default;
 
     // Intent attributes are the attributes sent in the notification into the
@@ -42,10 +48,25 @@ class ResponsePublisher : public ResponsePublisherInterface
     void writeToDB(const std::string &table, const std::string &key, const std::vector<swss::FieldValueTuple> &values,
                    const std::string &op, bool replace = false) override;
 
+    // Sends the buffered notifications and DB writes.
+    void flush();
+
+    void setBuffered(bool buffered);
+
   private:
+    swss::RedisPipeline *getPipeline();
+    swss::Table *getTable(const std::string &table);
+
     swss::DBConnector m_db;
+    // Created on first use, most Orchs never publish responses.
+    std::unique_ptr<swss::RedisPipeline> m_pipe;
+    bool m_buffered;
     // Maps table names to tables.
     std::unordered_map<std::string, std::unique_ptr<swss::Table>> m_tables;
+    // Maps table names to the keys present in the DB. Loaded when the table is
+    // first written, then kept up to date by writeToDB() which replaces reading
+    // the entry back before each write.
+    std::unordered_map<std::string, std::unordered_set<std::string>> m_keys;
     // Maps table names to notifiers.
     std::unordered_map<std::string, std::unique_ptr<swss::NotificationProducer>> m_notifiers;
 };
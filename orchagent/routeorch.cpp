@@ -266,29 +266,27 @@ void RouteOrch::attach(Observer *observer, const IpAddress& dstAddr, sai_object_
 {
     SWSS_LOG_ENTER();
 
-    Host host = std::make_pair(vrf_id, dstAddr);
-    auto observerEntry = m_nextHopObservers.find(host);
+    auto &hosts = m_nextHopObservers[vrf_id];
+    IpPrefix host(dstAddr.to_string());
+    auto observerEntry = hosts.find(host);
 
     /* Create a new observer entry if no current observer is observing this
      * IP address */
-    if (observerEntry == m_nextHopObservers.end())
+    if (observerEntry == hosts.end())
     {
-        m_nextHopObservers.emplace(host, NextHopObserverEntry());
-        observerEntry = m_nextHopObservers.find(host);
+        observerEntry = hosts.emplace(host, NextHopObserverEntry()).first;
 
         /* Find the prefixes that cover the destination IP */
-        if (m_syncdRoutes.find(vrf_id) != m_syncdRoutes.end())
+        auto route_table = m_syncdRoutes.find(vrf_id);
+        if (route_table != m_syncdRoutes.end())
         {
-            for (auto route : m_syncdRoutes.at(vrf_id))
+            route_table->second.forEachMatch(dstAddr, [&](const RouteTable::value_type &route)
             {
-                if (route.first.isAddressInSubnet(dstAddr))
-                {
-                    SWSS_LOG_INFO("Prefix %s covers destination address",
-                            route.first.to_string().c_str());
-                    observerEntry->second.routeTable.emplace(
-                            route.first, route.second);
-                }
-            }
+                SWSS_LOG_INFO("Prefix %s covers destination address",
+                        route.first.to_string().c_str());
+                observerEntry->second.routeTable.emplace(
+                        route.first, route.second);
+            });
         }
     }
 
@@ -311,9 +309,14 @@ void RouteOrch::detach(Observer *observer, const IpAddress& dstAddr, sai_object_
 {
     SWSS_LOG_ENTER();
 
-    auto observerEntry = m_nextHopObservers.find(std::make_pair(vrf_id, dstAddr));
+    auto hosts = m_nextHopObservers.find(vrf_id);
+    HostObserverTable::iterator observerEntry;
+    if (hosts != m_nextHopObservers.end())
+    {
+        observerEntry = hosts->second.find(IpPrefix(dstAddr.to_string()));
+    }
 
-    if (observerEntry == m_nextHopObservers.end())
+    if (hosts == m_nextHopObservers.end() || observerEntry == hosts->second.end())
     {
         SWSS_LOG_ERROR("Failed to locate observer for destination IP %s",
                 dstAddr.to_string().c_str());
@@ -336,7 +339,11 @@ void RouteOrch::detach(Observer *observer, const IpAddress& dstAddr, sai_object_
             // destination IP.
             if (observerEntry->second.observers.empty())
             {
-                m_nextHopObservers.erase(observerEntry);
+                hosts->second.erase(observerEntry);
+                if (hosts->second.empty())
+                {
+                    m_nextHopObservers.erase(hosts);
+                }
             }
             break;
         }
@@ -522,7 +529,7 @@ void RouteOrch::doTask(Consumer& consumer)
                 {
                     /* Mark all current routes as dirty (DEL) in consumer.m_toSync map */
                     SWSS_LOG_NOTICE("Start resync routes\n");
-                    for (auto j : m_syncdRoutes)
+                    for (const auto &j : m_syncdRoutes)
                     {
                         string vrf;
 
@@ -531,7 +538,7 @@ void RouteOrch::doTask(Consumer& consumer)
                             vrf = m_vrfOrch->getVRFname(j.first) + ":";
                         }
 
-                        for (auto i : j.second)
+                        for (const auto &i : j.second)
                         {
                             vector<FieldValueTuple> v;
                             key = vrf + i.first.to_string();
@@ -567,6 +574,7 @@ void RouteOrch::doTask(Consumer& consumer)
 
                 if (!m_vrfOrch->isVRFexists(vrf_name))
                 {
+                    consumer.waitFor(VRFOrch::getVrfDependency(vrf_name));
                     it++;
                     continue;
                 }
@@ -855,6 +863,9 @@ void RouteOrch::doTask(Consumer& consumer)
                 {
                     if (addRoute(ctx, nhg))
                         it = consumer.m_toSync.erase(it);
+                    /* Wait for the neighbor instead of retrying the route on every pass */
+                    else if (isNextHopNeighborPending(ctx, nhg))
+                        it = consumer.parkToSync(it, NeighOrch::getNeighborDependency(*nhg.getNextHops().begin()));
                     else
                         it++;
                 }
@@ -990,35 +1001,98 @@ void RouteOrch::doTask(Consumer& consumer)
     }
 }
 
+NextHopObserverEntry *RouteOrch::findNextHopObserverEntry(sai_object_id_t vrf_id, const IpPrefix &host)
+{
+    auto hosts = m_nextHopObservers.find(vrf_id);
+    if (hosts == m_nextHopObservers.end())
+    {
+        return nullptr;
+    }
+
+    auto entry = hosts->second.find(host);
+    if (entry == hosts->second.end())
+    {
+        return nullptr;
+    }
+
+    return &entry->second;
+}
+
+void RouteOrch::updateNextHopObservers(const IpPrefix &host, NextHopUpdate &update)
+{
+    NextHopObserverEntry *entry = findNextHopObserverEntry(update.vrf_id, host);
+    if (entry == nullptr)
+    {
+        return;
+    }
+
+    /* An observer may detach itself or others while being updated */
+    list<Observer *> observers = entry->observers;
+    for (auto observer : observers)
+    {
+        entry = findNextHopObserverEntry(update.vrf_id, host);
+        if (entry == nullptr)
+        {
+            return;
+        }
+
+        if (find(entry->observers.begin(), entry->observers.end(), observer) == entry->observers.end())
+        {
+            continue;
+        }
+
+        observer->update(SUBJECT_TYPE_NEXTHOP_CHANGE, static_cast<void *>(&update));
+    }
+}
+
 void RouteOrch::notifyNextHopChangeObservers(sai_object_id_t vrf_id, const IpPrefix &prefix, const NextHopGroupKey &nexthops, bool add)
 {
     SWSS_LOG_ENTER();
 
-    for (auto& entry : m_nextHopObservers)
+    auto hosts = m_nextHopObservers.find(vrf_id);
+    if (hosts == m_nextHopObservers.end())
+    {
+        return;
+    }
+
+    /* Only the hosts within the prefix are affected by the route change.
+     * Collect their keys first and look each one up again before use, as
+     * observers may attach or detach while being notified. */
+    vector<IpPrefix> hostKeys;
+    hosts->second.forEachInSubnet(prefix, [&](const HostObserverTable::value_type &entry)
+    {
+        hostKeys.push_back(entry.first);
+        return true;
+    });
+
+    for (const auto &hostKey : hostKeys)
     {
-        if (vrf_id != entry.first.first || !prefix.isAddressInSubnet(entry.first.second))
+        NextHopObserverEntry *entry = findNextHopObserverEntry(vrf_id, hostKey);
+        if (entry == nullptr)
         {
             continue;
         }
 
+        const IpAddress host = hostKey.getIp();
+
         if (add)
         {
             bool update_required = false;
-            NextHopUpdate update = { vrf_id, entry.first.second, prefix, nexthops };
+            NextHopUpdate update = { vrf_id, host, prefix, nexthops };
 
             /* Table should not be empty. Default route should always exists. */
-            assert(!entry.second.routeTable.empty());
+            assert(!entry->routeTable.empty());
 
-            auto route = entry.second.routeTable.find(prefix);
-            if (route == entry.second.routeTable.end())
+            auto route = entry->routeTable.find(prefix);
+            if (route == entry->routeTable.end())
             {
                 /* If added route is best match update observers */
-                if (entry.second.routeTable.rbegin()->first < prefix)
+                if (entry->routeTable.rbegin()->first < prefix)
                 {
                     update_required = true;
                 }
 
-                entry.second.routeTable.emplace(prefix, RouteNhg(nexthops, ""));
+                entry->routeTable.emplace(prefix, RouteNhg(nexthops, ""));
             }
             else
             {
@@ -1026,7 +1100,7 @@ void RouteOrch::notifyNextHopChangeObservers(sai_object_id_t vrf_id, const IpPre
                 {
                     route->second.nhg_key = nexthops;
                     /* If changed route is best match update observers */
-                    if (entry.second.routeTable.rbegin()->first == route->first)
+                    if (entry->routeTable.rbegin()->first == route->first)
                     {
                         update_required = true;
                     }
@@ -1035,36 +1109,30 @@ void RouteOrch::notifyNextHopChangeObservers(sai_object_id_t vrf_id, const IpPre
 
             if (update_required)
             {
-                for (auto observer : entry.second.observers)
-                {
-                    observer->update(SUBJECT_TYPE_NEXTHOP_CHANGE, static_cast<void *>(&update));
-                }
+                updateNextHopObservers(hostKey, update);
             }
         }
         else
         {
-            auto route = entry.second.routeTable.find(prefix);
-            if (route != entry.second.routeTable.end())
+            auto route = entry->routeTable.find(prefix);
+            if (route != entry->routeTable.end())
             {
                 /* If removed route was best match find another best match route */
-                if (route->first == entry.second.routeTable.rbegin()->first)
+                if (route->first == entry->routeTable.rbegin()->first)
                 {
-                    entry.second.routeTable.erase(route);
+                    entry->routeTable.erase(route);
 
                     /* Table should not be empty. Default route should always exists. */
-                    assert(!entry.second.routeTable.empty());
+                    assert(!entry->routeTable.empty());
 
-                    auto route = entry.second.routeTable.rbegin();
-                    NextHopUpdate update = { vrf_id, entry.first.second, route->first, route->second.nhg_key };
+                    auto route = entry->routeTable.rbegin();
+                    NextHopUpdate update = { vrf_id, host, route->first, route->second.nhg_key };
 
-                    for (auto observer : entry.second.observers)
-                    {
-                        observer->update(SUBJECT_TYPE_NEXTHOP_CHANGE, static_cast<void *>(&update));
-                    }
+                    updateNextHopObservers(hostKey, update);
                 }
                 else
                 {
-                    entry.second.routeTable.erase(route);
+                    entry->routeTable.erase(route);
                 }
             }
         }
@@ -1940,6 +2008,24 @@ bool RouteOrch::addRoute(RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
     return false;
 }
 
+/*
+ * A route to a single IP next hop can only be added once NeighOrch creates the
+ * next hop, which happens when the neighbor gets resolved.
+ */
+bool RouteOrch::isNextHopNeighborPending(const RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
+{
+    if (!ctx.nhg_index.empty() || nextHops.getSize() != 1 ||
+        nextHops.is_overlay_nexthop() || nextHops.is_srv6_nexthop())
+    {
+        return false;
+    }
+
+    const NextHopKey& nexthop = *nextHops.getNextHops().begin();
+
+    return !nexthop.isIntfNextHop() && !nexthop.isMplsNextHop() &&
+           !m_neighOrch->hasNextHop(nexthop);
+}
+
 bool RouteOrch::addRoutePost(const RouteBulkContext& ctx, const NextHopGroupKey &nextHops)
 {
     SWSS_LOG_ENTER();
@@ -13,9 +13,11 @@
 #include "ipaddresses.h"
 #include "ipprefix.h"
 #include "nexthopgroupkey.h"
+#include "prefixtable.h"
 #include "bulker.h"
 #include "fgnhgorch.h"
 #include <map>
+#include <unordered_map>
 
 /* Maximum next hop group number */
 #define NHGRP_MAX_SIZE 128
@@ -88,25 +90,26 @@ struct RouteKey
 };
 
 /* NextHopGroupTable: NextHopGroupKey, NextHopGroupEntry */
-typedef std::map<NextHopGroupKey, NextHopGroupEntry> NextHopGroupTable;
+typedef std::unordered_map<NextHopGroupKey, NextHopGroupEntry> NextHopGroupTable;
 /* RouteTable: destination network, NextHopGroupKey */
-typedef std::map<IpPrefix, RouteNhg> RouteTable;
+typedef PrefixTable<RouteNhg> RouteTable;
 /* RouteTables: vrf_id, RouteTable */
 typedef std::map<sai_object_id_t, RouteTable> RouteTables;
 /* LabelRouteTable: destination label, next hop address(es) */
 typedef std::map<Label, RouteNhg> LabelRouteTable;
 /* LabelRouteTables: vrf_id, LabelRouteTable */
 typedef std::map<sai_object_id_t, LabelRouteTable> LabelRouteTables;
-/* Host: vrf_id, IpAddress */
-typedef std::pair<sai_object_id_t, IpAddress> Host;
-/* NextHopObserverTable: Host, next hop observer entry */
-typedef std::map<Host, NextHopObserverEntry> NextHopObserverTable;
+/* HostObserverTable: observed host address as a full length prefix, next hop observer entry */
+typedef PrefixTable<NextHopObserverEntry> HostObserverTable;
+/* NextHopObserverTable: vrf_id, HostObserverTable */
+typedef std::map<sai_object_id_t, HostObserverTable> NextHopObserverTable;
 /* Single Nexthop to Routemap */
 typedef std::map<NextHopKey, std::set<RouteKey>> NextHopRouteTable;
 
 struct NextHopObserverEntry
 {
-    RouteTable routeTable;
+    /* Routes covering the observed host, rbegin() is the best match */
+    std::map<IpPrefix, RouteNhg> routeTable;
     list<Observer *> observers;
 };
 
@@ -245,6 +248,9 @@ private:
 
     NextHopObserverTable m_nextHopObservers;
 
+    NextHopObserverEntry *findNextHopObserverEntry(sai_object_id_t vrf_id, const IpPrefix &host);
+    void updateNextHopObservers(const IpPrefix &host, NextHopUpdate &update);
+
     EntityBulker<sai_route_api_t>           gRouteBulker;
     EntityBulker<sai_mpls_api_t>            gLabelRouteBulker;
     ObjectBulker<sai_next_hop_group_api_t>  gNextHopGroupMemberBulker;
@@ -254,6 +260,7 @@ private:
     bool removeRoute(RouteBulkContext& ctx);
     bool addRoutePost(const RouteBulkContext& ctx, const NextHopGroupKey &nextHops);
     bool removeRoutePost(const RouteBulkContext& ctx);
+    bool isNextHopNeighborPending(const RouteBulkContext& ctx, const NextHopGroupKey &nextHops);
 
     void addTempLabelRoute(LabelRouteBulkContext& ctx, const NextHopGroupKey&);
     bool addLabelRoute(LabelRouteBulkContext& ctx, const NextHopGroupKey&);
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+/*
+ * Hierarchical timer wheel of keys scheduled at a point in time.
+ *
+ * Times are integers in any unit (e.g. seconds) and are bucketed into ticks
+ * of the given resolution. Level 0 has one slot per tick, every upper level
+ * has slots spanning a whole turn of the level below; keys are moved down a
+ * level when the wheel reaches their slot. Scheduling is O(1) and advancing
+ * only touches the keys that are due, plus an amortized O(1) cascade.
+ *
+ * There is no cancellation: a key may be scheduled several times, the owner
+ * recognizes stale expirations by comparing the expiration time passed to the
+ * callback with the time it last scheduled the key at.
+ */
+template <typename Key>
+class TimerWheel
+{
+public:
+    TimerWheel(uint64_t resolution, uint64_t now) :
+        m_resolution(resolution ? resolution : 1),
+        m_now(now / m_resolution)
+    {
+    }
+
+    /* Schedule key to expire at time when, past times expire on the next advance */
+    void schedule(const Key &key, uint64_t when)
+    {
+        uint64_t tick = when / m_resolution;
+        if (tick < m_now)
+        {
+            m_overdue.emplace_back(key, when);
+        }
+        else
+        {
+            insert(Item(key, when), tick);
+        }
+        m_size++;
+    }
+
+    /* Expire all keys scheduled at or before time now, calling f(key, when) for each */
+    template <typename F>
+    void advance(uint64_t now, F f)
+    {
+        uint64_t target = now / m_resolution;
+
+        if (!m_overdue.empty())
+        {
+            std::vector<Item> expired;
+            expired.swap(m_overdue);
+            m_size -= expired.size();
+
+            for (const auto &item : expired)
+            {
+                f(item.first, item.second);
+            }
+        }
+
+        while (m_now <= target)
+        {
+            if (m_size == 0)
+            {
+                m_now = target + 1;
+                break;
+            }
+
+            // Entering a new turn of a level moves the keys of its current slot down
+            for (size_t level = LEVELS - 1; level > 0; level--)
+            {
+                if ((m_now & ((1ULL << (level * SLOT_BITS)) - 1)) == 0)
+                {
+                    cascade(level);
+                }
+            }
+
+            std::vector<Item> expired;
+            expired.swap(m_slots[0][m_now & SLOT_MASK]);
+            m_size -= expired.size();
+
+            m_now++;
+
+            for (const auto &item : expired)
+            {
+                f(item.first, item.second);
+            }
+        }
+    }
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+private:
+    typedef std::pair<Key, uint64_t> Item;
+
+    static const size_t SLOT_BITS = 6;
+    static const size_t SLOTS = 1 << SLOT_BITS;
+    static const uint64_t SLOT_MASK = SLOTS - 1;
+    static const size_t LEVELS = 4;
+
+    void insert(Item &&item, uint64_t tick)
+    {
+        size_t level = 0;
+        // Find the lowest level on which tick shares the current turn with m_now
+        while (level < LEVELS - 1 && (tick >> ((level + 1) * SLOT_BITS)) != (m_now >> ((level + 1) * SLOT_BITS)))
+        {
+            level++;
+        }
+
+        if ((tick >> (LEVELS * SLOT_BITS)) != (m_now >> (LEVELS * SLOT_BITS)))
+        {
+            // Beyond the top level turn, looked at again on every top level cascade
+            m_far.push_back(std::move(item));
+            return;
+        }
+
+        m_slots[level][(tick >> (level * SLOT_BITS)) & SLOT_MASK].push_back(std::move(item));
+    }
+
+    void cascade(size_t level)
+    {
+        std::vector<Item> items;
+        items.swap(m_slots[level][(m_now >> (level * SLOT_BITS)) & SLOT_MASK]);
+
+        if (level == LEVELS - 1 && !m_far.empty())
+        {
+            items.insert(items.end(), std::make_move_iterator(m_far.begin()), std::make_move_iterator(m_far.end()));
+            m_far.clear();
+        }
+
+        for (auto &item : items)
+        {
+            uint64_t tick = item.second / m_resolution;
+            insert(std::move(item), tick < m_now ? m_now : tick);
+        }
+    }
+
+    uint64_t m_resolution;
+    uint64_t m_now;
+    size_t m_size = 0;
+    std::vector<Item> m_overdue;
+    std::vector<Item> m_far;
+    std::vector<Item> m_slots[LEVELS][SLOTS];
+};
@@ -119,6 +119,8 @@ bool VRFOrch::addOperation(const Request& request)
         }
         m_stateVrfObjectTable.hset(vrf_name, "state", "ok");
         SWSS_LOG_NOTICE("VRF '%s' was added", vrf_name.c_str());
+
+        Consumer::wake(getVrfDependency(vrf_name));
     }
     else
     {
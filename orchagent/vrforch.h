@@ -60,6 +60,12 @@ public:
         return vrf_table_.find(name) != std::end(vrf_table_);
     }
 
+    // Name of the dependency consumers wait on until the VRF exists
+    static std::string getVrfDependency(const std::string& name)
+    {
+        return "vrf " + name;
+    }
+
     sai_object_id_t getVRFid(const std::string& name) const
     {
         if (vrf_table_.find(name) != std::end(vrf_table_))
@@ -14,6 +14,7 @@ extern "C" {
 #include "request_parser.h"
 #include "vxlanorch.h"
 #include "directory.h"
+#include "flexcounterorch.h"
 #include "swssnet.h"
 #include "warm_restart.h"
 #include "tokenize.h"
@@ -1198,23 +1199,11 @@ VxlanTunnelOrch::VxlanTunnelOrch(DBConnector *statedb, DBConnector *db, const st
         }
     }
 
-    FieldValueTuple fv;
-    string tunnel_rate_plugin = "tunnel_rates.lua";
     m_counter_db = shared_ptr<DBConnector>(new DBConnector("COUNTERS_DB", 0));
     m_asic_db = shared_ptr<DBConnector>(new DBConnector("ASIC_DB", 0));
-    try
-    {
-        string tunnel_rate_script = swss::loadLuaScript(tunnel_rate_plugin);
-        string tunnel_rate_sha = swss::loadRedisScript(m_counter_db.get(), tunnel_rate_script);
-        fv = FieldValueTuple(TUNNEL_PLUGIN_FIELD, tunnel_rate_sha);
-    }
-    catch (const runtime_error &e)
-    {
-        SWSS_LOG_WARN("Tunnel flex counter group plugins was not set successfully: %s", e.what());
-    }
 
     tunnel_stat_manager = g_FlexManagerDirectory.createFlexCounterManager(TUNNEL_STAT_COUNTER_FLEX_COUNTER_GROUP,
-                                        StatsMode::READ, TUNNEL_STAT_FLEX_COUNTER_POLLING_INTERVAL_MS, false, fv);
+                                        StatsMode::READ, TUNNEL_STAT_FLEX_COUNTER_POLLING_INTERVAL_MS, false);
 
     m_tunnelNameTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_TUNNEL_NAME_MAP));
     m_tunnelTypeTable = unique_ptr<Table>(new Table(m_counter_db.get(), COUNTERS_TUNNEL_TYPE_MAP));
@@ -1249,6 +1238,11 @@ void VxlanTunnelOrch::doTask(SelectableTimer &timer)
 
             m_tunnelNameTable->set("", tunnelNameFvs);
             m_tunnelTypeTable->set("", tunnelTypeFvs);
+            auto flex_counters_orch = gDirectory.get<FlexCounterOrch*>();
+            if (flex_counters_orch)
+            {
+                flex_counters_orch->refreshRateCounterObjects(COUNTERS_TUNNEL_NAME_MAP);
+            }
             auto tunnel_stats = generateTunnelCounterStats();
 
             tunnel_stat_manager->setCounterIdList(it->first, CounterType::TUNNEL,
@@ -1286,6 +1280,11 @@ void VxlanTunnelOrch::removeTunnelFromFlexCounter(sai_object_id_t oid, const str
 
     m_tunnelNameTable->hdel("", name);
     m_tunnelTypeTable->hdel("", sai_oid);
+    auto flex_counters_orch = gDirectory.get<FlexCounterOrch*>();
+    if (flex_counters_orch)
+    {
+        flex_counters_orch->refreshRateCounterObjects(COUNTERS_TUNNEL_NAME_MAP);
+    }
     tunnel_stat_manager->clearCounterIdList(oid);
     SWSS_LOG_DEBUG("Unregistered tunnel %s to Flex counter", name.c_str());
 }
@@ -1372,6 +1372,209 @@ namespace aclorch_test
         ASSERT_EQ(tableIt, orch->getAclTables().end());
     }
 
+    TEST_F(AclOrchTest, AclRule_BulkCreation)
+    {
+        string tableId = "acl_table_1";
+
+        auto orch = createAclOrch();
+
+        auto kvfAclTable = deque<KeyOpFieldsValuesTuple>({{
+            tableId,
+            SET_COMMAND,
+            {
+                { ACL_TABLE_DESCRIPTION, "L3 table" },
+                { ACL_TABLE_TYPE, TABLE_TYPE_L3 },
+                { ACL_TABLE_STAGE, STAGE_INGRESS },
+                { ACL_TABLE_PORTS, "1,2" }
+            }
+        }});
+
+        orch->doAclTableTask(kvfAclTable);
+
+        auto tableOid = orch->getTableById(tableId);
+        ASSERT_NE(tableOid, SAI_NULL_OBJECT_ID);
+
+        // add several acl rules in one drain, one of them with an invalid attribute ...
+
+        auto kvfAclRule = deque<KeyOpFieldsValuesTuple>({
+            {
+                tableId + "|acl_rule_1",
+                SET_COMMAND,
+                {
+                    { ACTION_PACKET_ACTION, PACKET_ACTION_FORWARD },
+                    { MATCH_SRC_IP, "1.2.3.4" }
+                }
+            },
+            {
+                tableId + "|acl_rule_2",
+                SET_COMMAND,
+                {
+                    { ACTION_PACKET_ACTION, PACKET_ACTION_DROP },
+                    { MATCH_L4_SRC_PORT_RANGE, "10..20" }
+                }
+            },
+            {
+                tableId + "|acl_rule_3",
+                SET_COMMAND,
+                {
+                    { ACTION_PACKET_ACTION, PACKET_ACTION_DROP },
+                    { "UNKNOWN_MATCH", "1" }
+                }
+            }
+        });
+
+        orch->doAclRuleTask(kvfAclRule);
+
+        // validate the valid rules are created with their counters ...
+
+        auto tableIt = orch->getAclTables().find(tableOid);
+        ASSERT_NE(tableIt, orch->getAclTables().end());
+        ASSERT_EQ(tableIt->second.rules.size(), 2U);
+
+        for (const auto &ruleId : { "acl_rule_1", "acl_rule_2" })
+        {
+            auto ruleIt = tableIt->second.rules.find(ruleId);
+            ASSERT_NE(ruleIt, tableIt->second.rules.end());
+            ASSERT_NE(ruleIt->second->getOid(), SAI_NULL_OBJECT_ID);
+            ASSERT_TRUE(ruleIt->second->hasCounter());
+            ASSERT_TRUE(validateAclRuleCounter(*ruleIt->second, true));
+        }
+
+        // re-setting existing acl rules updates them in place, rules with ranges are recreated ...
+
+        auto oldRule1 = tableIt->second.rules.at("acl_rule_1");
+        auto oldRule1Oid = oldRule1->getOid();
+        auto oldCounter1Oid = oldRule1->getCounterOid();
+        auto oldRule2 = tableIt->second.rules.at("acl_rule_2");
+
+        kvfAclRule = deque<KeyOpFieldsValuesTuple>({
+            {
+                tableId + "|acl_rule_1",
+                SET_COMMAND,
+                {
+                    { ACTION_PACKET_ACTION, PACKET_ACTION_DROP },
+                    { MATCH_DST_IP, "4.3.2.1" }
+                }
+            },
+            {
+                tableId + "|acl_rule_2",
+                SET_COMMAND,
+                {
+                    { ACTION_PACKET_ACTION, PACKET_ACTION_FORWARD },
+                    { MATCH_L4_SRC_PORT_RANGE, "10..30" }
+                }
+            }
+        });
+
+        orch->doAclRuleTask(kvfAclRule);
+
+        tableIt = orch->getAclTables().find(tableOid);
+        ASSERT_EQ(tableIt->second.rules.size(), 2U);
+
+        auto &rule1 = tableIt->second.rules.at("acl_rule_1");
+        ASSERT_EQ(rule1, oldRule1);
+        ASSERT_EQ(rule1->getOid(), oldRule1Oid);
+        ASSERT_EQ(rule1->getCounterOid(), oldCounter1Oid);
+        ASSERT_EQ(getAclRuleSaiAttribute(*rule1, SAI_ACL_ENTRY_ATTR_ACTION_PACKET_ACTION), "SAI_PACKET_ACTION_DROP");
+        ASSERT_EQ(getAclRuleSaiAttribute(*rule1, SAI_ACL_ENTRY_ATTR_FIELD_SRC_IP), "disabled");
+        ASSERT_EQ(getAclRuleSaiAttribute(*rule1, SAI_ACL_ENTRY_ATTR_FIELD_DST_IP), "4.3.2.1&mask:255.255.255.255");
+
+        auto &rule2 = tableIt->second.rules.at("acl_rule_2");
+        ASSERT_NE(rule2, oldRule2);
+        ASSERT_NE(rule2->getOid(), SAI_NULL_OBJECT_ID);
+    }
+
+    static sai_create_acl_entry_fn old_create_acl_entry;
+    static sai_create_acl_counter_fn old_create_acl_counter;
+    static uint32_t acl_entry_create_calls;
+    static uint32_t acl_counter_create_calls;
+
+    static sai_status_t counting_create_acl_entry(sai_object_id_t *oid, sai_object_id_t switch_id, uint32_t attr_count, const sai_attribute_t *attr_list)
+    {
+        acl_entry_create_calls++;
+        return old_create_acl_entry(oid, switch_id, attr_count, attr_list);
+    }
+
+    static sai_status_t counting_create_acl_counter(sai_object_id_t *oid, sai_object_id_t switch_id, uint32_t attr_count, const sai_attribute_t *attr_list)
+    {
+        acl_counter_create_calls++;
+        return old_create_acl_counter(oid, switch_id, attr_count, attr_list);
+    }
+
+    TEST_F(AclOrchTest, AclRule_BulkCreationFallback)
+    {
+        string tableId = "acl_table_1";
+
+        auto orch = createAclOrch();
+
+        auto kvfAclTable = deque<KeyOpFieldsValuesTuple>({{
+            tableId,
+            SET_COMMAND,
+            {
+                { ACL_TABLE_DESCRIPTION, "L3 table" },
+                { ACL_TABLE_TYPE, TABLE_TYPE_L3 },
+                { ACL_TABLE_STAGE, STAGE_INGRESS },
+                { ACL_TABLE_PORTS, "1,2" }
+            }
+        }});
+
+        orch->doAclTableTask(kvfAclTable);
+
+        auto tableOid = orch->getTableById(tableId);
+        ASSERT_NE(tableOid, SAI_NULL_OBJECT_ID);
+
+        // a SAI without the bulk API creates the objects one by one ...
+
+        acl_bulk_supported<SAI_OBJECT_TYPE_ACL_ENTRY>() = false;
+        acl_bulk_supported<SAI_OBJECT_TYPE_ACL_COUNTER>() = false;
+        old_create_acl_entry = sai_acl_api->create_acl_entry;
+        old_create_acl_counter = sai_acl_api->create_acl_counter;
+        sai_acl_api->create_acl_entry = counting_create_acl_entry;
+        sai_acl_api->create_acl_counter = counting_create_acl_counter;
+        acl_entry_create_calls = 0;
+        acl_counter_create_calls = 0;
+
+        auto kvfAclRule = deque<KeyOpFieldsValuesTuple>({
+            {
+                tableId + "|acl_rule_1",
+                SET_COMMAND,
+                {
+                    { ACTION_PACKET_ACTION, PACKET_ACTION_FORWARD },
+                    { MATCH_SRC_IP, "1.2.3.4" }
+                }
+            },
+            {
+                tableId + "|acl_rule_2",
+                SET_COMMAND,
+                {
+                    { ACTION_PACKET_ACTION, PACKET_ACTION_DROP },
+                    { MATCH_DST_IP, "4.3.2.1" }
+                }
+            }
+        });
+
+        orch->doAclRuleTask(kvfAclRule);
+
+        sai_acl_api->create_acl_entry = old_create_acl_entry;
+        sai_acl_api->create_acl_counter = old_create_acl_counter;
+        acl_bulk_supported<SAI_OBJECT_TYPE_ACL_ENTRY>() = true;
+        acl_bulk_supported<SAI_OBJECT_TYPE_ACL_COUNTER>() = true;
+
+        ASSERT_EQ(acl_entry_create_calls, 2U);
+        ASSERT_EQ(acl_counter_create_calls, 2U);
+
+        auto tableIt = orch->getAclTables().find(tableOid);
+        ASSERT_NE(tableIt, orch->getAclTables().end());
+        ASSERT_EQ(tableIt->second.rules.size(), 2U);
+        for (const auto &ruleId : { "acl_rule_1", "acl_rule_2" })
+        {
+            auto ruleIt = tableIt->second.rules.find(ruleId);
+            ASSERT_NE(ruleIt, tableIt->second.rules.end());
+            ASSERT_NE(ruleIt->second->getOid(), SAI_NULL_OBJECT_ID);
+            ASSERT_TRUE(validateAclRuleCounter(*ruleIt->second, true));
+        }
+    }
+
     TEST_F(AclOrchTest, AclTableType_Configuration)
     {
         const string aclTableTypeName = "TEST_TYPE";
@@ -1645,6 +1848,100 @@ namespace aclorch_test
         ASSERT_TRUE(orch->getAclRule(aclTableName, aclRuleName));
     }
 
+    TEST_F(AclOrchTest, AclRule_TypeChangeRecreatesRule)
+    {
+        const string aclTableTypeName = "TEST_TYPE";
+        const string aclTableName = "TEST_TABLE";
+        const string aclRuleName = "TEST_RULE";
+        const string testSessionName = "test_session";
+
+        auto orch = createAclOrch();
+
+        orch->doAclTableTypeTask(
+            deque<KeyOpFieldsValuesTuple>(
+                {
+                    {
+                        aclTableTypeName,
+                        SET_COMMAND,
+                        {
+                            { ACL_TABLE_TYPE_MATCHES, MATCH_ETHER_TYPE },
+                            { ACL_TABLE_TYPE_BPOINT_TYPES, BIND_POINT_TYPE_PORT },
+                            { ACL_TABLE_TYPE_ACTIONS, string(ACTION_PACKET_ACTION) + comma + ACTION_MIRROR_INGRESS_ACTION }
+                        }
+                    }
+                }
+            )
+        );
+
+        orch->doAclTableTask(
+            deque<KeyOpFieldsValuesTuple>(
+                {
+                    {
+                        aclTableName,
+                        SET_COMMAND,
+                        {
+                            { ACL_TABLE_DESCRIPTION, "Test table" },
+                            { ACL_TABLE_TYPE, aclTableTypeName },
+                            { ACL_TABLE_STAGE, STAGE_INGRESS },
+                            { ACL_TABLE_PORTS, "1,2" }
+                        }
+                    }
+                }
+            )
+        );
+        ASSERT_TRUE(orch->getAclTable(aclTableName));
+
+        gMirrorOrch->createEntry(testSessionName, {});
+
+        auto setRule = [&](const string &action, const string &value) {
+            orch->doAclRuleTask(
+                deque<KeyOpFieldsValuesTuple>(
+                    {
+                        {
+                            aclTableName + "|" + aclRuleName,
+                            SET_COMMAND,
+                            {
+                                { MATCH_ETHER_TYPE, "2048" },
+                                { action, value },
+                            }
+                        }
+                    }
+                )
+            );
+        };
+
+        setRule(ACTION_PACKET_ACTION, PACKET_ACTION_DROP);
+        auto packetRule = orch->getAclRule(aclTableName, aclRuleName);
+        ASSERT_TRUE(packetRule);
+        ASSERT_TRUE(dynamic_cast<const AclRulePacket *>(packetRule));
+        auto packetRuleOid = packetRule->getOid();
+        ASSERT_NE(packetRuleOid, SAI_NULL_OBJECT_ID);
+
+        // a packet rule that becomes a mirror rule is replaced, not updated in place ...
+
+        setRule(ACTION_MIRROR_INGRESS_ACTION, testSessionName);
+        auto mirrorRule = orch->getAclRule(aclTableName, aclRuleName);
+        ASSERT_TRUE(mirrorRule);
+        ASSERT_TRUE(dynamic_cast<const AclRuleMirror *>(mirrorRule));
+        ASSERT_NE(mirrorRule->getOid(), packetRuleOid);
+
+        // ... and so is a mirror rule that becomes a packet rule again
+
+        setRule(ACTION_PACKET_ACTION, PACKET_ACTION_FORWARD);
+        packetRule = orch->getAclRule(aclTableName, aclRuleName);
+        ASSERT_TRUE(packetRule);
+        ASSERT_TRUE(dynamic_cast<const AclRulePacket *>(packetRule));
+        ASSERT_NE(packetRule->getOid(), SAI_NULL_OBJECT_ID);
+        ASSERT_EQ(getAclRuleSaiAttribute(*packetRule, SAI_ACL_ENTRY_ATTR_ACTION_PACKET_ACTION), "SAI_PACKET_ACTION_FORWARD");
+
+        // a rule of the same type is still updated in place
+        packetRuleOid = packetRule->getOid();
+        setRule(ACTION_PACKET_ACTION, PACKET_ACTION_DROP);
+        ASSERT_EQ(orch->getAclRule(aclTableName, aclRuleName), packetRule);
+        ASSERT_EQ(packetRule->getOid(), packetRuleOid);
+        ASSERT_EQ(getAclRuleSaiAttribute(*packetRule, SAI_ACL_ENTRY_ATTR_ACTION_PACKET_ACTION), "SAI_PACKET_ACTION_DROP");
+    }
+
     TEST_F(AclOrchTest, AclRuleUpdate)
     {
         string acl_table_id = "acl_table_1";
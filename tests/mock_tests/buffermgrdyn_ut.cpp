@@ -163,7 +163,7 @@ namespace buffermgrdyn_test
             WarmStart::checkWarmStart("buffermgrd", "swss");
         }
 
-        void StartBufferManager(shared_ptr<vector<KeyOpFieldsValuesTuple>> zero_profile=nullptr)
+        void StartBufferManager(shared_ptr<vector<KeyOpFieldsValuesTuple>> zero_profile=nullptr, unsigned int pool_check_debounce_msec=0)
         {
             // Init switch and create dependencies
             vector<TableConnector> buffer_table_connectors = {
@@ -180,7 +180,53 @@ namespace buffermgrdyn_test
                 TableConnector(m_state_db.get(), STATE_PORT_TABLE_NAME)
             };
 
-            m_dynamicBuffer = new BufferMgrDynamic(m_config_db.get(), m_state_db.get(), m_app_db.get(), buffer_table_connectors, nullptr, zero_profile);
+            m_dynamicBuffer = new BufferMgrDynamic(m_config_db.get(), m_state_db.get(), m_app_db.get(), buffer_table_connectors, nullptr, zero_profile, pool_check_debounce_msec);
+        }
+
+        // Start the buffer manager on the virtual switch whose buffer sizes are calculated in process
+        // Sizes of ingress_lossless_pool and egress_lossy_pool are calculated, Ethernet0 is admin up
+        void StartVsBufferManager(unsigned int pool_check_debounce_msec=0)
+        {
+            Table asicTable(m_state_db.get(), "ASIC_TABLE");
+            Table losslessTrafficPatternTable(m_config_db.get(), "LOSSLESS_TRAFFIC_PATTERN");
+
+            setenv("ASIC_VENDOR", "vs", 1);
+
+            asicTable.set("VS",
+                          {
+                              {"cell_size", "144"},
+                              {"pipeline_latency", "18"},
+                              {"mac_phy_delay", "0.8"},
+                              {"peer_response_time", "3.8"}
+                          });
+            losslessTrafficPatternTable.set("AZURE",
+                                            {
+                                                {"mtu", "1024"},
+                                                {"small_packet_percentage", "100"}
+                                            });
+            InitDefaultLosslessParameter();
+            bufferMaxParamTable.set("global",
+                                    {
+                                        {"mmu_size", "12766208"}
+                                    });
+
+            StartBufferManager(nullptr, pool_check_debounce_msec);
+            ASSERT_TRUE(m_dynamicBuffer->m_bufferCalculator != nullptr);
+
+            InitPort();
+            SetPortInitDone();
+            m_dynamicBuffer->doTask(m_selectableTable);
+
+            testBufferPool["ingress_lossless_pool"] = {
+                {"mode", "dynamic"},
+                {"type", "ingress"}
+            };
+            testBufferPool["egress_lossy_pool"] = {
+                {"mode", "dynamic"},
+                {"type", "egress"}
+            };
+            InitBufferPool();
+            m_dynamicBuffer->doTask(m_selectableTable);
         }
 
         void InitPort(const string &port="Ethernet0", const string &admin_status="up")
@@ -1422,4 +1468,101 @@ namespace buffermgrdyn_test
         HandleTable(cableLengthTable);
         ASSERT_EQ(m_dynamicBuffer->m_portInfoLookup["Ethernet12"].state, PORT_READY);
     }
+
+    /*
+     * In-process buffer calculator on the virtual switch
+     * The Lua plugins can not run against the mock database, so the expected results
+     * are worked out from the formulas in buffer_headroom_vs.lua and buffer_pool_vs.lua
+     * 1. Headroom of the dynamically calculated profile
+     * 2. Sizes of the pools without configured size, before and after buffer items are applied
+     */
+    TEST_F(BufferMgrDynTest, BufferMgrTestVsCalculator)
+    {
+        vector<FieldValueTuple> fieldValues;
+
+        StartVsBufferManager();
+
+        // Reserved: management PG 18432, egress mirror 10240, management pool 262144
+        ASSERT_TRUE(m_dynamicBuffer->m_bufferPoolReady);
+        ASSERT_EQ(m_dynamicBuffer->m_bufferPoolLookup["ingress_lossless_pool"].total_size, "12475392");
+        ASSERT_EQ(m_dynamicBuffer->m_bufferPoolLookup["egress_lossy_pool"].total_size, "12475392");
+
+        InitDefaultBufferProfile();
+        InitCableLength("Ethernet0", "5m");
+        InitBufferPg("Ethernet0|3-4");
+        InitBufferPg("Ethernet0|0", "ingress_lossless_profile");
+        InitBufferQueue("Ethernet0|0-2", "egress_lossy_profile");
+
+        auto expectedProfile = "pg_lossless_100000_5m_profile";
+        CheckPg("Ethernet0", "Ethernet0:3-4", expectedProfile);
+        ASSERT_TRUE(appBufferProfileTable.get(expectedProfile, fieldValues));
+        CheckIfVectorsMatch(fieldValues,
+                            {
+                                {"xon", "18432"},
+                                {"xoff", "81920"},
+                                {"size", "100352"},
+                                {"pool", "ingress_lossless_pool"},
+                                {"dynamic_th", "0"}
+                            });
+
+        // Reserved in addition: 2 lossless PGs 200704, a lossy PG 18432
+        m_dynamicBuffer->doTask(m_selectableTable);
+        ASSERT_EQ(m_dynamicBuffer->m_bufferPoolLookup["ingress_lossless_pool"].total_size, "12256256");
+        ASSERT_EQ(m_dynamicBuffer->m_bufferPoolLookup["egress_lossy_pool"].total_size, "12256256");
+        ASSERT_TRUE(appBufferPoolTable.get("ingress_lossless_pool", fieldValues));
+        ASSERT_TRUE(find(fieldValues.begin(), fieldValues.end(), FieldValueTuple("size", "12256256")) != fieldValues.end());
+
+        // Removing the lossy PG releases its reserved buffer
+        ClearBufferObject("Ethernet0|0", CFG_BUFFER_PG_TABLE_NAME);
+        m_dynamicBuffer->doTask(m_selectableTable);
+        ASSERT_EQ(m_dynamicBuffer->m_bufferPoolLookup["ingress_lossless_pool"].total_size, "12274688");
+    }
+
+    /*
+     * Shared buffer pool recalculation is deferred
+     * 1. Without debounce interval, pool sizes are updated once the table has been handled
+     * 2. With debounce interval, pool sizes are updated when the debounce timer fires
+     */
+    TEST_F(BufferMgrDynTest, BufferMgrTestDeferredPoolCalculation)
+    {
+        StartVsBufferManager(100);
+        ASSERT_TRUE(m_dynamicBuffer->m_bufferPoolCheckTimer != nullptr);
+        ASSERT_EQ(m_dynamicBuffer->m_bufferPoolLookup["ingress_lossless_pool"].total_size, "12475392");
+
+        InitDefaultBufferProfile();
+        InitCableLength("Ethernet0", "5m");
+
+        // Two lossless PGs and a lossy PG on two ports, handled in one drain
+        InitPort("Ethernet4");
+        cableLengthTable.set("AZURE",
+                             {
+                                 {"Ethernet4", "5m"}
+                             });
+        HandleTable(cableLengthTable);
+        bufferPgTable.set("Ethernet0|3-4", {{"profile", "NULL"}});
+        bufferPgTable.set("Ethernet4|3-4", {{"profile", "NULL"}});
+        bufferPgTable.set("Ethernet0|0", {{"profile", "ingress_lossless_profile"}});
+        HandleTable(bufferPgTable);
+
+        ASSERT_TRUE(m_dynamicBuffer->m_bufferPoolCheckPending);
+        ASSERT_EQ(m_dynamicBuffer->m_bufferPoolLookup["ingress_lossless_pool"].total_size, "12475392");
+
+        // Reserved in addition: 4 lossless PGs 401408, a lossy PG 18432, Ethernet4's management PG and egress mirror 28672
+        m_dynamicBuffer->doTask(*m_dynamicBuffer->m_bufferPoolCheckTimer);
+        ASSERT_FALSE(m_dynamicBuffer->m_bufferPoolCheckPending);
+        ASSERT_EQ(m_dynamicBuffer->m_bufferPoolLookup["ingress_lossless_pool"].total_size, "12026880");
+        ASSERT_EQ(m_dynamicBuffer->m_bufferPoolLookup["egress_lossy_pool"].total_size, "12026880");
+
+        delete m_dynamicBuffer;
+        testing_db::reset();
+
+        // Without debounce interval
+        StartVsBufferManager();
+        ASSERT_TRUE(m_dynamicBuffer->m_bufferPoolCheckTimer == nullptr);
+        InitDefaultBufferProfile();
+        InitCableLength("Ethernet0", "5m");
+        InitBufferPg("Ethernet0|3-4");
+        ASSERT_FALSE(m_dynamicBuffer->m_bufferPoolCheckPending);
+        ASSERT_EQ(m_dynamicBuffer->m_bufferPoolLookup["ingress_lossless_pool"].total_size, "12274688");
+    }
 }
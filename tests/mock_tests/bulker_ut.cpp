@@ -142,4 +142,89 @@ namespace bulker_test
         // Confirm route entry is not pending removal
         ASSERT_FALSE(gRouteBulker.bulk_entry_pending_removal(route_entry_non_remove));
     }
+
+    TEST_F(BulkerTest, FdbBulkerPendingEntries)
+    {
+        // Create FDB bulker
+        sai_fdb_api_t fdb_api = {};
+        EntityBulker<sai_fdb_api_t> gFdbBulker(&fdb_api, 1000);
+        deque<sai_status_t> object_statuses;
+
+        // Create a dummy FDB entry
+        sai_fdb_entry_t fdb_entry_create;
+        fdb_entry_create.switch_id = 0x0;
+        fdb_entry_create.bv_id = 0x26000000000001;
+        sai_mac_t mac = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55 };
+        memcpy(fdb_entry_create.mac_address, mac, sizeof(sai_mac_t));
+
+        sai_attribute_t fdb_attr;
+        fdb_attr.id = SAI_FDB_ENTRY_ATTR_TYPE;
+        fdb_attr.value.s32 = SAI_FDB_ENTRY_TYPE_DYNAMIC;
+
+        // Put FDB entry into create
+        object_statuses.emplace_back();
+        gFdbBulker.create_entry(&object_statuses.back(), &fdb_entry_create, 1, &fdb_attr);
+        ASSERT_EQ(gFdbBulker.creating_entries_count(fdb_entry_create), 1);
+
+        // Same MAC in another VLAN is a different FDB entry
+        sai_fdb_entry_t fdb_entry_remove = fdb_entry_create;
+        fdb_entry_remove.bv_id = 0x26000000000002;
+        ASSERT_EQ(gFdbBulker.creating_entries_count(fdb_entry_remove), 0);
+
+        // Put the other FDB entry into remove
+        object_statuses.emplace_back();
+        gFdbBulker.remove_entry(&object_statuses.back(), &fdb_entry_remove);
+
+        // Confirm only the removed FDB entry is pending removal
+        ASSERT_TRUE(gFdbBulker.bulk_entry_pending_removal(fdb_entry_remove));
+        ASSERT_FALSE(gFdbBulker.bulk_entry_pending_removal(fdb_entry_create));
+    }
+
+    sai_status_t create_next_hops_second_fails(
+        _In_ sai_object_id_t switch_id,
+        _In_ uint32_t object_count,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_object_id_t *object_id,
+        _Out_ sai_status_t *object_statuses)
+    {
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = (i == 1) ? SAI_STATUS_TABLE_FULL : SAI_STATUS_SUCCESS;
+            object_id[i] = (i == 1) ? SAI_NULL_OBJECT_ID : 0x40000000000010 + i;
+        }
+        return SAI_STATUS_FAILURE;
+    }
+
+    TEST_F(BulkerTest, ObjectBulkerCreateStatus)
+    {
+        sai_next_hop_api_t next_hop_api = {};
+        next_hop_api.create_next_hops = create_next_hops_second_fails;
+        ObjectBulker<sai_next_hop_api_t> nextHopBulker(&next_hop_api, 0x0, 1000);
+
+        sai_attribute_t attr;
+        attr.id = SAI_NEXT_HOP_ATTR_TYPE;
+        attr.value.s32 = SAI_NEXT_HOP_TYPE_IP;
+
+        sai_object_id_t ids[2];
+        sai_status_t statuses[2];
+        sai_object_id_t id_without_status;
+        nextHopBulker.create_entry(&ids[0], &statuses[0], 1, &attr);
+        nextHopBulker.create_entry(&ids[1], &statuses[1], 1, &attr);
+        nextHopBulker.create_entry(&id_without_status, 1, &attr);
+        ASSERT_EQ(statuses[0], SAI_STATUS_NOT_EXECUTED);
+        ASSERT_EQ(statuses[1], SAI_STATUS_NOT_EXECUTED);
+        ASSERT_EQ(nextHopBulker.creating_entries_count(), 3);
+
+        nextHopBulker.flush();
+
+        // Each object gets its own status, not just a null id on failure
+        ASSERT_EQ(statuses[0], SAI_STATUS_SUCCESS);
+        ASSERT_EQ(ids[0], 0x40000000000010);
+        ASSERT_EQ(statuses[1], SAI_STATUS_TABLE_FULL);
+        ASSERT_EQ(ids[1], SAI_NULL_OBJECT_ID);
+        ASSERT_EQ(id_without_status, 0x40000000000012);
+        ASSERT_EQ(nextHopBulker.creating_entries_count(), 0);
+    }
 }
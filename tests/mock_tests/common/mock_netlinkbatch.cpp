@@ -0,0 +1,182 @@
+#include <cerrno>
+#include <string>
+#include <linux/rtnetlink.h>
+
+#include "exec.h"
+#include "netlinkbatch.h"
+
+/*
+ * Every queued netlink request is reported through swss::exec() with the same
+ * description the real library logs, so tests can observe and fail kernel
+ * programming the same way they do for shell commands.
+ */
+namespace swss {
+    NetlinkBatch::NetlinkBatch()
+    {
+    }
+
+    NetlinkBatch::~NetlinkBatch()
+    {
+    }
+
+    void NetlinkBatch::queue(const std::string &desc, Builder build)
+    {
+        m_requests.push_back({desc, build});
+    }
+
+    void NetlinkBatch::addBridge(const std::string &name)
+    {
+        queue("link add " + name + " type bridge", nullptr);
+    }
+
+    void NetlinkBatch::addDummy(const std::string &name, uint32_t mtu)
+    {
+        queue("link add " + name + (mtu ? " mtu " + std::to_string(mtu) : "") + " type dummy", nullptr);
+    }
+
+    void NetlinkBatch::addVlan(const std::string &name, const std::string &parent, uint16_t vlanId,
+                               const MacAddress &mac, bool up)
+    {
+        queue("link add link " + parent + (up ? " up" : "") + " name " + name +
+              (mac ? " address " + mac.to_string() : "") + " type vlan id " + std::to_string(vlanId), nullptr);
+    }
+
+    void NetlinkBatch::addVxlan(const std::string &name, uint32_t vni, const std::string &srcIp,
+                                const std::string &dstIp, const MacAddress &mac,
+                                bool learning, uint16_t dstPort)
+    {
+        queue("link add " + name + (mac ? " address " + mac.to_string() : "") +
+              " type vxlan id " + std::to_string(vni) +
+              (srcIp.empty() ? "" : " local " + srcIp) +
+              (dstIp.empty() ? "" : " remote " + dstIp) +
+              (learning ? "" : " nolearning") + " dstport " + std::to_string(dstPort), nullptr);
+    }
+
+    void NetlinkBatch::delLink(const std::string &name)
+    {
+        queue("link del " + name, nullptr);
+    }
+
+    void NetlinkBatch::setAdminState(const std::string &name, bool up)
+    {
+        queue("link set " + name + (up ? " up" : " down"), nullptr);
+    }
+
+    void NetlinkBatch::setMtu(const std::string &name, uint32_t mtu)
+    {
+        queue("link set " + name + " mtu " + std::to_string(mtu), nullptr);
+    }
+
+    void NetlinkBatch::setMac(const std::string &name, const MacAddress &mac)
+    {
+        queue("link set " + name + " address " + mac.to_string(), nullptr);
+    }
+
+    void NetlinkBatch::setMaster(const std::string &name, const std::string &master)
+    {
+        queue("link set " + name + (master.empty() ? " nomaster" : " master " + master), nullptr);
+    }
+
+    void NetlinkBatch::addAddress(const std::string &dev, const IpPrefix &prefix, uint32_t metric)
+    {
+        queue("address add " + prefix.to_string() + " dev " + dev +
+              (metric ? " metric " + std::to_string(metric) : ""), nullptr);
+    }
+
+    void NetlinkBatch::delAddress(const std::string &dev, const IpPrefix &prefix)
+    {
+        queue("address del " + prefix.to_string() + " dev " + dev, nullptr);
+    }
+
+    void NetlinkBatch::addBridgeVlan(const std::string &dev, uint16_t vid, bool pvidUntagged, bool self)
+    {
+        queue("bridge vlan add vid " + std::to_string(vid) + " dev " + dev +
+              (pvidUntagged ? " pvid untagged" : "") + (self ? " self" : ""), nullptr);
+    }
+
+    void NetlinkBatch::delBridgeVlan(const std::string &dev, uint16_t vid, bool self)
+    {
+        queue("bridge vlan del vid " + std::to_string(vid) + " dev " + dev + (self ? " self" : ""), nullptr);
+    }
+
+    void NetlinkBatch::queueBridgeVlans(int type, const std::string &dev, const std::set<uint16_t> &vids)
+    {
+        std::string ranges;
+        for (auto it = vids.begin(); it != vids.end();)
+        {
+            uint16_t first = *it, last = *it;
+            while (++it != vids.end() && *it == last + 1)
+            {
+                last = *it;
+            }
+            ranges += (ranges.empty() ? "" : ",") + std::to_string(first) +
+                      (last != first ? "-" + std::to_string(last) : "");
+        }
+        queue(std::string("bridge vlan ") + (type == RTM_SETLINK ? "add" : "del") + " vid " + ranges + " dev " + dev, nullptr);
+    }
+
+    void NetlinkBatch::addBridgeVlans(const std::string &dev, const std::set<uint16_t> &vids)
+    {
+        queueBridgeVlans(RTM_SETLINK, dev, vids);
+    }
+
+    void NetlinkBatch::delBridgeVlans(const std::string &dev, const std::set<uint16_t> &vids)
+    {
+        queueBridgeVlans(RTM_DELLINK, dev, vids);
+    }
+
+    void NetlinkBatch::setNeighbor(const std::string &dev, const IpAddress &ip, const MacAddress &mac)
+    {
+        queue("neigh replace " + ip.to_string() + " lladdr " + mac.to_string() + " dev " + dev, nullptr);
+    }
+
+    void NetlinkBatch::delNeighbor(const std::string &dev, const IpAddress &ip)
+    {
+        queue("neigh del " + ip.to_string() + " dev " + dev, nullptr);
+    }
+
+    bool NetlinkBatch::commit(bool stopOnError)
+    {
+        bool ok = true;
+
+        m_lastError.clear();
+        m_results.assign(m_requests.size(), ECANCELED);
+        for (size_t i = 0; i < m_requests.size() && (ok || !stopOnError); i++)
+        {
+            std::string res;
+            m_results[i] = swss::exec(m_requests[i].desc, res) != 0 ? EIO : 0;
+            if (m_results[i] != 0)
+            {
+                if (m_lastError.empty())
+                {
+                    m_lastError = "'" + m_requests[i].desc + "' failed";
+                }
+                ok = false;
+            }
+        }
+        m_requests.clear();
+
+        return ok;
+    }
+
+    const std::string &NetlinkBatch::getLastError() const
+    {
+        return m_lastError;
+    }
+
+    const std::vector<int> &NetlinkBatch::getResults() const
+    {
+        return m_results;
+    }
+
+    size_t NetlinkBatch::size() const
+    {
+        return m_requests.size();
+    }
+
+    bool NetlinkBatch::getBridgeVlans(const std::string &dev, std::set<uint16_t> &vlans)
+    {
+        vlans.clear();
+        return true;
+    }
+}
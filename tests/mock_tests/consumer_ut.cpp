@@ -322,4 +322,311 @@ namespace consumer_test
         validate_syncmap(consumer->m_toSync, 1, key, exp_kofv);
 
     }
+
+    struct RetryOrch : public Orch
+    {
+        RetryOrch(swss::DBConnector *db, const string &table)
+            : Orch(db, table)
+        {
+        }
+
+        void doTask(Consumer &consumer) override
+        {
+            attempts++;
+            if (ready)
+            {
+                consumer.m_toSync.clear();
+            }
+            else if (!dependency.empty())
+            {
+                for (size_t i = 0; i < consumer.m_toSync.size(); i++)
+                {
+                    consumer.waitFor(dependency);
+                }
+            }
+        }
+
+        Consumer *getConsumer(const string &table)
+        {
+            return dynamic_cast<Consumer *>(getExecutor(table));
+        }
+
+        bool ready = false;
+        int attempts = 0;
+        string dependency;
+    };
+
+    TEST_F(ConsumerTest, ConsumerDrain_DirtyScheduling)
+    {
+        RetryOrch blocked(m_app_db.get(), "TEST_RETRY_TABLE");
+        RetryOrch other(m_app_db.get(), "TEST_OTHER_TABLE");
+        auto retryConsumer = blocked.getConsumer("TEST_RETRY_TABLE");
+        auto otherConsumer = other.getConsumer("TEST_OTHER_TABLE");
+
+        Consumer::setDirtyScheduling(true);
+
+        // New task is always attempted
+        retryConsumer->addToSync(KeyOpFieldsValuesTuple({ key, SET_COMMAND, { { f1, v1a } } }));
+        ASSERT_TRUE(retryConsumer->isDirty());
+        retryConsumer->drain();
+        ASSERT_EQ(blocked.attempts, 1);
+        ASSERT_EQ(retryConsumer->m_toSync.size(), 1);
+
+        // Nothing changed, the pending task is not retried
+        auto avoided = Consumer::getSweepsAvoided();
+        ASSERT_FALSE(retryConsumer->isDirty());
+        static_cast<Orch *>(&blocked)->doTask();
+        ASSERT_EQ(blocked.attempts, 1);
+        ASSERT_EQ(Consumer::getSweepsAvoided(), avoided + 1);
+
+        // Progress in another consumer wakes the pending task
+        other.ready = true;
+        otherConsumer->addToSync(KeyOpFieldsValuesTuple({ key, SET_COMMAND, { { f1, v1a } } }));
+        otherConsumer->drain();
+        ASSERT_TRUE(otherConsumer->m_toSync.empty());
+        ASSERT_TRUE(retryConsumer->isDirty());
+        blocked.ready = true;
+        static_cast<Orch *>(&blocked)->doTask();
+        ASSERT_EQ(blocked.attempts, 2);
+        ASSERT_TRUE(retryConsumer->m_toSync.empty());
+
+        // Explicit wake up retries without progress
+        blocked.ready = false;
+        retryConsumer->addToSync(KeyOpFieldsValuesTuple({ key, SET_COMMAND, { { f1, v1a } } }));
+        retryConsumer->drain();
+        ASSERT_FALSE(retryConsumer->isDirty());
+        Consumer::wakeAll();
+        ASSERT_TRUE(retryConsumer->isDirty());
+
+        Consumer::setDirtyScheduling(false);
+    }
+
+    TEST_F(ConsumerTest, ConsumerDrain_DirtyScheduling_Dependency)
+    {
+        RetryOrch blocked(m_app_db.get(), "TEST_RETRY_TABLE");
+        RetryOrch other(m_app_db.get(), "TEST_OTHER_TABLE");
+        auto retryConsumer = blocked.getConsumer("TEST_RETRY_TABLE");
+        auto otherConsumer = other.getConsumer("TEST_OTHER_TABLE");
+        blocked.dependency = "vrf Vrf1";
+
+        Consumer::setDirtyScheduling(true);
+
+        retryConsumer->addToSync(KeyOpFieldsValuesTuple({ key, SET_COMMAND, { { f1, v1a } } }));
+        retryConsumer->drain();
+        ASSERT_EQ(blocked.attempts, 1);
+        ASSERT_FALSE(retryConsumer->isDirty());
+
+        // Progress in another consumer does not wake a task waiting on a named dependency
+        other.ready = true;
+        otherConsumer->addToSync(KeyOpFieldsValuesTuple({ key, SET_COMMAND, { { f1, v1a } } }));
+        otherConsumer->drain();
+        ASSERT_TRUE(otherConsumer->m_toSync.empty());
+        ASSERT_FALSE(retryConsumer->isDirty());
+        Consumer::wake(Consumer::PROGRESS_DEPENDENCY);
+        ASSERT_FALSE(retryConsumer->isDirty());
+
+        // Nor does another dependency
+        Consumer::wake("vrf Vrf2");
+        ASSERT_FALSE(retryConsumer->isDirty());
+        static_cast<Orch *>(&blocked)->doTask();
+        ASSERT_EQ(blocked.attempts, 1);
+
+        // The dependency it waits on does
+        Consumer::wake("vrf Vrf1");
+        ASSERT_TRUE(retryConsumer->isDirty());
+        blocked.ready = true;
+        static_cast<Orch *>(&blocked)->doTask();
+        ASSERT_EQ(blocked.attempts, 2);
+        ASSERT_TRUE(retryConsumer->m_toSync.empty());
+
+        // A task left without a named dependency waits on any progress
+        blocked.ready = false;
+        blocked.dependency.clear();
+        retryConsumer->addToSync(KeyOpFieldsValuesTuple({ key, SET_COMMAND, { { f1, v1a } } }));
+        retryConsumer->drain();
+        ASSERT_FALSE(retryConsumer->isDirty());
+        Consumer::wake(Consumer::PROGRESS_DEPENDENCY);
+        ASSERT_TRUE(retryConsumer->isDirty());
+
+        Consumer::setDirtyScheduling(false);
+    }
+
+    TEST_F(ConsumerTest, ConsumerParkToSync_Wake)
+    {
+        string dependency = "neighbor 10.0.0.1@Ethernet0";
+        auto entry = KeyOpFieldsValuesTuple(
+            { key,
+                SET_COMMAND,
+                { { f1, v1a },
+                    { f2, v2a } } });
+
+        consumer->addToSync(entry);
+        auto it = consumer->parkToSync(consumer->m_toSync.begin(), dependency);
+        ASSERT_EQ(it, consumer->m_toSync.end());
+        ASSERT_TRUE(consumer->m_toSync.empty());
+        ASSERT_EQ(consumer->getParkedSize(), 1);
+        ASSERT_EQ(consumer->getParkedCount(), 1);
+
+        // Parked tasks are still pending
+        vector<string> ts;
+        consumer->dumpPendingTasks(ts);
+        ASSERT_EQ(ts.size(), 1);
+
+        // Unrelated dependency does not wake the task
+        Consumer::wake("neighbor 10.0.0.2@Ethernet0");
+        ASSERT_TRUE(consumer->m_toSync.empty());
+
+        Consumer::wake(dependency);
+        ASSERT_EQ(consumer->getParkedSize(), 0);
+        ASSERT_EQ(consumer->getWokenCount(), 1);
+        validate_syncmap(consumer->m_toSync, 1, key, entry);
+    }
+
+    TEST_F(ConsumerTest, ConsumerParkToSync_NewTask)
+    {
+        // Test case, a new SET merges with the parked SET
+        auto entrya = KeyOpFieldsValuesTuple(
+            { key,
+                SET_COMMAND,
+                { { f1, v1a },
+                    { f2, v2a } } });
+
+        auto entryb = KeyOpFieldsValuesTuple(
+            { key,
+                SET_COMMAND,
+                { { f1, v1b } } });
+
+        consumer->addToSync(entrya);
+        consumer->parkToSync(consumer->m_toSync.begin(), "port Ethernet8 ready");
+        consumer->addToSync(entryb);
+        ASSERT_EQ(consumer->getParkedSize(), 0);
+
+        exp_kofv = KeyOpFieldsValuesTuple(
+            { key,
+                SET_COMMAND,
+                { { f2, v2a },
+                    { f1, v1b } } });
+        validate_syncmap(consumer->m_toSync, 1, key, exp_kofv);
+
+        // Waking the stale dependency is a no-op
+        Consumer::wake("port Ethernet8 ready");
+        ASSERT_EQ(consumer->getWokenCount(), 0);
+    }
+
+    TEST_F(ConsumerTest, ConsumerParkToSync_Wake_After_Del)
+    {
+        // Test case, DEL then SET pending, the SET is parked while the DEL is retried
+        string dependency = "neighbor 10.0.0.1@Ethernet0";
+        auto entrya = KeyOpFieldsValuesTuple(
+            { key,
+                DEL_COMMAND,
+                { } });
+
+        auto entryb = KeyOpFieldsValuesTuple(
+            { key,
+                SET_COMMAND,
+                { { f1, v1a },
+                    { f2, v2a } } });
+
+        consumer->addToSync(entrya);
+        consumer->addToSync(entryb);
+        auto it = consumer->m_toSync.begin();
+        ASSERT_EQ(kfvOp(it->second), DEL_COMMAND);
+        ++it;
+        consumer->parkToSync(it, dependency);
+        ASSERT_EQ(consumer->m_toSync.size(), 1);
+
+        // The woken SET still follows the pending DEL
+        Consumer::wake(dependency);
+        ASSERT_EQ(consumer->getParkedSize(), 0);
+        ASSERT_EQ(consumer->m_toSync.size(), 2);
+        it = consumer->m_toSync.begin();
+        ASSERT_EQ(it->second, entrya);
+        ++it;
+        ASSERT_EQ(it->second, entryb);
+    }
+
+    TEST_F(ConsumerTest, ConsumerAddToSync_Set_Merge_Many_Fields)
+    {
+        // Test case, SET then SET with more fields than the linear lookup handles
+        vector<FieldValueTuple> fvsa;
+        vector<FieldValueTuple> fvsb;
+        vector<FieldValueTuple> expected;
+        for (int i = 0; i < 16; i++)
+        {
+            fvsa.push_back({ "field" + to_string(i), "a" });
+        }
+        for (int i = 8; i < 24; i++)
+        {
+            fvsb.push_back({ "field" + to_string(i), "b" });
+        }
+        // Duplicated field in the same SET, the last one wins
+        fvsb.push_back({ "field8", "c" });
+
+        for (int i = 0; i < 8; i++)
+        {
+            expected.push_back({ "field" + to_string(i), "a" });
+        }
+        for (int i = 9; i < 24; i++)
+        {
+            expected.push_back({ "field" + to_string(i), "b" });
+        }
+        expected.push_back({ "field8", "c" });
+
+        consumer->addToSync(KeyOpFieldsValuesTuple({ key, SET_COMMAND, fvsa }));
+        consumer->addToSync(KeyOpFieldsValuesTuple({ key, SET_COMMAND, fvsb }));
+
+        exp_kofv = KeyOpFieldsValuesTuple({ key, SET_COMMAND, expected });
+        validate_syncmap(consumer->m_toSync, 1, key, exp_kofv);
+    }
+
+    TEST_F(ConsumerTest, ConsumerAddToSync_Route_Flood)
+    {
+        // Test case, 10 rounds of route tuples over the same prefixes, as fpmsyncd sends on a route flood,
+        // the 9th round deletes every prefix
+        const int rounds = 10;
+        const int prefixes = 1000;
+
+        vector<string> keys;
+        for (int i = 0; i < prefixes; i++)
+        {
+            keys.push_back("10.0." + to_string(i >> 8) + "." + to_string(i & 0xff) + "/32");
+        }
+
+        for (int i = 0; i < rounds * prefixes; i++)
+        {
+            const string &route = keys[i % prefixes];
+            if (i / prefixes == 8)
+            {
+                consumer->addToSync(KeyOpFieldsValuesTuple({ route, DEL_COMMAND, { } }));
+            }
+            else
+            {
+                consumer->addToSync(KeyOpFieldsValuesTuple(
+                    { route,
+                        SET_COMMAND,
+                        { { "nexthop", "10.0.0." + to_string(i % 8) },
+                            { "ifname", "Ethernet" + to_string((i % 8) * 4) } } }));
+            }
+        }
+
+        // Every prefix was last set after the same DEL, so DEL then the last SET is pending for each
+        ASSERT_EQ(consumer->m_toSync.size(), static_cast<size_t>(prefixes * 2));
+
+        for (int i = 0; i < prefixes; i++)
+        {
+            int last = (rounds - 1) * prefixes + i;
+            auto range = consumer->m_toSync.equal_range(keys[i]);
+            ASSERT_EQ(distance(range.first, range.second), 2);
+
+            auto it = range.first;
+            ASSERT_EQ(it->second, KeyOpFieldsValuesTuple({ keys[i], DEL_COMMAND, { } }));
+            ++it;
+            ASSERT_EQ(it->second, KeyOpFieldsValuesTuple(
+                { keys[i],
+                    SET_COMMAND,
+                    { { "nexthop", "10.0.0." + to_string(last % 8) },
+                        { "ifname", "Ethernet" + to_string((last % 8) * 4) } } }));
+        }
+    }
 }
@@ -0,0 +1,179 @@
+#define private public
+#include "crmorch.h"
+#undef private
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+#include "mock_table.h"
+
+namespace crmorch_test
+{
+    using namespace std;
+
+    /* ACL tables whose attributes can't be read */
+    set<sai_object_id_t> failingAclTables;
+
+    sai_status_t _ut_stub_get_acl_table_attribute(
+        _In_ sai_object_id_t acl_table_id,
+        _In_ uint32_t attr_count,
+        _Inout_ sai_attribute_t *attr_list)
+    {
+        if (failingAclTables.count(acl_table_id))
+        {
+            return SAI_STATUS_FAILURE;
+        }
+
+        for (uint32_t i = 0; i < attr_count; i++)
+        {
+            attr_list[i].value.u32 = static_cast<uint32_t>(acl_table_id * 100 + attr_list[i].id);
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    struct CrmOrchTest : public ::testing::Test
+    {
+        shared_ptr<swss::DBConnector> m_config_db;
+        shared_ptr<swss::DBConnector> m_counters_db;
+        shared_ptr<CrmOrch> m_crmOrch;
+
+        void SetUp() override
+        {
+            ::testing_db::reset();
+            failingAclTables.clear();
+
+            m_config_db = make_shared<swss::DBConnector>("CONFIG_DB", 0);
+            m_counters_db = make_shared<swss::DBConnector>("COUNTERS_DB", 0);
+            m_crmOrch = make_shared<CrmOrch>(m_config_db.get(), CFG_CRM_TABLE_NAME);
+        }
+
+        map<string, string> getStats()
+        {
+            Table crm_table(m_counters_db.get(), COUNTERS_CRM_TABLE);
+            vector<FieldValueTuple> fvs;
+            crm_table.get("STATS", fvs);
+            return map<string, string>(fvs.begin(), fvs.end());
+        }
+
+        void clearStats()
+        {
+            Table crm_table(m_counters_db.get(), COUNTERS_CRM_TABLE);
+            crm_table.del("STATS");
+        }
+
+        /* What a poll reads for the resource */
+        CrmOrch::CrmResourceCounter &setAvailable(CrmResourceType type, uint32_t available)
+        {
+            auto &cnt = m_crmOrch->m_resourcesMap.at(type).countersMap["STATS"];
+            cnt.availableCounter = available;
+            cnt.availableRead = true;
+            return cnt;
+        }
+    };
+
+    TEST_F(CrmOrchTest, WritesOnlyChangedCounters)
+    {
+        m_crmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
+        m_crmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
+        setAvailable(CrmResourceType::CRM_IPV4_ROUTE, 100);
+
+        m_crmOrch->updateCrmCountersTable();
+        ASSERT_EQ(getStats(), (map<string, string>{
+                { "crm_stats_ipv4_route_used", "2" },
+                { "crm_stats_ipv4_route_available", "100" },
+            }));
+
+        // Nothing is written when nothing changed
+        clearStats();
+        m_crmOrch->updateCrmCountersTable();
+        ASSERT_TRUE(getStats().empty());
+
+        // A used counter update also adjusts the available count
+        m_crmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
+        m_crmOrch->updateCrmCountersTable();
+        ASSERT_EQ(getStats(), (map<string, string>{
+                { "crm_stats_ipv4_route_used", "3" },
+                { "crm_stats_ipv4_route_available", "99" },
+            }));
+
+        // Only the field which changed is written
+        clearStats();
+        setAvailable(CrmResourceType::CRM_IPV4_ROUTE, 50);
+        m_crmOrch->updateCrmCountersTable();
+        ASSERT_EQ(getStats(), (map<string, string>{
+                { "crm_stats_ipv4_route_available", "50" },
+            }));
+    }
+
+    TEST_F(CrmOrchTest, ReportsThresholdCrossings)
+    {
+        // The default thresholds are 70% and 85% of used and available
+        auto &cnt = setAvailable(CrmResourceType::CRM_IPV4_ROUTE, 100);
+
+        for (int i = 0; i < 84; i++)
+        {
+            m_crmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
+        }
+        ASSERT_EQ(cnt.usedCounter, 84);
+        ASSERT_EQ(cnt.availableCounter, 16);
+        ASSERT_EQ(cnt.exceededLogCounter, 0);
+
+        m_crmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
+        ASSERT_EQ(cnt.exceededLogCounter, 1);
+
+        // Updates above the high threshold only report the crossing
+        m_crmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
+        m_crmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
+        ASSERT_EQ(cnt.exceededLogCounter, 1);
+
+        // The periodic check keeps reporting it
+        m_crmOrch->checkCrmThresholds();
+        ASSERT_EQ(cnt.exceededLogCounter, 2);
+
+        for (int i = 0; i < 14; i++)
+        {
+            m_crmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
+        }
+        ASSERT_EQ(cnt.usedCounter, 71);
+        ASSERT_EQ(cnt.exceededLogCounter, 2);
+
+        m_crmOrch->decCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
+        ASSERT_EQ(cnt.exceededLogCounter, 0);
+
+        m_crmOrch->incCrmResUsedCounter(CrmResourceType::CRM_IPV4_ROUTE);
+        ASSERT_EQ(cnt.exceededLogCounter, 0);
+    }
+
+    TEST_F(CrmOrchTest, ReadsAclTablesAfterFailedOne)
+    {
+        sai_acl_api_t ut_acl_api = {};
+        auto *old_acl_api = sai_acl_api;
+        ut_acl_api.get_acl_table_attribute = _ut_stub_get_acl_table_attribute;
+        sai_acl_api = &ut_acl_api;
+
+        for (sai_object_id_t table : { 1, 2, 3 })
+        {
+            m_crmOrch->incCrmAclTableUsedCounter(CrmResourceType::CRM_ACL_ENTRY, table);
+        }
+        m_crmOrch->incCrmAclTableUsedCounter(CrmResourceType::CRM_ACL_COUNTER, 2);
+        m_crmOrch->incCrmAclTableUsedCounter(CrmResourceType::CRM_ACL_COUNTER, 4);
+        failingAclTables = { 1, 3 };
+
+        m_crmOrch->getAclTableResAvailability();
+        sai_acl_api = old_acl_api;
+
+        auto &entries = m_crmOrch->m_resourcesMap.at(CrmResourceType::CRM_ACL_ENTRY).countersMap;
+        auto &counters = m_crmOrch->m_resourcesMap.at(CrmResourceType::CRM_ACL_COUNTER).countersMap;
+
+        ASSERT_FALSE(entries.at(m_crmOrch->getCrmAclTableKey(1)).availableRead);
+        ASSERT_FALSE(entries.at(m_crmOrch->getCrmAclTableKey(3)).availableRead);
+
+        // Entries and counters of a table are read together
+        auto &entry = entries.at(m_crmOrch->getCrmAclTableKey(2));
+        auto &counter = counters.at(m_crmOrch->getCrmAclTableKey(2));
+        ASSERT_TRUE(entry.availableRead);
+        ASSERT_EQ(entry.availableCounter, 200 + SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_ENTRY);
+        ASSERT_TRUE(counter.availableRead);
+        ASSERT_EQ(counter.availableCounter, 200 + SAI_ACL_TABLE_ATTR_AVAILABLE_ACL_COUNTER);
+
+        ASSERT_TRUE(counters.at(m_crmOrch->getCrmAclTableKey(4)).availableRead);
+    }
+}
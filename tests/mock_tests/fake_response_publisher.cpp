@@ -3,7 +3,8 @@
 
 #include "response_publisher.h"
 
-ResponsePublisher::ResponsePublisher() : m_db("APPL_STATE_DB", 0) {}
+ResponsePublisher::ResponsePublisher(bool buffered)
+    : m_db("APPL_STATE_DB", 0), m_buffered(buffered) {}
 
 void ResponsePublisher::publish(
     const std::string& table, const std::string& key,
@@ -20,3 +21,7 @@ void ResponsePublisher::writeToDB(
     const std::string& table, const std::string& key,
     const std::vector<swss::FieldValueTuple>& values, const std::string& op,
     bool replace) {}
+
+void ResponsePublisher::flush() {}
+
+void ResponsePublisher::setBuffered(bool buffered) {}
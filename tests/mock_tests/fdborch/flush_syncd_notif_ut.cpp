@@ -445,4 +445,48 @@ namespace fdb_syncd_flush_test
         ASSERT_EQ(m_fdborch->m_fdbStateTable.hget("Vlan40:7c:fe:90:12:22:ec", "port", port), false);
         ASSERT_EQ(m_fdborch->m_fdbStateTable.hget("Vlan40:7c:fe:90:12:22:ec", "type", entry_type), false);
     }
+
+    /* Test the per port and per vlan indices of the internal cache */
+    TEST_F(FdbOrchTest, FdbEntryIndexPortAndVlan)
+    {
+        ASSERT_NE(m_portsOrch, nullptr);
+        setUpVlan(m_portsOrch.get());
+        setUpPort(m_portsOrch.get());
+        setUpVlanMember(m_portsOrch.get());
+
+        auto bridge_port_oid = m_portsOrch->m_portList[ETH0].m_bridge_port_id;
+        auto vlan_oid = m_portsOrch->m_portList[VLAN40].m_vlan_info.vlan_oid;
+
+        /* Event 1: Learn two dynamic FDB Entries */
+        vector<uint8_t> mac_addr1 = {124, 254, 144, 18, 34, 236};
+        vector<uint8_t> mac_addr2 = {124, 254, 144, 18, 34, 237};
+        triggerUpdate(m_fdborch.get(), SAI_FDB_EVENT_LEARNED, mac_addr1, bridge_port_oid, vlan_oid);
+        triggerUpdate(m_fdborch.get(), SAI_FDB_EVENT_LEARNED, mac_addr2, bridge_port_oid, vlan_oid);
+
+        /* Make sure both indices follow the internal cache */
+        ASSERT_EQ(m_fdborch->m_entries.size(), 2);
+        ASSERT_EQ(m_fdborch->m_entriesByBridgePort[bridge_port_oid].size(), 2);
+        ASSERT_EQ(m_fdborch->m_entriesByBvId[vlan_oid].size(), 2);
+        ASSERT_EQ(m_fdborch->getFdbEntries(bridge_port_oid, vlan_oid).size(), 2);
+        ASSERT_EQ(m_fdborch->getFdbEntries(bridge_port_oid + 1, SAI_NULL_OBJECT_ID).size(), 0);
+
+        /* Event 2: Age out one of the entries */
+        triggerUpdate(m_fdborch.get(), SAI_FDB_EVENT_AGED, mac_addr1, bridge_port_oid, vlan_oid);
+        ASSERT_EQ(m_fdborch->m_entries.size(), 1);
+        ASSERT_EQ(m_fdborch->m_entriesByBridgePort[bridge_port_oid].size(), 1);
+        ASSERT_EQ(m_fdborch->m_entriesByBvId[vlan_oid].size(), 1);
+
+        /* Event 3: Flush the port, the indices are cleaned up with the last entry */
+        vector<uint8_t> flush_mac_addr = {0, 0, 0, 0, 0, 0};
+        for (map<FdbEntry, FdbData>::iterator it = m_fdborch->m_entries.begin(); it != m_fdborch->m_entries.end(); it++)
+        {
+            it->second.is_flush_pending = true;
+        }
+        triggerUpdate(m_fdborch.get(), SAI_FDB_EVENT_FLUSHED, flush_mac_addr, bridge_port_oid, SAI_NULL_OBJECT_ID);
+
+        ASSERT_EQ(m_fdborch->m_entries.size(), 0);
+        ASSERT_EQ(m_fdborch->m_entriesByBridgePort.count(bridge_port_oid), 0);
+        ASSERT_EQ(m_fdborch->m_entriesByBvId.count(vlan_oid), 0);
+        ASSERT_EQ(m_portsOrch->m_portList[ETH0].m_fdb_count, 0);
+    }
 }
@@ -17,7 +17,7 @@ bool Ethernet0IPv6Set = false;
 int cb(const std::string &cmd, std::string &stdout){
     mockCallArgs.push_back(cmd);
     if (cmd == "sysctl -w net.ipv6.conf.\"Ethernet0\".disable_ipv6=0") Ethernet0IPv6Set = true;
-    else if (cmd.find("/sbin/ip -6 address \"add\"") == 0) {
+    else if (cmd.find("address add 2001::8/64 dev Ethernet0") == 0) {
         return Ethernet0IPv6Set ? 0 : 2;
     }
     else {
@@ -76,7 +76,7 @@ namespace add_ipv6_prefix_ut
         intfmgr.doIntfAddrTask(keys, data, "SET");
         int ip_cmd_called = 0;
         for (auto cmd : mockCallArgs){
-            if (cmd.find("/sbin/ip -6 address \"add\"") == 0){
+            if (cmd.find("address add 2001::8/64 dev Ethernet0") == 0){
                 ip_cmd_called++;
             }
         }
@@ -100,7 +100,7 @@ namespace add_ipv6_prefix_ut
         intfmgr.doIntfAddrTask(keys, data, "SET");
         int ip_cmd_called = 0;
         for (auto cmd : mockCallArgs){
-            if (cmd.find("/sbin/ip -6 address \"add\"") == 0){
+            if (cmd.find("address add 2001::8/64 dev Ethernet0") == 0){
                 ip_cmd_called++;
             }
         }
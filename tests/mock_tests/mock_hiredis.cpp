@@ -1,12 +1,52 @@
 #include <stdlib.h>
 #include <hiredis/hiredis.h>
+#include <deque>
+#include <functional>
 #include <iostream>
+#include <string>
+#include <vector>
 
 // Add a global redisReply for user to mock
 redisReply *mockReply = nullptr;
 
+// Add a global handler for user to answer the commands sent with redisAppendFormattedCommand,
+// a nullptr reply falls back to the default reply
+std::function<redisReply *(const std::vector<std::string> &)> mockRedisCommand;
+
+static std::deque<redisReply *> mockReplies;
+
+static std::vector<std::string> parseCommand(const char *cmd, size_t len)
+{
+    std::vector<std::string> argv;
+    std::string command(cmd, len);
+
+    // *<argc>\r\n followed by $<len>\r\n<arg>\r\n for each argument
+    size_t pos = command.find("\r\n");
+    size_t argc = strtoul(command.c_str() + 1, nullptr, 10);
+    for (size_t i = 0; i < argc && pos != std::string::npos; i++)
+    {
+        pos += 2;
+        size_t end = command.find("\r\n", pos);
+        size_t arglen = strtoul(command.c_str() + pos + 1, nullptr, 10);
+        argv.emplace_back(command, end + 2, arglen);
+        pos = end + 2 + arglen;
+    }
+
+    return argv;
+}
+
 int redisGetReply(redisContext *c, void **reply)
 {
+    if (!mockReplies.empty())
+    {
+        *reply = mockReplies.front();
+        mockReplies.pop_front();
+        if (*reply != nullptr)
+        {
+            return 0;
+        }
+    }
+
     if (mockReply == nullptr)
     {
         *reply = calloc(sizeof(redisReply), 1);
@@ -21,6 +61,10 @@ int redisGetReply(redisContext *c, void **reply)
 
 int redisAppendFormattedCommand(redisContext *c, const char *cmd, size_t len)
 {
+    if (mockRedisCommand)
+    {
+        mockReplies.push_back(mockRedisCommand(parseCommand(cmd, len)));
+    }
     return 0;
 }
 
@@ -0,0 +1,480 @@
+#define private public
+#include "natorch.h"
+#undef private
+#include "ut_helper.h"
+#include "mock_orchagent_main.h"
+
+extern sai_nat_api_t *sai_nat_api;
+
+namespace natorch_test
+{
+    using namespace std;
+
+    /* State of a NAT entry in the fake SAI, by the source IP of its key */
+    struct FakeNatEntry
+    {
+        bool hitBit = false;
+        bool failBulkGet = false;
+        bool failGet = false;
+    };
+
+    map<uint32_t, FakeNatEntry> fakeNatEntries;
+    sai_status_t bulkGetStatus;
+    uint32_t bulkGetCalls;
+    uint32_t getCalls;
+
+    sai_status_t fakeGetHitBit(const sai_nat_entry_t *entry, sai_attribute_t *attrs, bool bulk)
+    {
+        auto it = fakeNatEntries.find(entry->data.key.src_ip);
+        if (it == fakeNatEntries.end() || (bulk ? it->second.failBulkGet : it->second.failGet))
+        {
+            return SAI_STATUS_FAILURE;
+        }
+
+        attrs[0].value.booldata = it->second.hitBit;
+        if (attrs[1].id == SAI_NAT_ENTRY_ATTR_HIT_BIT_COR && attrs[1].value.booldata)
+        {
+            it->second.hitBit = false;
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t fakeGetNatEntryAttribute(const sai_nat_entry_t *entry, uint32_t attr_count, sai_attribute_t *attr_list)
+    {
+        getCalls++;
+        return fakeGetHitBit(entry, attr_list, false);
+    }
+
+    sai_status_t fakeGetNatEntriesAttribute(uint32_t object_count, const sai_nat_entry_t *entries, uint32_t *attr_count,
+                                            sai_attribute_t **attr_list, sai_bulk_op_error_mode_t mode, sai_status_t *object_statuses)
+    {
+        bulkGetCalls++;
+        if (bulkGetStatus != SAI_STATUS_SUCCESS && bulkGetStatus != SAI_STATUS_FAILURE)
+        {
+            return bulkGetStatus;
+        }
+
+        sai_status_t status = SAI_STATUS_SUCCESS;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = fakeGetHitBit(&entries[i], attr_list[i], true);
+            if (object_statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+
+    /* NAT entries programmed in the fake SAI and the ones it fails to create, by source IP */
+    set<uint32_t> hwNatEntries;
+    set<uint32_t> failingNatEntries;
+    vector<uint32_t> bulkCreateSizes;
+    vector<uint32_t> bulkRemoveSizes;
+    uint32_t createCalls;
+
+    sai_status_t fakeCreateEntry(const sai_nat_entry_t *entry)
+    {
+        uint32_t ip = entry->data.key.src_ip;
+        if (failingNatEntries.count(ip))
+        {
+            return SAI_STATUS_FAILURE;
+        }
+        return hwNatEntries.insert(ip).second ? SAI_STATUS_SUCCESS : SAI_STATUS_ITEM_ALREADY_EXISTS;
+    }
+
+    sai_status_t fakeRemoveEntry(const sai_nat_entry_t *entry)
+    {
+        return hwNatEntries.erase(entry->data.key.src_ip) ? SAI_STATUS_SUCCESS : SAI_STATUS_ITEM_NOT_FOUND;
+    }
+
+    sai_status_t fakeCreateNatEntry(const sai_nat_entry_t *entry, uint32_t attr_count, const sai_attribute_t *attr_list)
+    {
+        createCalls++;
+        return fakeCreateEntry(entry);
+    }
+
+    sai_status_t fakeRemoveNatEntry(const sai_nat_entry_t *entry)
+    {
+        return fakeRemoveEntry(entry);
+    }
+
+    sai_status_t fakeCreateNatEntries(uint32_t object_count, const sai_nat_entry_t *entries, const uint32_t *attr_count,
+                                      const sai_attribute_t **attr_list, sai_bulk_op_error_mode_t mode, sai_status_t *object_statuses)
+    {
+        bulkCreateSizes.push_back(object_count);
+        sai_status_t status = SAI_STATUS_SUCCESS;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = fakeCreateEntry(&entries[i]);
+            if (object_statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+
+    sai_status_t fakeRemoveNatEntries(uint32_t object_count, const sai_nat_entry_t *entries,
+                                      sai_bulk_op_error_mode_t mode, sai_status_t *object_statuses)
+    {
+        bulkRemoveSizes.push_back(object_count);
+        sai_status_t status = SAI_STATUS_SUCCESS;
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = fakeRemoveEntry(&entries[i]);
+            if (object_statuses[i] != SAI_STATUS_SUCCESS)
+            {
+                status = SAI_STATUS_FAILURE;
+            }
+        }
+        return status;
+    }
+
+    sai_status_t fakeGetSwitchAttribute(sai_object_id_t switch_id, uint32_t attr_count, sai_attribute_t *attr_list)
+    {
+        return SAI_STATUS_NOT_SUPPORTED;
+    }
+
+    static time_t monotonicTime()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return ts.tv_sec;
+    }
+
+    /* Records the failed creations instead of aborting, and asks for them to be retried */
+    struct TestNatOrch : public NatOrch
+    {
+        vector<sai_status_t> m_createFailures;
+
+        TestNatOrch(DBConnector *appDb, DBConnector *stateDb, vector<table_name_with_pri_t> &tableNames) :
+            NatOrch(appDb, stateDb, tableNames, nullptr, nullptr)
+        {
+        }
+
+        task_process_status handleSaiCreateStatus(sai_api_t api, sai_status_t status, void *context = nullptr) override
+        {
+            m_createFailures.push_back(status);
+            return task_need_retry;
+        }
+    };
+
+    struct NatOrchTest : public ::testing::Test
+    {
+        shared_ptr<swss::DBConnector> m_app_db;
+        shared_ptr<swss::DBConnector> m_config_db;
+        shared_ptr<swss::DBConnector> m_state_db;
+        TestNatOrch *m_natOrch;
+
+        sai_switch_api_t *m_oldSwitchApi;
+        sai_nat_api_t *m_oldNatApi;
+        sai_switch_api_t m_switchApi;
+        sai_nat_api_t m_natApi;
+
+        void SetUp() override
+        {
+            ::testing_db::reset();
+
+            m_app_db = make_shared<swss::DBConnector>("APPL_DB", 0);
+            m_config_db = make_shared<swss::DBConnector>("CONFIG_DB", 0);
+            m_state_db = make_shared<swss::DBConnector>("STATE_DB", 0);
+
+            ASSERT_EQ(gCrmOrch, nullptr);
+            gCrmOrch = new CrmOrch(m_config_db.get(), CFG_CRM_TABLE_NAME);
+
+            m_oldSwitchApi = sai_switch_api;
+            m_switchApi = {};
+            m_switchApi.get_switch_attribute = fakeGetSwitchAttribute;
+            sai_switch_api = &m_switchApi;
+
+            m_oldNatApi = sai_nat_api;
+            m_natApi = {};
+            m_natApi.get_nat_entry_attribute = fakeGetNatEntryAttribute;
+            m_natApi.get_nat_entries_attribute = fakeGetNatEntriesAttribute;
+            m_natApi.create_nat_entry = fakeCreateNatEntry;
+            m_natApi.remove_nat_entry = fakeRemoveNatEntry;
+            m_natApi.create_nat_entries = fakeCreateNatEntries;
+            m_natApi.remove_nat_entries = fakeRemoveNatEntries;
+            sai_nat_api = &m_natApi;
+
+            fakeNatEntries.clear();
+            bulkGetStatus = SAI_STATUS_SUCCESS;
+            bulkGetCalls = 0;
+            getCalls = 0;
+            hwNatEntries.clear();
+            failingNatEntries.clear();
+            bulkCreateSizes.clear();
+            bulkRemoveSizes.clear();
+            createCalls = 0;
+
+            vector<table_name_with_pri_t> nat_tables = {
+                { APP_NAT_TABLE_NAME, 1 },
+                { APP_NAT_GLOBAL_TABLE_NAME, 0 },
+            };
+            m_natOrch = new TestNatOrch(m_app_db.get(), m_state_db.get(), nat_tables);
+        }
+
+        void TearDown() override
+        {
+            delete m_natOrch;
+            delete gCrmOrch;
+            gCrmOrch = nullptr;
+            sai_nat_api = m_oldNatApi;
+            sai_switch_api = m_oldSwitchApi;
+        }
+
+        /* Adds a dynamic SNAT entry programmed to the hardware, last seen active at activeTime */
+        NatEntry::iterator addSnatEntry(const string &ip, time_t activeTime, const FakeNatEntry &fake)
+        {
+            NatEntryValue value;
+            value.translated_ip = IpAddress("65.55.45.1");
+            value.nat_type = "snat";
+            value.entry_type = "dynamic";
+            value.activeTime = activeTime;
+            value.ageOutTime = activeTime + m_natOrch->timeout;
+            value.addedToHw = true;
+
+            IpAddress key(ip);
+            fakeNatEntries[key.getV4Addr()] = fake;
+            m_natOrch->m_natEntries[key] = value;
+
+            auto iter = m_natOrch->m_natEntries.find(key);
+            scheduleHitBitCheck(iter, activeTime);
+            return iter;
+        }
+
+        /* Adds a dynamic SNAPT entry that isn't programmed to the hardware yet */
+        NaptEntryKey addSnaptEntry(const string &ip)
+        {
+            NaptEntryKey key;
+            key.ip_address = IpAddress(ip);
+            key.l4_port = 1000;
+            key.prototype = "TCP";
+
+            NaptEntryValue value;
+            value.translated_ip = IpAddress("65.55.45.1");
+            value.translated_l4_port = 2000;
+            value.nat_type = "snat";
+            value.entry_type = "dynamic";
+            value.addedToHw = false;
+
+            m_natOrch->m_naptEntries[key] = value;
+            return key;
+        }
+
+        bool isAddedToHw(const NaptEntryKey &key)
+        {
+            auto iter = m_natOrch->m_naptEntries.find(key);
+            return iter != m_natOrch->m_naptEntries.end() && iter->second.addedToHw;
+        }
+
+        void scheduleHitBitCheck(NatEntry::iterator iter, time_t checkTime)
+        {
+            iter->second.hitBitCheckTime = checkTime;
+            m_natOrch->m_natAgingWheel.schedule(iter->first, checkTime);
+        }
+    };
+
+    TEST_F(NatOrchTest, HitBitQueryFallsBackToEntryGets)
+    {
+        time_t now = monotonicTime();
+        time_t longAgo = now - 2 * m_natOrch->timeout;
+        FakeNatEntry active, failBulk, failBoth;
+
+        active.hitBit = true;
+        failBulk.hitBit = true;
+        failBulk.failBulkGet = true;
+        failBoth.hitBit = true;
+        failBoth.failBulkGet = true;
+        failBoth.failGet = true;
+
+        auto activeIter = addSnatEntry("10.0.0.1", longAgo, active);
+        auto failBulkIter = addSnatEntry("10.0.0.2", longAgo, failBulk);
+        auto failBothIter = addSnatEntry("10.0.0.3", longAgo, failBoth);
+
+        m_natOrch->queryHitBits();
+
+        // Only the entries the bulk get failed for are queried again, the others' hit bits are already cleared
+        ASSERT_EQ(bulkGetCalls, 1);
+        ASSERT_EQ(getCalls, 2);
+        ASSERT_TRUE(m_natOrch->m_natBulkGetSupported);
+
+        ASSERT_GE(activeIter->second.activeTime, now);
+        ASSERT_GE(failBulkIter->second.activeTime, now);
+
+        // An entry whose hit bits can't be read is neither active nor aged, it is queried again soon
+        ASSERT_EQ(failBothIter->second.activeTime, longAgo);
+        ASSERT_GE(failBothIter->second.hitBitCheckTime, now + NAT_HITBIT_N_CNTRS_QUERY_PERIOD * NAT_HITBIT_QUERY_MULTIPLE);
+        ASSERT_EQ(m_natOrch->m_natAgingWheel.size(), 3);
+
+        // A SAI without the bulk get is queried entry by entry from then on
+        bulkGetStatus = SAI_STATUS_NOT_IMPLEMENTED;
+        bulkGetCalls = 0;
+        getCalls = 0;
+        m_natOrch->rescheduleAllHitBitChecks(now);
+        m_natOrch->queryHitBits();
+        ASSERT_EQ(bulkGetCalls, 1);
+        ASSERT_EQ(getCalls, 3);
+        ASSERT_FALSE(m_natOrch->m_natBulkGetSupported);
+
+        m_natOrch->rescheduleAllHitBitChecks(now);
+        m_natOrch->queryHitBits();
+        ASSERT_EQ(bulkGetCalls, 1);
+        ASSERT_EQ(getCalls, 6);
+    }
+
+    TEST_F(NatOrchTest, EntryActivityTransitions)
+    {
+        time_t now = monotonicTime();
+        int timeout = m_natOrch->timeout;
+        time_t interval = m_natOrch->getHitBitCheckInterval(timeout);
+        time_t retry = NAT_HITBIT_N_CNTRS_QUERY_PERIOD * NAT_HITBIT_QUERY_MULTIPLE;
+        FakeNatEntry set, clear, unknown;
+
+        set.hitBit = true;
+        unknown.failBulkGet = true;
+        unknown.failGet = true;
+        ASSERT_GT(interval, retry);
+
+        auto setIter = addSnatEntry("10.0.0.1", now - 2 * timeout, set);
+        auto clearRecentIter = addSnatEntry("10.0.0.2", now - 10, clear);
+        auto clearOldIter = addSnatEntry("10.0.0.3", now - 2 * timeout, clear);
+        auto unknownRecentIter = addSnatEntry("10.0.0.4", now - 10, unknown);
+        auto unknownOldIter = addSnatEntry("10.0.0.5", now - 2 * timeout, unknown);
+        for (auto iter : { setIter, clearRecentIter, clearOldIter, unknownRecentIter, unknownOldIter })
+        {
+            scheduleHitBitCheck(iter, now);
+        }
+
+        m_natOrch->queryHitBits();
+        time_t end = monotonicTime();
+
+        // Set refreshes the entry and checks it again after the regular interval
+        ASSERT_GE(setIter->second.activeTime, now);
+        ASSERT_EQ(setIter->second.ageOutTime, setIter->second.activeTime + timeout);
+        ASSERT_EQ(setIter->second.hitBitCheckTime, setIter->second.activeTime + interval);
+
+        // Clear within the timeout keeps the entry and checks it again after the regular interval
+        ASSERT_EQ(clearRecentIter->second.activeTime, now - 10);
+        ASSERT_GE(clearRecentIter->second.hitBitCheckTime, now + interval);
+        ASSERT_LE(clearRecentIter->second.hitBitCheckTime, end + interval);
+
+        // Clear past the timeout ages the entry out, it is checked again soon in case it is not removed
+        ASSERT_EQ(clearOldIter->second.activeTime, now - 2 * timeout);
+        ASSERT_GE(clearOldIter->second.hitBitCheckTime, now + retry);
+        ASSERT_LE(clearOldIter->second.hitBitCheckTime, end + retry);
+
+        // Unknown is not taken as inactive: the entry keeps its activity and is checked again soon
+        ASSERT_EQ(unknownRecentIter->second.activeTime, now - 10);
+        ASSERT_EQ(unknownOldIter->second.activeTime, now - 2 * timeout);
+        for (auto iter : { unknownRecentIter, unknownOldIter })
+        {
+            ASSERT_GE(iter->second.hitBitCheckTime, now + retry);
+            ASSERT_LE(iter->second.hitBitCheckTime, end + retry);
+        }
+
+        // Once readable again, the entry that was recently active is still active
+        fakeNatEntries[IpAddress("10.0.0.4").getV4Addr()] = set;
+        scheduleHitBitCheck(unknownRecentIter, now);
+        m_natOrch->queryHitBits();
+        ASSERT_GE(unknownRecentIter->second.activeTime, now);
+    }
+
+    TEST_F(NatOrchTest, RescheduleLeavesNoStaleChecks)
+    {
+        time_t now = monotonicTime();
+        FakeNatEntry active;
+        active.hitBit = true;
+
+        addSnatEntry("10.0.0.1", now, active);
+        addSnatEntry("10.0.0.2", now, active);
+        auto &wheel = m_natOrch->m_natAgingWheel;
+        ASSERT_EQ(wheel.size(), 2);
+
+        // Timeout changes reschedule every entry, the previous checks are dropped
+        m_natOrch->rescheduleAllHitBitChecks(now);
+        m_natOrch->rescheduleAllHitBitChecks(now);
+        ASSERT_EQ(wheel.size(), 2);
+
+        // An entry scheduled twice for the same time is queried once
+        scheduleHitBitCheck(m_natOrch->m_natEntries.find(IpAddress("10.0.0.1")), now);
+        ASSERT_EQ(wheel.size(), 3);
+
+        m_natOrch->queryHitBits();
+        ASSERT_EQ(bulkGetCalls, 1);
+        ASSERT_EQ(wheel.size(), 2);
+    }
+
+    TEST_F(NatOrchTest, BulkFlushAppliesEntryOutcomes)
+    {
+        ASSERT_NE(m_natOrch->m_natBulker, nullptr);
+        auto first = addSnaptEntry("10.0.0.1");
+        auto failing = addSnaptEntry("10.0.0.2");
+        auto last = addSnaptEntry("10.0.0.3");
+        failingNatEntries.insert(failing.ip_address.getV4Addr());
+
+        // Creations are queued until the flush, their bookkeeping runs with it
+        m_natOrch->m_natBulkMode = true;
+        for (const auto &key : { first, failing, last })
+        {
+            ASSERT_TRUE(m_natOrch->addHwSnaptEntry(key));
+        }
+        ASSERT_TRUE(bulkCreateSizes.empty());
+        ASSERT_EQ(m_natOrch->totalEntries, 0);
+
+        m_natOrch->flushNatBulker();
+        m_natOrch->m_natBulkMode = false;
+        ASSERT_EQ(bulkCreateSizes, vector<uint32_t>({ 3 }));
+        ASSERT_EQ(createCalls, 0);
+        ASSERT_EQ(m_natOrch->m_createFailures, vector<sai_status_t>({ SAI_STATUS_FAILURE }));
+        ASSERT_TRUE(m_natOrch->m_natBulkOps.empty());
+
+        ASSERT_TRUE(isAddedToHw(first));
+        ASSERT_FALSE(isAddedToHw(failing));
+        ASSERT_TRUE(isAddedToHw(last));
+        ASSERT_EQ(m_natOrch->totalEntries, 2);
+        ASSERT_EQ(m_natOrch->totalDynamicNaptEntries, 2);
+        ASSERT_EQ(m_natOrch->m_naptAgingWheel.size(), 2);
+
+        // Outside of bulk mode the failure is returned right away
+        ASSERT_FALSE(m_natOrch->addHwSnaptEntry(failing));
+        ASSERT_EQ(createCalls, 1);
+        ASSERT_EQ(bulkCreateSizes.size(), 1);
+        ASSERT_FALSE(isAddedToHw(failing));
+
+        // Removals are queued the same way
+        m_natOrch->m_natBulkMode = true;
+        ASSERT_TRUE(m_natOrch->removeHwSnaptEntry(first));
+        ASSERT_TRUE(m_natOrch->removeHwSnaptEntry(last));
+        ASSERT_TRUE(bulkRemoveSizes.empty());
+        m_natOrch->flushNatBulker();
+        m_natOrch->m_natBulkMode = false;
+        ASSERT_EQ(bulkRemoveSizes, vector<uint32_t>({ 2 }));
+        ASSERT_TRUE(hwNatEntries.empty());
+        ASSERT_EQ(m_natOrch->totalEntries, 0);
+        ASSERT_EQ(m_natOrch->totalDynamicNaptEntries, 0);
+    }
+
+    TEST_F(NatOrchTest, BulkDuplicateCreateIsNotDropped)
+    {
+        auto key = addSnaptEntry("10.0.0.1");
+
+        // The pending creation is flushed before the second one is queued
+        m_natOrch->m_natBulkMode = true;
+        ASSERT_TRUE(m_natOrch->addHwSnaptEntry(key));
+        ASSERT_TRUE(m_natOrch->addHwSnaptEntry(key));
+        ASSERT_EQ(bulkCreateSizes, vector<uint32_t>({ 1 }));
+        ASSERT_TRUE(isAddedToHw(key));
+        ASSERT_EQ(m_natOrch->m_natBulkOps.size(), 1);
+
+        // The second creation reaches the SAI and its outcome is handled as it would be serially
+        m_natOrch->flushNatBulker();
+        m_natOrch->m_natBulkMode = false;
+        ASSERT_EQ(bulkCreateSizes, vector<uint32_t>({ 1, 1 }));
+        ASSERT_EQ(m_natOrch->m_createFailures, vector<sai_status_t>({ SAI_STATUS_ITEM_ALREADY_EXISTS }));
+        ASSERT_TRUE(m_natOrch->m_natBulkOps.empty());
+        ASSERT_TRUE(isAddedToHw(key));
+        ASSERT_EQ(m_natOrch->totalEntries, 1);
+    }
+}
@@ -0,0 +1,292 @@
+#include "gtest/gtest.h"
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <set>
+#include <string>
+#include <unistd.h>
+#include <sched.h>
+#include <ifaddrs.h>
+#include <net/if.h>
+#include <net/ethernet.h>
+#include <arpa/inet.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include "netlinkbatch.h"
+
+/*
+ * These tests drive the real NetlinkBatch against the kernel. Each test runs
+ * in a network namespace of its own, entered through a user namespace when
+ * not running as root, and is skipped where namespaces, the bridge, dummy and
+ * VLAN link types or bridge VLAN filtering are not available.
+ */
+namespace netlinkbatch_ut
+{
+    using namespace std;
+    using namespace swss;
+
+    static bool writeFile(const string &path, const string &value)
+    {
+        ofstream file(path);
+        file << value;
+        return file.good();
+    }
+
+    static bool enterUserNamespace()
+    {
+        uid_t uid = geteuid();
+        gid_t gid = getegid();
+
+        if (uid == 0)
+        {
+            return true;
+        }
+        if (unshare(CLONE_NEWUSER) < 0)
+        {
+            return false;
+        }
+        return writeFile("/proc/self/setgroups", "deny") &&
+               writeFile("/proc/self/uid_map", "0 " + to_string(uid) + " 1") &&
+               writeFile("/proc/self/gid_map", "0 " + to_string(gid) + " 1");
+    }
+
+    static int ioctlIfreq(const string &name, unsigned long request, struct ifreq &ifr)
+    {
+        int fd = socket(AF_INET, SOCK_DGRAM, 0);
+        memset(&ifr, 0, sizeof(ifr));
+        strncpy(ifr.ifr_name, name.c_str(), IFNAMSIZ - 1);
+        int ret = ioctl(fd, request, &ifr);
+        close(fd);
+        return ret;
+    }
+
+    static bool hasAddress(const string &dev, const string &ip)
+    {
+        struct ifaddrs *addrs;
+        bool found = false;
+
+        if (getifaddrs(&addrs) < 0)
+        {
+            return false;
+        }
+        for (auto *ifa = addrs; ifa; ifa = ifa->ifa_next)
+        {
+            if (!ifa->ifa_addr || ifa->ifa_addr->sa_family != AF_INET || dev != ifa->ifa_name)
+            {
+                continue;
+            }
+            char buf[INET_ADDRSTRLEN];
+            inet_ntop(AF_INET, &reinterpret_cast<struct sockaddr_in *>(ifa->ifa_addr)->sin_addr, buf, sizeof(buf));
+            found = found || ip == buf;
+        }
+        freeifaddrs(addrs);
+        return found;
+    }
+
+    struct NetlinkBatchTest : public ::testing::Test
+    {
+        static bool s_userns;
+
+        static void SetUpTestCase()
+        {
+            s_userns = enterUserNamespace();
+        }
+
+        void SetUp() override
+        {
+            if (!s_userns || unshare(CLONE_NEWNET) < 0)
+            {
+                GTEST_SKIP() << "Network namespaces are not available";
+            }
+
+            NetlinkBatch probe;
+            probe.addBridge("probe0");
+            probe.addDummy("probe1");
+            probe.addVlan("probe2", "probe0", 2);
+            probe.addBridgeVlan("probe0", 2, false, true);
+            if (!probe.commit())
+            {
+                GTEST_SKIP() << "Bridge, dummy or VLAN links are not available: " << probe.getLastError();
+            }
+            probe.delLink("probe2");
+            probe.delLink("probe1");
+            probe.delLink("probe0");
+            ASSERT_TRUE(probe.commit());
+        }
+    };
+
+    bool NetlinkBatchTest::s_userns = false;
+
+    TEST_F(NetlinkBatchTest, BuildsRequests)
+    {
+        NetlinkBatch nl;
+        MacAddress mac("00:11:22:33:44:55");
+
+        nl.addBridge("Bridge");
+        nl.setAdminState("Bridge", true);
+        nl.addBridgeVlan("Bridge", 100, false, true);
+        nl.addVlan("Vlan100", "Bridge", 100, mac, true);
+        nl.addDummy("Ethernet0", 9100);
+        nl.setMaster("Ethernet0", "Bridge");
+        nl.delBridgeVlan("Ethernet0", 1);
+        nl.addBridgeVlan("Ethernet0", 100, true);
+        nl.addAddress("Vlan100", IpPrefix("192.168.0.1/24"));
+        nl.setMtu("Vlan100", 1500);
+        ASSERT_EQ(nl.size(), 10);
+
+        ASSERT_TRUE(nl.commit()) << nl.getLastError();
+        ASSERT_EQ(nl.size(), 0);
+        ASSERT_EQ(nl.getResults(), vector<int>(10, 0));
+
+        struct ifreq ifr;
+        ASSERT_EQ(ioctlIfreq("Ethernet0", SIOCGIFMTU, ifr), 0);
+        ASSERT_EQ(ifr.ifr_mtu, 9100);
+        ASSERT_EQ(ioctlIfreq("Vlan100", SIOCGIFMTU, ifr), 0);
+        ASSERT_EQ(ifr.ifr_mtu, 1500);
+        ASSERT_EQ(ioctlIfreq("Vlan100", SIOCGIFFLAGS, ifr), 0);
+        ASSERT_TRUE(ifr.ifr_flags & IFF_UP);
+        ASSERT_EQ(ioctlIfreq("Vlan100", SIOCGIFHWADDR, ifr), 0);
+        ASSERT_EQ(memcmp(ifr.ifr_hwaddr.sa_data, mac.getMac(), ETHER_ADDR_LEN), 0);
+        ASSERT_TRUE(hasAddress("Vlan100", "192.168.0.1"));
+
+        set<uint16_t> vlans;
+        ASSERT_TRUE(nl.getBridgeVlans("Ethernet0", vlans));
+        ASSERT_EQ(vlans, set<uint16_t>({ 100 }));
+
+        nl.delAddress("Vlan100", IpPrefix("192.168.0.1/24"));
+        nl.setMaster("Ethernet0", "");
+        nl.delLink("Vlan100");
+        ASSERT_TRUE(nl.commit()) << nl.getLastError();
+        ASSERT_EQ(if_nametoindex("Vlan100"), 0);
+        ASSERT_FALSE(hasAddress("Vlan100", "192.168.0.1"));
+        ASSERT_TRUE(nl.getBridgeVlans("Ethernet0", vlans));
+        ASSERT_TRUE(vlans.empty());
+    }
+
+    TEST_F(NetlinkBatchTest, ChunksVlanRanges)
+    {
+        NetlinkBatch nl;
+
+        nl.addBridge("Bridge");
+        nl.addDummy("Ethernet0");
+        nl.setMaster("Ethernet0", "Bridge");
+        ASSERT_TRUE(nl.commit()) << nl.getLastError();
+
+        // 300 single VLANs and one range of 101 VLANs are 301 ranges, sent as 3 requests
+        set<uint16_t> vids;
+        for (uint16_t vid = 2; vid < 602; vid += 2)
+        {
+            vids.insert(vid);
+        }
+        for (uint16_t vid = 1000; vid <= 1100; vid++)
+        {
+            vids.insert(vid);
+        }
+        nl.addBridgeVlans("Ethernet0", vids);
+        ASSERT_EQ(nl.size(), 3);
+        ASSERT_TRUE(nl.commit()) << nl.getLastError();
+
+        set<uint16_t> vlans;
+        ASSERT_TRUE(nl.getBridgeVlans("Ethernet0", vlans));
+        vlans.erase(1);
+        ASSERT_EQ(vlans, vids);
+
+        nl.delBridgeVlans("Ethernet0", vids);
+        ASSERT_EQ(nl.size(), 3);
+        ASSERT_TRUE(nl.commit()) << nl.getLastError();
+        ASSERT_TRUE(nl.getBridgeVlans("Ethernet0", vlans));
+        ASSERT_EQ(vlans, set<uint16_t>({ 1 }));
+    }
+
+    TEST_F(NetlinkBatchTest, CollectsAcksOfAllWindows)
+    {
+        NetlinkBatch nl;
+
+        // More requests than one window holds
+        for (int i = 0; i < 150; i++)
+        {
+            nl.addDummy("dummy" + to_string(i));
+        }
+        ASSERT_TRUE(nl.commit()) << nl.getLastError();
+        ASSERT_EQ(nl.getResults(), vector<int>(150, 0));
+        for (int i = 0; i < 150; i++)
+        {
+            ASSERT_NE(if_nametoindex(("dummy" + to_string(i)).c_str()), 0) << i;
+        }
+
+        for (int i = 0; i < 150; i++)
+        {
+            nl.delLink("dummy" + to_string(i));
+        }
+        ASSERT_TRUE(nl.commit()) << nl.getLastError();
+        ASSERT_EQ(if_nametoindex("dummy0"), 0);
+        ASSERT_EQ(if_nametoindex("dummy149"), 0);
+    }
+
+    TEST_F(NetlinkBatchTest, ResolvesDevicesCreatedInTheSameBatch)
+    {
+        NetlinkBatch nl;
+
+        // Bridge and Vlan100 do not exist yet when the later requests are queued
+        nl.addBridge("Bridge");
+        nl.addDummy("Ethernet0");
+        nl.setMaster("Ethernet0", "Bridge");
+        nl.addBridgeVlan("Ethernet0", 10, true);
+        nl.addVlan("Vlan100", "Bridge", 100);
+        nl.addAddress("Vlan100", IpPrefix("192.168.0.1/24"));
+        ASSERT_TRUE(nl.commit()) << nl.getLastError();
+        ASSERT_EQ(nl.getResults(), vector<int>(6, 0));
+
+        set<uint16_t> vlans;
+        ASSERT_TRUE(nl.getBridgeVlans("Ethernet0", vlans));
+        ASSERT_EQ(vlans.count(10), 1);
+        ASSERT_TRUE(hasAddress("Vlan100", "192.168.0.1"));
+    }
+
+    TEST_F(NetlinkBatchTest, StopsAtFirstFailure)
+    {
+        NetlinkBatch nl;
+
+        // A device that cannot be resolved stops the batch once the requests before it are sent
+        nl.addDummy("dummy1");
+        nl.setMaster("dummy1", "NoBridge");
+        nl.addDummy("dummy2");
+        ASSERT_FALSE(nl.commit());
+        ASSERT_EQ(nl.getLastError(), string("'link set dummy1 master NoBridge' failed: ") + strerror(ENODEV));
+        ASSERT_EQ(nl.getResults(), vector<int>({ 0, ENODEV, ECANCELED }));
+        ASSERT_NE(if_nametoindex("dummy1"), 0);
+        ASSERT_EQ(if_nametoindex("dummy2"), 0);
+
+        // A request rejected by the kernel stops the batch after its window
+        for (int i = 0; i < 100; i++)
+        {
+            nl.addDummy(i == 10 ? "dummy1" : "dummy" + to_string(i + 100));
+        }
+        ASSERT_FALSE(nl.commit());
+        ASSERT_EQ(nl.getLastError(), string("'link add dummy1 type dummy' failed: ") + strerror(EEXIST));
+        const auto &results = nl.getResults();
+        ASSERT_EQ(results.size(), 100);
+        ASSERT_EQ(results[9], 0);
+        ASSERT_EQ(results[10], EEXIST);
+        // The rest of the failed window is still applied by the kernel
+        ASSERT_EQ(results[11], 0);
+        ASSERT_NE(if_nametoindex("dummy111"), 0);
+        ASSERT_EQ(results[99], ECANCELED);
+        ASSERT_EQ(if_nametoindex("dummy199"), 0);
+    }
+
+    TEST_F(NetlinkBatchTest, ContinuesAfterFailureWhenAsked)
+    {
+        NetlinkBatch nl;
+
+        nl.addDummy("dummy1");
+        nl.delLink("NoDevice");
+        nl.setMaster("dummy1", "NoBridge");
+        nl.addDummy("dummy2");
+        ASSERT_FALSE(nl.commit(false));
+        ASSERT_EQ(nl.getLastError(), string("'link del NoDevice' failed: ") + strerror(ENODEV));
+        ASSERT_EQ(nl.getResults(), vector<int>({ 0, ENODEV, ENODEV, 0 }));
+        ASSERT_NE(if_nametoindex("dummy1"), 0);
+        ASSERT_NE(if_nametoindex("dummy2"), 0);
+    }
+}
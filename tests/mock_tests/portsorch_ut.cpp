@@ -14,6 +14,7 @@
 #include <sstream>
 
 extern redisReply *mockReply;
+extern uint32_t gPortOperStatusCoalesceMs;
 
 namespace portsorch_test
 {
@@ -25,6 +26,11 @@ namespace portsorch_test
     bool not_support_fetching_fec;
     vector<sai_port_fec_mode_t> mock_port_fec_modes = {SAI_PORT_FEC_MODE_RS, SAI_PORT_FEC_MODE_FC};
 
+    bool fail_port_qos_object_counts;
+    uint32_t _sai_get_port_qos_object_lists_count;
+    uint32_t _sai_get_port_queue_count_count;
+    bool _sai_get_port_scheduler_group_list;
+
     sai_status_t _ut_stub_sai_get_port_attribute(
         _In_ sai_object_id_t port_id,
         _In_ uint32_t attr_count,
@@ -48,10 +54,31 @@ namespace portsorch_test
                 status = SAI_STATUS_SUCCESS;
             }
         }
+        else if (attr_count > 1 && attr_list[0].id == SAI_PORT_ATTR_NUMBER_OF_INGRESS_PRIORITY_GROUPS &&
+                 fail_port_qos_object_counts)
+        {
+            status = SAI_STATUS_FAILURE;
+        }
         else
         {
             status = pold_sai_port_api->get_port_attribute(port_id, attr_count, attr_list);
         }
+
+        if (attr_count > 1 && attr_list[0].id == SAI_PORT_ATTR_INGRESS_PRIORITY_GROUP_LIST)
+        {
+            _sai_get_port_qos_object_lists_count++;
+            for (uint32_t i = 0; i < attr_count; i++)
+            {
+                if (attr_list[i].id == SAI_PORT_ATTR_QOS_SCHEDULER_GROUP_LIST)
+                {
+                    _sai_get_port_scheduler_group_list = true;
+                }
+            }
+        }
+        else if (attr_count == 1 && attr_list[0].id == SAI_PORT_ATTR_QOS_NUMBER_OF_QUEUES)
+        {
+            _sai_get_port_queue_count_count++;
+        }
         return status;
     }
 
@@ -310,6 +337,106 @@ namespace portsorch_test
         ASSERT_FALSE(gPortsOrch->getPort(port.m_port_id, port));
     }
 
+    /**
+     * Test that verifies lookups by OID follow LAGs, VLANs and bridge ports
+     * as they are added, remapped and removed
+     */
+    TEST_F(PortsOrchTest, PortOidLookupTest)
+    {
+        Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+        Table lagTable = Table(m_app_db.get(), APP_LAG_TABLE_NAME);
+        Table vlanTable = Table(m_app_db.get(), APP_VLAN_TABLE_NAME);
+
+        // Get SAI default ports to populate DB
+        auto ports = ut_helper::getInitialSaiPorts();
+
+        for (const auto &it : ports)
+        {
+            portTable.set(it.first, it.second);
+        }
+
+        // Set PortConfigDone, PortInitDone
+        portTable.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+        portTable.set("PortInitDone", { { } });
+
+        lagTable.set("PortChannel0001", { { "admin_status", "up" }, { "mtu", "9100" } });
+        vlanTable.set("Vlan5", { { "admin_status", "up" }, { "mtu", "9100" } });
+
+        // refill consumer
+        gPortsOrch->addExistingData(&portTable);
+        gPortsOrch->addExistingData(&lagTable);
+        gPortsOrch->addExistingData(&vlanTable);
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        const Port *port = gPortsOrch->findPort("Ethernet0");
+        ASSERT_NE(port, nullptr);
+        sai_object_id_t port_id = port->m_port_id;
+        ASSERT_EQ(gPortsOrch->findPort(port_id), port);
+
+        const Port *lag = gPortsOrch->findPort("PortChannel0001");
+        ASSERT_NE(lag, nullptr);
+        sai_object_id_t lag_id = lag->m_lag_id;
+        ASSERT_EQ(gPortsOrch->findPort(lag_id), lag);
+
+        const Port *vlan = gPortsOrch->findPort("Vlan5");
+        ASSERT_NE(vlan, nullptr);
+        sai_object_id_t vlan_oid = vlan->m_vlan_info.vlan_oid;
+        ASSERT_EQ(gPortsOrch->findPort(vlan_oid), vlan);
+
+        // Bridge port of the LAG is removed and created again with a new OID
+        Port lagPort = *lag;
+        ASSERT_TRUE(gPortsOrch->addBridgePort(lagPort));
+        sai_object_id_t bridge_port_id = lagPort.m_bridge_port_id;
+        ASSERT_EQ(gPortsOrch->findPortByBridgePortId(bridge_port_id), lag);
+        ASSERT_EQ(lag->m_bridge_port_id, bridge_port_id);
+
+        ASSERT_TRUE(gPortsOrch->removeBridgePort(lagPort));
+        ASSERT_EQ(gPortsOrch->findPortByBridgePortId(bridge_port_id), nullptr);
+        ASSERT_EQ(gPortsOrch->findPort(lag_id), lag);
+
+        ASSERT_TRUE(gPortsOrch->addBridgePort(lagPort));
+        ASSERT_EQ(gPortsOrch->findPortByBridgePortId(lagPort.m_bridge_port_id), lag);
+        ASSERT_EQ(lag->m_bridge_port_id, lagPort.m_bridge_port_id);
+        ASSERT_TRUE(gPortsOrch->removeBridgePort(lagPort));
+
+        // Delete LAG and VLAN
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({ "PortChannel0001", "DEL", {} });
+        auto consumer = dynamic_cast<Consumer *>(gPortsOrch->getExecutor(APP_LAG_TABLE_NAME));
+        consumer->addToSync(entries);
+        entries.clear();
+
+        entries.push_back({ "Vlan5", "DEL", {} });
+        consumer = dynamic_cast<Consumer *>(gPortsOrch->getExecutor(APP_VLAN_TABLE_NAME));
+        consumer->addToSync(entries);
+        entries.clear();
+
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        ASSERT_EQ(gPortsOrch->findPort("PortChannel0001"), nullptr);
+        ASSERT_EQ(gPortsOrch->findPort(lag_id), nullptr);
+        ASSERT_EQ(gPortsOrch->findPort("Vlan5"), nullptr);
+        ASSERT_EQ(gPortsOrch->findPort(vlan_oid), nullptr);
+
+        // Ports which are still there resolve to the same entry
+        port = gPortsOrch->findPort(port_id);
+        ASSERT_NE(port, nullptr);
+        ASSERT_EQ(port->m_alias, "Ethernet0");
+
+        // LAG created again under the same name resolves by its new OID
+        lagTable.set("PortChannel0001", { { "admin_status", "up" }, { "mtu", "9100" } });
+        gPortsOrch->addExistingData(&lagTable);
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        lag = gPortsOrch->findPort("PortChannel0001");
+        ASSERT_NE(lag, nullptr);
+        ASSERT_EQ(gPortsOrch->findPort(lag->m_lag_id), lag);
+
+        Port p;
+        ASSERT_TRUE(gPortsOrch->getPort(lag->m_lag_id, p));
+        ASSERT_EQ(p.m_alias, "PortChannel0001");
+    }
+
     TEST_F(PortsOrchTest, PortSupportedFecModes)
     {
         _hook_sai_port_api();
@@ -473,6 +600,152 @@ namespace portsorch_test
         _unhook_sai_port_api();
     }
 
+    /*
+     * Get the list of QoS objects of type list_attr_id of a port straight from SAI
+     */
+    vector<sai_object_id_t> getPortQosObjectList(sai_object_id_t port_id, sai_attr_id_t count_attr_id, sai_attr_id_t list_attr_id)
+    {
+        sai_attribute_t attr;
+        attr.id = count_attr_id;
+        EXPECT_EQ(pold_sai_port_api->get_port_attribute(port_id, 1, &attr), SAI_STATUS_SUCCESS);
+
+        vector<sai_object_id_t> ids(attr.value.u32);
+        attr.id = list_attr_id;
+        attr.value.objlist.count = (uint32_t)ids.size();
+        attr.value.objlist.list = ids.data();
+        EXPECT_EQ(pold_sai_port_api->get_port_attribute(port_id, 1, &attr), SAI_STATUS_SUCCESS);
+
+        return ids;
+    }
+
+    void checkPortQosObjects(const Port &port)
+    {
+        auto pgs = getPortQosObjectList(port.m_port_id, SAI_PORT_ATTR_NUMBER_OF_INGRESS_PRIORITY_GROUPS,
+                                        SAI_PORT_ATTR_INGRESS_PRIORITY_GROUP_LIST);
+        auto queues = getPortQosObjectList(port.m_port_id, SAI_PORT_ATTR_QOS_NUMBER_OF_QUEUES,
+                                           SAI_PORT_ATTR_QOS_QUEUE_LIST);
+
+        ASSERT_FALSE(pgs.empty());
+        ASSERT_FALSE(queues.empty());
+        ASSERT_EQ(port.m_priority_group_ids, pgs);
+        ASSERT_EQ(port.m_queue_ids, queues);
+        ASSERT_EQ(port.m_queue_lock.size(), queues.size());
+    }
+
+    /*
+     * Test that the QoS objects fetched ahead of port init end up on the ports
+     * and the time of each init phase is recorded in STATE_DB
+     */
+    TEST_F(PortsOrchTest, PortQosObjectsPrefetch)
+    {
+        _hook_sai_port_api();
+        Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+        Table timingTable = Table(m_state_db.get(), "PORT_INIT_TIMING");
+
+        fail_port_qos_object_counts = false;
+        _sai_get_port_qos_object_lists_count = 0;
+        _sai_get_port_queue_count_count = 0;
+        _sai_get_port_scheduler_group_list = false;
+
+        // Get SAI default ports to populate DB
+        auto ports = ut_helper::getInitialSaiPorts();
+
+        for (const auto &it : ports)
+        {
+            portTable.set(it.first, it.second);
+        }
+
+        // Set PortConfigDone
+        portTable.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+
+        // refill consumer
+        gPortsOrch->addExistingData(&portTable);
+
+        // Apply configuration :
+        //  create ports
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        // One combined get of the lists per port, none of the per type gets
+        ASSERT_EQ(_sai_get_port_qos_object_lists_count, ports.size());
+        ASSERT_EQ(_sai_get_port_queue_count_count, 0);
+        ASSERT_TRUE(_sai_get_port_scheduler_group_list);
+
+        for (const auto &it : ports)
+        {
+            Port port;
+            ASSERT_TRUE(gPortsOrch->getPort(it.first, port));
+            checkPortQosObjects(port);
+        }
+
+        string value;
+        ASSERT_TRUE(timingTable.hget("ports", "port_count", value));
+        ASSERT_EQ(value, to_string(ports.size()));
+        for (const auto &phase : { "add_ports_ms", "qos_objects_ms", "init_ports_ms" })
+        {
+            ASSERT_TRUE(timingTable.hget("ports", phase, value));
+            ASSERT_GE(stod(value), 0);
+        }
+
+        // Updating a port initializes no new ports and records no timing
+        timingTable.del("ports");
+
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"Ethernet0", "SET", { {"mtu", "9100"} }});
+        auto consumer = dynamic_cast<Consumer *>(gPortsOrch->getExecutor(APP_PORT_TABLE_NAME));
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        ASSERT_FALSE(timingTable.hget("ports", "port_count", value));
+        ASSERT_EQ(_sai_get_port_qos_object_lists_count, ports.size());
+
+        _unhook_sai_port_api();
+    }
+
+    /*
+     * Test that ports whose QoS objects could not be fetched ahead of init
+     * get them with the per type gets
+     */
+    TEST_F(PortsOrchTest, PortQosObjectsPrefetchFailure)
+    {
+        _hook_sai_port_api();
+        Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+
+        fail_port_qos_object_counts = true;
+        _sai_get_port_qos_object_lists_count = 0;
+        _sai_get_port_queue_count_count = 0;
+
+        // Get SAI default ports to populate DB
+        auto ports = ut_helper::getInitialSaiPorts();
+
+        for (const auto &it : ports)
+        {
+            portTable.set(it.first, it.second);
+        }
+
+        // Set PortConfigDone
+        portTable.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+
+        // refill consumer
+        gPortsOrch->addExistingData(&portTable);
+
+        // Apply configuration :
+        //  create ports
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        ASSERT_EQ(_sai_get_port_qos_object_lists_count, 0);
+        ASSERT_EQ(_sai_get_port_queue_count_count, ports.size());
+
+        for (const auto &it : ports)
+        {
+            Port port;
+            ASSERT_TRUE(gPortsOrch->getPort(it.first, port));
+            checkPortQosObjects(port);
+        }
+
+        fail_port_qos_object_counts = false;
+        _unhook_sai_port_api();
+    }
+
     TEST_F(PortsOrchTest, PortReadinessColdBoot)
     {
         Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
@@ -1155,4 +1428,154 @@ namespace portsorch_test
         ASSERT_FALSE(bridgePortCalledBeforeLagMember); // bridge port created on lag before lag member was created
     }
 
+
+    struct PortsOrchCoalesceTest : public PortsOrchTest
+    {
+        struct TestObserver : public Observer
+        {
+            vector<vector<PortOperStateUpdate>> notifications;
+            void update(SubjectType type, void *cntx) override
+            {
+                if (type == SUBJECT_TYPE_PORT_OPER_STATE_CHANGE)
+                {
+                    notifications.push_back(static_cast<PortOperStateUpdates *>(cntx)->updates);
+                }
+            }
+        };
+
+        void SetUp() override
+        {
+            gPortOperStatusCoalesceMs = 100;
+            PortsOrchTest::SetUp();
+        }
+
+        void TearDown() override
+        {
+            PortsOrchTest::TearDown();
+            gPortOperStatusCoalesceMs = 0;
+        }
+
+        void sendPortOperStatus(sai_object_id_t port_id, sai_port_oper_status_t status)
+        {
+            auto exec = static_cast<Notifier *>(gPortsOrch->getExecutor("PORT_STATUS_NOTIFICATIONS"));
+            auto consumer = exec->getNotificationConsumer();
+
+            // mock a redis reply for notification
+            mockReply = (redisReply *)calloc(sizeof(redisReply), 1);
+            mockReply->type = REDIS_REPLY_ARRAY;
+            mockReply->elements = 3; // REDIS_PUBLISH_MESSAGE_ELEMNTS
+            mockReply->element = (redisReply **)calloc(sizeof(redisReply *), mockReply->elements);
+            mockReply->element[2] = (redisReply *)calloc(sizeof(redisReply), 1);
+            mockReply->element[2]->type = REDIS_REPLY_STRING;
+            sai_port_oper_status_notification_t port_oper_status;
+            port_oper_status.port_id = port_id;
+            port_oper_status.port_state = status;
+            std::string data = sai_serialize_port_oper_status_ntf(1, &port_oper_status);
+            std::vector<FieldValueTuple> notifyValues;
+            FieldValueTuple opdata("port_state_change", data);
+            notifyValues.push_back(opdata);
+            std::string msg = swss::JSon::buildJson(notifyValues);
+            mockReply->element[2]->str = (char*)calloc(1, msg.length() + 1);
+            memcpy(mockReply->element[2]->str, msg.c_str(), msg.length());
+
+            consumer->readData();
+            gPortsOrch->doTask(*consumer);
+            mockReply = nullptr;
+        }
+
+        void expireWindow()
+        {
+            gPortsOrch->getExecutor("PORT_OPER_STATUS_COALESCE")->execute();
+        }
+
+        string getOperStatus(Table &portTable, const string &alias)
+        {
+            string status;
+            portTable.hget(alias, "oper_status", status);
+            return status;
+        }
+    };
+
+    /*
+    * The scope of this test is to verify that port oper status notifications
+    * received within the coalescing window are processed once the window
+    * expires, with the last status of each port and one observer notification.
+    */
+    TEST_F(PortsOrchCoalesceTest, PortOperStatusIsCoalesced)
+    {
+        Table portTable = Table(m_app_db.get(), APP_PORT_TABLE_NAME);
+
+        // Get SAI default ports to populate DB
+        auto ports = ut_helper::getInitialSaiPorts();
+
+        // Populate port table with SAI ports
+        for (const auto &it : ports)
+        {
+            portTable.set(it.first, it.second);
+        }
+
+        // Set PortConfigDone, PortInitDone
+        portTable.set("PortConfigDone", { { "count", to_string(ports.size()) } });
+        portTable.set("PortInitDone", { { "lanes", "0" } });
+
+        // refill consumer
+        gPortsOrch->addExistingData(&portTable);
+        // Apply configuration : create ports
+        static_cast<Orch *>(gPortsOrch)->doTask();
+
+        Port port0, port4;
+        ASSERT_TRUE(gPortsOrch->getPort("Ethernet0", port0));
+        ASSERT_TRUE(gPortsOrch->getPort("Ethernet4", port4));
+
+        TestObserver observer;
+        gPortsOrch->attach(&observer);
+
+        // Bring Ethernet0 up in a first window
+        sendPortOperStatus(port0.m_port_id, SAI_PORT_OPER_STATUS_UP);
+        ASSERT_TRUE(observer.notifications.empty());
+        expireWindow();
+        ASSERT_EQ(getOperStatus(portTable, "Ethernet0"), "up");
+        ASSERT_EQ(observer.notifications.size(), 1);
+        observer.notifications.clear();
+
+        // Ethernet0 flaps down, up, down and Ethernet4 goes up in one window
+        sendPortOperStatus(port0.m_port_id, SAI_PORT_OPER_STATUS_DOWN);
+        sendPortOperStatus(port0.m_port_id, SAI_PORT_OPER_STATUS_UP);
+        sendPortOperStatus(port0.m_port_id, SAI_PORT_OPER_STATUS_DOWN);
+        sendPortOperStatus(port4.m_port_id, SAI_PORT_OPER_STATUS_UP);
+
+        // Nothing is processed before the window expires
+        ASSERT_TRUE(observer.notifications.empty());
+        gPortsOrch->getPort("Ethernet0", port0);
+        ASSERT_EQ(port0.m_oper_status, SAI_PORT_OPER_STATUS_UP);
+        ASSERT_EQ(getOperStatus(portTable, "Ethernet0"), "up");
+
+        expireWindow();
+
+        gPortsOrch->getPort("Ethernet0", port0);
+        gPortsOrch->getPort("Ethernet4", port4);
+        ASSERT_EQ(port0.m_oper_status, SAI_PORT_OPER_STATUS_DOWN);
+        ASSERT_EQ(port4.m_oper_status, SAI_PORT_OPER_STATUS_UP);
+        ASSERT_EQ(getOperStatus(portTable, "Ethernet0"), "down");
+        ASSERT_EQ(getOperStatus(portTable, "Ethernet4"), "up");
+
+        // Both final states are carried by a single notification
+        ASSERT_EQ(observer.notifications.size(), 1);
+        map<string, sai_port_oper_status_t> updates;
+        for (const auto &update : observer.notifications[0])
+        {
+            updates[update.port.m_alias] = update.operStatus;
+        }
+        ASSERT_EQ(updates, (map<string, sai_port_oper_status_t>{
+                { "Ethernet0", SAI_PORT_OPER_STATUS_DOWN },
+                { "Ethernet4", SAI_PORT_OPER_STATUS_UP },
+            }));
+
+        // An expired window with nothing pending notifies nothing
+        expireWindow();
+        ASSERT_EQ(observer.notifications.size(), 1);
+
+        gPortsOrch->detach(&observer);
+    }
+
 }
@@ -0,0 +1,324 @@
+#include "gtest/gtest.h"
+#include "mock_table.h"
+#include "rate_counter_manager.h"
+#include "schema.h"
+
+#include <cstring>
+#include <functional>
+#include <hiredis/hiredis.h>
+#include <map>
+
+extern std::function<redisReply *(const std::vector<std::string> &)> mockRedisCommand;
+
+namespace testing_db
+{
+    extern std::map<int, std::map<std::string, std::map<std::string, std::vector<swss::FieldValueTuple>>>> gDB;
+}
+
+namespace ratecountermanager_test
+{
+    using namespace std;
+    using namespace swss;
+
+    int countersDbId;
+    /* Poll time returned by the read that follows the counters, when set */
+    string pollTimeAfterRead;
+
+    redisReply *stringReply(const string &value)
+    {
+        auto reply = (redisReply *)calloc(sizeof(redisReply), 1);
+        reply->type = REDIS_REPLY_STRING;
+        reply->str = (char *)malloc(value.size() + 1);
+        memcpy(reply->str, value.c_str(), value.size() + 1);
+        reply->len = value.size();
+        return reply;
+    }
+
+    redisReply *fieldReply(const string &key, const string &field)
+    {
+        auto sep = key.find(':');
+        auto &table = testing_db::gDB[countersDbId][key.substr(0, sep)];
+        auto it = table.find(key.substr(sep + 1));
+
+        if (it != table.end())
+        {
+            for (const auto &fv : it->second)
+            {
+                if (fvField(fv) == field)
+                {
+                    return stringReply(fvValue(fv));
+                }
+            }
+        }
+
+        auto reply = (redisReply *)calloc(sizeof(redisReply), 1);
+        reply->type = REDIS_REPLY_NIL;
+        return reply;
+    }
+
+    /* Answers HGET and HMGET from the COUNTERS_DB tables of the mock DB */
+    redisReply *answerCommand(const vector<string> &argv)
+    {
+        if (argv[0] == "HGET")
+        {
+            if (!pollTimeAfterRead.empty())
+            {
+                return stringReply(pollTimeAfterRead);
+            }
+            return fieldReply(argv[1], argv[2]);
+        }
+
+        if (argv[0] == "HMGET")
+        {
+            auto reply = (redisReply *)calloc(sizeof(redisReply), 1);
+            reply->type = REDIS_REPLY_ARRAY;
+            reply->elements = argv.size() - 2;
+            reply->element = (redisReply **)calloc(sizeof(redisReply *), reply->elements);
+            for (size_t i = 2; i < argv.size(); i++)
+            {
+                reply->element[i - 2] = fieldReply(argv[1], argv[i]);
+            }
+            return reply;
+        }
+
+        return nullptr;
+    }
+
+    struct RateCounterManagerTest : public ::testing::Test
+    {
+        shared_ptr<DBConnector> m_counters_db;
+        shared_ptr<Table> m_counters_table;
+        shared_ptr<Table> m_rates_table;
+        shared_ptr<Table> m_name_map_table;
+        shared_ptr<RateCounterManager> m_manager;
+
+        void SetUp() override
+        {
+            ::testing_db::reset();
+            pollTimeAfterRead.clear();
+            mockRedisCommand = answerCommand;
+
+            m_counters_db = make_shared<DBConnector>("COUNTERS_DB", 0);
+            countersDbId = m_counters_db->getDbId();
+            m_counters_table = make_shared<Table>(m_counters_db.get(), COUNTERS_TABLE);
+            m_rates_table = make_shared<Table>(m_counters_db.get(), "RATES");
+            m_name_map_table = make_shared<Table>(m_counters_db.get(), COUNTERS_PORT_NAME_MAP);
+
+            m_manager = make_shared<RateCounterManager>("PORT", COUNTERS_PORT_NAME_MAP, vector<RateCounterSpec>{
+                    { "RX_BPS", { "SAI_PORT_STAT_IF_IN_OCTETS" } },
+                    { "RX_PPS", { "SAI_PORT_STAT_IF_IN_UCAST_PKTS", "SAI_PORT_STAT_IF_IN_NON_UCAST_PKTS" } },
+                });
+
+            m_name_map_table->set("", { { "Ethernet0", "oid:0x1" } });
+        }
+
+        void TearDown() override
+        {
+            mockRedisCommand = nullptr;
+        }
+
+        void setCounters(const string &oid, uint64_t octets, uint64_t ucast, uint64_t non_ucast)
+        {
+            m_counters_table->set(oid, {
+                    { "SAI_PORT_STAT_IF_IN_OCTETS", to_string(octets) },
+                    { "SAI_PORT_STAT_IF_IN_UCAST_PKTS", to_string(ucast) },
+                    { "SAI_PORT_STAT_IF_IN_NON_UCAST_PKTS", to_string(non_ucast) },
+                });
+        }
+
+        /* What the rates plugin records after a syncd poll */
+        void setPollTime(uint64_t poll_time, const string &alpha = "0.5")
+        {
+            m_rates_table->set("PORT", { { "PORT_ALPHA", alpha }, { "PORT_POLL_TIME", to_string(poll_time) } });
+        }
+
+        map<string, string> getRates(const string &oid)
+        {
+            vector<FieldValueTuple> fvs;
+            m_rates_table->get(oid, fvs);
+            return map<string, string>(fvs.begin(), fvs.end());
+        }
+
+        string getInitState(const string &oid)
+        {
+            string state;
+            m_rates_table->hget(oid + ":PORT", "INIT_DONE", state);
+            return state;
+        }
+
+        /* Polls the first two syncd polls of oid:0x1, 2 s apart, up to its first rates */
+        void initRates()
+        {
+            setCounters("oid:0x1", 1000, 10, 0);
+            setPollTime(1000);
+            m_manager->poll();
+
+            setCounters("oid:0x1", 3000, 30, 10);
+            setPollTime(3000);
+            m_manager->poll();
+        }
+    };
+
+    TEST_F(RateCounterManagerTest, InitStates)
+    {
+        setCounters("oid:0x1", 1000, 10, 0);
+
+        // Nothing is computed before the plugin records a syncd poll
+        m_manager->poll();
+        ASSERT_TRUE(getRates("oid:0x1").empty());
+        ASSERT_EQ(getInitState("oid:0x1"), "");
+
+        // The first poll only stores the counters
+        setPollTime(1000);
+        m_manager->poll();
+        ASSERT_EQ(getRates("oid:0x1"), (map<string, string>{
+                { "SAI_PORT_STAT_IF_IN_OCTETS_last", "1000" },
+                { "SAI_PORT_STAT_IF_IN_UCAST_PKTS_last", "10" },
+                { "SAI_PORT_STAT_IF_IN_NON_UCAST_PKTS_last", "0" },
+            }));
+        ASSERT_EQ(getInitState("oid:0x1"), "COUNTERS_LAST");
+
+        // Counters read before the next syncd poll is recorded are not used
+        setCounters("oid:0x1", 2000, 20, 0);
+        m_manager->poll();
+        ASSERT_EQ(getRates("oid:0x1")["SAI_PORT_STAT_IF_IN_OCTETS_last"], "1000");
+        ASSERT_EQ(getInitState("oid:0x1"), "COUNTERS_LAST");
+
+        // The first rates are over the time between the syncd polls and are not smoothed
+        setCounters("oid:0x1", 3000, 30, 10);
+        setPollTime(3000);
+        m_manager->poll();
+        ASSERT_EQ(getRates("oid:0x1"), (map<string, string>{
+                { "RX_BPS", "1000" },
+                { "RX_PPS", "15" },
+                { "SAI_PORT_STAT_IF_IN_OCTETS_last", "3000" },
+                { "SAI_PORT_STAT_IF_IN_UCAST_PKTS_last", "30" },
+                { "SAI_PORT_STAT_IF_IN_NON_UCAST_PKTS_last", "10" },
+            }));
+        ASSERT_EQ(getInitState("oid:0x1"), "DONE");
+    }
+
+    TEST_F(RateCounterManagerTest, Ewma)
+    {
+        initRates();
+
+        setCounters("oid:0x1", 7000, 70, 10);
+        setPollTime(4000);
+        m_manager->poll();
+
+        // 0.5 * 4000 + 0.5 * 1000 and 0.5 * 40 + 0.5 * 15
+        auto rates = getRates("oid:0x1");
+        ASSERT_EQ(rates["RX_BPS"], "2500");
+        ASSERT_EQ(rates["RX_PPS"], "27.5");
+        ASSERT_EQ(rates["SAI_PORT_STAT_IF_IN_OCTETS_last"], "7000");
+    }
+
+    TEST_F(RateCounterManagerTest, SkipsSyncdPollDuringRead)
+    {
+        initRates();
+
+        // A syncd poll recorded while the counters are read may have updated only some of them
+        setCounters("oid:0x1", 7000, 70, 10);
+        setPollTime(4000);
+        pollTimeAfterRead = "5000";
+        m_manager->poll();
+        ASSERT_EQ(getRates("oid:0x1")["RX_BPS"], "1000");
+
+        pollTimeAfterRead.clear();
+        setPollTime(5000);
+        m_manager->poll();
+        // 0.5 * 2000 + 0.5 * 1000
+        ASSERT_EQ(getRates("oid:0x1")["RX_BPS"], "1500");
+    }
+
+    TEST_F(RateCounterManagerTest, MissingCounters)
+    {
+        m_counters_table->set("oid:0x1", {
+                { "SAI_PORT_STAT_IF_IN_OCTETS", "1000" },
+                { "SAI_PORT_STAT_IF_IN_UCAST_PKTS", "10" },
+            });
+        setPollTime(1000);
+        m_manager->poll();
+        ASSERT_TRUE(getRates("oid:0x1").empty());
+        ASSERT_EQ(getInitState("oid:0x1"), "");
+
+        // Missing counters count as zero when the group allows it
+        RateCounterManager manager("PORT", COUNTERS_PORT_NAME_MAP, {
+                { "RX_BPS", { "SAI_PORT_STAT_IF_IN_OCTETS" } },
+                { "RX_PPS", { "SAI_PORT_STAT_IF_IN_UCAST_PKTS", "SAI_PORT_STAT_IF_IN_NON_UCAST_PKTS" } },
+            }, true);
+        manager.poll();
+        ASSERT_EQ(getRates("oid:0x1")["SAI_PORT_STAT_IF_IN_NON_UCAST_PKTS_last"], "0");
+        ASSERT_EQ(getInitState("oid:0x1"), "COUNTERS_LAST");
+    }
+
+    TEST_F(RateCounterManagerTest, SkipsIdleObjects)
+    {
+        initRates();
+
+        // Unchanged counters still bring the rates down
+        setPollTime(4000, "1");
+        m_manager->poll();
+        ASSERT_EQ(getRates("oid:0x1")["RX_BPS"], "0");
+        ASSERT_EQ(getRates("oid:0x1")["RX_PPS"], "0");
+
+        // Once they are down, an object whose counters did not change is not written
+        m_rates_table->del("oid:0x1");
+        setPollTime(5000, "1");
+        m_manager->poll();
+        ASSERT_TRUE(getRates("oid:0x1").empty());
+
+        setCounters("oid:0x1", 4000, 30, 10);
+        setPollTime(6000, "1");
+        m_manager->poll();
+        ASSERT_EQ(getRates("oid:0x1")["RX_BPS"], "1000");
+    }
+
+    TEST_F(RateCounterManagerTest, Clear)
+    {
+        initRates();
+
+        // Rates start over from the counters after a clear
+        m_manager->clear();
+        setCounters("oid:0x1", 7000, 70, 10);
+        setPollTime(4000);
+        m_manager->poll();
+        ASSERT_EQ(getRates("oid:0x1"), (map<string, string>{
+                { "SAI_PORT_STAT_IF_IN_OCTETS_last", "7000" },
+                { "SAI_PORT_STAT_IF_IN_UCAST_PKTS_last", "70" },
+                { "SAI_PORT_STAT_IF_IN_NON_UCAST_PKTS_last", "10" },
+            }));
+        ASSERT_EQ(getInitState("oid:0x1"), "COUNTERS_LAST");
+
+        setCounters("oid:0x1", 8000, 80, 10);
+        setPollTime(5000);
+        m_manager->poll();
+        ASSERT_EQ(getRates("oid:0x1")["RX_BPS"], "1000");
+        ASSERT_EQ(getInitState("oid:0x1"), "DONE");
+    }
+
+    TEST_F(RateCounterManagerTest, ReadsNameMapWhenInvalidated)
+    {
+        initRates();
+
+        m_name_map_table->set("", { { "Ethernet0", "oid:0x1" }, { "Ethernet4", "oid:0x2" } });
+        setCounters("oid:0x2", 100, 1, 0);
+        setPollTime(4000);
+        m_manager->poll();
+        ASSERT_TRUE(getRates("oid:0x2").empty());
+
+        m_manager->invalidateObjects();
+        setPollTime(5000);
+        m_manager->poll();
+        ASSERT_EQ(getRates("oid:0x2")["SAI_PORT_STAT_IF_IN_OCTETS_last"], "100");
+
+        // Removed objects are no longer read
+        m_name_map_table->set("", { { "Ethernet4", "oid:0x2" } });
+        m_manager->invalidateObjects();
+        m_rates_table->del("oid:0x1");
+        setCounters("oid:0x1", 9000, 90, 10);
+        setPollTime(6000);
+        m_manager->poll();
+        ASSERT_TRUE(getRates("oid:0x1").empty());
+    }
+}
@@ -0,0 +1,97 @@
+#include "gtest/gtest.h"
+#include "mock_table.h"
+#include "response_publisher.h"
+
+#include <fstream>
+#include <map>
+
+bool gResponsePublisherRecord = false;
+bool gResponsePublisherLogRotate = false;
+std::ofstream gResponsePublisherRecordOfs;
+std::string gResponsePublisherRecordFile;
+
+namespace response_publisher_ut
+{
+    using namespace std;
+    using namespace swss;
+
+    struct ResponsePublisherTest : public ::testing::Test
+    {
+        shared_ptr<DBConnector> m_app_state_db;
+        shared_ptr<Table> m_table;
+
+        void SetUp() override
+        {
+            ::testing_db::reset();
+            m_app_state_db = make_shared<DBConnector>("APPL_STATE_DB", 0);
+            m_table = make_shared<Table>(m_app_state_db.get(), "SWITCH_TABLE");
+        }
+
+        map<string, string> getEntry(const string &key)
+        {
+            vector<FieldValueTuple> fvs;
+            m_table->get(key, fvs);
+            return map<string, string>(fvs.begin(), fvs.end());
+        }
+
+        bool exists(const string &key)
+        {
+            vector<FieldValueTuple> fvs;
+            return m_table->get(key, fvs);
+        }
+    };
+
+    TEST_F(ResponsePublisherTest, WritesFirstEntry)
+    {
+        ResponsePublisher publisher;
+
+        publisher.writeToDB("SWITCH_TABLE", "switch0", { { "mac", "00:11:22:33:44:55" } }, SET_COMMAND);
+        ASSERT_EQ(getEntry("switch0"), (map<string, string>{ { "mac", "00:11:22:33:44:55" } }));
+
+        // An entry without attributes is written as the NULL placeholder
+        publisher.writeToDB("SWITCH_TABLE", "switch1", {}, SET_COMMAND);
+        ASSERT_EQ(getEntry("switch1"), (map<string, string>{ { "NULL", "NULL" } }));
+    }
+
+    TEST_F(ResponsePublisherTest, SkipsNullWriteToExistingEntry)
+    {
+        // Keys already in the DB are loaded on the first use of the table
+        m_table->set("switch0", { { "mac", "00:11:22:33:44:55" } });
+        ResponsePublisher publisher;
+
+        publisher.writeToDB("SWITCH_TABLE", "switch0", {}, SET_COMMAND);
+        ASSERT_EQ(getEntry("switch0"), (map<string, string>{ { "mac", "00:11:22:33:44:55" } }));
+
+        // Same for an entry written by the publisher itself
+        publisher.writeToDB("SWITCH_TABLE", "switch1", { { "mac", "00:11:22:33:44:66" } }, SET_COMMAND);
+        publisher.writeToDB("SWITCH_TABLE", "switch1", {}, SET_COMMAND);
+        ASSERT_EQ(getEntry("switch1"), (map<string, string>{ { "mac", "00:11:22:33:44:66" } }));
+    }
+
+    TEST_F(ResponsePublisherTest, Replace)
+    {
+        ResponsePublisher publisher;
+
+        publisher.writeToDB("SWITCH_TABLE", "switch0", { { "mac", "00:11:22:33:44:55" } }, SET_COMMAND);
+
+        // A replacing write without attributes leaves only the NULL placeholder
+        publisher.writeToDB("SWITCH_TABLE", "switch0", {}, SET_COMMAND, true);
+        ASSERT_EQ(getEntry("switch0"), (map<string, string>{ { "NULL", "NULL" } }));
+
+        publisher.writeToDB("SWITCH_TABLE", "switch0", { { "mac", "00:11:22:33:44:66" } }, SET_COMMAND, true);
+        ASSERT_EQ(getEntry("switch0"), (map<string, string>{ { "mac", "00:11:22:33:44:66" } }));
+    }
+
+    TEST_F(ResponsePublisherTest, SetAfterDel)
+    {
+        ResponsePublisher publisher;
+
+        publisher.writeToDB("SWITCH_TABLE", "switch0", { { "mac", "00:11:22:33:44:55" } }, SET_COMMAND);
+        publisher.writeToDB("SWITCH_TABLE", "switch0", {}, DEL_COMMAND);
+        ASSERT_FALSE(exists("switch0"));
+
+        // The deleted key is written again as a new entry
+        publisher.writeToDB("SWITCH_TABLE", "switch0", {}, SET_COMMAND);
+        ASSERT_EQ(getEntry("switch0"), (map<string, string>{ { "NULL", "NULL" } }));
+    }
+}
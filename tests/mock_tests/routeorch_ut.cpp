@@ -4,6 +4,9 @@
 #define protected public
 #include "orch.h"
 #undef protected
+#define private public // make the mux peer switch available to configure mux cables.
+#include "muxorch.h"
+#undef private
 #include "ut_helper.h"
 #include "mock_orchagent_main.h"
 #include "mock_table.h"
@@ -89,6 +92,59 @@ namespace routeorch_test
         return old_set_route_entries_attribute(object_count, route_entry, attr_list, mode, object_statuses);
     }
 
+    /* Tunnel routes the fake route API fails to program, and the calls it got */
+    set<string> failing_tunnel_routes;
+    vector<string> tunnel_route_calls;
+
+    sai_status_t _ut_stub_tunnel_route_status(const string &call, const sai_route_entry_t &route_entry)
+    {
+        string ip = IpAddress(route_entry.destination.addr.ip4).to_string();
+        tunnel_route_calls.push_back(call + " " + ip);
+        return failing_tunnel_routes.count(ip) ? SAI_STATUS_FAILURE : SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_tunnel_create_route_entries(
+        _In_ uint32_t object_count,
+        _In_ const sai_route_entry_t *route_entry,
+        _In_ const uint32_t *attr_count,
+        _In_ const sai_attribute_t **attr_list,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = _ut_stub_tunnel_route_status("bulk create", route_entry[i]);
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_tunnel_remove_route_entries(
+        _In_ uint32_t object_count,
+        _In_ const sai_route_entry_t *route_entry,
+        _In_ sai_bulk_op_error_mode_t mode,
+        _Out_ sai_status_t *object_statuses)
+    {
+        for (uint32_t i = 0; i < object_count; i++)
+        {
+            object_statuses[i] = _ut_stub_tunnel_route_status("bulk remove", route_entry[i]);
+        }
+        return SAI_STATUS_SUCCESS;
+    }
+
+    sai_status_t _ut_stub_tunnel_create_route_entry(
+        _In_ const sai_route_entry_t *route_entry,
+        _In_ uint32_t attr_count,
+        _In_ const sai_attribute_t *attr_list)
+    {
+        return _ut_stub_tunnel_route_status("create", *route_entry);
+    }
+
+    sai_status_t _ut_stub_tunnel_remove_route_entry(
+        _In_ const sai_route_entry_t *route_entry)
+    {
+        return _ut_stub_tunnel_route_status("remove", *route_entry);
+    }
+
     struct RouteOrchTest : public ::testing::Test
     {
         RouteOrchTest()
@@ -402,6 +458,107 @@ namespace routeorch_test
         ASSERT_EQ(current_set_count, set_route_count);
     }
 
+    TEST_F(RouteOrchTest, RouteOrchTestNextHopObserverSubnet)
+    {
+        struct TestObserver : public Observer
+        {
+            vector<NextHopUpdate> updates;
+            void update(SubjectType type, void *cntx) override
+            {
+                updates.push_back(*static_cast<NextHopUpdate *>(cntx));
+            }
+        };
+
+        TestObserver inside, outside;
+        gRouteOrch->attach(&inside, IpAddress("1.1.1.5"), gVirtualRouterId);
+        gRouteOrch->attach(&outside, IpAddress("2.2.2.2"), gVirtualRouterId);
+
+        // Both get the current best match on attach
+        ASSERT_EQ(inside.updates.size(), 1);
+        ASSERT_EQ(inside.updates.back().prefix, IpPrefix("1.1.1.0/24"));
+        ASSERT_EQ(outside.updates.size(), 1);
+        ASSERT_EQ(outside.updates.back().prefix, IpPrefix("0.0.0.0/0"));
+
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"1.1.1.0/25", "SET", { {"ifname", "Ethernet0"},
+                                                  {"nexthop", "10.0.0.3"}}});
+        auto consumer = dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        // Only the host within the new prefix is notified
+        ASSERT_EQ(inside.updates.size(), 2);
+        ASSERT_EQ(inside.updates.back().prefix, IpPrefix("1.1.1.0/25"));
+        ASSERT_EQ(outside.updates.size(), 1);
+
+        entries.clear();
+        entries.push_back({"1.1.1.0/25", "DEL", { {} }});
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        // Removing the best match falls back to the covering route
+        ASSERT_EQ(inside.updates.size(), 3);
+        ASSERT_EQ(inside.updates.back().prefix, IpPrefix("1.1.1.0/24"));
+        ASSERT_EQ(outside.updates.size(), 1);
+
+        gRouteOrch->detach(&inside, IpAddress("1.1.1.5"), gVirtualRouterId);
+        gRouteOrch->detach(&outside, IpAddress("2.2.2.2"), gVirtualRouterId);
+    }
+
+    TEST_F(RouteOrchTest, RouteOrchTestNextHopObserverDetachOnUpdate)
+    {
+        struct TestObserver : public Observer
+        {
+            vector<NextHopUpdate> updates;
+            std::function<void()> onUpdate;
+            void update(SubjectType type, void *cntx) override
+            {
+                updates.push_back(*static_cast<NextHopUpdate *>(cntx));
+                if (onUpdate)
+                {
+                    onUpdate();
+                }
+            }
+        };
+
+        TestObserver first, second, third;
+        gRouteOrch->attach(&first, IpAddress("1.1.1.5"), gVirtualRouterId);
+        gRouteOrch->attach(&second, IpAddress("1.1.1.5"), gVirtualRouterId);
+        gRouteOrch->attach(&third, IpAddress("1.1.1.6"), gVirtualRouterId);
+
+        // The first observer detaches the other observer of its host and the
+        // only observer of the next host, which removes that host entry
+        first.onUpdate = [&]()
+        {
+            first.onUpdate = nullptr;
+            gRouteOrch->detach(&second, IpAddress("1.1.1.5"), gVirtualRouterId);
+            gRouteOrch->detach(&third, IpAddress("1.1.1.6"), gVirtualRouterId);
+        };
+
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"1.1.1.0/25", "SET", { {"ifname", "Ethernet0"},
+                                                  {"nexthop", "10.0.0.3"}}});
+        auto consumer = dynamic_cast<Consumer *>(gRouteOrch->getExecutor(APP_ROUTE_TABLE_NAME));
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        // Detached observers are not updated
+        ASSERT_EQ(first.updates.size(), 2);
+        ASSERT_EQ(first.updates.back().prefix, IpPrefix("1.1.1.0/25"));
+        ASSERT_EQ(second.updates.size(), 1);
+        ASSERT_EQ(third.updates.size(), 1);
+
+        entries.clear();
+        entries.push_back({"1.1.1.0/25", "DEL", { {} }});
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gRouteOrch)->doTask();
+
+        ASSERT_EQ(first.updates.size(), 3);
+        ASSERT_EQ(first.updates.back().prefix, IpPrefix("1.1.1.0/24"));
+
+        gRouteOrch->detach(&first, IpAddress("1.1.1.5"), gVirtualRouterId);
+    }
+
     TEST_F(RouteOrchTest, RouteOrchTestDelSetDefaultRoute)
     {
         std::deque<KeyOpFieldsValuesTuple> entries;
@@ -422,4 +579,269 @@ namespace routeorch_test
         ASSERT_EQ(current_set_count + 1, set_route_count);
         ASSERT_EQ(sai_fail_count, 0);
     }
+
+    TEST_F(RouteOrchTest, NeighOrchBulkNeighborAndNextHop)
+    {
+        // Neighbors from SetUp are created in bulk together with their next hops
+        ASSERT_TRUE(gNeighOrch->hasNextHop(NextHopKey("10.0.0.2", "Ethernet0")));
+        ASSERT_TRUE(gNeighOrch->hasNextHop(NextHopKey("10.0.0.3", "Ethernet0")));
+
+        std::deque<KeyOpFieldsValuesTuple> entries;
+        entries.push_back({"Ethernet0:10.0.0.4", "SET", { {"neigh", "00:00:0a:00:00:04"},
+                                                         {"family", "IPv4"}}});
+        entries.push_back({"Ethernet0:10.0.0.5", "SET", { {"neigh", "00:00:0a:00:00:05"},
+                                                         {"family", "IPv4"}}});
+        auto consumer = dynamic_cast<Consumer *>(gNeighOrch->getExecutor(APP_NEIGH_TABLE_NAME));
+        consumer->addToSync(entries);
+        static_cast<Orch *>(gNeighOrch)->doTask();
+
+        ASSERT_EQ(consumer->m_toSync.size(), 0);
+        ASSERT_TRUE(gNeighOrch->isHwConfigured(NeighborEntry("10.0.0.4", "Ethernet0")));
+        ASSERT_NE(gNeighOrch->getNextHopId(NextHopKey("10.0.0.4", "Ethernet0")), SAI_NULL_OBJECT_ID);
+        ASSERT_NE(gNeighOrch->getNextHopId(NextHopKey("10.0.0.5", "Ethernet0")), SAI_NULL_OBJECT_ID);
+        ASSERT_EQ(gNeighOrch->m_syncdNeighbors.size(), 4);
+    }
+
+    TEST_F(RouteOrchTest, MuxCableSubnetLookup)
+    {
+        auto mux_orch = gDirectory.get<MuxOrch*>();
+        mux_orch->mux_peer_switch_ = IpAddress("2.2.2.2");
+
+        // The cables aren't ports of PortsOrch, they are created in standby without touching the hardware
+        auto consumer = dynamic_cast<Consumer *>(mux_orch->getExecutor(CFG_MUX_CABLE_TABLE_NAME));
+        auto doMuxTask = [&](const string &op, const string &port, const string &ipv4, const string &ipv6)
+        {
+            std::deque<KeyOpFieldsValuesTuple> entries;
+            entries.push_back({ port, op, { { "server_ipv4", ipv4 }, { "server_ipv6", ipv6 } } });
+            consumer->addToSync(entries);
+            static_cast<Orch *>(mux_orch)->doTask();
+        };
+        auto cableName = [&](const string &ip) -> string
+        {
+            MuxCable *cable = mux_orch->findMuxCableInSubnet(IpAddress(ip));
+            return cable ? cable->mux_name_ : "";
+        };
+
+        // MuxPort1 covers the subnets of the others, MuxPort2 shares its IPv4 subnet with MuxPort0
+        doMuxTask(SET_COMMAND, "MuxPort0", "192.168.0.2/32", "fc02::2/128");
+        doMuxTask(SET_COMMAND, "MuxPort1", "192.168.0.0/24", "fc02::/64");
+        doMuxTask(SET_COMMAND, "MuxPort2", "192.168.0.2/32", "fc02::3/128");
+        ASSERT_TRUE(mux_orch->isMuxExists("MuxPort0"));
+        ASSERT_TRUE(mux_orch->isMuxExists("MuxPort1"));
+        ASSERT_TRUE(mux_orch->isMuxExists("MuxPort2"));
+        ASSERT_EQ(mux_orch->mux_cable_subnets_.size(), 5);
+
+        ASSERT_EQ(cableName("192.168.0.2"), "MuxPort0");
+        ASSERT_EQ(cableName("192.168.0.5"), "MuxPort1");
+        ASSERT_EQ(cableName("fc02::2"), "MuxPort0");
+        ASSERT_EQ(cableName("fc02::3"), "MuxPort2");
+        ASSERT_EQ(cableName("fc02::9"), "MuxPort1");
+        ASSERT_EQ(cableName("10.0.0.2"), "");
+
+        // A shared subnet stays with the remaining cable
+        doMuxTask(DEL_COMMAND, "MuxPort0", "192.168.0.2/32", "fc02::2/128");
+        ASSERT_FALSE(mux_orch->isMuxExists("MuxPort0"));
+        ASSERT_EQ(mux_orch->mux_cable_subnets_.size(), 4);
+        ASSERT_EQ(cableName("192.168.0.2"), "MuxPort2");
+        ASSERT_EQ(cableName("fc02::2"), "MuxPort1");
+
+        // Once no cable has the more specific subnet, the covering one matches
+        doMuxTask(DEL_COMMAND, "MuxPort2", "192.168.0.2/32", "fc02::3/128");
+        ASSERT_EQ(mux_orch->mux_cable_subnets_.size(), 2);
+        ASSERT_EQ(cableName("192.168.0.2"), "MuxPort1");
+        ASSERT_EQ(cableName("fc02::3"), "MuxPort1");
+
+        doMuxTask(DEL_COMMAND, "MuxPort1", "192.168.0.0/24", "fc02::/64");
+        ASSERT_TRUE(mux_orch->mux_cable_subnets_.empty());
+        ASSERT_EQ(cableName("192.168.0.2"), "");
+        ASSERT_EQ(cableName("fc02::9"), "");
+    }
+
+    TEST_F(RouteOrchTest, MuxSwitchoverRollsBackFailedCables)
+    {
+        ut_sai_route_api.create_route_entries = _ut_stub_tunnel_create_route_entries;
+        ut_sai_route_api.remove_route_entries = _ut_stub_tunnel_remove_route_entries;
+        ut_sai_route_api.create_route_entry = _ut_stub_tunnel_create_route_entry;
+        ut_sai_route_api.remove_route_entry = _ut_stub_tunnel_remove_route_entry;
+        failing_tunnel_routes = { "192.168.0.3" };
+        tunnel_route_calls.clear();
+
+        auto mux_cb_orch = new MuxCableOrch(m_app_db.get(), m_state_db.get(), APP_MUX_CABLE_TABLE_NAME);
+        gDirectory.set(mux_cb_orch);
+
+        // The cables aren't ports of PortsOrch and have no neighbors, the switchover is driven the way their handlers drive it
+        IpPrefix srv_ip("192.168.0.0/24"), srv_ip6("fc02::/64");
+        MuxCable to_standby("MuxPort0", srv_ip, srv_ip6, IpAddress("2.2.2.2"), {});
+        MuxCable to_active("MuxPort1", srv_ip, srv_ip6, IpAddress("2.2.2.2"), {});
+        sai_object_id_t tnh = 0x1234;
+        IpPrefix pfx2("192.168.0.2/32"), pfx3("192.168.0.3/32"), pfx4("192.168.0.4/32");
+        NextHopKey nh2("192.168.0.2", "MuxPort0"), nh3("192.168.0.3", "MuxPort0"), nh4("192.168.0.4", "MuxPort1");
+        mux_cb_orch->addTunnelRoute(nh4);
+
+        MuxSwitchover switchover;
+
+        // One of the tunnel routes of MuxPort0 fails
+        to_standby.state_ = MuxState::MUX_STATE_STANDBY;
+        to_standby.st_chg_in_progress_ = true;
+        switchover.begin(&to_standby, MuxState::MUX_STATE_ACTIVE, "standby");
+        mux_cb_orch->addTunnelRoute(nh2);
+        switchover.createRoute(pfx2, nh2, tnh);
+        mux_cb_orch->addTunnelRoute(nh3);
+        switchover.createRoute(pfx3, nh3, tnh);
+
+        to_active.state_ = MuxState::MUX_STATE_ACTIVE;
+        to_active.st_chg_in_progress_ = true;
+        switchover.begin(&to_active, MuxState::MUX_STATE_STANDBY, "active");
+        switchover.removeRoute(pfx4, nh4, tnh);
+
+        switchover.commit();
+
+        // The routes are programmed in bulk, the one MuxPort0 did get is removed again
+        ASSERT_EQ(tunnel_route_calls.size(), 4);
+        ASSERT_EQ(count(tunnel_route_calls.begin(), tunnel_route_calls.end(), "bulk create 192.168.0.2"), 1);
+        ASSERT_EQ(count(tunnel_route_calls.begin(), tunnel_route_calls.end(), "bulk create 192.168.0.3"), 1);
+        ASSERT_EQ(count(tunnel_route_calls.begin(), tunnel_route_calls.end(), "bulk remove 192.168.0.4"), 1);
+        ASSERT_EQ(tunnel_route_calls.back(), "remove 192.168.0.2");
+
+        // MuxPort0 is back to its previous state, without tunnel routes in APPL_DB
+        Table tunnel_route_table(m_app_db.get(), APP_TUNNEL_ROUTE_TABLE_NAME);
+        Table hw_mux_table(m_app_db.get(), APP_HW_MUX_CABLE_TABLE_NAME);
+        vector<FieldValueTuple> values;
+        string state;
+        ASSERT_EQ(to_standby.getState(), "active");
+        ASSERT_TRUE(to_standby.isStateChangeFailed());
+        ASSERT_FALSE(to_standby.isStateChangeInProgress());
+        ASSERT_FALSE(tunnel_route_table.get("192.168.0.2/32", values));
+        ASSERT_FALSE(tunnel_route_table.get("192.168.0.3/32", values));
+        ASSERT_FALSE(hw_mux_table.hget("MuxPort0", "state", state));
+
+        // MuxPort1 completes its change, its APPL_DB tunnel route is removed after the SAI one
+        ASSERT_EQ(to_active.getState(), "active");
+        ASSERT_FALSE(to_active.isStateChangeFailed());
+        ASSERT_FALSE(to_active.isStateChangeInProgress());
+        ASSERT_FALSE(tunnel_route_table.get("192.168.0.4/32", values));
+        ASSERT_TRUE(hw_mux_table.hget("MuxPort1", "state", state));
+        ASSERT_EQ(state, "active");
+    }
+
+    TEST(NextHopGroupKeyTest, InternedKeyIdentity)
+    {
+        NextHopGroupKey nhg1("10.0.0.2@Ethernet0,10.0.0.3@Ethernet4");
+        NextHopGroupKey nhg2("10.0.0.3@Ethernet4,10.0.0.2@Ethernet0");
+        ASSERT_TRUE(nhg1 == nhg2);
+        ASSERT_EQ(nhg1.getHash(), nhg2.getHash());
+        ASSERT_FALSE(nhg1 < nhg2 || nhg2 < nhg1);
+
+        // Same members with different weights are different groups
+        NextHopGroupKey weighted("10.0.0.2@Ethernet0,10.0.0.3@Ethernet4", string("1,2"));
+        ASSERT_TRUE(nhg1 != weighted);
+        ASSERT_TRUE(nhg1 < weighted || weighted < nhg1);
+
+        // Incremental updates end up equal to a freshly parsed key
+        NextHopGroupKey nhg3("10.0.0.2@Ethernet0");
+        nhg3.add("10.0.0.3@Ethernet4");
+        nhg3.add("10.0.0.4@Ethernet8");
+        nhg3.remove("10.0.0.4@Ethernet8");
+        ASSERT_TRUE(nhg1 == nhg3);
+        ASSERT_EQ(nhg1.getHash(), nhg3.getHash());
+        ASSERT_EQ(nhg3.to_string(), "10.0.0.2@Ethernet0,10.0.0.3@Ethernet4");
+
+        nhg3.clear();
+        ASSERT_TRUE(nhg3 == NextHopGroupKey());
+
+        std::unordered_map<NextHopGroupKey, int> table;
+        table[nhg1] = 1;
+        ASSERT_EQ(table.count(nhg2), 1);
+        ASSERT_EQ(table.count(weighted), 0);
+    }
+
+    TEST(NextHopGroupKeyTest, InternedIdsAreReleased)
+    {
+        size_t size = NextHopKeyTable::size();
+        {
+            NextHopGroupKey nhg1("10.0.1.2@Ethernet0,10.0.1.3@Ethernet4");
+            NextHopGroupKey nhg2 = nhg1;
+            ASSERT_EQ(NextHopKeyTable::size(), size + 2);
+
+            nhg1.remove("10.0.1.3@Ethernet4");
+            ASSERT_EQ(NextHopKeyTable::size(), size + 2);
+            nhg2.remove("10.0.1.3@Ethernet4");
+            ASSERT_EQ(NextHopKeyTable::size(), size + 1);
+
+            // The released id is reused by the next new next hop
+            uint32_t id;
+            ASSERT_FALSE(NextHopKeyTable::find(NextHopKey("10.0.1.3", "Ethernet4"), id));
+            nhg1.add("10.0.1.4@Ethernet8");
+            ASSERT_EQ(NextHopKeyTable::size(), size + 2);
+            ASSERT_TRUE(nhg1.contains("10.0.1.4@Ethernet8"));
+            ASSERT_FALSE(nhg1.contains("10.0.1.3@Ethernet4"));
+            ASSERT_EQ(nhg1.to_string(), "10.0.1.2@Ethernet0,10.0.1.4@Ethernet8");
+
+            NextHopGroupKey nhg3(std::move(nhg1));
+            ASSERT_EQ(nhg1.getSize(), 0);
+            ASSERT_EQ(nhg3.getNextHops().size(), 2);
+            ASSERT_EQ(NextHopKeyTable::size(), size + 2);
+        }
+        ASSERT_EQ(NextHopKeyTable::size(), size);
+    }
+
+    TEST(PrefixTableTest, LongestMatchAndOrder)
+    {
+        PrefixTable<int> table;
+        table[IpPrefix("0.0.0.0/0")] = 0;
+        table[IpPrefix("10.0.0.0/8")] = 8;
+        table[IpPrefix("10.1.0.0/16")] = 16;
+        table[IpPrefix("10.1.1.0/24")] = 24;
+        table[IpPrefix("10.2.0.0/16")] = 17;
+        table[IpPrefix("2001::/64")] = 64;
+        ASSERT_EQ(table.size(), 6);
+
+        ASSERT_EQ(table.longestMatch(IpAddress("10.1.1.1"))->second, 24);
+        ASSERT_EQ(table.longestMatch(IpAddress("10.1.2.1"))->second, 16);
+        ASSERT_EQ(table.longestMatch(IpAddress("11.0.0.1"))->second, 0);
+        ASSERT_TRUE(table.longestMatch(IpAddress("2002::1")) == table.end());
+
+        vector<int> covering;
+        table.forEachMatch(IpAddress("10.1.1.1"), [&](const PrefixTable<int>::value_type &entry)
+        {
+            covering.push_back(entry.second);
+        });
+        ASSERT_EQ(covering, vector<int>({ 0, 8, 16, 24 }));
+
+        vector<int> subnet;
+        table.forEachInSubnet(IpPrefix("10.0.0.0/8"), [&](const PrefixTable<int>::value_type &entry)
+        {
+            subnet.push_back(entry.second);
+            return true;
+        });
+        ASSERT_EQ(subnet, vector<int>({ 8, 16, 24, 17 }));
+
+        // The walk stops once the callback returns false
+        subnet.clear();
+        table.forEachInSubnet(IpPrefix("10.0.0.0/8"), [&](const PrefixTable<int>::value_type &entry)
+        {
+            subnet.push_back(entry.second);
+            return subnet.size() < 2;
+        });
+        ASSERT_EQ(subnet, vector<int>({ 8, 16 }));
+
+        // Iteration follows std::map<IpPrefix, T> order, IPv4 first
+        std::map<IpPrefix, int> reference;
+        for (const auto &entry : table)
+        {
+            reference.emplace(entry.first, entry.second);
+        }
+        auto it = table.begin();
+        for (const auto &entry : reference)
+        {
+            ASSERT_EQ(it->first, entry.first);
+            ++it;
+        }
+
+        ASSERT_EQ(table.erase(IpPrefix("10.1.0.0/16")), 1);
+        ASSERT_EQ(table.erase(IpPrefix("10.1.0.0/16")), 0);
+        ASSERT_EQ(table.longestMatch(IpAddress("10.1.2.1"))->second, 8);
+        ASSERT_EQ(table.at(IpPrefix("10.1.1.0/24")), 24);
+        ASSERT_THROW(table.at(IpPrefix("10.1.0.0/16")), std::out_of_range);
+    }
 }
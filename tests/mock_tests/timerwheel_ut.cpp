@@ -0,0 +1,115 @@
+#include "gtest/gtest.h"
+#include "timerwheel.h"
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace timerwheel_test
+{
+    using namespace std;
+
+    typedef vector<pair<string, uint64_t>> Expired;
+
+    static Expired expire(TimerWheel<string> &wheel, uint64_t now)
+    {
+        Expired expired;
+        wheel.advance(now, [&](const string &key, uint64_t when) {
+            expired.emplace_back(key, when);
+        });
+        return expired;
+    }
+
+    TEST(TimerWheelTest, ExpiresKeysWhenDue)
+    {
+        TimerWheel<string> wheel(1, 100);
+
+        wheel.schedule("a", 105);
+        wheel.schedule("b", 103);
+        wheel.schedule("c", 105);
+        ASSERT_EQ(wheel.size(), 3);
+
+        ASSERT_TRUE(expire(wheel, 102).empty());
+        ASSERT_EQ(expire(wheel, 103), Expired({ { "b", 103 } }));
+        ASSERT_TRUE(expire(wheel, 104).empty());
+
+        auto expired = expire(wheel, 110);
+        ASSERT_EQ(expired.size(), 2);
+        ASSERT_EQ((map<string, uint64_t>(expired.begin(), expired.end())), (map<string, uint64_t>{ { "a", 105 }, { "c", 105 } }));
+        ASSERT_EQ(wheel.size(), 0);
+    }
+
+    TEST(TimerWheelTest, PastTimesExpireOnNextAdvance)
+    {
+        TimerWheel<string> wheel(1, 100);
+
+        wheel.schedule("late", 50);
+        ASSERT_EQ(wheel.size(), 1);
+        ASSERT_EQ(expire(wheel, 100), Expired({ { "late", 50 } }));
+        ASSERT_EQ(wheel.size(), 0);
+    }
+
+    TEST(TimerWheelTest, CascadesFromUpperLevels)
+    {
+        TimerWheel<string> wheel(5, 0);
+
+        // One key per level, and one beyond the top level turn
+        map<string, uint64_t> schedule = {
+            { "level0", 5 * 10 },
+            { "level1", 5 * (64 * 3 + 7) },
+            { "level2", 5 * (64 * 64 * 2 + 64 * 5 + 1) },
+            { "level3", 5 * (64 * 64 * 64 * 3 + 11) },
+            { "far", 5 * (64ULL * 64 * 64 * 64 + 3) },
+        };
+        for (const auto &item : schedule)
+        {
+            wheel.schedule(item.first, item.second);
+        }
+
+        // Every key expires in the tick it was scheduled at, never before
+        map<string, uint64_t> expired;
+        vector<uint64_t> times;
+        for (const auto &item : schedule)
+        {
+            times.push_back(item.second);
+        }
+        sort(times.begin(), times.end());
+        for (auto when : times)
+        {
+            ASSERT_TRUE(expire(wheel, when - 1).empty()) << when;
+            auto due = expire(wheel, when);
+            ASSERT_EQ(due.size(), 1) << when;
+            ASSERT_EQ(due[0].second, when);
+            expired.insert(due[0]);
+        }
+
+        ASSERT_EQ(expired, schedule);
+        ASSERT_EQ(wheel.size(), 0);
+    }
+
+    TEST(TimerWheelTest, DuplicatesAreExpiredEach)
+    {
+        TimerWheel<string> wheel(1, 0);
+
+        // There is no cancellation, a rescheduled key expires at both times
+        wheel.schedule("a", 10);
+        wheel.schedule("a", 20);
+        ASSERT_EQ(wheel.size(), 2);
+
+        ASSERT_EQ(expire(wheel, 15), Expired({ { "a", 10 } }));
+        ASSERT_EQ(expire(wheel, 25), Expired({ { "a", 20 } }));
+        ASSERT_EQ(wheel.size(), 0);
+    }
+
+    TEST(TimerWheelTest, SchedulesWhileIdle)
+    {
+        TimerWheel<string> wheel(1, 0);
+
+        // An empty wheel jumps to the current time, later keys are still placed relative to it
+        ASSERT_TRUE(expire(wheel, 1000000).empty());
+        wheel.schedule("a", 1000010);
+        ASSERT_TRUE(expire(wheel, 1000009).empty());
+        ASSERT_EQ(expire(wheel, 1000010), Expired({ { "a", 1000010 } }));
+    }
+}
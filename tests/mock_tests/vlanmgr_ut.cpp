@@ -0,0 +1,165 @@
+#define private public
+#include "vlanmgr.h"
+#undef private
+#include "gtest/gtest.h"
+#include "mock_table.h"
+#include "redisutility.h"
+
+extern int (*callback)(const std::string &cmd, std::string &stdout);
+extern std::vector<std::string> mockCallArgs;
+
+namespace vlanmgr_ut
+{
+    using namespace swss;
+    using namespace std;
+
+    /* Netlink requests, by description, that fail the given number of times */
+    map<string, int> failingRequests;
+
+    int failRequests(const string &cmd, string &stdout)
+    {
+        mockCallArgs.push_back(cmd);
+        auto it = failingRequests.find(cmd);
+        if (it != failingRequests.end() && it->second > 0)
+        {
+            it->second--;
+            return 1;
+        }
+        return 0;
+    }
+
+    struct VlanMgrTest : public ::testing::Test
+    {
+        shared_ptr<swss::DBConnector> m_app_db;
+        shared_ptr<swss::DBConnector> m_config_db;
+        shared_ptr<swss::DBConnector> m_state_db;
+        shared_ptr<VlanMgr> m_vlanMgr;
+
+        VlanMgrTest()
+        {
+            m_app_db = make_shared<swss::DBConnector>("APPL_DB", 0);
+            m_config_db = make_shared<swss::DBConnector>("CONFIG_DB", 0);
+            m_state_db = make_shared<swss::DBConnector>("STATE_DB", 0);
+        }
+
+        void SetUp() override
+        {
+            ::testing_db::reset();
+            failingRequests.clear();
+            callback = failRequests;
+
+            vector<string> cfg_vlan_tables = {
+                CFG_VLAN_TABLE_NAME,
+                CFG_VLAN_MEMBER_TABLE_NAME,
+            };
+            m_vlanMgr.reset(new VlanMgr(m_config_db.get(), m_app_db.get(), m_state_db.get(), cfg_vlan_tables));
+
+            Table state_port_table(m_state_db.get(), STATE_PORT_TABLE_NAME);
+            Table state_vlan_table(m_state_db.get(), STATE_VLAN_TABLE_NAME);
+            for (auto port : { "Ethernet0", "Ethernet4", "Ethernet8" })
+            {
+                state_port_table.set(port, { { "state", "ok" } });
+            }
+            for (auto vlan : { "Vlan10", "Vlan20" })
+            {
+                state_vlan_table.set(vlan, { { "state", "ok" } });
+            }
+            mockCallArgs.clear();
+        }
+
+        void TearDown() override
+        {
+            callback = nullptr;
+        }
+
+        void doVlanMemberTask(const deque<KeyOpFieldsValuesTuple> &entries)
+        {
+            auto consumer = dynamic_cast<Consumer *>(m_vlanMgr->getExecutor(CFG_VLAN_MEMBER_TABLE_NAME));
+            consumer->addToSync(entries);
+            m_vlanMgr->doTask(*consumer);
+        }
+
+        size_t count(const string &cmd)
+        {
+            return std::count(mockCallArgs.begin(), mockCallArgs.end(), cmd);
+        }
+
+        /* Whether the member is in both APPL_DB and STATE_DB, EXPECTs them to agree */
+        bool isPublished(const string &vlan, const string &port)
+        {
+            Table app_vlan_member_table(m_app_db.get(), APP_VLAN_MEMBER_TABLE_NAME);
+            Table state_vlan_member_table(m_state_db.get(), STATE_VLAN_MEMBER_TABLE_NAME);
+            vector<FieldValueTuple> values;
+            bool app = app_vlan_member_table.get(vlan + ":" + port, values);
+            bool state = state_vlan_member_table.get(vlan + "|" + port, values);
+            EXPECT_EQ(app, state) << vlan << " " << port;
+            return app && state;
+        }
+    };
+
+    TEST_F(VlanMgrTest, ReplaysOnlyFailedMembers)
+    {
+        failingRequests["bridge vlan add vid 10 dev Ethernet4 pvid untagged"] = 1;
+
+        doVlanMemberTask({
+            { "Vlan10|Ethernet0", SET_COMMAND, { { "tagging_mode", "tagged" } } },
+            { "Vlan10|Ethernet4", SET_COMMAND, { { "tagging_mode", "untagged" } } },
+            { "Vlan20|Ethernet8", SET_COMMAND, { { "tagging_mode", "untagged" } } },
+        });
+
+        // The members programmed by the batch are not replayed
+        ASSERT_EQ(count("link set Ethernet0 master Bridge"), 1);
+        ASSERT_EQ(count("bridge vlan add vid 10 dev Ethernet0"), 1);
+        ASSERT_EQ(count("link set Ethernet8 master Bridge"), 1);
+        ASSERT_EQ(count("bridge vlan add vid 20 dev Ethernet8 pvid untagged"), 1);
+
+        // The failed one is replayed on its own
+        ASSERT_EQ(count("link set Ethernet4 master Bridge"), 2);
+        ASSERT_EQ(count("bridge vlan add vid 10 dev Ethernet4 pvid untagged"), 2);
+
+        ASSERT_TRUE(isPublished("Vlan10", "Ethernet0"));
+        ASSERT_TRUE(isPublished("Vlan10", "Ethernet4"));
+        ASSERT_TRUE(isPublished("Vlan20", "Ethernet8"));
+    }
+
+    TEST_F(VlanMgrTest, PublishesOnlyProgrammedMembers)
+    {
+        failingRequests["bridge vlan add vid 10 dev Ethernet4 pvid untagged"] = 2;
+
+        ASSERT_THROW(doVlanMemberTask({
+            { "Vlan10|Ethernet0", SET_COMMAND, { { "tagging_mode", "tagged" } } },
+            { "Vlan10|Ethernet4", SET_COMMAND, { { "tagging_mode", "untagged" } } },
+            { "Vlan20|Ethernet8", SET_COMMAND, { { "tagging_mode", "untagged" } } },
+        }), runtime_error);
+
+        ASSERT_TRUE(isPublished("Vlan10", "Ethernet0"));
+        ASSERT_TRUE(isPublished("Vlan20", "Ethernet8"));
+        ASSERT_FALSE(isPublished("Vlan10", "Ethernet4"));
+    }
+
+    TEST_F(VlanMgrTest, ReplaysOnlyFailedRemovals)
+    {
+        doVlanMemberTask({
+            { "Vlan10|Ethernet0", SET_COMMAND, { { "tagging_mode", "tagged" } } },
+            { "Vlan20|Ethernet4", SET_COMMAND, { { "tagging_mode", "tagged" } } },
+        });
+        ASSERT_TRUE(isPublished("Vlan10", "Ethernet0"));
+        ASSERT_TRUE(isPublished("Vlan20", "Ethernet4"));
+
+        mockCallArgs.clear();
+        failingRequests["bridge vlan del vid 20 dev Ethernet4"] = 1;
+        doVlanMemberTask({
+            { "Vlan10|Ethernet0", DEL_COMMAND, {} },
+            { "Vlan20|Ethernet4", DEL_COMMAND, {} },
+        });
+
+        ASSERT_EQ(count("bridge vlan del vid 10 dev Ethernet0"), 1);
+        ASSERT_EQ(count("bridge vlan del vid 20 dev Ethernet4"), 2);
+        // Neither port is left in a VLAN, each is detached once
+        ASSERT_EQ(count("link set Ethernet0 nomaster"), 1);
+        ASSERT_EQ(count("link set Ethernet4 nomaster"), 1);
+
+        ASSERT_FALSE(isPublished("Vlan10", "Ethernet0"));
+        ASSERT_FALSE(isPublished("Vlan20", "Ethernet4"));
+    }
+}